@@ -0,0 +1,77 @@
+/*!
+ 	 \file FreeRTOSConfig.h
+
+ 	 \brief This is the FreeRTOS configuration of the host build. The
+ 	 	 	 application values are the ones of Generated_Code/FreeRTOSConfig.h,
+ 	 	 	 only the Cortex-M specific definitions are left out.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION                     1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ( 48000000UL )
+#define configBUS_CLOCK_HZ                       24000000
+#define configTICK_RATE_HZ                       ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                     ( 8 )
+#define configMINIMAL_STACK_SIZE                 ( ( unsigned short ) 200 )
+#define configTOTAL_HEAP_SIZE                    ( ( size_t ) 8704 )
+#define configMAX_TASK_NAME_LEN                  ( 12 )
+#define configUSE_TRACE_FACILITY                 1
+#define configUSE_16_BIT_TICKS                   0
+#define configIDLE_SHOULD_YIELD                  1
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                0
+#define configCHECK_FOR_STACK_OVERFLOW           0
+#define configUSE_RECURSIVE_MUTEXES              1
+#define configUSE_MALLOC_FAILED_HOOK             1
+#define configUSE_APPLICATION_TASK_TAG           0
+#define configUSE_COUNTING_SEMAPHORES            1
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 3 )
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             128
+
+/* API functions definitions */
+#define INCLUDE_vTaskPrioritySet                 1
+#define INCLUDE_uxTaskPriorityGet                1
+#define INCLUDE_vTaskDelete                      1
+#define INCLUDE_vTaskSuspend                     1
+#define INCLUDE_vTaskDelayUntil                  1
+#define INCLUDE_vTaskDelay                       1
+#define INCLUDE_eTaskGetState                    0
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#define INCLUDE_xTaskGetSchedulerState           1
+#define INCLUDE_xQueueGetMutexHolder             1
+#define INCLUDE_xTaskGetCurrentTaskHandle        1
+#define INCLUDE_xTaskGetIdleTaskHandle           0
+#define INCLUDE_pcTaskGetTaskName                0
+#define INCLUDE_xEventGroupSetBitFromISR         1
+#define INCLUDE_xTimerPendFunctionCall           1
+
+#define configUSE_STATS_FORMATTING_FUNCTIONS     0
+#define configGENERATE_RUN_TIME_STATS            0
+
+/* Definition assert() function. */
+#define configASSERT(x)                          if((x)==0) { vAssertCalled(__FILE__, __LINE__); }
+void vAssertCalled(const char* file, unsigned long line);
+
+/* Tickless Idle Mode */
+#define configUSE_TICKLESS_IDLE                  0
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,129 @@
+/*!
+ 	 \file S32K144.h
+
+ 	 \brief This is the host stand-in of the S32K144 peripheral access layer.
+ 	 	 	 It is picked in place of the SDK header when the sources are built
+ 	 	 	 on a PC: the register structures, masks and IRQ numbers are the
+ 	 	 	 ones of the SDK, but each peripheral pointer points to an in-memory
+ 	 	 	 instance instead of its bus address. Each instance is alone in its
+ 	 	 	 pages, so the host simulator can trap its accesses.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HOST_S32K144_H_
+#define HOST_S32K144_H_
+
+/* Register structures, masks and IRQ numbers of the SDK */
+#include_next "S32K144.h"
+
+/** Defines the size of a page of the host*/
+#define HOST_PAGE_SIZE					(4096)
+
+/** Declares the instance of a peripheral in its own pages (The host simulator protects each
+ 	 peripheral apart, to see its accesses)*/
+#define HOST_PERIPHERAL(type)			struct { type regs; } __attribute__((aligned(HOST_PAGE_SIZE)))
+
+/*!
+ 	 \brief In-memory instances of the peripherals.
+ */
+typedef struct
+{
+	HOST_PERIPHERAL(CAN_Type) can[CAN_INSTANCE_COUNT];		/*!< FlexCAN modules*/
+	HOST_PERIPHERAL(ADC_Type) adc[ADC_INSTANCE_COUNT];		/*!< ADC modules*/
+	HOST_PERIPHERAL(GPIO_Type) gpio[GPIO_INSTANCE_COUNT];	/*!< GPIO ports*/
+	HOST_PERIPHERAL(PORT_Type) port[PORT_INSTANCE_COUNT];	/*!< Pin control of the ports*/
+	HOST_PERIPHERAL(LPSPI_Type) lpspi[LPSPI_INSTANCE_COUNT];	/*!< LPSPI modules*/
+	HOST_PERIPHERAL(LPTMR_Type) lptmr[LPTMR_INSTANCE_COUNT];	/*!< Low power timer*/
+	HOST_PERIPHERAL(PDB_Type) pdb[PDB_INSTANCE_COUNT];		/*!< Programmable delay blocks*/
+	HOST_PERIPHERAL(PCC_Type) pcc;							/*!< Peripheral clock control*/
+	HOST_PERIPHERAL(SCG_Type) scg;							/*!< System clock generator*/
+	HOST_PERIPHERAL(SIM_Type) sim;							/*!< System integration module*/
+	HOST_PERIPHERAL(PMC_Type) pmc;							/*!< Power management controller*/
+	HOST_PERIPHERAL(SMC_Type) smc;							/*!< System mode controller*/
+	HOST_PERIPHERAL(RCM_Type) rcm;							/*!< Reset control module*/
+	HOST_PERIPHERAL(WDOG_Type) wdog;						/*!< Watchdog*/
+}host_peripherals_t;
+
+/** Peripherals used by the sources (Defined by the host tests, or by the host simulator that maps its memory
+ 	 over them). It is an object, so the instances are address constants as the ones of the SDK*/
+extern host_peripherals_t host_peripherals;
+
+#undef CAN0
+#undef CAN1
+#undef CAN2
+/** FlexCAN instances*/
+#define CAN0							(&host_peripherals.can[0U].regs)
+#define CAN1							(&host_peripherals.can[1U].regs)
+#define CAN2							(&host_peripherals.can[2U].regs)
+
+#undef ADC0
+#undef ADC1
+/** ADC instances*/
+#define ADC0							(&host_peripherals.adc[0U].regs)
+#define ADC1							(&host_peripherals.adc[1U].regs)
+
+#undef PTA
+#undef PTB
+#undef PTC
+#undef PTD
+#undef PTE
+/** GPIO instances*/
+#define PTA								(&host_peripherals.gpio[0U].regs)
+#define PTB								(&host_peripherals.gpio[1U].regs)
+#define PTC								(&host_peripherals.gpio[2U].regs)
+#define PTD								(&host_peripherals.gpio[3U].regs)
+#define PTE								(&host_peripherals.gpio[4U].regs)
+
+#undef PORTA
+#undef PORTB
+#undef PORTC
+#undef PORTD
+#undef PORTE
+/** PORT instances*/
+#define PORTA							(&host_peripherals.port[0U].regs)
+#define PORTB							(&host_peripherals.port[1U].regs)
+#define PORTC							(&host_peripherals.port[2U].regs)
+#define PORTD							(&host_peripherals.port[3U].regs)
+#define PORTE							(&host_peripherals.port[4U].regs)
+
+#undef LPSPI0
+#undef LPSPI1
+#undef LPSPI2
+/** LPSPI instances*/
+#define LPSPI0							(&host_peripherals.lpspi[0U].regs)
+#define LPSPI1							(&host_peripherals.lpspi[1U].regs)
+#define LPSPI2							(&host_peripherals.lpspi[2U].regs)
+
+#undef LPTMR0
+/** LPTMR instance*/
+#define LPTMR0							(&host_peripherals.lptmr[0U].regs)
+
+#undef PDB0
+#undef PDB1
+/** PDB instances*/
+#define PDB0							(&host_peripherals.pdb[0U].regs)
+#define PDB1							(&host_peripherals.pdb[1U].regs)
+
+#undef PCC
+#undef SCG
+#undef SIM
+#undef PMC
+#undef SMC
+#undef RCM
+#undef WDOG
+/** System instances (The core peripherals, as the SysTick or the NVIC, keep their addresses)*/
+#define PCC								(&host_peripherals.pcc.regs)
+#define SCG								(&host_peripherals.scg.regs)
+#define SIM								(&host_peripherals.sim.regs)
+#define PMC								(&host_peripherals.pmc.regs)
+#define SMC								(&host_peripherals.smc.regs)
+#define RCM								(&host_peripherals.rcm.regs)
+#define WDOG							(&host_peripherals.wdog.regs)
+
+#endif /* HOST_S32K144_H_ */
@@ -0,0 +1,28 @@
+/*!
+ 	 \file device_registers.h
+
+ 	 \brief This is the host stand-in of the register access layer of the SDK.
+ 	 	 	 The SDK header includes the device header by its path, so the
+ 	 	 	 host stand-ins (S32K144.h and s32_core_cm4.h) are included
+ 	 	 	 first: the SDK includes are then skipped by their guards, and the
+ 	 	 	 drivers and HALs use the in-memory peripherals too.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HOST_DEVICE_REGISTERS_H_
+#define HOST_DEVICE_REGISTERS_H_
+
+/* Found by the include paths, so their include_next reach the SDK headers */
+#include <S32K144.h>
+#include <s32_core_cm4.h>
+
+/* Features of the device and the asserts of the SDK */
+#include_next "device_registers.h"
+
+#endif /* HOST_DEVICE_REGISTERS_H_ */
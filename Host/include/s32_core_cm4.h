@@ -0,0 +1,32 @@
+/*!
+ 	 \file s32_core_cm4.h
+
+ 	 \brief This is the host stand-in of the Cortex-M4 core header. The byte
+ 	 	 	 reverse macros use the compiler builtins instead of the
+ 	 	 	 ARM instructions, and the core does not sleep.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HOST_CORE_CM4_H_
+#define HOST_CORE_CM4_H_
+
+#include_next "s32_core_cm4.h"
+
+#undef REV_BYTES_32
+#undef REV_BYTES_16
+/** Reverses the byte order in a word*/
+#define REV_BYTES_32(a, b)		(b = __builtin_bswap32(a))
+/** Reverses the byte order in each halfword*/
+#define REV_BYTES_16(a, b)		(b = ((((a) & 0xFF00FF00U) >> 8U) | (((a) & 0x00FF00FFU) << 8U)))
+
+#undef STANDBY
+/** Waits for an interruption (The host simulator does not stop the core)*/
+#define STANDBY()
+
+#endif /* HOST_CORE_CM4_H_ */
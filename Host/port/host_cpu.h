@@ -0,0 +1,104 @@
+/*!
+ 	 \file host_cpu.h
+
+ 	 \brief This is the header file of the interruptions of the host port of
+ 	 	 	 FreeRTOS. The port keeps a vector table and the pending, enabled
+ 	 	 	 and priority bits of an NVIC; the simulated peripherals set the
+ 	 	 	 pending bits from any thread, and the handlers run in the thread
+ 	 	 	 of the running task, as the exceptions of the Cortex-M4 do.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HOST_CPU_H_
+#define HOST_CPU_H_
+
+#include <stdint.h>
+
+/** Defines the exceptions of the core before the first IRQ (The IRQ numbers of the
+ 	 core exceptions are negative, as in the device header)*/
+#define HOST_CPU_EXCEPTIONS			(16)
+/** Defines the vectors of the table*/
+#define HOST_CPU_VECTORS			(256)
+/** Defines the IRQ number of the SysTick*/
+#define HOST_CPU_SYSTICK_IRQ		(-1)
+
+/** Handler of an interruption*/
+typedef void (*host_cpu_isr_t)(void);
+
+/*!
+ 	 \brief This function installs the handler of an interruption.
+
+ 	 \param[in] irq IRQ number (Negative for the core exceptions).
+ 	 \param[in] handler Handler of the interruption.
+
+ 	 \return The previous handler.
+ */
+host_cpu_isr_t host_cpu_install_handler(int32_t irq, host_cpu_isr_t handler);
+
+/*!
+ 	 \brief This function enables or disables an interruption (The core
+ 	 	 	 exceptions are always enabled).
+
+ 	 \param[in] irq IRQ number.
+ 	 \param[in] enable 1 to enable it, 0 to disable it.
+
+ 	 \return void.
+ */
+void host_cpu_enable_irq(int32_t irq, uint8_t enable);
+
+/*!
+ 	 \brief This function sets the priority of an interruption.
+
+ 	 \param[in] irq IRQ number.
+ 	 \param[in] priority Priority, 0 is the highest.
+
+ 	 \return void.
+ */
+void host_cpu_set_priority(int32_t irq, uint8_t priority);
+
+/*!
+ 	 \brief This function sets an interruption as pending, it can be called from
+ 	 	 	 any thread. The handler runs in the thread of the running task
+ 	 	 	 as soon as the interruptions are not masked.
+
+ 	 \param[in] irq IRQ number.
+
+ 	 \return void.
+ */
+void host_cpu_set_pending(int32_t irq);
+
+/*!
+ 	 \brief This function clears a pending interruption (A level interruption
+ 	 	 	 whose source was cleared before its handler ran).
+
+ 	 \param[in] irq IRQ number.
+
+ 	 \return void.
+ */
+void host_cpu_clear_pending(int32_t irq);
+
+/*!
+ 	 \brief This function gets the handlers run since the scheduler started.
+
+ 	 \param[in] irq IRQ number.
+
+ 	 \return Number of times the handler ran.
+ */
+uint32_t host_cpu_get_isr_count(int32_t irq);
+
+/*!
+ 	 \brief This function waits for an interruption in the running task (The
+ 	 	 	 WFI of the Cortex-M4), so a task with nothing to do does not keep
+ 	 	 	 the host core from the other threads.
+
+ 	 \return void.
+ */
+void host_cpu_wait_for_interrupt(void);
+
+#endif /* HOST_CPU_H_ */
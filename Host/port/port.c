@@ -0,0 +1,592 @@
+/*!
+ 	 \file port.c
+
+ 	 \brief This is the source file of the host port of FreeRTOS, it is used in
+ 	 	 	 place of portable/GCC/ARM_CM4F to run the kernel on a PC. Each task
+ 	 	 	 runs in its own POSIX thread and only the thread of the running
+ 	 	 	 task is not blocked, so the kernel sees a single core. The
+ 	 	 	 interruptions are sent to that thread with a signal, and their
+ 	 	 	 handlers run there as long as the interruptions are not masked,
+ 	 	 	 as the exceptions of the Cortex-M4 run on the stack of the task.
+ 	 	 	 A context switch requested in a critical section, or from a
+ 	 	 	 handler, is done when the interruptions are unmasked (The PendSV
+ 	 	 	 of the Cortex-M4).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "host_cpu.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the signal that interrupts the running task*/
+#define INTERRUPT_SIGNAL			(SIGUSR1)
+/** Defines the stack of the thread of a task (The FreeRTOS stack only keeps the thread)*/
+#define THREAD_STACK_SIZE			(256 * 1024)
+/** Defines the alignment of the thread in the FreeRTOS stack*/
+#define THREAD_ALIGNMENT			(16)
+/** Defines the nesting before the scheduler starts, so the interruptions stay masked until then*/
+#define NESTING_BEFORE_START		(0xaaaaaaaa)
+/** Defines the bits of a word of the pending and enabled bits*/
+#define BITS_PER_WORD				(32)
+/** Defines the words of the pending and enabled bits*/
+#define VECTOR_WORDS				(HOST_CPU_VECTORS / BITS_PER_WORD)
+/** Defines the enabled bits of the core exceptions, they can not be disabled*/
+#define EXCEPTIONS_ENABLED			((1UL << HOST_CPU_EXCEPTIONS) - 1UL)
+/** Defines that no vector is pending*/
+#define NO_VECTOR					(HOST_CPU_VECTORS)
+/** Defines the priority of the kernel interruptions (The lowest one)*/
+#define KERNEL_PRIORITY				(configKERNEL_INTERRUPT_PRIORITY >> (8 - configPRIO_BITS))
+/** Defines the flag as set*/
+#define FLAG_SET					(1)
+
+/** Defines the SysTick registers, at their address in the core (Used by the default timer setup)*/
+#define SYSTICK_CTRL_REG			(*((volatile uint32_t*)0xe000e010))
+#define SYSTICK_LOAD_REG			(*((volatile uint32_t*)0xe000e014))
+#define SYSTICK_CURRENT_VALUE_REG	(*((volatile uint32_t*)0xe000e018))
+/** Defines the bits to start the SysTick with the core clock and its interruption*/
+#define SYSTICK_START				(0x00000007UL)
+
+/*!
+ 	 \brief Thread of a task, it is kept at the top of the FreeRTOS stack of the task,
+ 	 	 	 so the first word of the TCB points to it.
+ */
+typedef struct
+{
+	pthread_t thread;		/*!< Thread that runs the task*/
+	sem_t resume;			/*!< Posted when the task becomes the running one*/
+	TaskFunction_t code;	/*!< Function of the task*/
+	void* parameters;		/*!< Parameters of the task*/
+}host_thread_t;
+
+/** Running task of the kernel*/
+extern void* volatile pxCurrentTCB;
+
+/** Thread of the running task (NULL until the scheduler starts)*/
+static host_thread_t* volatile running_thread = NULL;
+/** Thread of the task of the calling thread*/
+static __thread host_thread_t* own_thread = NULL;
+/** Nesting of the critical sections*/
+static volatile UBaseType_t critical_nesting = NESTING_BEFORE_START;
+/** Indicates if the interruptions are masked (BASEPRI of the Cortex-M4)*/
+static volatile sig_atomic_t interrupts_masked = INIT_VAL;
+/** Indicates if a handler is running*/
+static volatile sig_atomic_t handler_running = INIT_VAL;
+/** Indicates if a context switch was requested (PendSV of the Cortex-M4)*/
+static volatile sig_atomic_t yield_pending = INIT_VAL;
+/** Indicates if the scheduler started*/
+static volatile sig_atomic_t scheduler_running = INIT_VAL;
+
+/** Vector table*/
+static host_cpu_isr_t vectors[HOST_CPU_VECTORS];
+/** Pending bits of the vectors*/
+static uint32_t pending[VECTOR_WORDS];
+/** Enabled bits of the vectors*/
+static uint32_t enabled[VECTOR_WORDS];
+/** Priorities of the vectors*/
+static uint8_t priorities[HOST_CPU_VECTORS];
+/** Times each handler ran*/
+static uint32_t isr_count[HOST_CPU_VECTORS];
+
+/** This function gets the vector of an IRQ number, NO_VECTOR if it is not valid*/
+static uint32_t host_vector(int32_t irq)
+{
+	/** Vector of the IRQ*/
+	int32_t vector = irq + HOST_CPU_EXCEPTIONS;
+
+	return ((INIT_VAL <= vector) && (HOST_CPU_VECTORS > vector)) ? (uint32_t)vector : NO_VECTOR;
+}
+
+/** This function gets the signal of the interruptions as a set*/
+static void host_interrupt_set(sigset_t* set)
+{
+	sigemptyset(set);
+	sigaddset(set, INTERRUPT_SIGNAL);
+}
+
+/** This function gets the thread of the running task*/
+static host_thread_t* host_task_thread(void)
+{
+	return (host_thread_t*)(*(StackType_t* volatile*)pxCurrentTCB);
+}
+
+/** This function waits until the thread is the running one*/
+static void host_thread_wait(host_thread_t* thread)
+{
+	while((INIT_VAL != sem_wait(&thread->resume)) && (EINTR == errno))
+	{
+	}
+}
+
+/** This function gets the pending and enabled vector with the highest priority*/
+static uint32_t host_next_vector(void)
+{
+	/** Vector with the highest priority*/
+	uint32_t next = NO_VECTOR;
+	/** Counter for the words*/
+	uint32_t word;
+	/** Pending and enabled bits of the word*/
+	uint32_t bits;
+	/** Vector of a bit*/
+	uint32_t vector;
+
+	for(word = INIT_VAL; VECTOR_WORDS > word; word ++)
+	{
+		bits = __atomic_load_n(&pending[word], __ATOMIC_SEQ_CST) & __atomic_load_n(&enabled[word], __ATOMIC_SEQ_CST);
+
+		while(INIT_VAL != bits)
+		{
+			vector = (word * BITS_PER_WORD) + (uint32_t)__builtin_ctz(bits);
+			bits &= bits - 1UL;
+
+			/** The lowest number wins between equal priorities, as in the NVIC*/
+			if((NO_VECTOR == next) || (priorities[vector] < priorities[next]))
+			{
+				next = vector;
+			}
+		}
+	}
+
+	return next;
+}
+
+/** This function switches to the task selected by the kernel, the calling thread waits until its task runs again*/
+static void host_switch(void)
+{
+	/** Thread of the task that stops*/
+	host_thread_t* previous = own_thread;
+	/** Thread of the task that runs*/
+	host_thread_t* next;
+
+	yield_pending = INIT_VAL;
+
+	/** The kernel lists are changed with the interruptions masked, as in the PendSV*/
+	interrupts_masked = FLAG_SET;
+	vTaskSwitchContext();
+	interrupts_masked = INIT_VAL;
+
+	next = host_task_thread();
+
+	if(next != previous)
+	{
+		__atomic_store_n(&running_thread, next, __ATOMIC_SEQ_CST);
+		sem_post(&next->resume);
+		host_thread_wait(previous);
+	}
+}
+
+/** This function runs the pending handlers, and the requested context switches, while the interruptions
+ 	 are not masked (The interruption signal must be blocked)*/
+static void host_dispatch(void)
+{
+	/** Vector to be run*/
+	uint32_t vector;
+	/** Bit of the vector*/
+	uint32_t bit;
+
+	while(scheduler_running && !interrupts_masked)
+	{
+		vector = host_next_vector();
+
+		if(NO_VECTOR != vector)
+		{
+			bit = 1UL << (vector % BITS_PER_WORD);
+
+			/** The handler is not run if the interruption was cleared meanwhile*/
+			if((__atomic_fetch_and(&pending[vector / BITS_PER_WORD], ~bit, __ATOMIC_SEQ_CST) & bit) && (NULL != vectors[vector]))
+			{
+				handler_running = FLAG_SET;
+				isr_count[vector] ++;
+				vectors[vector]();
+				handler_running = INIT_VAL;
+			}
+		}
+		else if(yield_pending)
+		{
+			host_switch();
+		}
+		else
+		{
+			break;
+		}
+	}
+}
+
+/** This function runs the pending work after the interruptions are unmasked in a task*/
+static void host_service(void)
+{
+	/** Signal mask of the thread*/
+	sigset_t previous;
+	/** Signal of the interruptions*/
+	sigset_t interrupt;
+
+	if(scheduler_running && (yield_pending || (NO_VECTOR != host_next_vector())))
+	{
+		host_interrupt_set(&interrupt);
+		pthread_sigmask(SIG_BLOCK, &interrupt, &previous);
+		host_dispatch();
+		pthread_sigmask(SIG_SETMASK, &previous, NULL);
+	}
+}
+
+/** Handler of the interruption signal, it interrupts the running task*/
+static void host_interrupt_handler(int signal)
+{
+	/** errno of the interrupted code*/
+	int saved_errno = errno;
+
+	(void)signal;
+
+	/** A thread that was interrupted before it stopped runs the handlers when it runs again*/
+	if((own_thread == running_thread) && !handler_running)
+	{
+		host_dispatch();
+	}
+
+	errno = saved_errno;
+}
+
+/** Function of the threads of the tasks*/
+static void* host_thread_start(void* parameters)
+{
+	/** Thread of the task*/
+	host_thread_t* thread = (host_thread_t*)parameters;
+	/** Signal of the interruptions*/
+	sigset_t interrupt;
+
+	own_thread = thread;
+
+	/** Waits until the task runs for the first time*/
+	host_thread_wait(thread);
+
+	host_interrupt_set(&interrupt);
+	pthread_sigmask(SIG_UNBLOCK, &interrupt, NULL);
+	host_service();
+
+	thread->code(thread->parameters);
+
+	/** A task can not return*/
+	configASSERT(INIT_VAL);
+
+	return NULL;
+}
+
+/** This function installs the handler of an interruption*/
+host_cpu_isr_t host_cpu_install_handler(int32_t irq, host_cpu_isr_t handler)
+{
+	/** Vector of the interruption*/
+	uint32_t vector = host_vector(irq);
+	/** Previous handler*/
+	host_cpu_isr_t previous = NULL;
+
+	if(NO_VECTOR != vector)
+	{
+		previous = vectors[vector];
+		vectors[vector] = handler;
+	}
+
+	return previous;
+}
+
+/** This function enables or disables an interruption*/
+void host_cpu_enable_irq(int32_t irq, uint8_t enable)
+{
+	/** Vector of the interruption*/
+	uint32_t vector = host_vector(irq);
+	/** Bit of the vector*/
+	uint32_t bit;
+
+	if((NO_VECTOR != vector) && (HOST_CPU_EXCEPTIONS <= vector))
+	{
+		bit = 1UL << (vector % BITS_PER_WORD);
+
+		if(enable)
+		{
+			__atomic_fetch_or(&enabled[vector / BITS_PER_WORD], bit, __ATOMIC_SEQ_CST);
+
+			/** An interruption that was pending while it was disabled runs now*/
+			if(__atomic_load_n(&pending[vector / BITS_PER_WORD], __ATOMIC_SEQ_CST) & bit)
+			{
+				host_cpu_set_pending(irq);
+			}
+		}
+		else
+		{
+			__atomic_fetch_and(&enabled[vector / BITS_PER_WORD], ~bit, __ATOMIC_SEQ_CST);
+		}
+	}
+}
+
+/** This function sets the priority of an interruption*/
+void host_cpu_set_priority(int32_t irq, uint8_t priority)
+{
+	/** Vector of the interruption*/
+	uint32_t vector = host_vector(irq);
+
+	if(NO_VECTOR != vector)
+	{
+		priorities[vector] = priority;
+	}
+}
+
+/** This function sets an interruption as pending*/
+void host_cpu_set_pending(int32_t irq)
+{
+	/** Vector of the interruption*/
+	uint32_t vector = host_vector(irq);
+	/** Thread of the running task*/
+	host_thread_t* thread;
+
+	if(NO_VECTOR != vector)
+	{
+		__atomic_fetch_or(&pending[vector / BITS_PER_WORD], 1UL << (vector % BITS_PER_WORD), __ATOMIC_SEQ_CST);
+
+		/** If the running task changes meanwhile, the new one checks the pending bits when it runs*/
+		thread = __atomic_load_n(&running_thread, __ATOMIC_SEQ_CST);
+		if(NULL != thread)
+		{
+			pthread_kill(thread->thread, INTERRUPT_SIGNAL);
+		}
+	}
+}
+
+/** This function clears a pending interruption*/
+void host_cpu_clear_pending(int32_t irq)
+{
+	/** Vector of the interruption*/
+	uint32_t vector = host_vector(irq);
+
+	if(NO_VECTOR != vector)
+	{
+		__atomic_fetch_and(&pending[vector / BITS_PER_WORD], ~(1UL << (vector % BITS_PER_WORD)), __ATOMIC_SEQ_CST);
+	}
+}
+
+/** This function gets the handlers run*/
+uint32_t host_cpu_get_isr_count(int32_t irq)
+{
+	/** Vector of the interruption*/
+	uint32_t vector = host_vector(irq);
+
+	return (NO_VECTOR != vector) ? isr_count[vector] : INIT_VAL;
+}
+
+/** This function waits for an interruption in the running task*/
+void host_cpu_wait_for_interrupt(void)
+{
+	/** Signal mask of the thread*/
+	sigset_t previous;
+	/** Signal of the interruptions*/
+	sigset_t interrupt;
+
+	host_interrupt_set(&interrupt);
+	pthread_sigmask(SIG_BLOCK, &interrupt, &previous);
+
+	/** The interruption that is already pending does not send the signal again*/
+	if(!interrupts_masked && !yield_pending && (NO_VECTOR == host_next_vector()))
+	{
+		sigsuspend(&previous);
+	}
+
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
+	host_service();
+}
+
+/** This function creates the thread of a task, the FreeRTOS stack only keeps the thread*/
+StackType_t* pxPortInitialiseStack(StackType_t* pxTopOfStack, TaskFunction_t pxCode, void* pvParameters)
+{
+	/** Thread of the task, at the top of its stack*/
+	host_thread_t* thread = (host_thread_t*)(((uintptr_t)pxTopOfStack - sizeof(host_thread_t)) & ~(uintptr_t)(THREAD_ALIGNMENT - 1));
+	/** Attributes of the thread*/
+	pthread_attr_t attributes;
+	/** Signal mask of the calling thread*/
+	sigset_t previous;
+	/** Signal of the interruptions*/
+	sigset_t interrupt;
+	/** Result of the creation*/
+	int result;
+
+	thread->code = pxCode;
+	thread->parameters = pvParameters;
+	sem_init(&thread->resume, INIT_VAL, INIT_VAL);
+
+	pthread_attr_init(&attributes);
+	pthread_attr_setstacksize(&attributes, THREAD_STACK_SIZE);
+
+	/** The thread starts with the interruptions blocked, it unblocks them when its task runs*/
+	host_interrupt_set(&interrupt);
+	pthread_sigmask(SIG_BLOCK, &interrupt, &previous);
+	result = pthread_create(&thread->thread, &attributes, host_thread_start, thread);
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+	pthread_attr_destroy(&attributes);
+	configASSERT(INIT_VAL == result);
+
+	return (StackType_t*)thread;
+}
+
+/** This function starts the SysTick with configCPU_CLOCK_HZ, the application can replace it*/
+__attribute__((weak)) void vPortSetupTimerInterrupt(void)
+{
+	SYSTICK_LOAD_REG = (configCPU_CLOCK_HZ / configTICK_RATE_HZ) - 1UL;
+	SYSTICK_CURRENT_VALUE_REG = INIT_VAL;
+	SYSTICK_CTRL_REG = SYSTICK_START;
+}
+
+/** Handler of the SysTick*/
+void xPortSysTickHandler(void)
+{
+	/** Interruption mask when the handler started*/
+	UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+	/** Increments the tick, a context switch is done if a task was unblocked*/
+	if(pdFALSE != xTaskIncrementTick())
+	{
+		yield_pending = FLAG_SET;
+	}
+
+	portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/** This function starts the first task, the calling thread does not run tasks after it*/
+BaseType_t xPortStartScheduler(void)
+{
+	/** Handler of the interruption signal*/
+	struct sigaction action;
+	/** Signal of the interruptions*/
+	sigset_t interrupt;
+	/** Thread of the first task*/
+	host_thread_t* first;
+
+	memset(&action, INIT_VAL, sizeof(action));
+	action.sa_handler = host_interrupt_handler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(INTERRUPT_SIGNAL, &action, NULL);
+
+	host_interrupt_set(&interrupt);
+	pthread_sigmask(SIG_BLOCK, &interrupt, NULL);
+
+	/** The core exceptions are always enabled, the SysTick has the lowest priority*/
+	__atomic_fetch_or(&enabled[INIT_VAL], EXCEPTIONS_ENABLED, __ATOMIC_SEQ_CST);
+	host_cpu_install_handler(HOST_CPU_SYSTICK_IRQ, xPortSysTickHandler);
+	host_cpu_set_priority(HOST_CPU_SYSTICK_IRQ, KERNEL_PRIORITY);
+
+	/** Starts the timer that generates the tick interrupt*/
+	vPortSetupTimerInterrupt();
+
+	/** Starts the first task with the interruptions unmasked*/
+	critical_nesting = INIT_VAL;
+	interrupts_masked = INIT_VAL;
+	first = host_task_thread();
+	__atomic_store_n(&running_thread, first, __ATOMIC_SEQ_CST);
+	scheduler_running = FLAG_SET;
+	sem_post(&first->resume);
+
+	for(;;)
+	{
+		pause();
+	}
+
+	return pdFALSE;
+}
+
+/** The scheduler can not be stopped, there is nothing to return to*/
+void vPortEndScheduler(void)
+{
+	configASSERT(INIT_VAL == scheduler_running);
+}
+
+/** This function requests a context switch from a task, it is done when the interruptions are unmasked*/
+void vPortYield(void)
+{
+	yield_pending = FLAG_SET;
+
+	if(!interrupts_masked && !handler_running)
+	{
+		host_service();
+	}
+}
+
+/** This function requests a context switch from a handler, it is done when the handlers finish*/
+void vPortYieldFromISR(void)
+{
+	yield_pending = FLAG_SET;
+}
+
+/** Critical sections, they mask the interruptions*/
+void vPortEnterCritical(void)
+{
+	interrupts_masked = FLAG_SET;
+	critical_nesting ++;
+}
+
+void vPortExitCritical(void)
+{
+	configASSERT(INIT_VAL != critical_nesting);
+	critical_nesting --;
+
+	if(INIT_VAL == critical_nesting)
+	{
+		interrupts_masked = INIT_VAL;
+
+		if(!handler_running)
+		{
+			host_service();
+		}
+	}
+}
+
+/** Interruption mask of the handlers, it returns the previous mask*/
+UBaseType_t uxPortSetInterruptMask(void)
+{
+	/** Mask before the call*/
+	UBaseType_t previous = (UBaseType_t)interrupts_masked;
+
+	interrupts_masked = FLAG_SET;
+
+	return previous;
+}
+
+void vPortClearInterruptMask(UBaseType_t uxMask)
+{
+	interrupts_masked = (sig_atomic_t)uxMask;
+
+	if(!interrupts_masked && !handler_running)
+	{
+		host_service();
+	}
+}
+
+void vPortDisableInterrupts(void)
+{
+	interrupts_masked = FLAG_SET;
+}
+
+void vPortEnableInterrupts(void)
+{
+	interrupts_masked = INIT_VAL;
+
+	if(!handler_running)
+	{
+		host_service();
+	}
+}
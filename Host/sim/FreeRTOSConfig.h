@@ -0,0 +1,41 @@
+/*!
+ 	 \file FreeRTOSConfig.h
+
+ 	 \brief This is the FreeRTOS configuration of the host simulator. It is the
+ 	 	 	 configuration of the application (Generated_Code/FreeRTOSConfig.h),
+ 	 	 	 with the run-time stats and the kernel trace, and only the values
+ 	 	 	 that can not be used on a PC are changed.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HOST_SIM_FREERTOS_CONFIG_H
+#define HOST_SIM_FREERTOS_CONFIG_H
+
+#include "../../S32K144_FreeRTOS/Generated_Code/FreeRTOSConfig.h"
+
+/* The objects of the kernel are twice as big on a 64 bits host (heap_2 is used in place of the heap pools,
+whose classes have the sizes of the target). */
+#undef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE                    ( ( size_t ) ( 256 * 1024 ) )
+
+/* The idle task does not stop the core (tickless.c sleeps with WFI and the SysTick of the target). */
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE                  0
+
+/* The idle task waits for an interruption instead, so it does not take the core of the host from the tasks
+and the clock of the simulator. */
+#undef configUSE_IDLE_HOOK
+#define configUSE_IDLE_HOOK                      1
+
+/* A failed assertion ends the simulation with the file and the line. */
+#undef configASSERT
+#define configASSERT(x)                          if((x)==0) { vAssertCalled(__FILE__, __LINE__); }
+void vAssertCalled(const char* file, unsigned long line);
+
+#endif /* HOST_SIM_FREERTOS_CONFIG_H */
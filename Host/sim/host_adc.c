@@ -0,0 +1,191 @@
+/*!
+ 	 \file host_adc.c
+
+ 	 \brief This is the source file of the ADC model of the host simulator. A
+ 	 	 	 software triggered conversion (SC1[0] written with a channel) ends
+ 	 	 	 after the sample time of CFG2 and the conversion of the bits, for
+ 	 	 	 each conversion of the hardware average of SC3, with the input of
+ 	 	 	 the scenario at the resolution of CFG1. Reading R[0] clears COCO,
+ 	 	 	 and its interruption, as in the ADC. The calibration sequence
+ 	 	 	 ends at once.
+
+ 	 \note The hardware triggers (PDB) are not simulated. The ADC clock is the
+ 	 	 	 SOSCDIV2 of the application (8 MHz), the PCC is not read.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the channel that disables the conversions*/
+#define ADCH_DISABLED				(0x1FUL)
+/** Defines the resolutions of CFG1 MODE*/
+#define MODE_8_BITS					(0)
+#define MODE_12_BITS				(1)
+#define MODE_10_BITS				(2)
+/** Defines the shifts from a 12 bits input to the resolutions*/
+#define SHIFT_8_BITS				(4)
+#define SHIFT_10_BITS				(2)
+/** Defines the maximum input (12 bits)*/
+#define INPUT_MAX					(0x0FFFU)
+/** Defines the ns of a cycle of the ADC clock (SOSCDIV2 of 8 MHz)*/
+#define ADCK_NS						(125ULL)
+/** Defines the ADC clocks of a conversion after the sample time (Successive approximation of the bits)*/
+#define CONVERT_ADCK				(20U)
+/** Defines the conversions of the hardware average of AVGS (4 << AVGS)*/
+#define AVERAGE_MIN					(4U)
+
+/*!
+ 	 \brief Model of an ADC.
+ */
+typedef struct
+{
+	uint8_t instance;		/*!< Number of the ADC*/
+	IRQn_Type irq;			/*!< Interruption of the ADC*/
+	ADC_Type* regs;			/*!< Registers, as the model changes them*/
+	host_sim_timer_t timer;	/*!< End of the conversion in progress*/
+	uint32_t channel;		/*!< Channel of the conversion in progress*/
+	uint32_t conversions;	/*!< Conversions done*/
+}host_adc_t;
+
+/** Models of the ADCs*/
+static host_adc_t adcs[ADC_INSTANCE_COUNT];
+/** Input of the channels*/
+static host_adc_input_t adc_input = NULL;
+
+/** This function gets the time of a conversion, in ns*/
+static uint64_t host_adc_conversion_time(const host_adc_t* adc)
+{
+	/** ADC clocks of one conversion (SMPLTS + 1 clocks of sample time)*/
+	uint64_t clocks = ((adc->regs->CFG2 & ADC_CFG2_SMPLTS_MASK) >> ADC_CFG2_SMPLTS_SHIFT) + 1U + CONVERT_ADCK;
+
+	if(adc->regs->SC3 & ADC_SC3_AVGE_MASK)
+	{
+		clocks *= (uint64_t)AVERAGE_MIN << ((adc->regs->SC3 & ADC_SC3_AVGS_MASK) >> ADC_SC3_AVGS_SHIFT);
+	}
+
+	return clocks * ADCK_NS;
+}
+
+/** This function ends the conversion of a channel in R[0]*/
+static void host_adc_convert(void* context)
+{
+	/** Model of the ADC*/
+	host_adc_t* adc = (host_adc_t*)context;
+	/** Input of the channel*/
+	uint16_t input = (NULL != adc_input) ? adc_input(adc->instance, (uint8_t)adc->channel) : INIT_VAL;
+	/** Result at the resolution of CFG1*/
+	uint32_t result = (INPUT_MAX < input) ? INPUT_MAX : input;
+
+	switch((adc->regs->CFG1 & ADC_CFG1_MODE_MASK) >> ADC_CFG1_MODE_SHIFT)
+	{
+		case MODE_8_BITS:
+			result >>= SHIFT_8_BITS;
+			break;
+		case MODE_10_BITS:
+			result >>= SHIFT_10_BITS;
+			break;
+		case MODE_12_BITS:
+		default:
+			break;
+	}
+
+	HOST_SIM_SET(adc->regs->R[0], result);
+	adc->regs->SC1[0] |= ADC_SC1_COCO_MASK;
+	adc->conversions ++;
+
+	if(adc->regs->SC1[0] & ADC_SC1_AIEN_MASK)
+	{
+		host_cpu_set_pending(adc->irq);
+	}
+}
+
+/** Reads of the registers of an ADC*/
+static void host_adc_after_read(void* context, uint32_t offset)
+{
+	/** Model of the ADC*/
+	host_adc_t* adc = (host_adc_t*)context;
+
+	/** Reading the result clears the conversion complete flag*/
+	if(offsetof(ADC_Type, R) == offset)
+	{
+		adc->regs->SC1[0] &= ~ADC_SC1_COCO_MASK;
+		host_cpu_clear_pending(adc->irq);
+	}
+}
+
+/** Writes to the registers of an ADC*/
+static void host_adc_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	/** Model of the ADC*/
+	host_adc_t* adc = (host_adc_t*)context;
+
+	(void)old_value;
+
+	if(offsetof(ADC_Type, SC1) == offset)
+	{
+		/** A write to SC1 aborts the conversion, and starts a new one with the software trigger*/
+		adc->regs->SC1[0] = value & ~ADC_SC1_COCO_MASK;
+		host_cpu_clear_pending(adc->irq);
+		host_sim_timer_stop(&adc->timer);
+
+		if((ADCH_DISABLED != (value & ADC_SC1_ADCH_MASK)) && !(adc->regs->SC2 & ADC_SC2_ADTRG_MASK))
+		{
+			adc->channel = (value & ADC_SC1_ADCH_MASK) >> ADC_SC1_ADCH_SHIFT;
+			host_sim_timer_start(&adc->timer, host_sim_now() + host_adc_conversion_time(adc));
+		}
+	}
+	else if((offsetof(ADC_Type, SC3) == offset) && (value & ADC_SC3_CAL_MASK))
+	{
+		/** The calibration sequence ends at once*/
+		adc->regs->SC3 = value & ~ADC_SC3_CAL_MASK;
+		adc->regs->SC1[0] |= ADC_SC1_COCO_MASK;
+	}
+}
+
+/** Hooks of the ADCs*/
+static const host_sim_hooks_t adc_hooks = {NULL, host_adc_after_read, host_adc_after_write};
+
+/** This function initializes the ADC models*/
+void host_adc_init(void)
+{
+	/** Registers of the ADCs*/
+	ADC_Type* const instances[ADC_INSTANCE_COUNT] = ADC_BASE_PTRS;
+	/** Interruptions of the ADCs*/
+	const IRQn_Type irqs[ADC_INSTANCE_COUNT] = {ADC0_IRQn, ADC1_IRQn};
+	/** Counter for the ADCs*/
+	uint8_t instance;
+	/** Model of an ADC*/
+	host_adc_t* adc;
+
+	for(instance = INIT_VAL; ADC_INSTANCE_COUNT > instance; instance ++)
+	{
+		adc = &adcs[instance];
+		adc->instance = instance;
+		adc->irq = irqs[instance];
+		adc->regs = host_sim_alias(instances[instance]);
+		adc->regs->SC1[0] = ADCH_DISABLED;
+		host_sim_timer_init(&adc->timer, host_adc_convert, adc);
+
+		host_sim_map(instances[instance], sizeof(ADC_Type), host_sim_trap_accesses, &adc_hooks, adc);
+	}
+}
+
+/** This function sets the inputs of the ADCs*/
+void host_adc_set_input(host_adc_input_t input)
+{
+	adc_input = input;
+}
+
+/** This function gets the conversions of an ADC*/
+uint32_t host_adc_get_conversions(uint8_t instance)
+{
+	return adcs[instance].conversions;
+}
@@ -0,0 +1,602 @@
+/*!
+ 	 \file host_can.c
+
+ 	 \brief This is the source file of the FlexCAN model of the host simulator.
+ 	 	 	 Each CAN has a bus with one more node, the scenario, whose frames
+ 	 	 	 are injected in a queue. The bus takes the frame with the lowest
+ 	 	 	 ID among the Tx MBs of the application and the head of the queue,
+ 	 	 	 and ends it after its bits at the bit rate of CTRL1. The frames of
+ 	 	 	 the other node are matched against the Rx FIFO filters and the Rx
+ 	 	 	 MBs, as the FlexCAN does, and the MB interruptions follow
+ 	 	 	 IFLAG1 and IMASK1. A frame of the Rx FIFO released before its
+ 	 	 	 ID was read is counted as discarded.
+
+ 	 \note Only standard data frames without errors are simulated, and the
+ 	 	 	 frames of the application are not received by itself (SRXDIS).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include <string.h>
+
+#include "host_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the flag as set*/
+#define FLAG_SET					(1)
+/** Defines the reset value of the MCR (Disabled and frozen)*/
+#define MCR_RESET					(0xD890000FUL)
+/** Defines the clock of the protocol engine with CLKSRC = 0 (SOSCDIV2)*/
+#define OSC_CLOCK_HZ				(8000000UL)
+/** Defines the bits of a standard data frame without data, with the interframe space*/
+#define FRAME_BITS					(47U)
+/** Defines the bits of a data byte*/
+#define BITS_PER_BYTE				(8U)
+/** Defines the words of a MB*/
+#define MB_WORDS					(4U)
+/** Defines the positions of the words of a MB*/
+#define MB_CS						(0U)
+#define MB_ID						(1U)
+#define MB_DATA						(2U)
+/** Defines the code of a MB*/
+#define MB_CODE_SHIFT				(24U)
+#define MB_CODE_MASK				(0x0F000000UL)
+/** Defines the codes of the MBs*/
+#define CODE_RX_EMPTY				(0x4UL)
+#define CODE_RX_FULL				(0x2UL)
+#define CODE_RX_OVERRUN				(0x6UL)
+#define CODE_TX_INACTIVE			(0x8UL)
+#define CODE_TX_DATA				(0xCUL)
+/** Defines the DLC of a MB*/
+#define MB_DLC_SHIFT				(16U)
+#define MB_DLC_MASK					(0x000F0000UL)
+/** Defines the time stamp of a MB*/
+#define MB_TIMESTAMP_MASK			(0x0000FFFFUL)
+/** Defines the standard ID of a MB*/
+#define MB_STD_ID_SHIFT				(18U)
+/** Defines the standard ID of a Rx FIFO filter element (Format A)*/
+#define FIFO_STD_ID_SHIFT			(19U)
+/** Defines the mask of the standard ID*/
+#define STD_ID_MASK					(0x7FFUL)
+/** Defines the first word of the Rx FIFO filter table*/
+#define FIFO_FILTER_POS				(24U)
+/** Defines the filter elements of each RFFN step*/
+#define FIFO_FILTERS_PER_RFFN		(8U)
+/** Defines the MBs taken by the Rx FIFO before the filter table*/
+#define FIFO_MBS					(6U)
+/** Defines the MBs of filter elements of each RFFN step*/
+#define FIFO_MBS_PER_RFFN			(2U)
+/** Defines the frames of the Rx FIFO*/
+#define FIFO_DEPTH					(6U)
+/** Defines the frames of the Rx FIFO that set the warning*/
+#define FIFO_WARNING				(5U)
+/** Defines the frames in the queue of the other node*/
+#define QUEUE_DEPTH					(64U)
+/** Defines the Rx FIFO flags of IFLAG1*/
+#define FIFO_AVAILABLE				(CAN_IFLAG1_BUF5I_MASK)
+#define FIFO_WARNING_FLAG			(CAN_IFLAG1_BUF6I_MASK)
+#define FIFO_OVERFLOW				(CAN_IFLAG1_BUF7I_MASK)
+/** Defines the MB flags of the first interruption (MB0 to MB15)*/
+#define LOW_MB_FLAGS				(0x0000FFFFUL)
+/** Defines that no MB is on the bus*/
+#define NO_MB						(-1)
+/** Defines the MBs of CAN0*/
+#define CAN0_MBS					(32U)
+/** Defines the MBs of CAN1 and CAN2*/
+#define CAN1_2_MBS					(16U)
+/** Defines the MBs that only have the first interruption*/
+#define NO_HIGH_IRQ					((IRQn_Type)INIT_VAL)
+
+/*!
+ 	 \brief Model of a FlexCAN and its bus.
+ */
+typedef struct
+{
+	uint8_t instance;								/*!< Number of the CAN*/
+	uint8_t mbs;									/*!< MBs of the CAN*/
+	IRQn_Type low_irq;								/*!< Interruption of MB0 to MB15*/
+	IRQn_Type high_irq;								/*!< Interruption of MB16 to MB31*/
+	CAN_Type* regs;									/*!< Registers, as the model changes them*/
+	host_sim_timer_t timer;							/*!< End of the frame on the bus*/
+	uint8_t busy;									/*!< Indicates if a frame is on the bus*/
+	int32_t mb;										/*!< MB of the frame on the bus, NO_MB for the other node*/
+	uint64_t frame_start;							/*!< Start of the frame on the bus*/
+	host_can_frame_t frame;							/*!< Frame on the bus*/
+	host_can_frame_t queue[QUEUE_DEPTH];			/*!< Frames of the other node*/
+	uint32_t queue_head;							/*!< First frame of the queue*/
+	uint32_t queue_count;							/*!< Frames in the queue*/
+	host_can_frame_t fifo[FIFO_DEPTH];				/*!< Frames of the Rx FIFO*/
+	uint32_t fifo_head;								/*!< First frame of the Rx FIFO (In MB0)*/
+	uint32_t fifo_count;							/*!< Frames in the Rx FIFO*/
+	uint8_t fifo_output_read;						/*!< Indicates if the ID of the Rx FIFO output was read*/
+	host_can_stats_t stats;							/*!< Statistics of the bus*/
+}host_can_t;
+
+/** Models of the FlexCANs*/
+static host_can_t cans[CAN_INSTANCE_COUNT];
+/** Observer of the buses*/
+static host_can_observer_t can_observer = NULL;
+
+/** This function gets the bit rate of the CTRL1 configuration*/
+static uint32_t host_can_bit_rate(const host_can_t* can)
+{
+	/** Control 1 register*/
+	uint32_t control = can->regs->CTRL1;
+	/** Clock of the protocol engine*/
+	uint32_t clock = (control & CAN_CTRL1_CLKSRC_MASK) ? host_system_core_clock() / 2UL : OSC_CLOCK_HZ;
+	/** Time quanta of a bit*/
+	uint32_t quanta = 1UL + (((control & CAN_CTRL1_PROPSEG_MASK) >> CAN_CTRL1_PROPSEG_SHIFT) + 1UL) +
+			(((control & CAN_CTRL1_PSEG1_MASK) >> CAN_CTRL1_PSEG1_SHIFT) + 1UL) + (((control & CAN_CTRL1_PSEG2_MASK) >> CAN_CTRL1_PSEG2_SHIFT) + 1UL);
+
+	return clock / ((((control & CAN_CTRL1_PRESDIV_MASK) >> CAN_CTRL1_PRESDIV_SHIFT) + 1UL) * quanta);
+}
+
+/** This function gets the time stamp of the free running timer (It counts bits)*/
+static uint32_t host_can_timestamp(const host_can_t* can)
+{
+	return (uint32_t)(((host_sim_now() / HOST_SIM_NS_PER_US) * host_can_bit_rate(can)) / (HOST_SIM_NS_PER_S / HOST_SIM_NS_PER_US)) & MB_TIMESTAMP_MASK;
+}
+
+/** This function indicates if the module takes part on the bus (Enabled and not frozen)*/
+static uint8_t host_can_ready(const host_can_t* can)
+{
+	return (can->regs->MCR & (CAN_MCR_MDIS_MASK | CAN_MCR_FRZACK_MASK | CAN_MCR_NOTRDY_MASK)) ? INIT_VAL : FLAG_SET;
+}
+
+/** This function gets the first MB that is not taken by the Rx FIFO*/
+static uint32_t host_can_first_mb(const host_can_t* can)
+{
+	/** First MB*/
+	uint32_t first = INIT_VAL;
+
+	if(can->regs->MCR & CAN_MCR_RFEN_MASK)
+	{
+		first = FIFO_MBS + (FIFO_MBS_PER_RFFN * (((can->regs->CTRL2 & CAN_CTRL2_RFFN_MASK) >> CAN_CTRL2_RFFN_SHIFT) + 1UL));
+	}
+
+	return first;
+}
+
+/** This function gets the last MB in use (MAXMB)*/
+static uint32_t host_can_last_mb(const host_can_t* can)
+{
+	/** Last MB*/
+	uint32_t last = can->regs->MCR & CAN_MCR_MAXMB_MASK;
+
+	return (last < can->mbs) ? last : (uint32_t)(can->mbs - 1U);
+}
+
+/** This function sets the interruptions of the flags that are set and enabled*/
+static void host_can_update_irq(host_can_t* can)
+{
+	/** Flags set and enabled*/
+	uint32_t flags = can->regs->IFLAG1 & can->regs->IMASK1;
+
+	if(flags & LOW_MB_FLAGS)
+	{
+		host_cpu_set_pending(can->low_irq);
+	}
+	else
+	{
+		host_cpu_clear_pending(can->low_irq);
+	}
+
+	if(NO_HIGH_IRQ != can->high_irq)
+	{
+		if(flags & ~LOW_MB_FLAGS)
+		{
+			host_cpu_set_pending(can->high_irq);
+		}
+		else
+		{
+			host_cpu_clear_pending(can->high_irq);
+		}
+	}
+}
+
+/** This function writes a frame in a MB*/
+static void host_can_write_mb(host_can_t* can, uint32_t mb, const host_can_frame_t* frame, uint32_t code)
+{
+	/** Words of the MB*/
+	volatile uint32_t* words = &can->regs->RAMn[mb * MB_WORDS];
+
+	words[MB_ID] = (uint32_t)frame->ID << MB_STD_ID_SHIFT;
+	/** The MB keeps the first byte in the MSB*/
+	words[MB_DATA] = ((uint32_t)frame->data[0] << 24) | ((uint32_t)frame->data[1] << 16) | ((uint32_t)frame->data[2] << 8) | frame->data[3];
+	words[MB_DATA + 1U] = ((uint32_t)frame->data[4] << 24) | ((uint32_t)frame->data[5] << 16) | ((uint32_t)frame->data[6] << 8) | frame->data[7];
+	words[MB_CS] = (code << MB_CODE_SHIFT) | ((uint32_t)frame->DLC << MB_DLC_SHIFT) | host_can_timestamp(can);
+}
+
+/** This function reads the frame of a MB*/
+static void host_can_read_mb(const host_can_t* can, uint32_t mb, host_can_frame_t* frame)
+{
+	/** Words of the MB*/
+	const volatile uint32_t* words = &can->regs->RAMn[mb * MB_WORDS];
+	/** Counter for the bytes*/
+	uint32_t byte;
+
+	frame->ID = (uint16_t)((words[MB_ID] >> MB_STD_ID_SHIFT) & STD_ID_MASK);
+	frame->DLC = (uint8_t)((words[MB_CS] & MB_DLC_MASK) >> MB_DLC_SHIFT);
+	if(HOST_CAN_DATA_BYTES < frame->DLC)
+	{
+		frame->DLC = HOST_CAN_DATA_BYTES;
+	}
+	for(byte = INIT_VAL; HOST_CAN_DATA_BYTES > byte; byte ++)
+	{
+		frame->data[byte] = (uint8_t)(words[MB_DATA + (byte / 4U)] >> (24U - ((byte % 4U) * 8U)));
+	}
+}
+
+/** This function moves the first frame of the Rx FIFO to its output (MB0)*/
+static void host_can_fifo_output(host_can_t* can)
+{
+	if(INIT_VAL != can->fifo_count)
+	{
+		host_can_write_mb(can, INIT_VAL, &can->fifo[can->fifo_head], INIT_VAL);
+		can->fifo_output_read = INIT_VAL;
+		can->regs->IFLAG1 |= FIFO_AVAILABLE;
+	}
+}
+
+/** This function stores a frame of the other node in the Rx FIFO, it returns the event of the frame*/
+static host_can_event_t host_can_receive_fifo(host_can_t* can, const host_can_frame_t* frame)
+{
+	/** Event of the frame*/
+	host_can_event_t event = host_can_filtered;
+	/** Filter elements*/
+	uint32_t filters = FIFO_FILTERS_PER_RFFN * (((can->regs->CTRL2 & CAN_CTRL2_RFFN_MASK) >> CAN_CTRL2_RFFN_SHIFT) + 1UL);
+	/** Counter for the filter elements*/
+	uint32_t element;
+	/** Mask of an element*/
+	uint32_t mask;
+	/** ID of the frame as a filter element*/
+	uint32_t id = (uint32_t)frame->ID << FIFO_STD_ID_SHIFT;
+
+	for(element = INIT_VAL; (filters > element) && (host_can_filtered == event); element ++)
+	{
+		mask = ((can->regs->MCR & CAN_MCR_IRMQ_MASK) && (CAN_RXIMR_COUNT > element)) ? can->regs->RXIMR[element] : can->regs->RXFGMASK;
+
+		if(INIT_VAL == ((id ^ can->regs->RAMn[FIFO_FILTER_POS + element]) & mask & (STD_ID_MASK << FIFO_STD_ID_SHIFT)))
+		{
+			event = host_can_received;
+		}
+	}
+
+	if(host_can_received == event)
+	{
+		if(FIFO_DEPTH <= can->fifo_count)
+		{
+			can->regs->IFLAG1 |= FIFO_OVERFLOW;
+			event = host_can_lost;
+		}
+		else
+		{
+			can->fifo[(can->fifo_head + can->fifo_count) % FIFO_DEPTH] = *frame;
+			can->fifo_count ++;
+
+			if(FIFO_WARNING <= can->fifo_count)
+			{
+				can->regs->IFLAG1 |= FIFO_WARNING_FLAG;
+			}
+			if(!(can->regs->IFLAG1 & FIFO_AVAILABLE))
+			{
+				host_can_fifo_output(can);
+			}
+		}
+	}
+
+	return event;
+}
+
+/** This function stores a frame of the other node in a Rx MB, it returns the event of the frame*/
+static host_can_event_t host_can_receive_mb(host_can_t* can, const host_can_frame_t* frame)
+{
+	/** MB that takes the frame*/
+	int32_t target = NO_MB;
+	/** Indicates if the MB that takes the frame has an unread one*/
+	uint8_t overrun = INIT_VAL;
+	/** Counter for the MBs*/
+	uint32_t mb;
+	/** Code of a MB*/
+	uint32_t code;
+	/** Mask of a MB*/
+	uint32_t mask;
+	/** ID of the frame as a MB ID*/
+	uint32_t id = (uint32_t)frame->ID << MB_STD_ID_SHIFT;
+
+	for(mb = host_can_first_mb(can); (host_can_last_mb(can) >= mb) && !((NO_MB != target) && !overrun); mb ++)
+	{
+		code = (can->regs->RAMn[(mb * MB_WORDS) + MB_CS] & MB_CODE_MASK) >> MB_CODE_SHIFT;
+		mask = ((can->regs->MCR & CAN_MCR_IRMQ_MASK) && (CAN_RXIMR_COUNT > mb)) ? can->regs->RXIMR[mb] : can->regs->RXMGMASK;
+
+		if(((CODE_RX_EMPTY == code) || (CODE_RX_FULL == code) || (CODE_RX_OVERRUN == code)) &&
+		   (INIT_VAL == ((id ^ can->regs->RAMn[(mb * MB_WORDS) + MB_ID]) & mask & (STD_ID_MASK << MB_STD_ID_SHIFT))))
+		{
+			/** The first empty MB takes the frame, else the last matching one is overwritten*/
+			target = (int32_t)mb;
+			overrun = (CODE_RX_EMPTY == code) ? INIT_VAL : FLAG_SET;
+		}
+	}
+
+	if(NO_MB != target)
+	{
+		host_can_write_mb(can, (uint32_t)target, frame, overrun ? CODE_RX_OVERRUN : CODE_RX_FULL);
+		can->regs->IFLAG1 |= 1UL << target;
+	}
+
+	return (NO_MB == target) ? host_can_filtered : (overrun ? host_can_overrun : host_can_received);
+}
+
+/** This function gives an event to the observer*/
+static void host_can_notify(const host_can_t* can, host_can_event_t event, const host_can_frame_t* frame)
+{
+	if(NULL != can_observer)
+	{
+		can_observer(can->instance, event, frame);
+	}
+}
+
+/** This function starts the next frame, if the bus is free and there is one*/
+static void host_can_arbitrate(host_can_t* can)
+{
+	/** MB of the frame that wins*/
+	int32_t winner = NO_MB;
+	/** ID of the frame that wins*/
+	uint32_t winner_id = STD_ID_MASK + 1UL;
+	/** Counter for the MBs*/
+	uint32_t mb;
+	/** Code and DLC of a MB*/
+	uint32_t cs;
+	/** ID of a MB*/
+	uint32_t id;
+
+	if(!can->busy && host_can_ready(can))
+	{
+		for(mb = host_can_first_mb(can); host_can_last_mb(can) >= mb; mb ++)
+		{
+			cs = can->regs->RAMn[(mb * MB_WORDS) + MB_CS];
+			id = (can->regs->RAMn[(mb * MB_WORDS) + MB_ID] >> MB_STD_ID_SHIFT) & STD_ID_MASK;
+
+			/** The lowest ID wins, the lowest MB between equal IDs*/
+			if((CODE_TX_DATA == ((cs & MB_CODE_MASK) >> MB_CODE_SHIFT)) && (id < winner_id))
+			{
+				winner = (int32_t)mb;
+				winner_id = id;
+			}
+		}
+
+		if((INIT_VAL != can->queue_count) && (can->queue[can->queue_head].ID < winner_id))
+		{
+			winner = NO_MB;
+			can->frame = can->queue[can->queue_head];
+			can->queue_head = (can->queue_head + 1U) % QUEUE_DEPTH;
+			can->queue_count --;
+			can->busy = FLAG_SET;
+		}
+		else if(NO_MB != winner)
+		{
+			host_can_read_mb(can, (uint32_t)winner, &can->frame);
+			can->busy = FLAG_SET;
+		}
+
+		if(can->busy)
+		{
+			can->mb = winner;
+			can->frame_start = host_sim_now();
+			host_sim_timer_start(&can->timer, can->frame_start + (((uint64_t)(FRAME_BITS + (BITS_PER_BYTE * can->frame.DLC)) * HOST_SIM_NS_PER_S) / host_can_bit_rate(can)));
+		}
+	}
+}
+
+/** Timer of the bus, the frame on the bus ends*/
+static void host_can_frame_end(void* context)
+{
+	/** Model of the CAN*/
+	host_can_t* can = (host_can_t*)context;
+	/** Event of the frame*/
+	host_can_event_t event = host_can_sent;
+	/** Code and DLC of the MB*/
+	uint32_t cs;
+
+	can->busy = INIT_VAL;
+	can->frame.time = host_sim_now();
+	can->stats.busy_time += can->frame.time - can->frame_start;
+
+	if(NO_MB != can->mb)
+	{
+		/** The MB is sent only if the application did not abort it meanwhile*/
+		cs = can->regs->RAMn[(can->mb * MB_WORDS) + MB_CS];
+		if(CODE_TX_DATA == ((cs & MB_CODE_MASK) >> MB_CODE_SHIFT))
+		{
+			can->regs->RAMn[(can->mb * MB_WORDS) + MB_CS] = (cs & MB_DLC_MASK) | (CODE_TX_INACTIVE << MB_CODE_SHIFT) | host_can_timestamp(can);
+			can->regs->IFLAG1 |= 1UL << can->mb;
+			can->stats.sent ++;
+			host_can_notify(can, event, &can->frame);
+		}
+	}
+	else
+	{
+		if(!host_can_ready(can))
+		{
+			event = host_can_lost;
+		}
+		else
+		{
+			event = (can->regs->MCR & CAN_MCR_RFEN_MASK) ? host_can_receive_fifo(can, &can->frame) : host_can_filtered;
+
+			/** The MBs after the Rx FIFO receive the frames that the FIFO did not accept*/
+			if(host_can_filtered == event)
+			{
+				event = host_can_receive_mb(can, &can->frame);
+			}
+		}
+
+		switch(event)
+		{
+			case host_can_received:
+				can->stats.received ++;
+				break;
+			case host_can_overrun:
+				can->stats.overruns ++;
+				break;
+			case host_can_lost:
+				can->stats.lost ++;
+				break;
+			default:
+				can->stats.filtered ++;
+				break;
+		}
+		host_can_notify(can, event, &can->frame);
+	}
+
+	host_can_update_irq(can);
+	host_can_arbitrate(can);
+}
+
+/** Writes to the registers of a FlexCAN*/
+static void host_can_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	/** Model of the CAN*/
+	host_can_t* can = (host_can_t*)context;
+	/** Module configuration*/
+	uint32_t mcr;
+
+	if(offsetof(CAN_Type, MCR) == offset)
+	{
+		/** The acknowledges follow the requests at once*/
+		mcr = value & ~(CAN_MCR_SOFTRST_MASK | CAN_MCR_LPMACK_MASK | CAN_MCR_FRZACK_MASK | CAN_MCR_NOTRDY_MASK);
+
+		if(value & CAN_MCR_SOFTRST_MASK)
+		{
+			mcr = MCR_RESET & ~(CAN_MCR_MDIS_MASK | CAN_MCR_LPMACK_MASK);
+			mcr |= CAN_MCR_FRZACK_MASK;
+		}
+		else if(mcr & CAN_MCR_MDIS_MASK)
+		{
+			mcr |= CAN_MCR_LPMACK_MASK | CAN_MCR_NOTRDY_MASK;
+		}
+		else if((mcr & CAN_MCR_FRZ_MASK) && (mcr & CAN_MCR_HALT_MASK))
+		{
+			mcr |= CAN_MCR_FRZACK_MASK | CAN_MCR_NOTRDY_MASK;
+		}
+		can->regs->MCR = mcr;
+
+		host_can_arbitrate(can);
+	}
+	else if(offsetof(CAN_Type, IFLAG1) == offset)
+	{
+		/** The flags are cleared by writing 1*/
+		can->regs->IFLAG1 = old_value & ~value;
+
+		/** Releasing the Rx FIFO output moves the next frame to it*/
+		if((value & FIFO_AVAILABLE) && (old_value & FIFO_AVAILABLE) && (can->regs->MCR & CAN_MCR_RFEN_MASK) && (INIT_VAL != can->fifo_count))
+		{
+			/** A frame released before its ID was read is lost for the application*/
+			if(!can->fifo_output_read)
+			{
+				can->stats.discarded ++;
+			}
+			can->fifo_head = (can->fifo_head + 1U) % FIFO_DEPTH;
+			can->fifo_count --;
+			host_can_fifo_output(can);
+		}
+		host_can_update_irq(can);
+	}
+	else if(offsetof(CAN_Type, IMASK1) == offset)
+	{
+		host_can_update_irq(can);
+	}
+	else if((offsetof(CAN_Type, RAMn) <= offset) && (offsetof(CAN_Type, RXIMR) > offset) &&
+			(MB_CS == (((offset - offsetof(CAN_Type, RAMn)) / sizeof(uint32_t)) % MB_WORDS)))
+	{
+		/** A MB that is set to transmit takes part in the next arbitration*/
+		if(CODE_TX_DATA == ((value & MB_CODE_MASK) >> MB_CODE_SHIFT))
+		{
+			host_can_arbitrate(can);
+		}
+	}
+}
+
+/** Reads of the registers of a FlexCAN*/
+static void host_can_after_read(void* context, uint32_t offset)
+{
+	/** Model of the CAN*/
+	host_can_t* can = (host_can_t*)context;
+
+	/** The Rx FIFO output is in MB0*/
+	if((offsetof(CAN_Type, RAMn) + (MB_ID * sizeof(uint32_t))) == offset)
+	{
+		can->fifo_output_read = FLAG_SET;
+	}
+}
+
+/** Hooks of the FlexCANs*/
+static const host_sim_hooks_t can_hooks = {NULL, host_can_after_read, host_can_after_write};
+
+/** This function initializes the FlexCAN models*/
+void host_can_init(void)
+{
+	/** Registers of the FlexCANs*/
+	CAN_Type* const instances[CAN_INSTANCE_COUNT] = CAN_BASE_PTRS;
+	/** Interruptions of MB0 to MB15*/
+	const IRQn_Type low_irqs[CAN_INSTANCE_COUNT] = {CAN0_ORed_0_15_MB_IRQn, CAN1_ORed_0_15_MB_IRQn, CAN2_ORed_0_15_MB_IRQn};
+	/** Counter for the FlexCANs*/
+	uint8_t instance;
+	/** Model of a CAN*/
+	host_can_t* can;
+
+	for(instance = INIT_VAL; CAN_INSTANCE_COUNT > instance; instance ++)
+	{
+		can = &cans[instance];
+		memset(can, INIT_VAL, sizeof(host_can_t));
+		can->instance = instance;
+		can->mbs = (INIT_VAL == instance) ? CAN0_MBS : CAN1_2_MBS;
+		can->low_irq = low_irqs[instance];
+		can->high_irq = (INIT_VAL == instance) ? CAN0_ORed_16_31_MB_IRQn : NO_HIGH_IRQ;
+		can->regs = host_sim_alias(instances[instance]);
+		can->regs->MCR = MCR_RESET;
+		can->mb = NO_MB;
+		host_sim_timer_init(&can->timer, host_can_frame_end, can);
+
+		host_sim_map(instances[instance], sizeof(CAN_Type), host_sim_trap_accesses, &can_hooks, can);
+	}
+}
+
+/** This function sets the observer of the buses*/
+void host_can_set_observer(host_can_observer_t observer)
+{
+	can_observer = observer;
+}
+
+/** This function sends a frame of the other node*/
+uint8_t host_can_inject(uint8_t instance, const host_can_frame_t* frame)
+{
+	/** Model of the CAN*/
+	host_can_t* can = &cans[instance];
+	/** Indicates if the frame was queued*/
+	uint8_t queued = INIT_VAL;
+
+	if(QUEUE_DEPTH > can->queue_count)
+	{
+		can->queue[(can->queue_head + can->queue_count) % QUEUE_DEPTH] = *frame;
+		can->queue_count ++;
+		queued = FLAG_SET;
+
+		/** Without the application on the bus the frame is not acknowledged, it waits in the queue*/
+		host_can_arbitrate(can);
+	}
+
+	return queued;
+}
+
+/** This function gets the statistics of a bus*/
+void host_can_get_stats(uint8_t instance, host_can_stats_t* stats)
+{
+	*stats = cans[instance].stats;
+}
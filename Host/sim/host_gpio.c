@@ -0,0 +1,296 @@
+/*!
+ 	 \file host_gpio.c
+
+ 	 \brief This is the source file of the GPIO and PORT model of the host
+ 	 	 	 simulator. The set, clear and toggle registers change the outputs
+ 	 	 	 of PDOR, PDIR follows the outputs and the inputs driven by the
+ 	 	 	 scenario, and the edges of the inputs set the interrupt flags of
+ 	 	 	 the PCR as their IRQC selects. The interruption of a port is
+ 	 	 	 pending while its ISFR has a flag.
+
+ 	 \note The DMA requests, the digital filters and the pull resistors are not
+ 	 	 	 simulated.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the bit of a pin*/
+#define PIN_BIT(pin)				(1UL << (pin))
+/** Defines the pins of the GPCLR register*/
+#define GPCLR_FIRST_PIN				(0U)
+/** Defines the pins of the GPCHR register*/
+#define GPCHR_FIRST_PIN				(16U)
+/** Defines the pins of a global pin control register*/
+#define GLOBAL_PINS					(16U)
+/** Defines the interrupt configurations of the IRQC field*/
+#define IRQC_LOGIC_ZERO				(0x8UL)
+#define IRQC_RISING_EDGE			(0x9UL)
+#define IRQC_FALLING_EDGE			(0xAUL)
+#define IRQC_EITHER_EDGE			(0xBUL)
+#define IRQC_LOGIC_ONE				(0xCUL)
+
+/*!
+ 	 \brief Model of a port (Its GPIO and its pin control).
+ */
+typedef struct
+{
+	uint8_t instance;	/*!< Number of the port*/
+	IRQn_Type irq;		/*!< Interruption of the port*/
+	GPIO_Type* gpio;	/*!< GPIO registers, as the model changes them*/
+	PORT_Type* port;	/*!< PORT registers, as the model changes them*/
+	uint32_t inputs;	/*!< Levels driven on the pins*/
+}host_gpio_t;
+
+/** Models of the ports*/
+static host_gpio_t gpios[PORT_INSTANCE_COUNT];
+/** Observer of the outputs*/
+static host_gpio_observer_t gpio_observer = NULL;
+
+/** This function updates the interruption of a port*/
+static void host_gpio_update_irq(host_gpio_t* gpio)
+{
+	/** Counter for the pins*/
+	uint32_t pin;
+	/** Interrupt flags of the pins*/
+	uint32_t flags = INIT_VAL;
+
+	for(pin = INIT_VAL; PORT_PCR_COUNT > pin; pin ++)
+	{
+		if(gpio->port->PCR[pin] & PORT_PCR_ISF_MASK)
+		{
+			flags |= PIN_BIT(pin);
+		}
+	}
+	gpio->port->ISFR = flags;
+
+	if(INIT_VAL != flags)
+	{
+		host_cpu_set_pending(gpio->irq);
+	}
+	else
+	{
+		host_cpu_clear_pending(gpio->irq);
+	}
+}
+
+/** This function sets the interrupt flags of the pins whose levels match their IRQC*/
+static void host_gpio_detect(host_gpio_t* gpio, uint32_t old_levels, uint32_t levels)
+{
+	/** Counter for the pins*/
+	uint32_t pin;
+	/** Indicates if the pin matched its configuration*/
+	uint8_t matched;
+	/** Levels of the pin*/
+	uint32_t old_level;
+	uint32_t level;
+
+	for(pin = INIT_VAL; PORT_PCR_COUNT > pin; pin ++)
+	{
+		old_level = old_levels & PIN_BIT(pin);
+		level = levels & PIN_BIT(pin);
+
+		switch((gpio->port->PCR[pin] & PORT_PCR_IRQC_MASK) >> PORT_PCR_IRQC_SHIFT)
+		{
+			case IRQC_LOGIC_ZERO:
+				matched = !level;
+				break;
+			case IRQC_RISING_EDGE:
+				matched = !old_level && level;
+				break;
+			case IRQC_FALLING_EDGE:
+				matched = old_level && !level;
+				break;
+			case IRQC_EITHER_EDGE:
+				matched = old_level != level;
+				break;
+			case IRQC_LOGIC_ONE:
+				matched = INIT_VAL != level;
+				break;
+			default:
+				matched = INIT_VAL;
+				break;
+		}
+
+		if(matched)
+		{
+			gpio->port->PCR[pin] |= PORT_PCR_ISF_MASK;
+		}
+	}
+
+	host_gpio_update_irq(gpio);
+}
+
+/** This function updates the levels of the pins after a change of the outputs or the inputs*/
+static void host_gpio_update_levels(host_gpio_t* gpio)
+{
+	/** Levels before the change*/
+	uint32_t old_levels = gpio->gpio->PDIR;
+
+	HOST_SIM_SET(gpio->gpio->PDIR, (gpio->gpio->PDOR & gpio->gpio->PDDR) | (gpio->inputs & ~gpio->gpio->PDDR));
+
+	host_gpio_detect(gpio, old_levels, gpio->gpio->PDIR);
+}
+
+/** Writes to the GPIO registers of a port*/
+static void host_gpio_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	/** Model of the port*/
+	host_gpio_t* gpio = (host_gpio_t*)context;
+	/** Outputs before the write*/
+	uint32_t old_output = gpio->gpio->PDOR;
+
+	switch(offset)
+	{
+		case offsetof(GPIO_Type, PDOR):
+			old_output = old_value;
+			break;
+		case offsetof(GPIO_Type, PSOR):
+			gpio->gpio->PDOR |= value;
+			break;
+		case offsetof(GPIO_Type, PCOR):
+			gpio->gpio->PDOR &= ~value;
+			break;
+		case offsetof(GPIO_Type, PTOR):
+			gpio->gpio->PDOR ^= value;
+			break;
+		case offsetof(GPIO_Type, PDIR):
+			/** The inputs are read only*/
+			HOST_SIM_SET(gpio->gpio->PDIR, old_value);
+			break;
+		default:
+			break;
+	}
+
+	/** The set, clear and toggle registers read as zero*/
+	HOST_SIM_SET(gpio->gpio->PSOR, INIT_VAL);
+	HOST_SIM_SET(gpio->gpio->PCOR, INIT_VAL);
+	HOST_SIM_SET(gpio->gpio->PTOR, INIT_VAL);
+
+	if((old_output != gpio->gpio->PDOR) && (NULL != gpio_observer))
+	{
+		gpio_observer(gpio->instance, old_output, gpio->gpio->PDOR);
+	}
+
+	host_gpio_update_levels(gpio);
+}
+
+/** This function writes the global pin control of 16 pins*/
+static void host_gpio_global_write(host_gpio_t* gpio, uint32_t first_pin, uint32_t value)
+{
+	/** Counter for the pins*/
+	uint32_t pin;
+	/** Pins that are written*/
+	uint32_t pins = (value & PORT_GPCLR_GPWE_MASK) >> PORT_GPCLR_GPWE_SHIFT;
+
+	for(pin = INIT_VAL; GLOBAL_PINS > pin; pin ++)
+	{
+		if(pins & PIN_BIT(pin))
+		{
+			gpio->port->PCR[first_pin + pin] = (gpio->port->PCR[first_pin + pin] & ~PORT_GPCLR_GPWD_MASK) | (value & PORT_GPCLR_GPWD_MASK);
+		}
+	}
+}
+
+/** Writes to the PORT registers of a port*/
+static void host_port_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	/** Model of the port*/
+	host_gpio_t* gpio = (host_gpio_t*)context;
+	/** Counter for the pins*/
+	uint32_t pin;
+
+	if(offsetof(PORT_Type, GPCLR) > offset)
+	{
+		/** The interrupt flag of a pin is cleared by writing 1*/
+		gpio->port->PCR[offset / sizeof(uint32_t)] = (value & ~PORT_PCR_ISF_MASK) | (old_value & ~value & PORT_PCR_ISF_MASK);
+	}
+	else if(offsetof(PORT_Type, GPCLR) == offset)
+	{
+		host_gpio_global_write(gpio, GPCLR_FIRST_PIN, value);
+		HOST_SIM_SET(gpio->port->GPCLR, INIT_VAL);
+	}
+	else if(offsetof(PORT_Type, GPCHR) == offset)
+	{
+		host_gpio_global_write(gpio, GPCHR_FIRST_PIN, value);
+		HOST_SIM_SET(gpio->port->GPCHR, INIT_VAL);
+	}
+	else if(offsetof(PORT_Type, ISFR) == offset)
+	{
+		/** The interrupt flags of the port are cleared by writing 1*/
+		for(pin = INIT_VAL; PORT_PCR_COUNT > pin; pin ++)
+		{
+			if(old_value & value & PIN_BIT(pin))
+			{
+				gpio->port->PCR[pin] &= ~PORT_PCR_ISF_MASK;
+			}
+		}
+	}
+
+	/** The level configurations match as soon as they are selected*/
+	host_gpio_detect(gpio, gpio->gpio->PDIR, gpio->gpio->PDIR);
+}
+
+/** Hooks of the GPIO registers*/
+static const host_sim_hooks_t gpio_hooks = {NULL, NULL, host_gpio_after_write};
+/** Hooks of the PORT registers*/
+static const host_sim_hooks_t port_hooks = {NULL, NULL, host_port_after_write};
+
+/** This function initializes the port models*/
+void host_gpio_init(void)
+{
+	/** GPIO registers of the ports*/
+	GPIO_Type* const gpio_instances[GPIO_INSTANCE_COUNT] = GPIO_BASE_PTRS;
+	/** PORT registers of the ports*/
+	PORT_Type* const port_instances[PORT_INSTANCE_COUNT] = PORT_BASE_PTRS;
+	/** Interruptions of the ports*/
+	const IRQn_Type irqs[PORT_INSTANCE_COUNT] = PORT_IRQS;
+	/** Counter for the ports*/
+	uint8_t instance;
+	/** Model of a port*/
+	host_gpio_t* gpio;
+
+	for(instance = INIT_VAL; PORT_INSTANCE_COUNT > instance; instance ++)
+	{
+		gpio = &gpios[instance];
+		gpio->instance = instance;
+		gpio->irq = irqs[instance];
+		gpio->gpio = host_sim_alias(gpio_instances[instance]);
+		gpio->port = host_sim_alias(port_instances[instance]);
+
+		host_sim_map(gpio_instances[instance], sizeof(GPIO_Type), host_sim_trap_writes, &gpio_hooks, gpio);
+		host_sim_map(port_instances[instance], sizeof(PORT_Type), host_sim_trap_writes, &port_hooks, gpio);
+	}
+}
+
+/** This function drives an input pin*/
+void host_gpio_set_input(uint8_t port, uint8_t pin, uint8_t level)
+{
+	/** Model of the port*/
+	host_gpio_t* gpio = &gpios[port];
+
+	if(level)
+	{
+		gpio->inputs |= PIN_BIT(pin);
+	}
+	else
+	{
+		gpio->inputs &= ~PIN_BIT(pin);
+	}
+
+	host_gpio_update_levels(gpio);
+}
+
+/** This function sets the observer of the outputs*/
+void host_gpio_set_observer(host_gpio_observer_t observer)
+{
+	gpio_observer = observer;
+}
@@ -0,0 +1,74 @@
+/*!
+ 	 \file host_interrupt.c
+
+ 	 \brief This is the source file of the interrupt manager of the host
+ 	 	 	 simulator. It takes the place of interrupt_manager.c of the SDK,
+ 	 	 	 which writes the handlers in the vector table of the RAM: here
+ 	 	 	 they are installed in the table of the host port, and the IRQs
+ 	 	 	 are enabled through the NVIC registers, as in the SDK.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "interrupt_manager.h"
+#include "FreeRTOS.h"
+#include "host_cpu.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the IRQs of a NVIC register*/
+#define IRQS_PER_REGISTER			(32U)
+
+/** Nested disables of the global interruption*/
+static int32_t interrupt_disable_count = INIT_VAL;
+
+/** This function installs the handler of an interruption*/
+void INT_SYS_InstallHandler(IRQn_Type irqNumber, const isr_t newHandler, isr_t* const oldHandler)
+{
+	/** Handler that was installed*/
+	host_cpu_isr_t old = host_cpu_install_handler(irqNumber, newHandler);
+
+	if(NULL != oldHandler)
+	{
+		*oldHandler = old;
+	}
+}
+
+/** This function enables an interruption*/
+void INT_SYS_EnableIRQ(IRQn_Type irqNumber)
+{
+	S32_NVIC->ISER[(uint32_t)irqNumber / IRQS_PER_REGISTER] = 1UL << ((uint32_t)irqNumber % IRQS_PER_REGISTER);
+}
+
+/** This function disables an interruption*/
+void INT_SYS_DisableIRQ(IRQn_Type irqNumber)
+{
+	S32_NVIC->ICER[(uint32_t)irqNumber / IRQS_PER_REGISTER] = 1UL << ((uint32_t)irqNumber % IRQS_PER_REGISTER);
+}
+
+/** This function enables the global interruption, once every disable is undone*/
+void INT_SYS_EnableIRQGlobal(void)
+{
+	if(INIT_VAL < interrupt_disable_count)
+	{
+		interrupt_disable_count --;
+
+		if(INIT_VAL == interrupt_disable_count)
+		{
+			portENABLE_INTERRUPTS();
+		}
+	}
+}
+
+/** This function disables the global interruption*/
+void INT_SYS_DisableIRQGlobal(void)
+{
+	portDISABLE_INTERRUPTS();
+
+	interrupt_disable_count ++;
+}
@@ -0,0 +1,313 @@
+/*!
+ 	 \file host_lpspi.c
+
+ 	 \brief This is the source file of the LPSPI model of the host simulator.
+ 	 	 	 The words written to TDR wait in the Tx FIFO and are shifted one
+ 	 	 	 by one, each in the time of a word of the SBC configuration, to
+ 	 	 	 the Rx FIFO with the answer of the device. The flags of SR follow
+ 	 	 	 the FIFOs and the watermarks of FCR, and the interruption follows
+ 	 	 	 SR and IER. The device of LPSPI1 is the MC33903 SBC of the board:
+ 	 	 	 it answers the reads of its status registers with the flags set
+ 	 	 	 by the scenario, and counts the watchdog refreshes.
+
+ 	 \note The transmit commands of TCR, the delays of CCR and the DMA requests
+ 	 	 	 are not simulated, every word has 16 bits.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the flag as set*/
+#define FLAG_SET					(1)
+/** Defines the words of the FIFOs*/
+#define FIFO_WORDS					(4U)
+/** Defines the time of one word, in ns (16 SCK of 1 us and the delays of the CCR of the SBC)*/
+#define WORD_NS						(18500ULL)
+/** Defines the flags of SR that are cleared by writing 1*/
+#define SR_W1C_FLAGS				(LPSPI_SR_WCF_MASK | LPSPI_SR_FCF_MASK | LPSPI_SR_TCF_MASK | \
+									 LPSPI_SR_TEF_MASK | LPSPI_SR_REF_MASK | LPSPI_SR_DMF_MASK)
+/** Defines the flags of SR that can interrupt*/
+#define SR_IRQ_FLAGS				(LPSPI_SR_TDF_MASK | LPSPI_SR_RDF_MASK | SR_W1C_FLAGS)
+/** Defines the empty flag of the Rx FIFO in RSR*/
+#define RSR_RXEMPTY					(0x2UL)
+/** Defines the LPSPI of the SBC*/
+#define SBC_INSTANCE				(1U)
+/** Defines the watchdog refresh command of the SBC*/
+#define SBC_WD_REFRESH				(0x5A00U)
+/** Defines the read commands of the status registers of the SBC*/
+#define SBC_READ_VREG				(0xDF80U)
+#define SBC_READ_CAN				(0xE180U)
+#define SBC_READ_IO					(0xE380U)
+/** Defines the status registers of the SBC*/
+#define SBC_STATUS_REGS				(3U)
+
+/*!
+ 	 \brief FIFO of 16 bits words.
+ */
+typedef struct
+{
+	uint16_t words[FIFO_WORDS];		/*!< Words of the FIFO*/
+	uint32_t head;					/*!< First word*/
+	uint32_t count;					/*!< Words in the FIFO*/
+}host_lpspi_fifo_t;
+
+/*!
+ 	 \brief Model of a LPSPI.
+ */
+typedef struct
+{
+	uint8_t instance;			/*!< Number of the LPSPI*/
+	IRQn_Type irq;				/*!< Interruption of the LPSPI*/
+	LPSPI_Type* regs;			/*!< Registers, as the model changes them*/
+	host_sim_timer_t timer;		/*!< End of the word being shifted*/
+	uint8_t busy;				/*!< Indicates if a word is being shifted*/
+	host_lpspi_fifo_t tx;		/*!< Tx FIFO*/
+	host_lpspi_fifo_t rx;		/*!< Rx FIFO*/
+}host_lpspi_t;
+
+/** Models of the LPSPIs*/
+static host_lpspi_t lpspis[LPSPI_INSTANCE_COUNT];
+/** Read commands of the status registers of the SBC*/
+static const uint16_t sbc_commands[SBC_STATUS_REGS] = {SBC_READ_VREG, SBC_READ_CAN, SBC_READ_IO};
+/** Flags of the status registers of the SBC*/
+static uint16_t sbc_flags[SBC_STATUS_REGS] = {INIT_VAL};
+/** Watchdog refreshes received by the SBC*/
+static uint32_t sbc_refreshes = INIT_VAL;
+
+/** This function pushes a word to a FIFO, it returns 0 if the FIFO is full*/
+static uint8_t host_lpspi_push(host_lpspi_fifo_t* fifo, uint16_t word)
+{
+	if(FIFO_WORDS == fifo->count)
+	{
+		return INIT_VAL;
+	}
+
+	fifo->words[(fifo->head + fifo->count) % FIFO_WORDS] = word;
+	fifo->count ++;
+
+	return FLAG_SET;
+}
+
+/** This function pops a word from a FIFO (The FIFO must not be empty)*/
+static uint16_t host_lpspi_pop(host_lpspi_fifo_t* fifo)
+{
+	/** First word of the FIFO*/
+	uint16_t word = fifo->words[fifo->head];
+
+	fifo->head = (fifo->head + 1U) % FIFO_WORDS;
+	fifo->count --;
+
+	return word;
+}
+
+/** This function gets the answer of the device of a LPSPI to a word*/
+static uint16_t host_lpspi_answer(const host_lpspi_t* lpspi, uint16_t word)
+{
+	/** Counter for the status registers*/
+	uint32_t index;
+	/** Answer of the device*/
+	uint16_t answer = INIT_VAL;
+
+	if(SBC_INSTANCE != lpspi->instance)
+	{
+		return answer;
+	}
+
+	if(SBC_WD_REFRESH == word)
+	{
+		sbc_refreshes ++;
+	}
+
+	for(index = INIT_VAL; SBC_STATUS_REGS > index; index ++)
+	{
+		if(sbc_commands[index] == word)
+		{
+			answer = sbc_flags[index];
+		}
+	}
+
+	return answer;
+}
+
+/** This function updates the status flags, the FIFO registers and the interruption of a LPSPI*/
+static void host_lpspi_update(host_lpspi_t* lpspi)
+{
+	/** Status flags*/
+	uint32_t sr = lpspi->regs->SR & SR_W1C_FLAGS;
+	/** Watermarks*/
+	uint32_t tx_water = (lpspi->regs->FCR & LPSPI_FCR_TXWATER_MASK) >> LPSPI_FCR_TXWATER_SHIFT;
+	uint32_t rx_water = (lpspi->regs->FCR & LPSPI_FCR_RXWATER_MASK) >> LPSPI_FCR_RXWATER_SHIFT;
+
+	if(tx_water >= lpspi->tx.count)
+	{
+		sr |= LPSPI_SR_TDF_MASK;
+	}
+	if(rx_water < lpspi->rx.count)
+	{
+		sr |= LPSPI_SR_RDF_MASK;
+	}
+	if(lpspi->busy)
+	{
+		sr |= LPSPI_SR_MBF_MASK;
+	}
+	lpspi->regs->SR = sr;
+
+	HOST_SIM_SET(lpspi->regs->FSR, LPSPI_FSR_TXCOUNT(lpspi->tx.count) | LPSPI_FSR_RXCOUNT(lpspi->rx.count));
+	HOST_SIM_SET(lpspi->regs->RSR, (INIT_VAL == lpspi->rx.count) ? RSR_RXEMPTY : INIT_VAL);
+	HOST_SIM_SET(lpspi->regs->RDR, (INIT_VAL == lpspi->rx.count) ? INIT_VAL : lpspi->rx.words[lpspi->rx.head]);
+
+	if(sr & lpspi->regs->IER & SR_IRQ_FLAGS)
+	{
+		host_cpu_set_pending(lpspi->irq);
+	}
+	else
+	{
+		host_cpu_clear_pending(lpspi->irq);
+	}
+}
+
+/** This function starts to shift the next word, if the LPSPI is enabled and the Rx FIFO has room (It stalls
+ 	 otherwise)*/
+static void host_lpspi_shift(host_lpspi_t* lpspi)
+{
+	if(!lpspi->busy && (lpspi->regs->CR & LPSPI_CR_MEN_MASK) && (INIT_VAL != lpspi->tx.count) && (FIFO_WORDS > lpspi->rx.count))
+	{
+		lpspi->busy = FLAG_SET;
+		host_sim_timer_start(&lpspi->timer, host_sim_now() + WORD_NS);
+	}
+}
+
+/** This function ends the word being shifted*/
+static void host_lpspi_word_end(void* context)
+{
+	/** Model of the LPSPI*/
+	host_lpspi_t* lpspi = (host_lpspi_t*)context;
+	/** Word sent*/
+	uint16_t word;
+
+	lpspi->busy = INIT_VAL;
+
+	/** The FIFOs could be reset while the word was shifted*/
+	if(INIT_VAL != lpspi->tx.count)
+	{
+		word = host_lpspi_pop(&lpspi->tx);
+		host_lpspi_push(&lpspi->rx, host_lpspi_answer(lpspi, word));
+		lpspi->regs->SR |= LPSPI_SR_WCF_MASK;
+	}
+
+	host_lpspi_shift(lpspi);
+	host_lpspi_update(lpspi);
+}
+
+/** Reads of the registers of a LPSPI*/
+static void host_lpspi_after_read(void* context, uint32_t offset)
+{
+	/** Model of the LPSPI*/
+	host_lpspi_t* lpspi = (host_lpspi_t*)context;
+
+	/** Reading the received data pops it*/
+	if((offsetof(LPSPI_Type, RDR) == offset) && (INIT_VAL != lpspi->rx.count))
+	{
+		host_lpspi_pop(&lpspi->rx);
+		host_lpspi_shift(lpspi);
+		host_lpspi_update(lpspi);
+	}
+}
+
+/** Writes to the registers of a LPSPI*/
+static void host_lpspi_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	/** Model of the LPSPI*/
+	host_lpspi_t* lpspi = (host_lpspi_t*)context;
+
+	switch(offset)
+	{
+		case offsetof(LPSPI_Type, CR):
+			/** The FIFO resets are done at once*/
+			if(value & LPSPI_CR_RTF_MASK)
+			{
+				lpspi->tx.count = INIT_VAL;
+			}
+			if(value & LPSPI_CR_RRF_MASK)
+			{
+				lpspi->rx.count = INIT_VAL;
+			}
+			lpspi->regs->CR = value & ~(LPSPI_CR_RTF_MASK | LPSPI_CR_RRF_MASK);
+			break;
+		case offsetof(LPSPI_Type, SR):
+			lpspi->regs->SR = old_value & ~(value & SR_W1C_FLAGS);
+			break;
+		case offsetof(LPSPI_Type, TDR):
+			if(!host_lpspi_push(&lpspi->tx, (uint16_t)value))
+			{
+				lpspi->regs->SR |= LPSPI_SR_TEF_MASK;
+			}
+			break;
+		case offsetof(LPSPI_Type, RDR):
+			/** The received data is read only*/
+			HOST_SIM_SET(lpspi->regs->RDR, old_value);
+			break;
+		default:
+			break;
+	}
+
+	host_lpspi_shift(lpspi);
+	host_lpspi_update(lpspi);
+}
+
+/** Hooks of the LPSPIs*/
+static const host_sim_hooks_t lpspi_hooks = {NULL, host_lpspi_after_read, host_lpspi_after_write};
+
+/** This function initializes the LPSPI models*/
+void host_lpspi_init(void)
+{
+	/** Registers of the LPSPIs*/
+	LPSPI_Type* const instances[LPSPI_INSTANCE_COUNT] = LPSPI_BASE_PTRS;
+	/** Interruptions of the LPSPIs*/
+	const IRQn_Type irqs[LPSPI_INSTANCE_COUNT] = LPSPI_IRQS;
+	/** Counter for the LPSPIs*/
+	uint8_t instance;
+	/** Model of a LPSPI*/
+	host_lpspi_t* lpspi;
+
+	for(instance = INIT_VAL; LPSPI_INSTANCE_COUNT > instance; instance ++)
+	{
+		lpspi = &lpspis[instance];
+		lpspi->instance = instance;
+		lpspi->irq = irqs[instance];
+		lpspi->regs = host_sim_alias(instances[instance]);
+		host_sim_timer_init(&lpspi->timer, host_lpspi_word_end, lpspi);
+		host_lpspi_update(lpspi);
+
+		host_sim_map(instances[instance], sizeof(LPSPI_Type), host_sim_trap_accesses, &lpspi_hooks, lpspi);
+	}
+}
+
+/** This function sets the flags of a status register of the SBC*/
+void host_lpspi_set_sbc_flags(uint16_t command, uint16_t flags)
+{
+	/** Counter for the status registers*/
+	uint32_t index;
+
+	for(index = INIT_VAL; SBC_STATUS_REGS > index; index ++)
+	{
+		if(sbc_commands[index] == command)
+		{
+			sbc_flags[index] = flags;
+		}
+	}
+}
+
+/** This function gets the watchdog refreshes received by the SBC*/
+uint32_t host_lpspi_get_sbc_refreshes(void)
+{
+	return sbc_refreshes;
+}
@@ -0,0 +1,455 @@
+/*!
+ 	 \file host_scenario.c
+
+ 	 \brief This is the source file of the scenario of the host simulator. From
+ 	 	 	 the start of the scheduler it plays the other nodes of the board:
+ 	 	 	 it sends the test request (0x123) on CAN0 (And on CAN1 and CAN2
+ 	 	 	 when the application uses them), presses SW3 (PTC13),
+ 	 	 	 drives a sine on the potentiometer (ADC0 channel 12) and sets a
+ 	 	 	 CAN fault in the SBC at the half of the run. At the end it prints
+ 	 	 	 the latency of the answers, the frames of each ID, the load of the
+ 	 	 	 bus and the interruptions, and exits with 0 if every expected
+ 	 	 	 frame was seen.
+
+ 	 \note The times are of the host clock, they depend on the load of the PC.
+ 	 	 	 The run is set with HEMI_SIM_TIME_MS (Length, 2000 ms by default),
+ 	 	 	 HEMI_SIM_REQUEST_US (Period of the test request, 5000 us),
+ 	 	 	 HEMI_SIM_PRESS_MS (Period of the SW3 presses, 300 ms) and
+ 	 	 	 HEMI_SIM_CANS (CANs that get the request, from CAN0, 1 by default).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the flag as set*/
+#define FLAG_SET					(1)
+/** Defines the exit status of a passed run*/
+#define SCENARIO_PASS				(0)
+/** Defines the exit status of a failed run*/
+#define SCENARIO_FAIL				(1)
+/** Defines the default length of the run, in ms*/
+#define DEFAULT_TIME_MS				(2000UL)
+/** Defines the default period of the test request, in us*/
+#define DEFAULT_REQUEST_US			(5000UL)
+/** Defines the default period of the SW3 presses, in ms*/
+#define DEFAULT_PRESS_MS			(300UL)
+/** Defines the time that SW3 is held, in ms*/
+#define PRESS_HOLD_MS				(20ULL)
+/** Defines the CAN of the application*/
+#define APP_CAN						(0U)
+/** Defines the default number of CANs that get the test request*/
+#define DEFAULT_CANS				(1U)
+/** Defines the port and the pin of SW3 (PTC13)*/
+#define SW3_PORT					(2U)
+#define SW3_PIN						(13U)
+/** Defines the ADC and the channel of the potentiometer*/
+#define POT_ADC						(0U)
+#define POT_CHANNEL					(12U)
+/** Defines the sine on the potentiometer (12 bits), its period is 1 s*/
+#define POT_OFFSET					(2048.0)
+#define POT_AMPLITUDE				(1500.0)
+#define POT_PERIOD_NS				(1000000000.0)
+#define TWO_PI						(6.283185307179586)
+/** Defines the IDs of the frames*/
+#define ID_ADC						(0x10U)
+#define ID_ANSWER					(0x25U)
+#define ID_SW3						(0x30U)
+#define ID_PERIODIC					(0x40U)
+#define ID_SBC_FAULT				(0x50U)
+#define ID_RUNTIME					(0x70U)
+#define ID_REQUEST					(0x123U)
+/** Defines the IDs of a standard frame*/
+#define IDS							(0x800U)
+/** Defines the data of the test request*/
+#define REQUEST_DLC					(2U)
+/** Defines the command and the flags of the SBC fault (CAN flags of the MC33903, bus failure)*/
+#define SBC_FAULT_COMMAND			(0xE180U)
+#define SBC_FAULT_FLAGS				(0x0008U)
+/** Defines the requests that can wait for their answers*/
+#define PENDING_REQUESTS			(64U)
+/** Defines the requests that can be left unanswered at the end of the run*/
+#define UNANSWERED_MARGIN			(2U)
+/** Defines the part of the request period that the host can stop the simulator before an overrun is
+ 	 not a failure of the application*/
+#define OVERRUN_DELAY_DIVIDER		(2U)
+
+/*!
+ 	 \brief Latency of an answer.
+ */
+typedef struct
+{
+	uint64_t min;		/*!< Minimum latency, in ns*/
+	uint64_t max;		/*!< Maximum latency, in ns*/
+	uint64_t total;		/*!< Sum of the latencies, in ns*/
+	uint32_t count;		/*!< Answers measured*/
+}host_latency_t;
+
+/*!
+ 	 \brief Test requests of a CAN.
+ */
+typedef struct
+{
+	uint64_t pending[PENDING_REQUESTS];	/*!< Requests received by the application and not answered, by the time they were stored*/
+	uint32_t head;						/*!< Oldest pending request*/
+	uint32_t count;						/*!< Pending requests*/
+	uint32_t sent;						/*!< Requests sent*/
+	uint32_t dropped;					/*!< Requests that could not be queued*/
+	host_latency_t latency;				/*!< Latency of the answers*/
+}host_requests_t;
+
+/*!
+ 	 \brief Interruption shown in the report.
+ */
+typedef struct
+{
+	const char* name;	/*!< Name of the interruption*/
+	int32_t irq;		/*!< IRQ number*/
+}host_report_irq_t;
+
+/** Timers of the scenario*/
+static host_sim_timer_t request_timer;
+static host_sim_timer_t press_timer;
+static host_sim_timer_t release_timer;
+static host_sim_timer_t fault_timer;
+static host_sim_timer_t end_timer;
+/** Periods and length of the run, in ns*/
+static uint64_t request_period;
+static uint64_t press_period;
+static uint64_t run_time;
+/** Start of the run*/
+static uint64_t start_time = INIT_VAL;
+/** Indicates if the run started*/
+static uint8_t started = INIT_VAL;
+/** Time of the SBC fault (0 before it)*/
+static uint64_t fault_time = INIT_VAL;
+/** CANs that get the test request, from CAN0*/
+static uint32_t cans = DEFAULT_CANS;
+/** Test requests of each CAN*/
+static host_requests_t requests[CAN_INSTANCE_COUNT];
+/** Time of the last SW3 press not answered (0 if there is none)*/
+static uint64_t press_time = INIT_VAL;
+/** SW3 presses*/
+static uint32_t presses = INIT_VAL;
+/** Latency of the SW3 answers*/
+static host_latency_t sw3_latency = {UINT64_MAX, INIT_VAL, INIT_VAL, INIT_VAL};
+/** Frames sent by the application, by ID*/
+static uint32_t frames_sent[IDS];
+/** SBC fault frames sent after the fault*/
+static uint32_t fault_frames = INIT_VAL;
+
+/** This function gets a setting of the environment*/
+static uint64_t host_scenario_setting(const char* name, uint64_t default_value)
+{
+	/** Value of the environment*/
+	const char* value = getenv(name);
+	/** Number of the value*/
+	unsigned long long number;
+
+	if((NULL == value) || (INIT_VAL == (number = strtoull(value, NULL, 10))))
+	{
+		return default_value;
+	}
+
+	return number;
+}
+
+/** This function adds a latency*/
+static void host_latency_add(host_latency_t* latency, uint64_t value)
+{
+	latency->min = (latency->min > value) ? value : latency->min;
+	latency->max = (latency->max < value) ? value : latency->max;
+	latency->total += value;
+	latency->count ++;
+}
+
+/** This function prints a latency, in us*/
+static void host_latency_print(const char* name, const host_latency_t* latency)
+{
+	if(INIT_VAL == latency->count)
+	{
+		printf("  %-22s no answers\n", name);
+		return;
+	}
+
+	printf("  %-22s %6u answers, min %8.1f us, avg %8.1f us, max %8.1f us\n", name, latency->count,
+		(double)latency->min / HOST_SIM_NS_PER_US, (double)latency->total / latency->count / HOST_SIM_NS_PER_US,
+		(double)latency->max / HOST_SIM_NS_PER_US);
+}
+
+/** Observer of the CAN buses*/
+static void host_scenario_can(uint8_t instance, host_can_event_t event, const host_can_frame_t* frame)
+{
+	/** Test requests of the CAN*/
+	host_requests_t* bus;
+
+	if(cans <= instance)
+	{
+		return;
+	}
+	bus = &requests[instance];
+
+	/** A stored request waits for its answer*/
+	if((host_can_received == event) && (ID_REQUEST == frame->ID) && (PENDING_REQUESTS > bus->count))
+	{
+		bus->pending[(bus->head + bus->count) % PENDING_REQUESTS] = frame->time;
+		bus->count ++;
+	}
+	/** A request stored over an unread one replaces it, the answer is measured from the newest one*/
+	else if((host_can_overrun == event) && (ID_REQUEST == frame->ID) && (INIT_VAL != bus->count))
+	{
+		bus->pending[(bus->head + bus->count - 1U) % PENDING_REQUESTS] = frame->time;
+	}
+
+	if(host_can_sent != event)
+	{
+		return;
+	}
+
+	/** Each CAN answers its own requests*/
+	if((ID_ANSWER == frame->ID) && (INIT_VAL != bus->count))
+	{
+		host_latency_add(&bus->latency, frame->time - bus->pending[bus->head]);
+		bus->head = (bus->head + 1U) % PENDING_REQUESTS;
+		bus->count --;
+	}
+
+	/** The other frames are sent on the CAN of the application*/
+	if(APP_CAN != instance)
+	{
+		return;
+	}
+
+	frames_sent[frame->ID] ++;
+
+	switch(frame->ID)
+	{
+		case ID_SW3:
+			if(INIT_VAL != press_time)
+			{
+				host_latency_add(&sw3_latency, frame->time - press_time);
+				press_time = INIT_VAL;
+			}
+			break;
+		case ID_SBC_FAULT:
+			if((INIT_VAL != fault_time) && (fault_time < frame->time))
+			{
+				fault_frames ++;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+/** Input of the ADC channels*/
+static uint16_t host_scenario_adc(uint8_t instance, uint8_t channel)
+{
+	/** Phase of the sine*/
+	double phase;
+
+	if((POT_ADC != instance) || (POT_CHANNEL != channel))
+	{
+		return INIT_VAL;
+	}
+
+	phase = TWO_PI * (double)(host_sim_now() - start_time) / POT_PERIOD_NS;
+
+	return (uint16_t)(POT_OFFSET + POT_AMPLITUDE * sin(phase));
+}
+
+/** This function sends the test request on each CAN at the same time*/
+static void host_scenario_request(void* context)
+{
+	/** Test request*/
+	host_can_frame_t frame = {ID_REQUEST, REQUEST_DLC, {INIT_VAL}, INIT_VAL};
+	/** Counter for the CANs*/
+	uint8_t instance;
+
+	(void)context;
+
+	for(instance = INIT_VAL; cans > instance; instance ++)
+	{
+		frame.data[0] = (uint8_t)(requests[instance].sent >> 8);
+		frame.data[1] = (uint8_t)requests[instance].sent;
+		requests[instance].sent ++;
+
+		if(!host_can_inject(instance, &frame))
+		{
+			requests[instance].dropped ++;
+		}
+	}
+
+	host_sim_timer_start(&request_timer, request_timer.due + request_period);
+}
+
+/** This function presses SW3*/
+static void host_scenario_press(void* context)
+{
+	(void)context;
+
+	press_time = host_sim_now();
+	presses ++;
+	host_gpio_set_input(SW3_PORT, SW3_PIN, FLAG_SET);
+
+	host_sim_timer_start(&release_timer, press_time + PRESS_HOLD_MS * HOST_SIM_NS_PER_MS);
+	host_sim_timer_start(&press_timer, press_timer.due + press_period);
+}
+
+/** This function releases SW3*/
+static void host_scenario_release(void* context)
+{
+	(void)context;
+
+	host_gpio_set_input(SW3_PORT, SW3_PIN, INIT_VAL);
+}
+
+/** This function sets the fault of the SBC*/
+static void host_scenario_fault(void* context)
+{
+	(void)context;
+
+	fault_time = host_sim_now();
+	host_lpspi_set_sbc_flags(SBC_FAULT_COMMAND, SBC_FAULT_FLAGS);
+}
+
+/** This function prints the report of the run, it returns the exit status*/
+static int host_scenario_report(const char* reason)
+{
+	/** Interruptions of the report*/
+	static const host_report_irq_t report_irqs[] =
+	{
+		{"SysTick", HOST_CPU_SYSTICK_IRQ},
+		{"CAN0 MB0-15", CAN0_ORed_0_15_MB_IRQn},
+		{"CAN1 MB0-15", CAN1_ORed_0_15_MB_IRQn},
+		{"CAN2 MB0-15", CAN2_ORed_0_15_MB_IRQn},
+		{"PORTC (SW3)", PORTC_IRQn},
+		{"ADC0", ADC0_IRQn},
+		{"LPSPI1 (SBC)", LPSPI1_IRQn},
+	};
+	/** Time of the run*/
+	uint64_t elapsed = host_sim_now() - start_time;
+	/** Statistics of the bus*/
+	host_can_stats_t stats;
+	/** Counter for the IDs, the CANs and the interruptions*/
+	uint32_t index;
+	/** Name of the latency of a CAN*/
+	char name[32];
+	/** Checks of the run*/
+	uint8_t passed = FLAG_SET;
+
+	printf("HEMI host simulation: %s after %.1f ms (core clock %u Hz)\n", reason,
+		(double)elapsed / HOST_SIM_NS_PER_MS, host_system_core_clock());
+	printf("Latency (end of the frame to the end of the answer):\n");
+	for(index = INIT_VAL; cans > index; index ++)
+	{
+		snprintf(name, sizeof(name), "CAN%u 0x123 -> 0x25", index);
+		host_latency_print(name, &requests[index].latency);
+	}
+	host_latency_print("SW3 -> 0x30", &sw3_latency);
+	printf("Frames sent by the application:\n");
+	for(index = INIT_VAL; IDS > index; index ++)
+	{
+		if(INIT_VAL != frames_sent[index])
+		{
+			printf("  0x%03X %6u\n", index, frames_sent[index]);
+		}
+	}
+	for(index = INIT_VAL; cans > index; index ++)
+	{
+		host_can_get_stats(index, &stats);
+
+		printf("CAN%u: %u requests (%u not queued), %u received, %u overruns, %u filtered, %u lost, %u discarded, bus load %.2f %%\n",
+			index, requests[index].sent, requests[index].dropped, stats.received, stats.overruns, stats.filtered, stats.lost,
+			stats.discarded, (INIT_VAL == elapsed) ? 0.0 : (double)stats.busy_time * 100.0 / elapsed);
+
+		/** Every stored request is answered, but the ones in flight at the end*/
+		passed &= (INIT_VAL != requests[index].latency.count) && (UNANSWERED_MARGIN >= requests[index].count);
+		passed &= (INIT_VAL == stats.lost) && (INIT_VAL == stats.discarded) && (INIT_VAL == requests[index].dropped);
+		/** A request is only overwritten if the host stopped the simulator for a part of the period*/
+		passed &= (INIT_VAL == stats.overruns) || ((request_period / OVERRUN_DELAY_DIVIDER) <= host_sim_get_max_delay());
+	}
+	printf("SBC: %u watchdog refreshes, %u fault frames after the fault\n", host_lpspi_get_sbc_refreshes(), fault_frames);
+	printf("ADC0: %u conversions\n", host_adc_get_conversions(POT_ADC));
+	printf("Host: timers delayed up to %.1f us\n", (double)host_sim_get_max_delay() / HOST_SIM_NS_PER_US);
+	printf("Interruptions:\n");
+	for(index = INIT_VAL; (sizeof(report_irqs) / sizeof(report_irqs[0])) > index; index ++)
+	{
+		printf("  %-14s %8u\n", report_irqs[index].name, host_cpu_get_isr_count(report_irqs[index].irq));
+	}
+
+	/** Every press is answered, but the last one*/
+	passed &= (INIT_VAL != sw3_latency.count) && (presses <= sw3_latency.count + 1U);
+	passed &= (INIT_VAL != frames_sent[ID_ADC]) && (INIT_VAL != frames_sent[ID_PERIODIC]) && (INIT_VAL != frames_sent[ID_RUNTIME]);
+	passed &= (INIT_VAL != fault_frames) && (INIT_VAL != host_lpspi_get_sbc_refreshes());
+
+	printf("%s\n", passed ? "PASS" : "FAIL");
+
+	return passed ? SCENARIO_PASS : SCENARIO_FAIL;
+}
+
+/** This function ends the run*/
+static void host_scenario_end(void* context)
+{
+	(void)context;
+
+	host_sim_exit(host_scenario_report("end of the run"));
+}
+
+/** This function starts the scenario*/
+void host_scenario_start(void)
+{
+	/** Counter for the CANs*/
+	uint8_t instance;
+
+	if(started)
+	{
+		return;
+	}
+	started = FLAG_SET;
+
+	start_time = host_sim_now();
+	run_time = host_scenario_setting("HEMI_SIM_TIME_MS", DEFAULT_TIME_MS) * HOST_SIM_NS_PER_MS;
+	request_period = host_scenario_setting("HEMI_SIM_REQUEST_US", DEFAULT_REQUEST_US) * HOST_SIM_NS_PER_US;
+	press_period = host_scenario_setting("HEMI_SIM_PRESS_MS", DEFAULT_PRESS_MS) * HOST_SIM_NS_PER_MS;
+	cans = (uint32_t)host_scenario_setting("HEMI_SIM_CANS", DEFAULT_CANS);
+	cans = (CAN_INSTANCE_COUNT < cans) ? CAN_INSTANCE_COUNT : cans;
+	for(instance = INIT_VAL; CAN_INSTANCE_COUNT > instance; instance ++)
+	{
+		requests[instance].latency.min = UINT64_MAX;
+	}
+
+	host_can_set_observer(host_scenario_can);
+	host_adc_set_input(host_scenario_adc);
+
+	host_sim_timer_init(&request_timer, host_scenario_request, NULL);
+	host_sim_timer_init(&press_timer, host_scenario_press, NULL);
+	host_sim_timer_init(&release_timer, host_scenario_release, NULL);
+	host_sim_timer_init(&fault_timer, host_scenario_fault, NULL);
+	host_sim_timer_init(&end_timer, host_scenario_end, NULL);
+
+	/** The first events leave a period to the tasks to start*/
+	host_sim_timer_start(&request_timer, start_time + request_period);
+	host_sim_timer_start(&press_timer, start_time + press_period);
+	host_sim_timer_start(&fault_timer, start_time + run_time / 2U);
+	host_sim_timer_start(&end_timer, start_time + run_time);
+}
+
+/** This function ends the scenario because the application reset the core*/
+void host_scenario_reset(void)
+{
+	host_scenario_report("reset requested by the application");
+
+	host_sim_exit(SCENARIO_FAIL);
+}
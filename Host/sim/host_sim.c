@@ -0,0 +1,579 @@
+/*!
+ 	 \file host_sim.c
+
+ 	 \brief This is the source file of the host simulator of the HEMI
+ 	 	 	 application. It keeps the memory of the peripherals, traps the
+ 	 	 	 accesses of the application to them, and runs the timers of the
+ 	 	 	 models in the clock thread. A trapped access is done in two steps:
+ 	 	 	 the fault unprotects the page and steps the instruction, and the
+ 	 	 	 trap that follows protects the page again and gives the access to
+ 	 	 	 the model. The interruption signal of the port is blocked between
+ 	 	 	 both steps, so a handler never runs in the middle of an access.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "host_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the maximum peripherals mapped in the simulator*/
+#define MAX_REGIONS					(48)
+/** Defines the words compared after a trapped write (An access can take more than one word)*/
+#define SNAPSHOT_WORDS				(4)
+/** Defines the write bit of the page fault error code of the x86-64*/
+#define FAULT_WRITE					(0x2)
+/** Defines the trap flag of the x86-64, it steps one instruction*/
+#define TRAP_FLAG					(0x100)
+/** Defines the signal that interrupts the running task (The one of the port)*/
+#define INTERRUPT_SIGNAL			(SIGUSR1)
+/** Defines the flag as set*/
+#define FLAG_SET					(1)
+
+/*!
+ 	 \brief Peripheral mapped in the simulator.
+ */
+typedef struct
+{
+	uintptr_t base;					/*!< Registers, as seen by the application*/
+	size_t size;					/*!< Size of the registers, in pages*/
+	host_sim_trap_t trap;			/*!< Accesses that are trapped*/
+	const host_sim_hooks_t* hooks;	/*!< Hooks of the model*/
+	void* context;					/*!< Parameter of the hooks*/
+}host_sim_region_t;
+
+/*!
+ 	 \brief Memory seen by the application, and its alias for the models.
+ */
+typedef struct
+{
+	uintptr_t view;		/*!< Protected mapping of the application*/
+	uintptr_t alias;	/*!< Mapping of the models*/
+	size_t size;		/*!< Size of the memory*/
+}host_sim_memory_t;
+
+/*!
+ 	 \brief Trapped access that is being stepped.
+ */
+typedef struct
+{
+	const host_sim_region_t* region;			/*!< Peripheral of the access*/
+	uint32_t offset;							/*!< Offset of the accessed word*/
+	uint32_t words;								/*!< Words in the snapshot*/
+	uint32_t snapshot[SNAPSHOT_WORDS];			/*!< Words before the access*/
+	uint8_t write;								/*!< Indicates if the access is a write*/
+	uint8_t masked;								/*!< Indicates if the interruption signal was blocked before*/
+}host_sim_access_t;
+
+/** Peripherals of the application, the memory of the simulator is mapped over them*/
+host_peripherals_t host_peripherals;
+
+/** Memory of host_peripherals*/
+static host_sim_memory_t peripheral_memory;
+/** Memory of the core peripherals, at their address*/
+static host_sim_memory_t core_memory;
+/** Peripherals mapped*/
+static host_sim_region_t regions[MAX_REGIONS];
+/** Number of peripherals mapped*/
+static uint32_t region_count = INIT_VAL;
+/** Trapped accesses of each peripheral*/
+static host_sim_accesses_t region_accesses[MAX_REGIONS];
+/** Access stepped by the calling thread*/
+static __thread host_sim_access_t access_trap;
+/** Size of a page of the host*/
+static size_t page_size;
+
+/** Lock of the models and the timers*/
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+/** Signals the clock thread that the first timer changed*/
+static pthread_cond_t clock_changed;
+/** Clock thread*/
+static pthread_t clock_thread;
+/** Armed timers, by due time*/
+static host_sim_timer_t* timers = NULL;
+/** Start of the simulator*/
+static struct timespec start_time;
+/** Longest delay of a timer, in ns (The host did not run the clock thread)*/
+static uint64_t max_delay = INIT_VAL;
+
+/** This function reports an error of the simulator and ends it*/
+static void host_sim_fail(const char* what)
+{
+	fprintf(stderr, "host_sim: %s\n", what);
+	host_sim_exit(EXIT_FAILURE);
+}
+
+/** This function creates a memory with two mappings, the view at the given address (MAP_FIXED replaces the
+ 	 pages that are there, MAP_FIXED_NOREPLACE needs the address to be free)*/
+static void host_sim_memory_create(host_sim_memory_t* memory, const char* name, size_t size, void* address, int placement)
+{
+	/** File of the memory*/
+	int file = memfd_create(name, INIT_VAL);
+	/** Mapping of the application*/
+	void* view;
+	/** Mapping of the models*/
+	void* alias;
+
+	if((INIT_VAL > file) || (INIT_VAL != ftruncate(file, (off_t)size)))
+	{
+		host_sim_fail("memory can not be created");
+	}
+
+	view = mmap(address, size, PROT_READ | PROT_WRITE, MAP_SHARED | placement, file, INIT_VAL);
+	alias = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, INIT_VAL);
+	close(file);
+
+	if((MAP_FAILED == view) || (MAP_FAILED == alias) || (view != address))
+	{
+		host_sim_fail("memory can not be mapped");
+	}
+
+	memory->view = (uintptr_t)view;
+	memory->alias = (uintptr_t)alias;
+	memory->size = size;
+}
+
+/** This function gets the memory of an address of the application, NULL if it is not simulated*/
+static const host_sim_memory_t* host_sim_memory(uintptr_t address)
+{
+	/** Memory of the address*/
+	const host_sim_memory_t* memory = NULL;
+
+	if((address >= peripheral_memory.view) && (address < (peripheral_memory.view + peripheral_memory.size)))
+	{
+		memory = &peripheral_memory;
+	}
+	else if((address >= core_memory.view) && (address < (core_memory.view + core_memory.size)))
+	{
+		memory = &core_memory;
+	}
+
+	return memory;
+}
+
+/** This function gets the peripheral of an address of the application, NULL if it is not mapped*/
+static const host_sim_region_t* host_sim_region(uintptr_t address)
+{
+	/** Peripheral of the address*/
+	const host_sim_region_t* region = NULL;
+	/** Counter for the peripherals*/
+	uint32_t index;
+
+	for(index = INIT_VAL; (region_count > index) && (NULL == region); index ++)
+	{
+		if((address >= regions[index].base) && (address < (regions[index].base + regions[index].size)))
+		{
+			region = &regions[index];
+		}
+	}
+
+	return region;
+}
+
+/** This function gets the protection of the pages of a peripheral*/
+static int host_sim_protection(host_sim_trap_t trap)
+{
+	/** Protection of the pages*/
+	int protection = PROT_READ | PROT_WRITE;
+
+	if(host_sim_trap_writes == trap)
+	{
+		protection = PROT_READ;
+	}
+	else if(host_sim_trap_accesses == trap)
+	{
+		protection = PROT_NONE;
+	}
+
+	return protection;
+}
+
+/** Handler of the faults, it starts a trapped access*/
+static void host_sim_fault_handler(int number, siginfo_t* info, void* context)
+{
+	/** Context of the interrupted thread*/
+	ucontext_t* thread_context = (ucontext_t*)context;
+	/** Faulting address*/
+	uintptr_t address = (uintptr_t)info->si_addr;
+	/** Peripheral of the address*/
+	const host_sim_region_t* region = host_sim_region(address);
+	/** Alias of the peripheral*/
+	const uint32_t* alias;
+	/** Counter for the words*/
+	uint32_t word;
+
+	/** A fault that is not a trap, or a fault while stepping, is a real one: it is raised again without the handler*/
+	if((NULL == region) || (NULL != access_trap.region) || (host_sim_plain == region->trap))
+	{
+		signal(number, SIG_DFL);
+		return;
+	}
+
+	pthread_mutex_lock(&sim_lock);
+
+	access_trap.region = region;
+	access_trap.offset = (uint32_t)(address - region->base) & ~3UL;
+	access_trap.write = (thread_context->uc_mcontext.gregs[REG_ERR] & FAULT_WRITE) ? FLAG_SET : INIT_VAL;
+
+	/** A read of a computed register (A counter, a FIFO) gets its value first*/
+	if((NULL != region->hooks) && (NULL != region->hooks->before_read))
+	{
+		region->hooks->before_read(region->context, access_trap.offset);
+	}
+
+	alias = (const uint32_t*)host_sim_alias((volatile void*)(region->base + access_trap.offset));
+	access_trap.words = (uint32_t)((region->size - access_trap.offset) / sizeof(uint32_t));
+	if(SNAPSHOT_WORDS < access_trap.words)
+	{
+		access_trap.words = SNAPSHOT_WORDS;
+	}
+	for(word = INIT_VAL; access_trap.words > word; word ++)
+	{
+		access_trap.snapshot[word] = alias[word];
+	}
+
+	/** The page is opened only for the stepped instruction*/
+	mprotect((void*)((region->base + access_trap.offset) & ~(page_size - 1)), page_size, PROT_READ | PROT_WRITE);
+	thread_context->uc_mcontext.gregs[REG_EFL] |= TRAP_FLAG;
+
+	/** The interruptions wait until the access is given to the model*/
+	access_trap.masked = (uint8_t)sigismember(&thread_context->uc_sigmask, INTERRUPT_SIGNAL);
+	sigaddset(&thread_context->uc_sigmask, INTERRUPT_SIGNAL);
+}
+
+/** Handler of the trap after the stepped instruction, it ends a trapped access*/
+static void host_sim_trap_handler(int signal, siginfo_t* info, void* context)
+{
+	/** Context of the interrupted thread*/
+	ucontext_t* thread_context = (ucontext_t*)context;
+	/** Peripheral of the access*/
+	const host_sim_region_t* region = access_trap.region;
+	/** Alias of the accessed words*/
+	const uint32_t* alias;
+	/** Counter for the words*/
+	uint32_t word;
+
+	(void)signal;
+	(void)info;
+
+	if(NULL == region)
+	{
+		return;
+	}
+
+	thread_context->uc_mcontext.gregs[REG_EFL] &= ~TRAP_FLAG;
+	mprotect((void*)((region->base + access_trap.offset) & ~(page_size - 1)), page_size, host_sim_protection(region->trap));
+	access_trap.region = NULL;
+
+	if(access_trap.write)
+	{
+		region_accesses[region - regions].writes ++;
+	}
+	else
+	{
+		region_accesses[region - regions].reads ++;
+	}
+
+	if(NULL != region->hooks)
+	{
+		alias = (const uint32_t*)host_sim_alias((volatile void*)(region->base + access_trap.offset));
+
+		if(!access_trap.write)
+		{
+			if(NULL != region->hooks->after_read)
+			{
+				region->hooks->after_read(region->context, access_trap.offset);
+			}
+		}
+		else if(NULL != region->hooks->after_write)
+		{
+			/** The accessed word is always given (A write of ones to a W1C register does not change it)*/
+			for(word = INIT_VAL; access_trap.words > word; word ++)
+			{
+				if((INIT_VAL == word) || (access_trap.snapshot[word] != alias[word]))
+				{
+					region->hooks->after_write(region->context, access_trap.offset + (word * sizeof(uint32_t)), access_trap.snapshot[word], alias[word]);
+				}
+			}
+		}
+	}
+
+	if(!access_trap.masked)
+	{
+		sigdelset(&thread_context->uc_sigmask, INTERRUPT_SIGNAL);
+	}
+
+	pthread_mutex_unlock(&sim_lock);
+}
+
+/** This function runs the timers, it is the clock thread*/
+static void* host_sim_clock(void* parameters)
+{
+	/** Expired timer*/
+	host_sim_timer_t* timer;
+	/** Time of the simulator*/
+	uint64_t now;
+	/** Due time of the first timer*/
+	struct timespec due;
+
+	(void)parameters;
+
+	pthread_mutex_lock(&sim_lock);
+
+	for(;;)
+	{
+		while((NULL != timers) && (timers->due <= (now = host_sim_now())))
+		{
+			timer = timers;
+			if(max_delay < (now - timer->due))
+			{
+				max_delay = now - timer->due;
+			}
+			timers = timer->next;
+			timer->armed = INIT_VAL;
+			timer->expired(timer->context);
+		}
+
+		if(NULL == timers)
+		{
+			pthread_cond_wait(&clock_changed, &sim_lock);
+		}
+		else
+		{
+			due.tv_sec = start_time.tv_sec + (time_t)(timers->due / HOST_SIM_NS_PER_S);
+			due.tv_nsec = start_time.tv_nsec + (long)(timers->due % HOST_SIM_NS_PER_S);
+			if((long)HOST_SIM_NS_PER_S <= due.tv_nsec)
+			{
+				due.tv_sec ++;
+				due.tv_nsec -= (long)HOST_SIM_NS_PER_S;
+			}
+			pthread_cond_timedwait(&clock_changed, &sim_lock, &due);
+		}
+	}
+
+	return NULL;
+}
+
+/** This function starts the simulator before the application*/
+__attribute__((constructor)) static void host_sim_start(void)
+{
+	/** Handlers of the traps*/
+	struct sigaction action;
+	/** Attributes of the clock condition*/
+	pthread_condattr_t attributes;
+	/** Signals blocked in the clock thread*/
+	sigset_t blocked;
+	/** Signal mask of the calling thread*/
+	sigset_t previous;
+
+	page_size = (size_t)sysconf(_SC_PAGESIZE);
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+	host_sim_memory_create(&peripheral_memory, "host_peripherals", sizeof(host_peripherals_t), &host_peripherals, MAP_FIXED);
+	host_sim_memory_create(&core_memory, "host_core", HOST_SIM_CORE_SIZE, (void*)HOST_SIM_CORE_BASE, MAP_FIXED_NOREPLACE);
+
+	memset(&action, INIT_VAL, sizeof(action));
+	action.sa_sigaction = host_sim_fault_handler;
+	action.sa_flags = SA_SIGINFO;
+	sigemptyset(&action.sa_mask);
+	sigaddset(&action.sa_mask, INTERRUPT_SIGNAL);
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = host_sim_trap_handler;
+	sigaction(SIGTRAP, &action, NULL);
+
+	pthread_condattr_init(&attributes);
+	pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+	pthread_cond_init(&clock_changed, &attributes);
+	pthread_condattr_destroy(&attributes);
+
+	/** The models map their registers and set their reset values*/
+	host_system_init();
+	host_can_init();
+	host_adc_init();
+	host_gpio_init();
+	host_lpspi_init();
+
+	/** The clock thread never runs the handlers of the application*/
+	sigfillset(&blocked);
+	pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+	if(INIT_VAL != pthread_create(&clock_thread, NULL, host_sim_clock, NULL))
+	{
+		host_sim_fail("clock thread can not be created");
+	}
+	pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+/** This function maps the registers of a peripheral*/
+void host_sim_map(volatile void* registers, size_t size, host_sim_trap_t trap, const host_sim_hooks_t* hooks, void* context)
+{
+	/** Peripheral to be mapped*/
+	host_sim_region_t* region;
+
+	if(MAX_REGIONS <= region_count)
+	{
+		host_sim_fail("too many peripherals");
+	}
+
+	region = &regions[region_count];
+	region->base = (uintptr_t)registers;
+	region->size = (size + page_size - 1) & ~(page_size - 1);
+	region->trap = trap;
+	region->hooks = hooks;
+	region->context = context;
+
+	if((NULL == host_sim_memory(region->base)) || (region->base & (page_size - 1)))
+	{
+		host_sim_fail("peripheral is not alone in its pages");
+	}
+
+	mprotect((void*)region->base, region->size, host_sim_protection(trap));
+	region_count ++;
+}
+
+/** This function gets the registers of a peripheral as the models change them*/
+void* host_sim_alias(volatile void* registers)
+{
+	/** Address of the registers*/
+	uintptr_t address = (uintptr_t)registers;
+	/** Memory of the registers*/
+	const host_sim_memory_t* memory = host_sim_memory(address);
+
+	if(NULL == memory)
+	{
+		host_sim_fail("registers are not simulated");
+	}
+
+	return (void*)(memory->alias + (address - memory->view));
+}
+
+/** This function gets the trapped accesses of a peripheral*/
+void host_sim_get_accesses(volatile void* registers, host_sim_accesses_t* accesses)
+{
+	/** Counter for the peripherals*/
+	uint32_t region;
+
+	pthread_mutex_lock(&sim_lock);
+	for(region = INIT_VAL; region_count > region; region ++)
+	{
+		if((uintptr_t)registers == regions[region].base)
+		{
+			*accesses = region_accesses[region];
+		}
+	}
+	pthread_mutex_unlock(&sim_lock);
+}
+
+/** This function gets the time of the simulator*/
+uint64_t host_sim_now(void)
+{
+	/** Time of the host*/
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)(now.tv_sec - start_time.tv_sec) * HOST_SIM_NS_PER_S) + (uint64_t)now.tv_nsec - (uint64_t)start_time.tv_nsec;
+}
+
+/** This function gets the longest delay of a timer*/
+uint64_t host_sim_get_max_delay(void)
+{
+	return max_delay;
+}
+
+/** This function prepares a timer*/
+void host_sim_timer_init(host_sim_timer_t* timer, void (*expired)(void* context), void* context)
+{
+	timer->next = NULL;
+	timer->expired = expired;
+	timer->context = context;
+	timer->due = INIT_VAL;
+	timer->armed = INIT_VAL;
+}
+
+/** This function arms a timer*/
+void host_sim_timer_start(host_sim_timer_t* timer, uint64_t due)
+{
+	/** Link to the place of the timer*/
+	host_sim_timer_t** link = &timers;
+
+	host_sim_timer_stop(timer);
+
+	while((NULL != *link) && ((*link)->due <= due))
+	{
+		link = &(*link)->next;
+	}
+
+	timer->due = due;
+	timer->next = *link;
+	timer->armed = FLAG_SET;
+	*link = timer;
+
+	/** The clock thread waits for the first timer*/
+	if(timers == timer)
+	{
+		pthread_cond_signal(&clock_changed);
+	}
+}
+
+/** This function disarms a timer*/
+void host_sim_timer_stop(host_sim_timer_t* timer)
+{
+	/** Link to the timer*/
+	host_sim_timer_t** link = &timers;
+
+	if(timer->armed)
+	{
+		while(timer != *link)
+		{
+			link = &(*link)->next;
+		}
+
+		*link = timer->next;
+		timer->next = NULL;
+		timer->armed = INIT_VAL;
+	}
+}
+
+/** This function ends the simulator*/
+void host_sim_exit(int status)
+{
+	fflush(stdout);
+	fflush(stderr);
+	_exit(status);
+}
+
+/** Assertion of FreeRTOS (configASSERT), the simulator ends*/
+void vAssertCalled(const char* file, unsigned long line)
+{
+	fprintf(stderr, "host_sim: assertion failed at %s:%lu\n", file, line);
+	host_sim_exit(EXIT_FAILURE);
+}
+
+/** The idle task waits for the next interruption, as the WFI of the target*/
+void vApplicationIdleHook(void)
+{
+	host_cpu_wait_for_interrupt();
+}
+
+/** The heap of FreeRTOS has no room, the simulator ends*/
+void vApplicationMallocFailedHook(void)
+{
+	host_sim_fail("FreeRTOS heap is full");
+}
@@ -0,0 +1,347 @@
+/*!
+ 	 \file host_sim.h
+
+ 	 \brief This is the header file of the host simulator of the HEMI
+ 	 	 	 application. The peripherals of host_peripherals, and the core
+ 	 	 	 peripherals at their real address, are in shared memory that the
+ 	 	 	 application sees protected: each access to a simulated register
+ 	 	 	 is trapped, done, and then given to the model of its peripheral.
+ 	 	 	 The models change their registers through a second mapping of the
+ 	 	 	 same memory, and their events run in the clock thread at the time
+ 	 	 	 of the host.
+
+ 	 \note The trap steps the access with the trap flag of the x86-64, so the
+ 	 	 	 simulator only runs on Linux x86-64. Every hook and every timer
+ 	 	 	 runs with the lock of the simulator taken.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "S32K144.h"
+#include "host_cpu.h"
+
+/** Defines the ns in a second*/
+#define HOST_SIM_NS_PER_S				(1000000000ULL)
+/** Defines the ns in a ms*/
+#define HOST_SIM_NS_PER_MS				(1000000ULL)
+/** Defines the ns in a us*/
+#define HOST_SIM_NS_PER_US				(1000ULL)
+
+/** Defines the base of the core peripherals (SCS and DWT of the Cortex-M4)*/
+#define HOST_SIM_CORE_BASE				(0xE0000000UL)
+/** Defines the size of the core peripherals that are simulated*/
+#define HOST_SIM_CORE_SIZE				(0x10000UL)
+/** Defines the DWT of the core*/
+#define HOST_SIM_DWT					((volatile void*)0xE0001000UL)
+/** Defines the system control space of the core (SCB, SysTick and NVIC)*/
+#define HOST_SIM_SCS					((volatile void*)0xE000E000UL)
+
+/** Sets a read only register through the alias of its peripheral (The models set what the application reads)*/
+#define HOST_SIM_SET(reg, value)		(*(uint32_t*)&(reg) = (uint32_t)(value))
+
+/** Defines the bits of the data of a CAN frame*/
+#define HOST_CAN_DATA_BYTES				(8)
+
+/*!
+ 	 \brief Accesses of a peripheral that are trapped.
+ */
+typedef enum
+{
+	host_sim_plain,			/*!< Plain memory, no access is trapped*/
+	host_sim_trap_writes,	/*!< The writes are trapped, the reads are plain*/
+	host_sim_trap_accesses	/*!< The reads and the writes are trapped*/
+}host_sim_trap_t;
+
+/*!
+ 	 \brief Hooks of the model of a peripheral, the offsets are of the accessed word.
+ */
+typedef struct
+{
+	void (*before_read)(void* context, uint32_t offset);									/*!< Updates a word before it is read*/
+	void (*after_read)(void* context, uint32_t offset);									/*!< A word was read*/
+	void (*after_write)(void* context, uint32_t offset, uint32_t old_value, uint32_t value);	/*!< A word was written*/
+}host_sim_hooks_t;
+
+/*!
+ 	 \brief Trapped accesses of a peripheral.
+ */
+typedef struct
+{
+	uint32_t reads;		/*!< Words read (Only counted with host_sim_trap_accesses)*/
+	uint32_t writes;	/*!< Words written*/
+}host_sim_accesses_t;
+
+/*!
+ 	 \brief Timer of the simulator, its function runs in the clock thread.
+ */
+typedef struct host_sim_timer
+{
+	struct host_sim_timer* next;	/*!< Next armed timer, by due time*/
+	void (*expired)(void* context);	/*!< Function of the timer*/
+	void* context;					/*!< Parameter of the function*/
+	uint64_t due;					/*!< Due time, in ns*/
+	uint8_t armed;					/*!< Indicates if it is armed*/
+}host_sim_timer_t;
+
+/*!
+ 	 \brief Frame of the CAN bus.
+ */
+typedef struct
+{
+	uint16_t ID;						/*!< Standard ID*/
+	uint8_t DLC;						/*!< Data length*/
+	uint8_t data[HOST_CAN_DATA_BYTES];	/*!< Data, in bus order*/
+	uint64_t time;						/*!< End of the frame on the bus, in ns*/
+}host_can_frame_t;
+
+/*!
+ 	 \brief Events of the CAN bus given to the observer.
+ */
+typedef enum
+{
+	host_can_sent,		/*!< A frame of the application was sent*/
+	host_can_received,	/*!< An injected frame was stored by the application*/
+	host_can_overrun,	/*!< An injected frame was stored over an unread one*/
+	host_can_filtered,	/*!< An injected frame was not accepted by the filters*/
+	host_can_lost		/*!< An injected frame was accepted, but there was no room for it*/
+}host_can_event_t;
+
+/*!
+ 	 \brief Statistics of a CAN bus.
+ */
+typedef struct
+{
+	uint32_t sent;			/*!< Frames sent by the application*/
+	uint32_t received;		/*!< Injected frames stored*/
+	uint32_t overruns;		/*!< Injected frames stored over an unread one*/
+	uint32_t filtered;		/*!< Injected frames not accepted*/
+	uint32_t lost;			/*!< Injected frames without room*/
+	uint32_t discarded;		/*!< Frames of the Rx FIFO released without being read*/
+	uint64_t busy_time;		/*!< Time of the bus with a frame, in ns*/
+}host_can_stats_t;
+
+/** Observer of a CAN bus*/
+typedef void (*host_can_observer_t)(uint8_t instance, host_can_event_t event, const host_can_frame_t* frame);
+/** Analog input of an ADC channel (12 bits)*/
+typedef uint16_t (*host_adc_input_t)(uint8_t instance, uint8_t channel);
+/** Observer of the outputs of a GPIO port*/
+typedef void (*host_gpio_observer_t)(uint8_t port, uint32_t old_output, uint32_t output);
+
+/*!
+ 	 \brief This function maps the registers of a peripheral in the simulator.
+
+ 	 \param[in] registers Registers of the peripheral, as seen by the application.
+ 	 \param[in] size Size of the registers.
+ 	 \param[in] trap Accesses that are trapped.
+ 	 \param[in] hooks Hooks of the model (NULL for plain memory).
+ 	 \param[in] context Parameter of the hooks.
+
+ 	 \return void.
+ */
+void host_sim_map(volatile void* registers, size_t size, host_sim_trap_t trap, const host_sim_hooks_t* hooks, void* context);
+
+/*!
+ 	 \brief This function gets the registers of a peripheral as the models change them.
+
+ 	 \param[in] registers Registers of the peripheral, as seen by the application.
+
+ 	 \return Registers that can be changed without a trap.
+ */
+void* host_sim_alias(volatile void* registers);
+
+/*!
+ 	 \brief This function gets the trapped accesses of a peripheral since the simulator
+ 	 	 	 started, compare two calls to count the accesses of a function.
+
+ 	 \param[in] registers Registers of the peripheral, as given to host_sim_map.
+ 	 \param[out] accesses Accesses of the application to the peripheral.
+
+ 	 \return void.
+ */
+void host_sim_get_accesses(volatile void* registers, host_sim_accesses_t* accesses);
+
+/*!
+ 	 \brief This function gets the time of the simulator.
+
+ 	 \return ns since the simulator started.
+ */
+uint64_t host_sim_now(void);
+
+/*!
+ 	 \brief This function gets the longest delay of a timer since the simulator
+ 	 	 	 started, it shows how long the host stopped the simulator.
+
+ 	 \return Longest delay, in ns.
+ */
+uint64_t host_sim_get_max_delay(void);
+
+/*!
+ 	 \brief This function prepares a timer.
+
+ 	 \param[out] timer Timer to be prepared.
+ 	 \param[in] expired Function of the timer.
+ 	 \param[in] context Parameter of the function.
+
+ 	 \return void.
+ */
+void host_sim_timer_init(host_sim_timer_t* timer, void (*expired)(void* context), void* context);
+
+/*!
+ 	 \brief This function arms a timer, or moves it if it is armed.
+
+ 	 \param[in] timer Timer to be armed.
+ 	 \param[in] due Due time, in ns.
+
+ 	 \return void.
+ */
+void host_sim_timer_start(host_sim_timer_t* timer, uint64_t due);
+
+/*!
+ 	 \brief This function disarms a timer.
+
+ 	 \param[in] timer Timer to be disarmed.
+
+ 	 \return void.
+ */
+void host_sim_timer_stop(host_sim_timer_t* timer);
+
+/*!
+ 	 \brief This function ends the simulator.
+
+ 	 \param[in] status Exit status of the process.
+
+ 	 \return void.
+ */
+void host_sim_exit(int status);
+
+/*!
+ 	 \brief These functions initialize the models, they map their registers.
+
+ 	 \return void.
+ */
+void host_system_init(void);
+void host_can_init(void);
+void host_adc_init(void);
+void host_gpio_init(void);
+void host_lpspi_init(void);
+
+/*!
+ 	 \brief This function gets the core clock of the SCG configuration.
+
+ 	 \return Frequency of the core clock, in Hz.
+ */
+uint32_t host_system_core_clock(void);
+
+/*!
+ 	 \brief This function sets the observer of the CAN buses.
+
+ 	 \param[in] observer Observer of the buses.
+
+ 	 \return void.
+ */
+void host_can_set_observer(host_can_observer_t observer);
+
+/*!
+ 	 \brief This function sends a frame of another node to a CAN bus.
+
+ 	 \param[in] instance CAN of the bus.
+ 	 \param[in] frame Frame to be sent (time is ignored).
+
+ 	 \return 1 if the frame was queued, 0 if the queue of the node is full.
+ */
+uint8_t host_can_inject(uint8_t instance, const host_can_frame_t* frame);
+
+/*!
+ 	 \brief This function gets the statistics of a CAN bus.
+
+ 	 \param[in] instance CAN of the bus.
+ 	 \param[out] stats Statistics of the bus.
+
+ 	 \return void.
+ */
+void host_can_get_stats(uint8_t instance, host_can_stats_t* stats);
+
+/*!
+ 	 \brief This function sets the analog inputs of the ADCs.
+
+ 	 \param[in] input Function that gives the input of a channel.
+
+ 	 \return void.
+ */
+void host_adc_set_input(host_adc_input_t input);
+
+/*!
+ 	 \brief This function gets the conversions of an ADC.
+
+ 	 \param[in] instance ADC.
+
+ 	 \return Conversions done.
+ */
+uint32_t host_adc_get_conversions(uint8_t instance);
+
+/*!
+ 	 \brief This function drives an input pin.
+
+ 	 \param[in] port Port of the pin (0 for PORTA).
+ 	 \param[in] pin Pin of the port.
+ 	 \param[in] level Level of the pin.
+
+ 	 \return void.
+ */
+void host_gpio_set_input(uint8_t port, uint8_t pin, uint8_t level);
+
+/*!
+ 	 \brief This function sets the observer of the GPIO outputs.
+
+ 	 \param[in] observer Observer of the outputs.
+
+ 	 \return void.
+ */
+void host_gpio_set_observer(host_gpio_observer_t observer);
+
+/*!
+ 	 \brief This function sets the flags that the SBC (MC33903, on LPSPI1) answers to
+ 	 	 	 the read of a status register.
+
+ 	 \param[in] command Read command of the register (0xDF80, 0xE180 or 0xE380).
+ 	 \param[in] flags Flags of the register.
+
+ 	 \return void.
+ */
+void host_lpspi_set_sbc_flags(uint16_t command, uint16_t flags);
+
+/*!
+ 	 \brief This function gets the watchdog refreshes received by the SBC.
+
+ 	 \return Watchdog refreshes.
+ */
+uint32_t host_lpspi_get_sbc_refreshes(void);
+
+/*!
+ 	 \brief This function starts the scenario, it is called when the application
+ 	 	 	 starts the SysTick (The scheduler is starting).
+
+ 	 \return void.
+ */
+void host_scenario_start(void);
+
+/*!
+ 	 \brief This function ends the scenario because the application requested a
+ 	 	 	 reset of the core.
+
+ 	 \return void.
+ */
+void host_scenario_reset(void);
+
+#endif /* HOST_SIM_H_ */
@@ -0,0 +1,434 @@
+/*!
+ 	 \file host_system.c
+
+ 	 \brief This is the source file of the system models of the host simulator:
+ 	 	 	 the clocks of the SCG, the reset values of the PCC, SMC and RCM,
+ 	 	 	 and the core peripherals (SysTick, NVIC, SCB and the cycle counter
+ 	 	 	 of the DWT). The SysTick and the cycle counter count the time of
+ 	 	 	 the host at the core clock of the SCG configuration.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include <stdio.h>
+
+#include "host_sim.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the flag as set*/
+#define FLAG_SET					(1)
+/** Defines the crystal of the SOSC (EVB)*/
+#define SOSC_HZ						(8000000UL)
+/** Defines the SIRC clock*/
+#define SIRC_HZ						(8000000UL)
+/** Defines the FIRC clock*/
+#define FIRC_HZ						(48000000UL)
+/** Defines the offset of the PLL multiplier*/
+#define SPLL_MULT_OFFSET			(16UL)
+/** Defines the divider of the VCO of the PLL*/
+#define SPLL_VCO_DIVIDER			(2UL)
+/** Defines the system clock sources of SCG_CSR_SCS*/
+#define SCS_SOSC					(1)
+#define SCS_SIRC					(2)
+#define SCS_FIRC					(3)
+#define SCS_SPLL					(6)
+/** Defines the enable bit of the clock source control registers*/
+#define SCG_SOURCE_EN				(0x1UL)
+/** Defines the valid bit of the clock source control registers*/
+#define SCG_SOURCE_VLD				(0x1000000UL)
+/** Defines the reset value of the FIRC control (FIRC enabled and valid)*/
+#define SCG_FIRCCSR_RESET			(0x01000001UL)
+/** Defines the reset value of the clock control (FIRC as system clock)*/
+#define SCG_RCCR_RESET				(0x03000001UL)
+/** Defines the mask of the fields of the RCCR that are reported in the CSR*/
+#define SCG_RCCR_FIELDS				(0x0F0F00FFUL)
+/** Defines the power mode status of the RUN mode*/
+#define SMC_PMSTAT_RUN				(0x01)
+/** Defines the key of the writes to the AIRCR*/
+#define AIRCR_KEY					(0x05FAUL)
+/** Defines the CPUID of the Cortex-M4 r0p1*/
+#define CPUID_CORTEX_M4				(0x410FC241UL)
+
+/** Defines the offsets in the SCS page*/
+#define SCS_SYST_CSR				(0x010)
+#define SCS_SYST_RVR				(0x014)
+#define SCS_SYST_CVR				(0x018)
+#define SCS_NVIC_ISER				(0x100)
+#define SCS_NVIC_ICER				(0x180)
+#define SCS_NVIC_ISPR				(0x200)
+#define SCS_NVIC_ICPR				(0x280)
+#define SCS_NVIC_IABR				(0x300)
+#define SCS_NVIC_IP					(0x400)
+#define SCS_NVIC_IP_END				(0x4F0)
+#define SCS_CPUID					(0xD00)
+#define SCS_AIRCR					(0xD0C)
+#define SCS_SHPR1					(0xD18)
+#define SCS_SHPR3					(0xD20)
+/** Defines the offsets in the DWT page*/
+#define DWT_OFFSET_CTRL				(0x000)
+#define DWT_OFFSET_CYCCNT			(0x004)
+/** Defines the cycle counter enable bit of the DWT*/
+#define DWT_CYCCNTENA				(0x1UL)
+/** Defines the mask of the offset of a word in its group of NVIC registers*/
+#define NVIC_WORD_MASK				(0x7FUL)
+/** Defines the IRQs of a byte of the NVIC registers*/
+#define IRQS_PER_BYTE				(8)
+/** Defines the bits of a word*/
+#define BITS_PER_WORD				(32)
+/** Defines the bytes of a word*/
+#define BYTES_PER_WORD				(4)
+/** Defines the first exception of the SHPR1*/
+#define SHPR_FIRST_EXCEPTION		(4)
+/** Defines the shift of the priorities of the NVIC (4 bits)*/
+#define PRIORITY_SHIFT				(4)
+
+/*!
+ 	 \brief State of the SysTick.
+ */
+typedef struct
+{
+	host_sim_timer_t timer;	/*!< Timer of the tick interruption*/
+	uint64_t start;			/*!< Time the counter was reloaded, in ns*/
+	uint64_t ticks;			/*!< Periods since the counter was reloaded*/
+	uint8_t started;		/*!< Indicates if the scheduler started the SysTick once*/
+}host_systick_t;
+
+/*!
+ 	 \brief State of the cycle counter.
+ */
+typedef struct
+{
+	uint32_t count;		/*!< Count at the start time*/
+	uint64_t start;		/*!< Time the count was taken, in ns*/
+}host_cyccnt_t;
+
+/** Registers of the SCG*/
+static SCG_Type* scg;
+/** SCS page of the core*/
+static volatile uint32_t* scs;
+/** DWT page of the core*/
+static volatile uint32_t* dwt;
+/** State of the SysTick*/
+static host_systick_t systick;
+/** State of the cycle counter*/
+static host_cyccnt_t cyccnt;
+
+/** This function gets the core cycles in a time*/
+static uint64_t host_system_cycles(uint64_t time)
+{
+	/** Core clock*/
+	uint64_t frequency = host_system_core_clock();
+
+	return ((time / HOST_SIM_NS_PER_S) * frequency) + (((time % HOST_SIM_NS_PER_S) * frequency) / HOST_SIM_NS_PER_S);
+}
+
+/** This function gets the time of some core cycles*/
+static uint64_t host_system_time(uint64_t cycles)
+{
+	/** Core clock*/
+	uint64_t frequency = host_system_core_clock();
+
+	return ((cycles / frequency) * HOST_SIM_NS_PER_S) + (((cycles % frequency) * HOST_SIM_NS_PER_S) / frequency);
+}
+
+/** This function gets the period of the SysTick in core cycles*/
+static uint64_t host_systick_period(void)
+{
+	return (uint64_t)scs[SCS_SYST_RVR / BYTES_PER_WORD] + 1ULL;
+}
+
+/** This function arms the timer of the next tick*/
+static void host_systick_arm(void)
+{
+	host_sim_timer_start(&systick.timer, systick.start + host_system_time((systick.ticks + 1ULL) * host_systick_period()));
+}
+
+/** Timer of the SysTick, it pends the tick interruption*/
+static void host_systick_expired(void* context)
+{
+	(void)context;
+
+	systick.ticks ++;
+	host_cpu_set_pending(HOST_CPU_SYSTICK_IRQ);
+	host_systick_arm();
+}
+
+/** This function reloads the SysTick counter, and arms the tick if it is enabled*/
+static void host_systick_reload(void)
+{
+	/** Control of the SysTick*/
+	uint32_t control = scs[SCS_SYST_CSR / BYTES_PER_WORD];
+
+	systick.start = host_sim_now();
+	systick.ticks = INIT_VAL;
+
+	if((control & S32_SysTick_CSR_ENABLE_MASK) && (control & S32_SysTick_CSR_TICKINT_MASK))
+	{
+		host_systick_arm();
+	}
+	else
+	{
+		host_sim_timer_stop(&systick.timer);
+	}
+}
+
+/** This function gets the count of the cycle counter*/
+static uint32_t host_cyccnt_read(void)
+{
+	/** Count of the counter*/
+	uint32_t count = cyccnt.count;
+
+	if(dwt[DWT_OFFSET_CTRL / BYTES_PER_WORD] & DWT_CYCCNTENA)
+	{
+		count += (uint32_t)host_system_cycles(host_sim_now() - cyccnt.start);
+	}
+
+	return count;
+}
+
+/** This function writes the NVIC bits of a word to the port*/
+static void host_nvic_write(uint32_t first_irq, uint32_t bits, uint32_t offset)
+{
+	/** Counter for the bits*/
+	uint32_t bit;
+	/** IRQ of a bit*/
+	int32_t irq;
+
+	for(bit = INIT_VAL; BITS_PER_WORD > bit; bit ++)
+	{
+		if(bits & (1UL << bit))
+		{
+			irq = (int32_t)(first_irq + bit);
+
+			if(SCS_NVIC_ICER > offset)
+			{
+				host_cpu_enable_irq(irq, FLAG_SET);
+			}
+			else if(SCS_NVIC_ISPR > offset)
+			{
+				host_cpu_enable_irq(irq, INIT_VAL);
+			}
+			else if(SCS_NVIC_ICPR > offset)
+			{
+				host_cpu_set_pending(irq);
+			}
+			else
+			{
+				host_cpu_clear_pending(irq);
+			}
+		}
+	}
+}
+
+/** The SysTick counter and the cycle counter are computed before they are read*/
+static void host_scs_before_read(void* context, uint32_t offset)
+{
+	/** Period of the SysTick*/
+	uint64_t period;
+
+	(void)context;
+
+	if(SCS_SYST_CVR == offset)
+	{
+		period = host_systick_period();
+		scs[SCS_SYST_CVR / BYTES_PER_WORD] = (uint32_t)((period - 1ULL) - (host_system_cycles(host_sim_now() - systick.start) % period));
+	}
+}
+
+/** Writes to the SysTick, the NVIC and the SCB*/
+static void host_scs_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	/** Counter for the bytes*/
+	uint32_t byte;
+	/** Offset of the word in its group of NVIC registers*/
+	uint32_t word;
+	/** Enabled bits of the word*/
+	volatile uint32_t* enabled;
+
+	(void)context;
+
+	if((SCS_SYST_CSR == offset) || (SCS_SYST_RVR == offset) || (SCS_SYST_CVR == offset))
+	{
+		/** A write to the counter clears it, the next cycle reloads it*/
+		scs[SCS_SYST_CVR / BYTES_PER_WORD] = INIT_VAL;
+		host_systick_reload();
+
+		if((SCS_SYST_CSR == offset) && (value & S32_SysTick_CSR_TICKINT_MASK) && !systick.started)
+		{
+			systick.started = FLAG_SET;
+			host_scenario_start();
+		}
+	}
+	else if((SCS_NVIC_ISER <= offset) && (SCS_NVIC_IABR > offset))
+	{
+		word = offset & NVIC_WORD_MASK;
+		host_nvic_write(word * IRQS_PER_BYTE, value, offset & ~NVIC_WORD_MASK);
+
+		/** The set and clear registers read back the enabled bits, the pending ones read as 0*/
+		enabled = &scs[(SCS_NVIC_ISER + word) / BYTES_PER_WORD];
+		if(SCS_NVIC_ICER > offset)
+		{
+			*enabled = old_value | value;
+		}
+		else if(SCS_NVIC_ISPR > offset)
+		{
+			*enabled &= ~value;
+		}
+		scs[(SCS_NVIC_ICER + word) / BYTES_PER_WORD] = *enabled;
+		scs[(SCS_NVIC_ISPR + word) / BYTES_PER_WORD] = INIT_VAL;
+		scs[(SCS_NVIC_ICPR + word) / BYTES_PER_WORD] = INIT_VAL;
+	}
+	else if((SCS_NVIC_IP <= offset) && (SCS_NVIC_IP_END > offset))
+	{
+		for(byte = INIT_VAL; BYTES_PER_WORD > byte; byte ++)
+		{
+			host_cpu_set_priority((int32_t)(offset - SCS_NVIC_IP + byte), (uint8_t)(((value >> (byte * 8U)) & 0xFFUL) >> PRIORITY_SHIFT));
+		}
+	}
+	else if((SCS_SHPR1 <= offset) && (SCS_SHPR3 >= offset))
+	{
+		for(byte = INIT_VAL; BYTES_PER_WORD > byte; byte ++)
+		{
+			host_cpu_set_priority((int32_t)(SHPR_FIRST_EXCEPTION + offset - SCS_SHPR1 + byte) - HOST_CPU_EXCEPTIONS, (uint8_t)(((value >> (byte * 8U)) & 0xFFUL) >> PRIORITY_SHIFT));
+		}
+	}
+	else if(SCS_AIRCR == offset)
+	{
+		/** A reset request ends the simulator, the scenario reports what ran until then*/
+		if(((AIRCR_KEY << 16) == (value & S32_SCB_AIRCR_VECTKEY_MASK)) && (value & S32_SCB_AIRCR_SYSRESETREQ_MASK))
+		{
+			host_scenario_reset();
+		}
+		scs[SCS_AIRCR / BYTES_PER_WORD] = old_value;
+	}
+	else if(SCS_CPUID == offset)
+	{
+		scs[SCS_CPUID / BYTES_PER_WORD] = CPUID_CORTEX_M4;
+	}
+}
+
+/** The cycle counter is computed before it is read*/
+static void host_dwt_before_read(void* context, uint32_t offset)
+{
+	(void)context;
+
+	if(DWT_OFFSET_CYCCNT == offset)
+	{
+		dwt[DWT_OFFSET_CYCCNT / BYTES_PER_WORD] = host_cyccnt_read();
+	}
+}
+
+/** Writes to the DWT, the cycle counter starts from the written count*/
+static void host_dwt_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	(void)context;
+
+	if(DWT_OFFSET_CYCCNT == offset)
+	{
+		cyccnt.count = value;
+		cyccnt.start = host_sim_now();
+	}
+	else if((DWT_OFFSET_CTRL == offset) && ((old_value ^ value) & DWT_CYCCNTENA))
+	{
+		/** The count when it was started or stopped is kept*/
+		dwt[DWT_OFFSET_CTRL / BYTES_PER_WORD] = old_value;
+		cyccnt.count = host_cyccnt_read();
+		cyccnt.start = host_sim_now();
+		dwt[DWT_OFFSET_CTRL / BYTES_PER_WORD] = value;
+	}
+}
+
+/** Writes to the SCG, the enabled clocks are valid at once and the clock control is applied*/
+static void host_scg_after_write(void* context, uint32_t offset, uint32_t old_value, uint32_t value)
+{
+	/** Written register*/
+	volatile uint32_t* reg = (volatile uint32_t*)((uintptr_t)scg + offset);
+
+	(void)context;
+	(void)old_value;
+
+	if((offsetof(SCG_Type, SOSCCSR) == offset) || (offsetof(SCG_Type, SIRCCSR) == offset) ||
+	   (offsetof(SCG_Type, FIRCCSR) == offset) || (offsetof(SCG_Type, SPLLCSR) == offset))
+	{
+		*reg = (value & SCG_SOURCE_EN) ? (value | SCG_SOURCE_VLD) : (value & ~SCG_SOURCE_VLD);
+	}
+	else if(offsetof(SCG_Type, RCCR) == offset)
+	{
+		HOST_SIM_SET(scg->CSR, value & SCG_RCCR_FIELDS);
+	}
+}
+
+/** Hooks of the SCS page*/
+static const host_sim_hooks_t scs_hooks = {host_scs_before_read, NULL, host_scs_after_write};
+/** Hooks of the DWT page*/
+static const host_sim_hooks_t dwt_hooks = {host_dwt_before_read, NULL, host_dwt_after_write};
+/** Hooks of the SCG*/
+static const host_sim_hooks_t scg_hooks = {NULL, NULL, host_scg_after_write};
+
+/** This function initializes the system models*/
+void host_system_init(void)
+{
+	/** PCC of the simulator*/
+	PCC_Type* pcc = host_sim_alias(PCC);
+	/** Counter for the PCC registers*/
+	uint32_t index;
+
+	scg = host_sim_alias(SCG);
+	scs = host_sim_alias(HOST_SIM_SCS);
+	dwt = host_sim_alias(HOST_SIM_DWT);
+
+	/** Reset values, the core runs with the FIRC*/
+	scg->FIRCCSR = SCG_FIRCCSR_RESET;
+	scg->RCCR = SCG_RCCR_RESET;
+	HOST_SIM_SET(scg->CSR, SCG_RCCR_RESET);
+	for(index = INIT_VAL; PCC_PCCn_COUNT > index; index ++)
+	{
+		pcc->PCCn[index] = PCC_PCCn_PR_MASK;
+	}
+	HOST_SIM_SET(((SMC_Type*)host_sim_alias(SMC))->PMSTAT, SMC_PMSTAT_RUN);
+	HOST_SIM_SET(((RCM_Type*)host_sim_alias(RCM))->SRS, RCM_SRS_POR_MASK);
+	scs[SCS_CPUID / BYTES_PER_WORD] = CPUID_CORTEX_M4;
+
+	host_sim_timer_init(&systick.timer, host_systick_expired, NULL);
+
+	host_sim_map(SCG, sizeof(SCG_Type), host_sim_trap_writes, &scg_hooks, NULL);
+	host_sim_map(HOST_SIM_SCS, HOST_PAGE_SIZE, host_sim_trap_accesses, &scs_hooks, NULL);
+	host_sim_map(HOST_SIM_DWT, HOST_PAGE_SIZE, host_sim_trap_accesses, &dwt_hooks, NULL);
+}
+
+/** This function gets the core clock of the SCG configuration*/
+uint32_t host_system_core_clock(void)
+{
+	/** Clock status*/
+	uint32_t status = scg->CSR;
+	/** Clock of the system source*/
+	uint32_t source;
+	/** Configuration of the PLL*/
+	uint32_t pll = scg->SPLLCFG;
+
+	switch((status & SCG_CSR_SCS_MASK) >> SCG_CSR_SCS_SHIFT)
+	{
+		case SCS_SOSC:
+			source = SOSC_HZ;
+			break;
+		case SCS_SIRC:
+			source = SIRC_HZ;
+			break;
+		case SCS_SPLL:
+			source = (uint32_t)(((uint64_t)SOSC_HZ / (((pll & SCG_SPLLCFG_PREDIV_MASK) >> SCG_SPLLCFG_PREDIV_SHIFT) + 1UL)) *
+					(((pll & SCG_SPLLCFG_MULT_MASK) >> SCG_SPLLCFG_MULT_SHIFT) + SPLL_MULT_OFFSET) / SPLL_VCO_DIVIDER);
+			break;
+		case SCS_FIRC:
+		default:
+			source = FIRC_HZ;
+			break;
+	}
+
+	return source / (((status & SCG_CSR_DIVCORE_MASK) >> SCG_CSR_DIVCORE_SHIFT) + 1UL);
+}
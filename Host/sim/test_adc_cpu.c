@@ -0,0 +1,272 @@
+/*!
+ 	 \file test_adc_cpu.c
+
+ 	 \brief This is the host test of the CPU used by the ADC reading. The
+ 	 	 	 kernel runs on the host port and the ADC task reads the
+ 	 	 	 potentiometer from the ADC model, with the hardware average of
+ 	 	 	 the application, as the ADC job of rtos_driver.c does it in each
+ 	 	 	 ADC_MODE: first by polling COCO (ADC_POLLING) and then with the
+ 	 	 	 conversion complete interruption (ADC_INTERRUPT). The run time of
+ 	 	 	 the ADC task, taken from the run-time stats, and the accesses to
+ 	 	 	 ADC0 are compared for each conversion.
+
+ 	 \note The times are of the host clock, they depend on the load of the PC.
+ 	 	 	 The accesses do not. On a host with one core the polling task also
+ 	 	 	 delays the clock thread of the model, so its run time is longer
+ 	 	 	 than the conversion of the model (16.5 us with the average of 4).
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+#include "interrupt_manager.h"
+#include "ADC.h"
+#include "adc_pipeline.h"
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the value of a set flag*/
+#define FLAG_SET					(1)
+/** Defines the exit status of a passed run*/
+#define TEST_PASS					(0)
+/** Defines the exit status of a failed run*/
+#define TEST_FAIL					(1)
+/** Defines the channel of the potentiometer*/
+#define ADC_POT_CHANNEL				(12)
+/** Defines the input of the potentiometer (12 bits)*/
+#define POT_INPUT					(2048U)
+/** Defines the hardware average of the potentiometer (The one of rtos_driver.c)*/
+#define ADC_POT_HW_AVERAGE			(adc_hw_average_4)
+/** Defines the priority of the interruption (The one of the ADC of the driver)*/
+#define ADC_INTERRUPT_PRIO			(0x03)
+/** Defines the priority of the ADC task (The one of main.c)*/
+#define ADC_THREAD_PRIO				(4)
+/** Defines the ticks to wait for a conversion (The timeout of the driver)*/
+#define ADC_CONVERSION_TIMEOUT		(2)
+/** Defines the period of the readings, in ticks*/
+#define READ_PERIOD					(2)
+/** Defines the readings of each mode*/
+#define READINGS					(200U)
+/** Defines the part of the run time of the polling that the interruption must be under*/
+#define RUN_TIME_DIVIDER			(2U)
+/** Defines the most tasks of the run-time stats (The ADC task, the idle task and the timer task)*/
+#define MAX_TASKS					(4U)
+/** Defines the reads of ADC0 of a polled reading without a poll of COCO (SC1 in convertAdcChan, and R[0])*/
+#define POLLED_READS_MIN			(2U)
+
+/*!
+ 	 \brief Modes of the ADC reading.
+ */
+typedef enum
+{
+	read_polling,		/*!< Polling of COCO in the task (ADC_POLLING)*/
+	read_interrupt,		/*!< Conversion complete interruption and a notification (ADC_INTERRUPT)*/
+	read_modes			/*!< Number of modes*/
+}read_mode_t;
+
+/*!
+ 	 \brief CPU used by a mode.
+ */
+typedef struct
+{
+	uint32_t run_time;				/*!< Run time of the ADC task, in cycles of the run-time stats*/
+	uint64_t elapsed;				/*!< Time of the readings, in ns*/
+	uint32_t samples;				/*!< Samples read*/
+	uint32_t interruptions;			/*!< Interruptions of the ADC*/
+	host_sim_accesses_t accesses;	/*!< Accesses to ADC0*/
+}read_cpu_t;
+
+/** Names of the modes*/
+static const char* const mode_names[read_modes] = {"polling (before)", "interruption (now)"};
+/** CPU used by each mode*/
+static read_cpu_t cpu[read_modes];
+/** ADC task*/
+static TaskHandle_t adc_task;
+/** Sample stored by the interruption*/
+static volatile uint16_t adc_sample;
+/** Samples stored by the interruption*/
+static volatile uint32_t adc_samples = INIT_VAL;
+
+/** Interruption for the ADC conversion complete, as ADC0_ISR*/
+static void adc_isr(void)
+{
+	/** Indicates if the notification unblocked a higher priority task*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	/** Reads the result in mV (Reading it clears the COCO flag)*/
+	adc_sample = (uint16_t)read_adc_chx();
+	adc_samples ++;
+
+	vTaskNotifyGiveFromISR(adc_task, &higher_priority_task_woken);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/** Reads the ADC once, as the job of the driver with ADC_POLLING*/
+static uint32_t read_job_polling(void)
+{
+	convertAdcChan(ADC_POT_CHANNEL);
+
+	while(0 == adc_complete());
+
+	return read_adc_chx();
+}
+
+/** Reads the ADC once, as the job of the driver with ADC_INTERRUPT*/
+static uint32_t read_job_interrupt(void)
+{
+	convertAdcChan_interrupt(ADC_POT_CHANNEL);
+	ulTaskNotifyTake(pdTRUE, ADC_CONVERSION_TIMEOUT);
+
+	return adc_sample;
+}
+
+/** Gets the run time of the ADC task*/
+static uint32_t adc_task_run_time(void)
+{
+	/** State of the tasks*/
+	TaskStatus_t status[MAX_TASKS];
+	/** Number of tasks, and counter for them*/
+	UBaseType_t tasks = uxTaskGetSystemState(status, MAX_TASKS, NULL);
+	UBaseType_t index;
+
+	for(index = INIT_VAL ; tasks > index ; index ++)
+	{
+		if(adc_task == status[index].xHandle)
+		{
+			return status[index].ulRunTimeCounter;
+		}
+	}
+
+	return INIT_VAL;
+}
+
+/** Reads the ADC READINGS times in a mode, and gets the CPU that it used*/
+static void read_run(read_cpu_t* measured, uint32_t (*read_job)(void))
+{
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	/** Counter for the readings*/
+	uint32_t reading;
+	/** Accesses to ADC0 and run time before the readings*/
+	host_sim_accesses_t before;
+	uint32_t run_time;
+	/** Start of the readings*/
+	uint64_t start;
+	/** Interruptions of the ADC before the readings*/
+	uint32_t interruptions = host_cpu_get_isr_count(ADC0_IRQn);
+
+	host_sim_get_accesses(ADC0, &before);
+	run_time = adc_task_run_time();
+	start = host_sim_now();
+
+	for(reading = INIT_VAL ; READINGS > reading ; reading ++)
+	{
+		if(INIT_VAL != read_job())
+		{
+			measured->samples ++;
+		}
+		vTaskDelayUntil(&xLastWakeTime, READ_PERIOD);
+	}
+
+	measured->elapsed = host_sim_now() - start;
+	measured->run_time = adc_task_run_time() - run_time;
+	measured->interruptions = host_cpu_get_isr_count(ADC0_IRQn) - interruptions;
+	host_sim_get_accesses(ADC0, &measured->accesses);
+	measured->accesses.reads -= before.reads;
+	measured->accesses.writes -= before.writes;
+}
+
+/** This function prints the CPU used by each mode, it returns the exit status*/
+static int report(void)
+{
+	/** Counter for the modes*/
+	uint8_t index;
+	/** Run time of a reading of each mode, in us*/
+	double reading_us[read_modes];
+	/** Checks of the run*/
+	uint8_t passed = FLAG_SET;
+
+	printf("ADC task, %u readings of the potentiometer every %u ms (core clock %u Hz):\n", READINGS,
+		READ_PERIOD * (1000U / configTICK_RATE_HZ), host_system_core_clock());
+	for(index = INIT_VAL; read_modes > index; index ++)
+	{
+		reading_us[index] = (double)cpu[index].run_time * HOST_SIM_NS_PER_S / host_system_core_clock() / HOST_SIM_NS_PER_US / READINGS;
+		printf("  %-20s %3u samples, %3u interruptions, ADC0 %4u reads/%3u writes, run time %7.1f us a reading, CPU %5.2f %%\n",
+			mode_names[index], cpu[index].samples, cpu[index].interruptions, cpu[index].accesses.reads, cpu[index].accesses.writes,
+			reading_us[index], reading_us[index] * READINGS * HOST_SIM_NS_PER_US * 100.0 / (double)cpu[index].elapsed);
+	}
+	printf("Host: timers delayed up to %.1f us\n", (double)host_sim_get_max_delay() / HOST_SIM_NS_PER_US);
+
+	/** Both modes read every sample*/
+	passed &= (READINGS == cpu[read_polling].samples) && (INIT_VAL == cpu[read_polling].interruptions);
+	passed &= (INIT_VAL != cpu[read_interrupt].samples) && (cpu[read_interrupt].interruptions == adc_samples);
+	/** The task polls SC1 during the conversion, the interruption only reads R[0]*/
+	passed &= ((POLLED_READS_MIN * READINGS) < cpu[read_polling].accesses.reads);
+	passed &= (cpu[read_interrupt].interruptions == cpu[read_interrupt].accesses.reads);
+	/** The task does not run during the conversion*/
+	passed &= ((cpu[read_polling].run_time / RUN_TIME_DIVIDER) > cpu[read_interrupt].run_time);
+
+	printf("%s\n", passed ? "PASS" : "FAIL");
+
+	return passed ? TEST_PASS : TEST_FAIL;
+}
+
+/** ADC task, it reads the ADC by polling and then with the interruption*/
+static void adc_thread(void* args)
+{
+	(void)args;
+
+	read_run(&cpu[read_polling], read_job_polling);
+
+	INT_SYS_InstallHandler(ADC0_IRQn, adc_isr, (isr_t *)NULL);
+	INT_SYS_EnableIRQ(ADC0_IRQn);
+	INT_SYS_SetPriority(ADC0_IRQn, ADC_INTERRUPT_PRIO);
+	read_run(&cpu[read_interrupt], read_job_interrupt);
+
+	host_sim_exit(report());
+}
+
+/** Input of the potentiometer*/
+static uint16_t pot_input(uint8_t instance, uint8_t channel)
+{
+	(void)instance;
+	(void)channel;
+
+	return POT_INPUT;
+}
+
+/** The inputs are constant*/
+void host_scenario_start(void)
+{
+}
+
+void host_scenario_reset(void)
+{
+	host_sim_exit(TEST_FAIL);
+}
+
+int main(void)
+{
+	host_adc_set_input(pot_input);
+
+	ADC_init();
+	ADC_pipeline_set_hw_average(ADC0, ADC_POT_HW_AVERAGE);
+
+	xTaskCreate(adc_thread, "ADC", configMINIMAL_STACK_SIZE, NULL, ADC_THREAD_PRIO, &adc_task);
+
+	vTaskStartScheduler();
+
+	for(;;);
+
+	return 0;
+}
@@ -0,0 +1,218 @@
+/*!
+ 	 \file test_can_mmio.c
+
+ 	 \brief This is the host test of the accesses of the CAN driver to the
+ 	 	 	 FlexCAN. The driver runs against the CAN model of the simulator,
+ 	 	 	 which traps every access, so the reads and the writes of the
+ 	 	 	 payload copies are counted, next to the byte by byte copy that the
+ 	 	 	 driver had before. The payload is also checked in the order of the
+ 	 	 	 bus after a write and a read back. The kernel is not started.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+
+#include <stdio.h>
+
+/* The static copies of the driver are tested */
+#include "can_driver.c"
+
+/** Checks a condition, the test fails if it is false*/
+#define MMIO_CHECK(condition)		mmio_check((condition) ? FLAG_SET : INIT_VAL, #condition, __LINE__)
+
+/** Defines the value of a set flag*/
+#define FLAG_SET					(1)
+/** Defines the MB of the copies*/
+#define TEST_MB						(8U)
+/** Defines the Rx MB of the received frame*/
+#define TEST_RX_MB					(CAN_RX_MB_FIRST)
+/** Defines the ID of the received frame*/
+#define TEST_ID						(0x123U)
+/** Defines the first data word of the test payload, in the order of the bus*/
+#define TEST_WORD_0					(0x01020304UL)
+/** Defines the second data word of the test payload, in the order of the bus*/
+#define TEST_WORD_1					(0x05060708UL)
+/** Defines the bytes of a data word*/
+#define WORD_BYTES					(4U)
+/** Defines the shift of the MSB of a data word*/
+#define MSB_SHIFT					(24U)
+/** Defines the bits of a byte*/
+#define BYTE_BITS					(8U)
+
+/** Checks done and failed*/
+static uint32_t checks = INIT_VAL;
+static uint32_t failed = INIT_VAL;
+/** Accesses to CAN0 before the measured function*/
+static host_sim_accesses_t before;
+
+/** This function records the result of a check*/
+static void mmio_check(uint8_t passed, const char* condition, uint32_t line)
+{
+	checks ++;
+	if(!passed)
+	{
+		failed ++;
+		printf("test_can_mmio.c:%u: check failed: %s\n", line, condition);
+	}
+}
+
+/** Starts counting the accesses to CAN0*/
+static void count_start(void)
+{
+	host_sim_get_accesses(CAN0, &before);
+}
+
+/** Gets the accesses to CAN0 since count_start*/
+static void count_end(host_sim_accesses_t* accesses)
+{
+	/** Accesses to CAN0 after the measured function*/
+	host_sim_accesses_t after;
+
+	host_sim_get_accesses(CAN0, &after);
+	accesses->reads = after.reads - before.reads;
+	accesses->writes = after.writes - before.writes;
+}
+
+/** Reads the payload of a MB as the driver did before the word copy: the MSB of the data word is
+ 	 taken and the word is shifted in the MB for each byte*/
+static void read_mb_data_bytewise(CAN_Type* base, uint8_t mb, uint8_t* msg, uint8_t DLC)
+{
+	/** Counter for the bytes*/
+	uint8_t counter;
+
+	for(counter = INIT_VAL ; counter < DLC ; counter ++)
+	{
+		msg[counter] = (uint8_t)(base->RAMn[(mb * MSG_BUF_SIZE) + (counter / WORD_BYTES) + MSG_POS] >> MSB_SHIFT);
+		base->RAMn[(mb * MSG_BUF_SIZE) + (counter / WORD_BYTES) + MSG_POS] <<= BYTE_BITS;
+	}
+}
+
+/** Puts a received frame in a Rx MB, as the FlexCAN does*/
+static void receive_frame(uint8_t mb)
+{
+	/** Registers of CAN0 as the model changes them*/
+	CAN_Type* regs = host_sim_alias(CAN0);
+
+	regs->RAMn[(mb * MSG_BUF_SIZE) + MSG_POS] = TEST_WORD_0;
+	regs->RAMn[(mb * MSG_BUF_SIZE) + ARRAY_OFFSET_1 + MSG_POS] = TEST_WORD_1;
+	regs->RAMn[(mb * MSG_BUF_SIZE) + ID_POS] = TEST_ID << STD_ID_SHIFT;
+	regs->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ((uint32_t)RX_CODE_FULL << MB_CODE_SHIFT) | ((uint32_t)MAX_DLC << CAN_WMBn_CS_DLC_SHIFT);
+	regs->IFLAG1 |= (uint32_t)BIT_MASK << mb;
+}
+
+/** The payload is in the order of the bus in the MB, and it is read back unchanged*/
+static void test_round_trip(void)
+{
+	/** Payload of the test*/
+	static const uint8_t payload[MAX_DLC] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	/** Registers of CAN0 as the model changes them*/
+	const CAN_Type* regs = host_sim_alias(CAN0);
+	/** Payload read back*/
+	uint8_t msg[MAX_DLC];
+	/** Counter for the bytes*/
+	uint8_t byte;
+
+	CAN_write_mb_data(CAN0, TEST_MB, payload, MAX_DLC);
+	MMIO_CHECK(TEST_WORD_0 == regs->RAMn[(TEST_MB * MSG_BUF_SIZE) + MSG_POS]);
+	MMIO_CHECK(TEST_WORD_1 == regs->RAMn[(TEST_MB * MSG_BUF_SIZE) + ARRAY_OFFSET_1 + MSG_POS]);
+
+	CAN_read_mb_data(CAN0, TEST_MB, msg);
+	for(byte = INIT_VAL ; MAX_DLC > byte ; byte ++)
+	{
+		MMIO_CHECK(payload[byte] == msg[byte]);
+	}
+
+	/** The bytes after the DLC are sent as 0*/
+	CAN_write_mb_data(CAN0, TEST_MB, payload, 3U);
+	MMIO_CHECK(0x01020300UL == regs->RAMn[(TEST_MB * MSG_BUF_SIZE) + MSG_POS]);
+	MMIO_CHECK(INIT_VAL == regs->RAMn[(TEST_MB * MSG_BUF_SIZE) + ARRAY_OFFSET_1 + MSG_POS]);
+}
+
+/** The word copies take one access per data word, the byte copy a read and a read-modify-write per byte*/
+static void test_copy_accesses(void)
+{
+	/** Payload of the test*/
+	static const uint8_t payload[MAX_DLC] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+	/** Registers of CAN0 as the model changes them*/
+	const CAN_Type* regs = host_sim_alias(CAN0);
+	/** Payload read*/
+	uint8_t msg[MAX_DLC];
+	/** Accesses of each copy*/
+	host_sim_accesses_t write_words;
+	host_sim_accesses_t read_words;
+	host_sim_accesses_t read_bytes;
+
+	count_start();
+	CAN_write_mb_data(CAN0, TEST_MB, payload, MAX_DLC);
+	count_end(&write_words);
+
+	count_start();
+	CAN_read_mb_data(CAN0, TEST_MB, msg);
+	count_end(&read_words);
+
+	count_start();
+	read_mb_data_bytewise(CAN0, TEST_MB, msg, MAX_DLC);
+	count_end(&read_bytes);
+
+	printf("Accesses to the FlexCAN for an 8-byte payload (reads/writes):\n");
+	printf("  write, word copy        %2u/%2u\n", write_words.reads, write_words.writes);
+	printf("  read, word copy         %2u/%2u\n", read_words.reads, read_words.writes);
+	printf("  read, byte copy (old)   %2u/%2u\n", read_bytes.reads, read_bytes.writes);
+
+	MMIO_CHECK((INIT_VAL == write_words.reads) && (TEMP_VAR_SIZE == write_words.writes));
+	MMIO_CHECK((TEMP_VAR_SIZE == read_words.reads) && (INIT_VAL == read_words.writes));
+	MMIO_CHECK(((2U * MAX_DLC) == read_bytes.reads) && (MAX_DLC == read_bytes.writes));
+
+	/** The byte copy leaves the MB shifted out*/
+	MMIO_CHECK(INIT_VAL == regs->RAMn[(TEST_MB * MSG_BUF_SIZE) + MSG_POS]);
+}
+
+/** A frame of a Rx MB is received with MCR, CS, ID, the data words and TIMER read, and IFLAG1 and CS written*/
+static void test_receive_accesses(void)
+{
+	/** Received message*/
+	can_message_rx_config_t message = {CAN0};
+	/** Accesses of the reception*/
+	host_sim_accesses_t received;
+	/** Result of the reception*/
+	uint8_t result;
+
+	receive_frame(TEST_RX_MB);
+
+	count_start();
+	result = CAN_receive_message(&message);
+	count_end(&received);
+
+	printf("  CAN_receive_message     %2u/%2u\n", received.reads, received.writes);
+
+	MMIO_CHECK(MSG_READ == result);
+	MMIO_CHECK((TEST_ID == message.ID) && (MAX_DLC == message.DLC));
+	MMIO_CHECK((0x01U == message.msg[0]) && (0x04U == message.msg[3]) && (0x05U == message.msg[4]) && (0x08U == message.msg[7]));
+	MMIO_CHECK((6U == received.reads) && (2U == received.writes));
+}
+
+/** The kernel is not started, so the SysTick and the reset never reach the scenario*/
+void host_scenario_start(void)
+{
+}
+
+void host_scenario_reset(void)
+{
+}
+
+int main(void)
+{
+	test_round_trip();
+	test_copy_accesses();
+	test_receive_accesses();
+
+	printf("%u checks, %u failed\n", checks, failed);
+
+	return (INIT_VAL == failed) ? 0 : 1;
+}
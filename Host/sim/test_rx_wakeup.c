@@ -0,0 +1,239 @@
+/*!
+ 	 \file test_rx_wakeup.c
+
+ 	 \brief This is the host test of the wakeup of the CAN Rx task. The kernel
+ 	 	 	 runs on the host port, and the interruption of the Rx MB is
+ 	 	 	 raised at times that are not aligned with the tick. The time from
+ 	 	 	 the interruption to the callback is measured with the wakeup that
+ 	 	 	 the driver had before (A binary semaphore given with pdFALSE and
+ 	 	 	 no yield, so the task waits for the next tick) and with the one it
+ 	 	 	 has now (A task notification and portYIELD_FROM_ISR).
+
+ 	 \note The times are of the host clock, they depend on the load of the PC.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+#include "host_cpu.h"
+#include "interrupt_manager.h"
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the value of a set flag*/
+#define FLAG_SET					(1)
+/** Defines the exit status of a passed run*/
+#define TEST_PASS					(0)
+/** Defines the exit status of a failed run*/
+#define TEST_FAIL					(1)
+/** Defines the interruption of the Rx MB*/
+#define RX_IRQ						(CAN0_ORed_0_15_MB_IRQn)
+/** Defines the priority of the interruption (The one of the CAN MBs of the driver)*/
+#define RX_IRQ_PRIO					(0x03)
+/** Defines the priority of the Rx task (The one of main.c)*/
+#define RX_TASK_PRIO				(3)
+/** Defines the frames of each wakeup*/
+#define FRAMES						(200U)
+/** Defines the period of the frames, in ns (Not a multiple of the tick)*/
+#define FRAME_PERIOD_NS				(2370000ULL)
+/** Defines the first frame, after the tasks started, in ns*/
+#define FIRST_FRAME_NS				(10000000ULL)
+/** Defines the part of the average latency of the semaphore that the notification must be under*/
+#define LATENCY_DIVIDER				(2U)
+
+/*!
+ 	 \brief Wakeups of the Rx task.
+ */
+typedef enum
+{
+	wakeup_semaphore,		/*!< Binary semaphore given with pdFALSE, without yield (Before)*/
+	wakeup_notification,	/*!< Task notification with portYIELD_FROM_ISR (Now)*/
+	wakeups					/*!< Number of wakeups*/
+}wakeup_t;
+
+/*!
+ 	 \brief Latency of the callbacks.
+ */
+typedef struct
+{
+	uint64_t min;		/*!< Minimum latency, in ns*/
+	uint64_t max;		/*!< Maximum latency, in ns*/
+	uint64_t total;		/*!< Sum of the latencies, in ns*/
+	uint32_t count;		/*!< Callbacks measured*/
+	uint32_t frames;	/*!< Frames seen by the callbacks*/
+}latency_t;
+
+/** Names of the wakeups*/
+static const char* const wakeup_names[wakeups] = {"semaphore, no yield", "notification, yield"};
+/** Wakeup of the run*/
+static volatile wakeup_t wakeup = wakeup_semaphore;
+/** Semaphore of the Rx task, as the driver had it*/
+static SemaphoreHandle_t rx_semaphore;
+/** Rx task of the notification*/
+static TaskHandle_t rx_task;
+/** Time of the last interruption*/
+static volatile uint64_t irq_time;
+/** Latency of each wakeup*/
+static latency_t latency[wakeups] = {{UINT64_MAX}, {UINT64_MAX}};
+/** Interruptions run with each wakeup (Two frames raised while the host stops the simulator take
+ 	 one interruption, as the pending bit of the NVIC)*/
+static volatile uint32_t isr_count[wakeups];
+/** Timer of the frames*/
+static host_sim_timer_t frame_timer;
+/** Frames raised*/
+static uint32_t frames = INIT_VAL;
+
+/** Interruption of the Rx MB, it wakes the Rx task*/
+static void rx_isr(void)
+{
+	/** Indicates if the Rx task has a higher priority than the interrupted one*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	isr_count[wakeup] ++;
+
+	if(wakeup_semaphore == wakeup)
+	{
+		/** The wakeup of the driver before the notifications*/
+		xSemaphoreGiveFromISR(rx_semaphore, pdFALSE);
+	}
+	else
+	{
+		vTaskNotifyGiveFromISR(rx_task, &higher_priority_task_woken);
+		portYIELD_FROM_ISR(higher_priority_task_woken);
+	}
+}
+
+/** Callback of the frames of a wakeup, it adds the latency since the last interruption*/
+static void rx_callback(latency_t* measured, uint32_t frames_seen)
+{
+	/** Latency of the callback*/
+	uint64_t value = host_sim_now() - irq_time;
+
+	measured->min = (measured->min > value) ? value : measured->min;
+	measured->max = (measured->max < value) ? value : measured->max;
+	measured->total += value;
+	measured->count ++;
+	measured->frames += frames_seen;
+}
+
+/** Rx task woken by the semaphore, as the driver had it*/
+static void rx_thread_semaphore(void* args)
+{
+	(void)args;
+
+	for(;;)
+	{
+		xSemaphoreTake(rx_semaphore, portMAX_DELAY);
+		rx_callback(&latency[wakeup_semaphore], 1U);
+	}
+}
+
+/** Rx task woken by the notification, as the driver has it now*/
+static void rx_thread_notification(void* args)
+{
+	(void)args;
+
+	/** Frames of the wakeup*/
+	uint32_t frames_seen;
+
+	for(;;)
+	{
+		frames_seen = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		rx_callback(&latency[wakeup_notification], frames_seen);
+	}
+}
+
+/** This function prints the latencies, it returns the exit status*/
+static int report(void)
+{
+	/** Counter for the wakeups*/
+	uint8_t index;
+	/** Average latency of each wakeup*/
+	uint64_t average[wakeups] = {INIT_VAL};
+	/** Checks of the run*/
+	uint8_t passed = FLAG_SET;
+
+	printf("Interruption of the Rx MB to the callback (%u frames every %.2f ms):\n", FRAMES,
+		(double)FRAME_PERIOD_NS / HOST_SIM_NS_PER_MS);
+	for(index = INIT_VAL; wakeups > index; index ++)
+	{
+		if(INIT_VAL != latency[index].count)
+		{
+			average[index] = latency[index].total / latency[index].count;
+			printf("  %-20s %4u interruptions, %4u callbacks (%4u frames), min %8.1f us, avg %8.1f us, max %8.1f us\n", wakeup_names[index],
+				isr_count[index], latency[index].count, latency[index].frames, (double)latency[index].min / HOST_SIM_NS_PER_US,
+				(double)average[index] / HOST_SIM_NS_PER_US, (double)latency[index].max / HOST_SIM_NS_PER_US);
+		}
+	}
+	printf("Host: timers delayed up to %.1f us\n", (double)host_sim_get_max_delay() / HOST_SIM_NS_PER_US);
+
+	/** The count of the notification keeps every interruption while the task did not run, the binary
+	 	 semaphore loses them*/
+	passed &= (INIT_VAL != latency[wakeup_semaphore].count) && (isr_count[wakeup_notification] == latency[wakeup_notification].frames);
+	/** Without the yield the task waits for the tick, about half a tick on average*/
+	passed &= ((average[wakeup_semaphore] / LATENCY_DIVIDER) > average[wakeup_notification]);
+
+	printf("%s\n", passed ? "PASS" : "FAIL");
+
+	return passed ? TEST_PASS : TEST_FAIL;
+}
+
+/** This function raises the interruption of a frame, the semaphore is used for the first FRAMES*/
+static void frame_raise(void* context)
+{
+	(void)context;
+
+	if((wakeups * FRAMES) <= frames)
+	{
+		host_sim_exit(report());
+		return;
+	}
+
+	wakeup = (FRAMES > frames) ? wakeup_semaphore : wakeup_notification;
+	frames ++;
+
+	irq_time = host_sim_now();
+	host_cpu_set_pending(RX_IRQ);
+
+	host_sim_timer_start(&frame_timer, frame_timer.due + FRAME_PERIOD_NS);
+}
+
+/** The SysTick started, the frames start after the tasks*/
+void host_scenario_start(void)
+{
+	host_sim_timer_init(&frame_timer, frame_raise, NULL);
+	host_sim_timer_start(&frame_timer, host_sim_now() + FIRST_FRAME_NS);
+}
+
+void host_scenario_reset(void)
+{
+	host_sim_exit(TEST_FAIL);
+}
+
+int main(void)
+{
+	rx_semaphore = xSemaphoreCreateBinary();
+	xTaskCreate(rx_thread_semaphore, "RX_sem", configMINIMAL_STACK_SIZE, NULL, RX_TASK_PRIO, NULL);
+	xTaskCreate(rx_thread_notification, "RX_notify", configMINIMAL_STACK_SIZE, NULL, RX_TASK_PRIO, &rx_task);
+
+	INT_SYS_InstallHandler(RX_IRQ, rx_isr, (isr_t *)NULL);
+	INT_SYS_EnableIRQ(RX_IRQ);
+	INT_SYS_SetPriority(RX_IRQ, RX_IRQ_PRIO);
+
+	vTaskStartScheduler();
+
+	for(;;);
+
+	return 0;
+}
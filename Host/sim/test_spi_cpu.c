@@ -0,0 +1,326 @@
+/*!
+ 	 \file test_spi_cpu.c
+
+ 	 \brief This is the host test of the CPU used by the SPI transfers of the
+ 	 	 	 SBC. The kernel runs on the host port and the SBC task sends the
+ 	 	 	 initialization of the MC33903 and then a burst of the watchdog
+ 	 	 	 refresh and the status reads every period to the LPSPI model,
+ 	 	 	 whose words take the time of the SPI clock. It is done first as
+ 	 	 	 the driver did before, polling TDF and RDF for each word
+ 	 	 	 (LPSPI1_init_MC33903), and then with the transfers of the LPSPI1
+ 	 	 	 engine and the SBC service, moved by the LPSPI1 interruption. The
+ 	 	 	 run time of the task, from the run-time stats, the cycles of the
+ 	 	 	 interruption and the accesses to LPSPI1 are compared.
+
+ 	 \note The times are of the host clock, they depend on the load of the PC.
+ 	 	 	 The accesses do not. Each access to the model costs a trap on the
+ 	 	 	 host, so a word takes more CPU than on the target in both modes.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+#include "interrupt_manager.h"
+#include "clocks_and_modes.h"
+#include "timebase.h"
+#include "transceiver.h"
+#include "lpspi_async.h"
+#include "sbc_service.h"
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the value of a set flag*/
+#define FLAG_SET					(1)
+/** Defines the exit status of a passed run*/
+#define TEST_PASS					(0)
+/** Defines the exit status of a failed run*/
+#define TEST_FAIL					(1)
+/** Defines the priority of the interruption (The one of the LPSPI1 of the driver)*/
+#define LPSPI_INTERRUPT_PRIO		(0x03)
+/** Defines the priority of the SBC task*/
+#define SBC_TASK_PRIO				(4)
+/** Defines the period of the bursts, in ms*/
+#define BURST_PERIOD_MS				(5U)
+/** Defines the bursts of each mode*/
+#define BURSTS						(50U)
+/** Defines the words of the initialization of the MC33903 (LPSPI1_init_MC33903)*/
+#define INIT_WORDS					(6U)
+/** Defines the words of a burst (The watchdog refresh and the 3 status reads)*/
+#define BURST_WORDS					(1U + sbc_status_count)
+/** Defines the watchdog refreshes of a mode (The initialization writes the watchdog too)*/
+#define MODE_REFRESHES				(1U + BURSTS)
+/** Defines the commands of a burst*/
+#define SBC_WD_REFRESH				(0x5A00U)
+#define SBC_READ_VREG				(0xDF80U)
+#define SBC_READ_CAN				(0xE180U)
+#define SBC_READ_IO					(0xE380U)
+/** Defines the CAN flags answered by the SBC (Bus failure)*/
+#define SBC_CAN_FLAGS				(0x0008U)
+/** Defines the time of a word of the LPSPI model, in us (16 SCK of 1 us and the delays of the CCR)*/
+#define SPI_WORD_US					(18.5)
+/** Defines the most tasks of the run-time stats (The SBC task, the idle task and the timer task)*/
+#define MAX_TASKS					(4U)
+/** Defines the part of the CPU of the polling that the interruption must be under*/
+#define CPU_DIVIDER					(2U)
+
+/*!
+ 	 \brief Modes of the SPI transfers.
+ */
+typedef enum
+{
+	spi_polling,		/*!< Polling of TDF and RDF for each word (Before)*/
+	spi_interrupt,		/*!< Transfers of the LPSPI1 engine, moved by the interruption (Now)*/
+	spi_modes			/*!< Number of modes*/
+}spi_mode_t;
+
+/*!
+ 	 \brief CPU used by a mode.
+ */
+typedef struct
+{
+	uint32_t run_time;				/*!< Run time of the SBC task, in core cycles*/
+	uint32_t isr_cycles;			/*!< Core cycles of the LPSPI1 interruption*/
+	uint32_t interruptions;			/*!< Interruptions of the LPSPI1*/
+	uint32_t refreshes;				/*!< Watchdog refreshes received by the SBC*/
+	uint16_t can_flags;				/*!< Last CAN flags read*/
+	host_sim_accesses_t accesses;	/*!< Accesses to LPSPI1*/
+}spi_cpu_t;
+
+/** Names of the modes*/
+static const char* const mode_names[spi_modes] = {"polling (before)", "interruption (now)"};
+/** Commands of a burst*/
+static const uint16_t burst_commands[BURST_WORDS] = {SBC_WD_REFRESH, SBC_READ_VREG, SBC_READ_CAN, SBC_READ_IO};
+/** CPU used by each mode*/
+static spi_cpu_t cpu[spi_modes];
+/** SBC task*/
+static TaskHandle_t sbc_task;
+
+/** Interruption for the LPSPI1, as LPSPI1_ISR*/
+static void lpspi_isr(void)
+{
+	/** Indicates if a completion function unblocked a higher priority task*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	LPSPI_async_isr(&higher_priority_task_woken);
+
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/** Gets the run time of the SBC task*/
+static uint32_t sbc_task_run_time(void)
+{
+	/** State of the tasks*/
+	TaskStatus_t status[MAX_TASKS];
+	/** Number of tasks, and counter for them*/
+	UBaseType_t tasks = uxTaskGetSystemState(status, MAX_TASKS, NULL);
+	UBaseType_t index;
+
+	for(index = INIT_VAL ; tasks > index ; index ++)
+	{
+		if(sbc_task == status[index].xHandle)
+		{
+			return status[index].ulRunTimeCounter;
+		}
+	}
+
+	return INIT_VAL;
+}
+
+/** Sends a burst by polling each word, it returns the CAN flags*/
+static uint16_t burst_polling(void)
+{
+	/** Counter for the words*/
+	uint8_t word;
+	/** Answer of each word*/
+	uint16_t answers[BURST_WORDS];
+
+	for(word = INIT_VAL ; BURST_WORDS > word ; word ++)
+	{
+		LPSPI1_transmit_16bits(burst_commands[word]);
+		answers[word] = LPSPI1_receive_16bits();
+	}
+
+	return answers[1U + sbc_status_can];
+}
+
+/** Starts counting the CPU of a mode*/
+static void count_start(spi_cpu_t* measured)
+{
+	/** Statistics of the LPSPI1 engine*/
+	lpspi_async_stats_t stats;
+
+	LPSPI_async_get_stats(&stats);
+	measured->isr_cycles = stats.isr_cycles;
+	measured->interruptions = host_cpu_get_isr_count(LPSPI1_IRQn);
+	measured->refreshes = host_lpspi_get_sbc_refreshes();
+	measured->run_time = sbc_task_run_time();
+	host_sim_get_accesses(LPSPI1, &measured->accesses);
+}
+
+/** Gets the CPU of a mode since count_start*/
+static void count_end(spi_cpu_t* measured)
+{
+	/** Statistics of the LPSPI1 engine*/
+	lpspi_async_stats_t stats;
+	/** Accesses to LPSPI1 at the end*/
+	host_sim_accesses_t accesses;
+
+	measured->run_time = sbc_task_run_time() - measured->run_time;
+	LPSPI_async_get_stats(&stats);
+	measured->isr_cycles = stats.isr_cycles - measured->isr_cycles;
+	measured->interruptions = host_cpu_get_isr_count(LPSPI1_IRQn) - measured->interruptions;
+	measured->refreshes = host_lpspi_get_sbc_refreshes() - measured->refreshes;
+	host_sim_get_accesses(LPSPI1, &accesses);
+	measured->accesses.reads = accesses.reads - measured->accesses.reads;
+	measured->accesses.writes = accesses.writes - measured->accesses.writes;
+}
+
+/** Sends the initialization and the bursts by polling each word, as the driver did before*/
+static void run_polling(spi_cpu_t* measured)
+{
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime;
+	/** Counter for the bursts*/
+	uint32_t burst;
+
+	count_start(measured);
+	LPSPI1_init_MC33903();
+
+	xLastWakeTime = xTaskGetTickCount();
+	for(burst = INIT_VAL ; BURSTS > burst ; burst ++)
+	{
+		vTaskDelayUntil(&xLastWakeTime, timebase_ms_to_ticks(BURST_PERIOD_MS));
+		measured->can_flags = burst_polling();
+	}
+	count_end(measured);
+}
+
+/** Sends the initialization and the bursts with the LPSPI1 engine and the SBC service, as the driver does now*/
+static void run_interrupt(spi_cpu_t* measured)
+{
+	/** Commands of the initialization (The sequence of LPSPI1_init_MC33903)*/
+	static const uint16_t init_commands[INIT_WORDS] = {0x2580, 0xDF80, 0x5A00, 0x5E10, 0x60C0, 0x66C4};
+	/** Transfer of the initialization*/
+	static lpspi_transfer_t init_transfer = {init_commands, NULL, INIT_WORDS, NULL, NULL, lpspi_transfer_idle};
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime;
+	/** Counter for the bursts*/
+	uint32_t burst;
+	/** Status of the SBC*/
+	sbc_status_t status;
+
+	LPSPI_async_init();
+	INT_SYS_InstallHandler(LPSPI1_IRQn, lpspi_isr, (isr_t *)NULL);
+	INT_SYS_SetPriority(LPSPI1_IRQn, LPSPI_INTERRUPT_PRIO);
+	INT_SYS_EnableIRQ(LPSPI1_IRQn);
+	SBC_service_init(BURST_PERIOD_MS);
+
+	count_start(measured);
+	LPSPI_async_submit(&init_transfer);
+
+	xLastWakeTime = xTaskGetTickCount();
+	for(burst = INIT_VAL ; BURSTS > burst ; burst ++)
+	{
+		vTaskDelayUntil(&xLastWakeTime, timebase_ms_to_ticks(BURST_PERIOD_MS));
+		SBC_service_run();
+	}
+
+	/** The answers of the last burst are checked in the next period*/
+	vTaskDelayUntil(&xLastWakeTime, timebase_ms_to_ticks(BURST_PERIOD_MS));
+	count_end(measured);
+
+	SBC_service_get_status(&status);
+	measured->can_flags = status.flags[sbc_status_can];
+}
+
+/** This function prints the CPU used by each mode, it returns the exit status*/
+static int report(void)
+{
+	/** Counter for the modes*/
+	uint8_t index;
+	/** CPU of each mode (Task and interruption), in us for each word*/
+	double word_us[spi_modes];
+	/** Words of a mode*/
+	uint32_t words = INIT_WORDS + (BURSTS * BURST_WORDS);
+	/** Checks of the run*/
+	uint8_t passed = FLAG_SET;
+
+	printf("SBC on LPSPI1, initialization and %u bursts every %u ms, %u words (core clock %u Hz):\n", BURSTS,
+		BURST_PERIOD_MS, words, host_system_core_clock());
+	for(index = INIT_VAL; spi_modes > index; index ++)
+	{
+		word_us[index] = (double)(cpu[index].run_time + cpu[index].isr_cycles) * HOST_SIM_NS_PER_S / host_system_core_clock() /
+			HOST_SIM_NS_PER_US / words;
+		printf("  %-20s %3u refreshes, %3u interruptions, LPSPI1 %5u reads/%4u writes, task %8.1f us, ISR %7.1f us, CPU %6.1f us a word\n",
+			mode_names[index], cpu[index].refreshes, cpu[index].interruptions, cpu[index].accesses.reads, cpu[index].accesses.writes,
+			(double)cpu[index].run_time * HOST_SIM_NS_PER_S / host_system_core_clock() / HOST_SIM_NS_PER_US,
+			(double)cpu[index].isr_cycles * HOST_SIM_NS_PER_S / host_system_core_clock() / HOST_SIM_NS_PER_US, word_us[index]);
+	}
+	printf("SPI clock: %.1f us a word\n", SPI_WORD_US);
+	printf("Host: timers delayed up to %.1f us\n", (double)host_sim_get_max_delay() / HOST_SIM_NS_PER_US);
+
+	/** Both modes send every word and read the flags of the SBC*/
+	passed &= (MODE_REFRESHES == cpu[spi_polling].refreshes) && (MODE_REFRESHES == cpu[spi_interrupt].refreshes);
+	passed &= (SBC_CAN_FLAGS == cpu[spi_polling].can_flags) && (SBC_CAN_FLAGS == cpu[spi_interrupt].can_flags);
+	/** The polling reads SR while each word is shifted, the interruption runs at least once for each transfer
+	 	 and reads FSR and the received words*/
+	passed &= (INIT_VAL == cpu[spi_polling].interruptions) && ((1U + BURSTS) <= cpu[spi_interrupt].interruptions);
+	passed &= (cpu[spi_interrupt].accesses.reads < cpu[spi_polling].accesses.reads);
+	/** The CPU does not wait for the SPI clock*/
+	passed &= ((word_us[spi_polling] / CPU_DIVIDER) > word_us[spi_interrupt]);
+
+	printf("%s\n", passed ? "PASS" : "FAIL");
+
+	return passed ? TEST_PASS : TEST_FAIL;
+}
+
+/** SBC task, it sends the transfers by polling and then with the interruption*/
+static void sbc_thread(void* args)
+{
+	(void)args;
+
+	run_polling(&cpu[spi_polling]);
+	run_interrupt(&cpu[spi_interrupt]);
+
+	host_sim_exit(report());
+}
+
+/** The SBC answers its flags from the start*/
+void host_scenario_start(void)
+{
+}
+
+void host_scenario_reset(void)
+{
+	host_sim_exit(TEST_FAIL);
+}
+
+int main(void)
+{
+	/** The clocks of the application*/
+	SOSC_init_8MHz();
+	SPLL_init_160MHz();
+	NormalRUNmode_80MHz();
+	timebase_init();
+
+	host_lpspi_set_sbc_flags(SBC_READ_CAN, SBC_CAN_FLAGS);
+	LPSPI1_init_master();
+
+	xTaskCreate(sbc_thread, "SBC", configMINIMAL_STACK_SIZE, NULL, SBC_TASK_PRIO, &sbc_task);
+
+	vTaskStartScheduler();
+
+	for(;;);
+
+	return 0;
+}
@@ -0,0 +1,200 @@
+/*!
+ 	 \file test_tick_timing.c
+
+ 	 \brief This is the host test of the timing of the periodic threads. The
+ 	 	 	 clocks are set to 80 MHz as in the application, the kernel runs
+ 	 	 	 on the host port and a thread wakes with vTaskDelayUntil every
+ 	 	 	 50 ms. The wakeups are timed with the SysTick of the timebase
+ 	 	 	 and the period converted by timebase_ms_to_ticks, and then with
+ 	 	 	 the SysTick programmed from configCPU_CLOCK_HZ (48 MHz) and the
+ 	 	 	 period multiplied by FIX_PERIOD, as the threads did before. The
+ 	 	 	 drift of the period is taken from the ticks of the wakeups and
+ 	 	 	 the SysTick period of the core clock of the model, and the jitter
+ 	 	 	 from the times of the host clock of the wakeups.
+
+ 	 \note The jitter depends on the load of the PC (A tick delayed by the host
+ 	 	 	 for longer than a tick is lost). The drift does not.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_sim.h"
+#include "clocks_and_modes.h"
+#include "timebase.h"
+
+#include <stdio.h>
+
+#include "task.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the value of a set flag*/
+#define FLAG_SET					(1)
+/** Defines the exit status of a passed run*/
+#define TEST_PASS					(0)
+/** Defines the exit status of a failed run*/
+#define TEST_FAIL					(1)
+/** Defines the period of the thread, in ms*/
+#define PERIOD_MS					(50U)
+/** Defines the wakeups timed with each timebase (The first one is the reference)*/
+#define WAKEUPS						(21U)
+/** Defines the priority of the periodic thread*/
+#define PERIODIC_THREAD_PRIO		(2)
+/** Defines the correction of the periods before the timebase*/
+#define FIX_PERIOD					((10.0025F) / (6.0F))
+/** Defines the drift allowed with the timebase, in ppm (50 ms are a whole number of ticks)*/
+#define DRIFT_LIMIT_PPM				(1.0)
+/** Defines the ppm of a unit*/
+#define PPM							(1000000.0)
+
+/*!
+ 	 \brief Timebases of the periodic thread.
+ */
+typedef enum
+{
+	timebase_core_clock,	/*!< SysTick of the real core clock and periods in integer ticks (Now)*/
+	timebase_fix_period,	/*!< SysTick of configCPU_CLOCK_HZ and periods times FIX_PERIOD (Before)*/
+	timebases				/*!< Number of timebases*/
+}timebase_t;
+
+/*!
+ 	 \brief Timing of the wakeups of a timebase.
+ */
+typedef struct
+{
+	double tick_us;			/*!< Period of the SysTick, in us*/
+	double period_us;		/*!< Average period, in us*/
+	double jitter_us;		/*!< Largest difference of the time between two wakeups to their ticks, in us*/
+	double drift_ppm;		/*!< Drift of the average period to PERIOD_MS, in ppm*/
+}timing_t;
+
+/*!
+ 	 \brief Wakeups of a timebase.
+ */
+typedef struct
+{
+	uint64_t time[WAKEUPS];		/*!< Host time of each wakeup, in ns*/
+	TickType_t tick[WAKEUPS];	/*!< Tick of each wakeup*/
+	uint32_t tick_cycles;		/*!< Core clock cycles of a tick*/
+}wakeups_t;
+
+/** Names of the timebases*/
+static const char* const timebase_names[timebases] = {"core clock, ticks", "48 MHz, FIX_PERIOD"};
+/** Wakeups of each timebase*/
+static wakeups_t wakeups[timebases];
+
+/** This function wakes the thread WAKEUPS times with a period in ticks, and keeps their times*/
+static void periodic_run(wakeups_t* run, TickType_t period)
+{
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime = xTaskGetTickCount();
+	/** Counter for the wakeups*/
+	uint32_t wakeup;
+
+	run->tick_cycles = S32_SysTick->RVR + 1UL;
+
+	for(wakeup = INIT_VAL ; WAKEUPS > wakeup ; wakeup ++)
+	{
+		vTaskDelayUntil(&xLastWakeTime, period);
+		run->time[wakeup] = host_sim_now();
+		run->tick[wakeup] = xTaskGetTickCount();
+	}
+}
+
+/** This function gets the timing of the wakeups of a timebase*/
+static void timing_get(const wakeups_t* run, timing_t* timing)
+{
+	/** Counter for the wakeups*/
+	uint32_t wakeup;
+	/** Difference of the time between two wakeups to their ticks, in us*/
+	double difference;
+
+	timing->tick_us = (double)run->tick_cycles * HOST_SIM_NS_PER_S / host_system_core_clock() / HOST_SIM_NS_PER_US;
+	timing->period_us = (double)(TickType_t)(run->tick[WAKEUPS - 1U] - run->tick[INIT_VAL]) * timing->tick_us / (WAKEUPS - 1U);
+	timing->drift_ppm = ((timing->period_us / ((double)PERIOD_MS * HOST_SIM_NS_PER_MS / HOST_SIM_NS_PER_US)) - 1.0) * PPM;
+
+	/** Each wakeup is compared with the previous one*/
+	timing->jitter_us = 0.0;
+	for(wakeup = 1U ; WAKEUPS > wakeup ; wakeup ++)
+	{
+		difference = ((double)(run->time[wakeup] - run->time[wakeup - 1U]) / HOST_SIM_NS_PER_US) -
+			((double)(TickType_t)(run->tick[wakeup] - run->tick[wakeup - 1U]) * timing->tick_us);
+		difference = (0.0 > difference) ? -difference : difference;
+		timing->jitter_us = (timing->jitter_us < difference) ? difference : timing->jitter_us;
+	}
+}
+
+/** This function prints the timing of each timebase, it returns the exit status*/
+static int report(void)
+{
+	/** Timing of each timebase*/
+	timing_t timing[timebases];
+	/** Counter for the timebases*/
+	uint8_t index;
+	/** Checks of the run*/
+	uint8_t passed = FLAG_SET;
+
+	printf("Periodic thread of %u ms, %u periods with each timebase:\n", PERIOD_MS, WAKEUPS - 1U);
+	for(index = INIT_VAL ; timebases > index ; index ++)
+	{
+		timing_get(&wakeups[index], &timing[index]);
+		printf("  %-20s tick %6.1f us, period %9.1f us, drift %+8.0f ppm, jitter %7.1f us\n", timebase_names[index],
+			timing[index].tick_us, timing[index].period_us, timing[index].drift_ppm, timing[index].jitter_us);
+	}
+	printf("Host: timers delayed up to %.1f us\n", (double)host_sim_get_max_delay() / HOST_SIM_NS_PER_US);
+
+	/** With the real core clock the period does not drift, FIX_PERIOD truncates 83.35 ticks of 0.6 ms*/
+	passed &= (DRIFT_LIMIT_PPM > timing[timebase_core_clock].drift_ppm) && (-DRIFT_LIMIT_PPM < timing[timebase_core_clock].drift_ppm);
+	passed &= (-DRIFT_LIMIT_PPM > timing[timebase_fix_period].drift_ppm);
+
+	printf("%s\n", passed ? "PASS" : "FAIL");
+
+	return passed ? TEST_PASS : TEST_FAIL;
+}
+
+/** Periodic thread, it is timed with the timebase and then as before it*/
+static void periodic_thread(void* args)
+{
+	(void)args;
+
+	periodic_run(&wakeups[timebase_core_clock], timebase_ms_to_ticks(PERIOD_MS));
+
+	/** The SysTick as the port programmed it from configCPU_CLOCK_HZ*/
+	S32_SysTick->RVR = (configCPU_CLOCK_HZ / configTICK_RATE_HZ) - 1UL;
+	S32_SysTick->CVR = INIT_VAL;
+	periodic_run(&wakeups[timebase_fix_period], (TickType_t)(PERIOD_MS * FIX_PERIOD));
+
+	host_sim_exit(report());
+}
+
+/** The kernel does not need the scenario*/
+void host_scenario_start(void)
+{
+}
+
+void host_scenario_reset(void)
+{
+	host_sim_exit(TEST_FAIL);
+}
+
+int main(void)
+{
+	/** The clocks of the application*/
+	SOSC_init_8MHz();
+	SPLL_init_160MHz();
+	NormalRUNmode_80MHz();
+	timebase_init();
+
+	xTaskCreate(periodic_thread, "Periodic", configMINIMAL_STACK_SIZE, NULL, PERIODIC_THREAD_PRIO, NULL);
+
+	vTaskStartScheduler();
+
+	for(;;);
+
+	return 0;
+}
@@ -0,0 +1,243 @@
+/*!
+ 	 \file host_test.c
+
+ 	 \brief This is the source file of the support of the host tests. It
+ 	 	 	 has the checks, the in-memory peripherals and the critical sections
+ 	 	 	 of FreeRTOS, so a module can be tested without the kernel.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL				(0)
+/** Defines the words of a message buffer*/
+#define MSG_BUF_SIZE			(4)
+/** Defines the code and DLC position in the message buffer*/
+#define CODE_AND_DLC_POS		(0)
+/** Defines the ID position in the message buffer*/
+#define ID_POS					(1)
+/** Defines the first data word position in the message buffer*/
+#define MSG_POS					(2)
+/** Defines the shifts of the standard ID*/
+#define STD_ID_SHIFT			(18)
+/** Defines the mask of the standard ID*/
+#define STD_ID_MASK				(0x7FF)
+/** Defines the shifts of the code*/
+#define CODE_SHIFT				(24)
+/** Defines the mask of the code*/
+#define CODE_MASK				(0xF)
+/** Defines the shifts of the DLC*/
+#define DLC_SHIFT				(16)
+/** Defines the mask of the DLC*/
+#define DLC_MASK				(0xF)
+/** Defines the bytes of a data word*/
+#define WORD_BYTES				(4)
+/** Defines the bits of a byte*/
+#define BYTE_BITS				(8)
+/** Defines the data bytes of a message buffer*/
+#define DATA_BYTES				(8)
+
+/** In-memory peripherals used by the sources*/
+host_peripherals_t host_peripherals;
+
+/** Checks done by the test*/
+static uint32_t checks;
+/** Checks that failed*/
+static uint32_t failures;
+/** Nesting of the critical sections*/
+static uint32_t critical_nesting;
+
+/** This function records the result of a check*/
+void host_test_check(uint8_t passed, const char* condition, const char* file, uint32_t line)
+{
+	checks ++;
+
+	if(!passed)
+	{
+		failures ++;
+		printf("%s:%lu: check failed: %s\n", file, (unsigned long)line, condition);
+	}
+}
+
+/** This function prints the result of the test*/
+int host_test_result(void)
+{
+	printf("%lu checks, %lu failed\n", (unsigned long)checks, (unsigned long)failures);
+
+	return (INIT_VAL == failures) ? 0 : 1;
+}
+
+/** This function clears every in-memory peripheral*/
+void host_test_reset_peripherals(void)
+{
+	memset(&host_peripherals, INIT_VAL, sizeof(host_peripherals));
+}
+
+/** This function gets the nesting of the critical sections*/
+uint32_t host_test_critical_nesting(void)
+{
+	return critical_nesting;
+}
+
+/** This function decodes a message buffer*/
+void host_can_read_mb(CAN_Type* base, uint8_t mb, host_can_mb_t* frame)
+{
+	/** Counter for the data bytes*/
+	uint8_t counter;
+	/** Code and DLC word*/
+	uint32_t code_and_dlc = base->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS];
+	/** Data word of the byte*/
+	uint32_t data;
+
+	frame->code = (uint8_t)((code_and_dlc >> CODE_SHIFT) & CODE_MASK);
+	frame->DLC = (uint8_t)((code_and_dlc >> DLC_SHIFT) & DLC_MASK);
+	frame->ID = (uint16_t)((base->RAMn[(mb * MSG_BUF_SIZE) + ID_POS] >> STD_ID_SHIFT) & STD_ID_MASK);
+
+	/** The first byte of each word is in its MSB*/
+	for(counter = INIT_VAL ; DATA_BYTES > counter ; counter ++)
+	{
+		data = base->RAMn[(mb * MSG_BUF_SIZE) + MSG_POS + (counter / WORD_BYTES)];
+		frame->data[counter] = (uint8_t)(data >> (BYTE_BITS * (WORD_BYTES - 1U - (counter % WORD_BYTES))));
+	}
+}
+
+/** This function writes a received message in a message buffer*/
+void host_can_write_mb(CAN_Type* base, uint8_t mb, const host_can_mb_t* frame)
+{
+	/** Counter for the data bytes*/
+	uint8_t counter;
+	/** Data words*/
+	uint32_t data[DATA_BYTES / WORD_BYTES] = {INIT_VAL};
+
+	for(counter = INIT_VAL ; DATA_BYTES > counter ; counter ++)
+	{
+		data[counter / WORD_BYTES] |= (uint32_t)frame->data[counter] << (BYTE_BITS * (WORD_BYTES - 1U - (counter % WORD_BYTES)));
+	}
+
+	base->RAMn[(mb * MSG_BUF_SIZE) + MSG_POS] = data[0];
+	base->RAMn[(mb * MSG_BUF_SIZE) + MSG_POS + 1U] = data[1];
+	base->RAMn[(mb * MSG_BUF_SIZE) + ID_POS] = (uint32_t)(frame->ID & STD_ID_MASK) << STD_ID_SHIFT;
+	base->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ((uint32_t)HOST_CAN_CODE_RX_FULL << CODE_SHIFT) |
+			((uint32_t)(frame->DLC & DLC_MASK) << DLC_SHIFT);
+	base->IFLAG1 |= (1UL << mb);
+}
+
+/** This function finishes the transmission of Tx message buffers*/
+void host_can_complete_tx(CAN_Type* base, uint32_t mbs)
+{
+	/** Counter for the message buffers*/
+	uint8_t mb;
+	/** Code and DLC word*/
+	uint32_t code_and_dlc;
+
+	for(mb = INIT_VAL ; (sizeof(mbs) * BYTE_BITS) > mb ; mb ++)
+	{
+		if(mbs & (1UL << mb))
+		{
+			code_and_dlc = base->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS];
+			code_and_dlc &= ~((uint32_t)CODE_MASK << CODE_SHIFT);
+			base->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = code_and_dlc | ((uint32_t)HOST_CAN_CODE_TX_INACTIVE << CODE_SHIFT);
+		}
+	}
+
+	/** The flags of the driver writes (Write 1 to clear) are not kept in memory*/
+	base->IFLAG1 = mbs;
+}
+
+/** This function sends the next Tx message buffer*/
+uint8_t host_can_send_next(CAN_Type* base, host_can_mb_t* frame)
+{
+	/** Counter for the message buffers*/
+	uint8_t mb;
+	/** Message buffer that wins the arbitration*/
+	uint8_t winner = HOST_CAN_NO_MB;
+	/** Decoded message buffer*/
+	host_can_mb_t candidate;
+
+	for(mb = INIT_VAL ; (CAN_RAMn_COUNT / MSG_BUF_SIZE) > mb ; mb ++)
+	{
+		host_can_read_mb(base, mb, &candidate);
+
+		/** Only a lower ID wins, so the lowest MB wins between equal IDs*/
+		if((HOST_CAN_CODE_TX_DATA == candidate.code) && ((HOST_CAN_NO_MB == winner) || (candidate.ID < frame->ID)))
+		{
+			winner = mb;
+			*frame = candidate;
+		}
+	}
+
+	if(HOST_CAN_NO_MB != winner)
+	{
+		host_can_complete_tx(base, 1UL << winner);
+	}
+
+	return winner;
+}
+
+/** Critical sections of the kernel, the tests have a single thread*/
+void vPortEnterCritical(void)
+{
+	critical_nesting ++;
+}
+
+void vPortExitCritical(void)
+{
+	TEST_CHECK(INIT_VAL != critical_nesting);
+	critical_nesting --;
+}
+
+UBaseType_t uxPortSetInterruptMask(void)
+{
+	critical_nesting ++;
+
+	return INIT_VAL;
+}
+
+void vPortClearInterruptMask(UBaseType_t uxMask)
+{
+	(void)uxMask;
+	TEST_CHECK(INIT_VAL != critical_nesting);
+	critical_nesting --;
+}
+
+void vPortDisableInterrupts(void)
+{
+}
+
+void vPortEnableInterrupts(void)
+{
+}
+
+/** Scheduler suspension, it is counted as a critical section*/
+void vTaskSuspendAll(void)
+{
+	critical_nesting ++;
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+	TEST_CHECK(INIT_VAL != critical_nesting);
+	critical_nesting --;
+
+	return pdFALSE;
+}
+
+/** Called by configASSERT*/
+void vAssertCalled(const char* file, unsigned long line)
+{
+	host_test_check(INIT_VAL, "configASSERT", file, (uint32_t)line);
+}
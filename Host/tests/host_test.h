@@ -0,0 +1,127 @@
+/*!
+ 	 \file host_test.h
+
+ 	 \brief This is the header file of the support of the host tests. It
+ 	 	 	 has the checks, the in-memory peripherals and the critical sections
+ 	 	 	 of FreeRTOS, so a module can be tested without the kernel.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include "S32K144.h"
+
+/** Checks a condition, the test fails if it is false*/
+#define TEST_CHECK(condition)		host_test_check((condition) ? 1U : 0U, #condition, __FILE__, __LINE__)
+
+/** Defines the code of an inactive Tx message buffer*/
+#define HOST_CAN_CODE_TX_INACTIVE	(0x8)
+/** Defines the code of a Tx message buffer waiting to be sent*/
+#define HOST_CAN_CODE_TX_DATA		(0xC)
+/** Defines that no message buffer was sent*/
+#define HOST_CAN_NO_MB				(0xFF)
+/** Defines the code of an empty Rx message buffer*/
+#define HOST_CAN_CODE_RX_EMPTY		(0x4)
+/** Defines the code of a full Rx message buffer*/
+#define HOST_CAN_CODE_RX_FULL		(0x2)
+
+/*!
+ 	 \brief Message buffer decoded from the CAN RAM.
+ */
+typedef struct
+{
+	uint8_t code;		/*!< Code of the message buffer*/
+	uint8_t DLC;		/*!< DLC of the message buffer*/
+	uint16_t ID;		/*!< Standard ID of the message buffer*/
+	uint8_t data[8];	/*!< Data, in bus order*/
+}host_can_mb_t;
+
+/*!
+ 	 \brief This function records the result of a check.
+
+ 	 \param[in] passed 1 if the check passed, 0 otherwise.
+ 	 \param[in] condition Text of the condition.
+ 	 \param[in] file File of the check.
+ 	 \param[in] line Line of the check.
+
+ 	 \return void.
+ */
+void host_test_check(uint8_t passed, const char* condition, const char* file, uint32_t line);
+
+/*!
+ 	 \brief This function prints the result of the test.
+
+ 	 \return 0 if every check passed, 1 otherwise (Exit status of the test).
+ */
+int host_test_result(void);
+
+/*!
+ 	 \brief This function clears every in-memory peripheral.
+
+ 	 \return void.
+ */
+void host_test_reset_peripherals(void);
+
+/*!
+ 	 \brief This function gets the nesting of the FreeRTOS critical sections (The
+ 	 	 	 scheduler suspensions are counted as critical sections too).
+
+ 	 \return Critical sections entered and not exited (0 when balanced).
+ */
+uint32_t host_test_critical_nesting(void);
+
+/*!
+ 	 \brief This function decodes a message buffer from the CAN RAM.
+
+ 	 \param[in] base CAN whose message buffer will be read.
+ 	 \param[in] mb Message buffer to be read.
+ 	 \param[out] frame Decoded message buffer.
+
+ 	 \return void.
+ */
+void host_can_read_mb(CAN_Type* base, uint8_t mb, host_can_mb_t* frame);
+
+/*!
+ 	 \brief This function writes a received message in a message buffer, and
+ 	 	 	 sets its flag, as the FlexCAN does when a message matches it.
+
+ 	 \param[in] base CAN that receives the message.
+ 	 \param[in] mb Message buffer that receives the message.
+ 	 \param[in] frame Message to be received (code is ignored).
+
+ 	 \return void.
+ */
+void host_can_write_mb(CAN_Type* base, uint8_t mb, const host_can_mb_t* frame);
+
+/*!
+ 	 \brief This function finishes the transmission of Tx message buffers: they
+ 	 	 	 become inactive and only their flags are set in IFLAG1.
+
+ 	 \param[in] base CAN that sent the messages.
+ 	 \param[in] mbs IFLAG1 bits of the message buffers.
+
+ 	 \return void.
+ */
+void host_can_complete_tx(CAN_Type* base, uint32_t mbs);
+
+/*!
+ 	 \brief This function sends the next Tx message buffer as the FlexCAN does
+ 	 	 	 with CTRL1.LBUF clear: the lowest ID wins the arbitration, and the
+ 	 	 	 lowest message buffer between equal IDs. Its transmission is
+ 	 	 	 finished as with host_can_complete_tx.
+
+ 	 \param[in] base CAN that sends the message.
+ 	 \param[out] frame Message put on the bus.
+
+ 	 \return Message buffer that was sent, HOST_CAN_NO_MB if none was waiting.
+ */
+uint8_t host_can_send_next(CAN_Type* base, host_can_mb_t* frame);
+
+#endif /* HOST_TEST_H_ */
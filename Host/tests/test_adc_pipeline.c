@@ -0,0 +1,198 @@
+/*!
+ 	 \file test_adc_pipeline.c
+
+ 	 \brief This is the host test of the ADC sample pipeline. Known sample
+ 	 	 	 sequences are passed through the filter, the decimation, the
+ 	 	 	 scaling and the hysteresis, and the hardware averaging is set in
+ 	 	 	 an in-memory ADC.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "adc_pipeline.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+/** Defines the full scale of the 12-bit ADC*/
+#define FULL_SCALE			(4095)
+
+/** Configuration that passes the raw results*/
+static const adc_pipeline_config_t identity = {INIT_VAL, 1, 1, INIT_VAL, INIT_VAL, INIT_VAL};
+
+/** The averaging bits are changed, and the rest of SC3 is kept*/
+static void test_hw_average(void)
+{
+	host_test_reset_peripherals();
+	ADC1->SC3 = ADC_SC3_CAL_MASK | ADC_SC3_ADCO_MASK;
+
+	ADC_pipeline_set_hw_average(ADC1, adc_hw_average_16);
+	TEST_CHECK((ADC_SC3_CAL_MASK | ADC_SC3_ADCO_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(2)) == ADC1->SC3);
+
+	ADC_pipeline_set_hw_average(ADC1, adc_hw_average_4);
+	TEST_CHECK((ADC_SC3_CAL_MASK | ADC_SC3_ADCO_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(0)) == ADC1->SC3);
+
+	ADC_pipeline_set_hw_average(ADC1, adc_hw_average_off);
+	TEST_CHECK((ADC_SC3_CAL_MASK | ADC_SC3_ADCO_MASK) == ADC1->SC3);
+	TEST_CHECK(INIT_VAL == ADC0->SC3);
+}
+
+/** Without filter, decimation, scaling or hysteresis the raw result is the output*/
+static void test_identity(void)
+{
+	/** Pipeline under test*/
+	adc_pipeline_t pipeline;
+	/** Output of the pipeline*/
+	uint16_t output = INIT_VAL;
+	/** Raw result*/
+	uint16_t raw;
+
+	ADC_pipeline_init(&pipeline, &identity);
+
+	for(raw = INIT_VAL ; FULL_SCALE >= raw ; raw += 15)
+	{
+		TEST_CHECK(1 == ADC_pipeline_process(&pipeline, raw, &output));
+		TEST_CHECK(raw == output);
+	}
+}
+
+/** The filter starts at the first sample, and follows a step without overshoot*/
+static void test_filter_step(void)
+{
+	/** Configuration with a filter of 1/4*/
+	adc_pipeline_config_t config = identity;
+	/** Pipeline under test*/
+	adc_pipeline_t pipeline;
+	/** Output of the pipeline*/
+	uint16_t output = INIT_VAL;
+	/** Previous output*/
+	uint16_t previous;
+	/** Counter for the samples*/
+	uint8_t sample;
+
+	config.iir_shift = 2;
+	ADC_pipeline_init(&pipeline, &config);
+
+	TEST_CHECK(1 == ADC_pipeline_process(&pipeline, 1000, &output));
+	TEST_CHECK(1000 == output);
+
+	/** A quarter of the step with each sample*/
+	ADC_pipeline_process(&pipeline, 3000, &output);
+	TEST_CHECK(1500 == output);
+
+	for(sample = INIT_VAL ; 60 > sample ; sample ++)
+	{
+		previous = output;
+		ADC_pipeline_process(&pipeline, 3000, &output);
+		TEST_CHECK((previous <= output) && (3000 >= output));
+	}
+	TEST_CHECK(3000 == output);
+
+	/** The filter also goes down (The state is signed)*/
+	ADC_pipeline_process(&pipeline, INIT_VAL, &output);
+	TEST_CHECK(2250 == output);
+}
+
+/** One output every decimation samples, the filter runs with every sample*/
+static void test_decimation(void)
+{
+	/** Configuration with a decimation of 4*/
+	adc_pipeline_config_t config = identity;
+	/** Pipeline under test*/
+	adc_pipeline_t pipeline;
+	/** Output of the pipeline*/
+	uint16_t output = INIT_VAL;
+	/** Counter for the samples*/
+	uint8_t sample;
+	/** Outputs produced*/
+	uint8_t outputs = INIT_VAL;
+
+	config.decimation = 4;
+	ADC_pipeline_init(&pipeline, &config);
+
+	for(sample = 1 ; 40 >= sample ; sample ++)
+	{
+		if(ADC_pipeline_process(&pipeline, sample, &output))
+		{
+			outputs ++;
+			TEST_CHECK(INIT_VAL == (sample % 4));
+			TEST_CHECK(sample == output);
+		}
+	}
+
+	TEST_CHECK(10 == outputs);
+}
+
+/** The scaling rounds with its offset and clamps negative results, and a trim is folded in*/
+static void test_scaling(void)
+{
+	/** Configuration of 1250 / 1024, rounded*/
+	adc_pipeline_config_t config = {INIT_VAL, 1, 1250, 512, 10, INIT_VAL};
+	/** Pipeline under test*/
+	adc_pipeline_t pipeline;
+	/** Output of the pipeline*/
+	uint16_t output = INIT_VAL;
+
+	ADC_pipeline_init(&pipeline, &config);
+	ADC_pipeline_process(&pipeline, 1024, &output);
+	TEST_CHECK(1250 == output);
+	ADC_pipeline_process(&pipeline, 3, &output);
+	TEST_CHECK(4 == output);
+
+	/** Negative results are 0*/
+	config.scale_offset = -100000;
+	ADC_pipeline_init(&pipeline, &config);
+	ADC_pipeline_process(&pipeline, 10, &output);
+	TEST_CHECK(INIT_VAL == output);
+
+	/** ((raw * 1.5) - 10) * 1000 / 1024*/
+	config.scale_mul = 1000;
+	config.scale_offset = INIT_VAL;
+	ADC_pipeline_apply_trim(&config, 98304, -10);
+	TEST_CHECK((1500 == config.scale_mul) && (-10000 == config.scale_offset));
+	ADC_pipeline_init(&pipeline, &config);
+	ADC_pipeline_process(&pipeline, 100, &output);
+	TEST_CHECK(136 == output);
+}
+
+/** Small changes keep the last output*/
+static void test_hysteresis(void)
+{
+	/** Configuration with a hysteresis of 10*/
+	adc_pipeline_config_t config = identity;
+	/** Pipeline under test*/
+	adc_pipeline_t pipeline;
+	/** Output of the pipeline*/
+	uint16_t output = INIT_VAL;
+
+	config.hysteresis = 10;
+	ADC_pipeline_init(&pipeline, &config);
+
+	ADC_pipeline_process(&pipeline, 500, &output);
+	TEST_CHECK(500 == output);
+	ADC_pipeline_process(&pipeline, 509, &output);
+	TEST_CHECK(500 == output);
+	ADC_pipeline_process(&pipeline, 491, &output);
+	TEST_CHECK(500 == output);
+	ADC_pipeline_process(&pipeline, 510, &output);
+	TEST_CHECK(510 == output);
+	ADC_pipeline_process(&pipeline, 500, &output);
+	TEST_CHECK(500 == output);
+}
+
+int main(void)
+{
+	test_hw_average();
+	test_identity();
+	test_filter_step();
+	test_decimation();
+	test_scaling();
+	test_hysteresis();
+
+	return host_test_result();
+}
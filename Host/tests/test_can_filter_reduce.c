@@ -0,0 +1,231 @@
+/*!
+ 	 \file test_can_filter_reduce.c
+
+ 	 \brief This is the host test of the CAN acceptance filters. The source
+ 	 	 	 of the driver is included, so the filter reduction can be tested on
+ 	 	 	 its own. The in-memory FlexCAN keeps FRZACK set, so the freeze
+ 	 	 	 requests are accepted while the filters are programmed.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+
+#include <stdlib.h>
+
+/* The static functions of the driver are tested */
+#include "can_driver.c"
+
+/** Defines the size of the random tables*/
+#define RANDOM_TABLE_SIZE		(33)
+/** Defines the number of random tables*/
+#define RANDOM_TABLES			(200)
+
+/** Checks that every ID of the table is accepted by one of the filters*/
+static uint8_t all_accepted(const uint16_t* IDs, uint16_t ID_count, const can_rx_filter_t* filters, uint16_t count)
+{
+	/** Counters for the IDs and the filters*/
+	uint16_t ID_counter;
+	uint16_t counter;
+	/** Defines whether the ID is accepted or not*/
+	uint8_t accepted;
+
+	for(ID_counter = INIT_VAL ; ID_counter < ID_count ; ID_counter ++)
+	{
+		accepted = INIT_VAL;
+
+		for(counter = INIT_VAL ; counter < count ; counter ++)
+		{
+			if(INIT_VAL == ((IDs[ID_counter] ^ filters[counter].ID) & filters[counter].mask))
+			{
+				accepted = BIT_MASK;
+			}
+		}
+
+		if(!accepted)
+		{
+			return INIT_VAL;
+		}
+	}
+
+	return BIT_MASK;
+}
+
+/** Fills a table of exact filters*/
+static void exact_filters(const uint16_t* IDs, uint16_t count, can_rx_filter_t* filters)
+{
+	/** Counter for the filters*/
+	uint16_t counter;
+
+	for(counter = INIT_VAL ; counter < count ; counter ++)
+	{
+		filters[counter].ID = IDs[counter];
+		filters[counter].mask = CAN_RX_FILTER_EXACT;
+	}
+}
+
+/** A table that fits is only sorted*/
+static void test_sort_only(void)
+{
+	/** IDs out of order*/
+	const uint16_t IDs[4] = {0x300, 0x010, 0x7FF, 0x123};
+	/** Filters to be reduced*/
+	can_rx_filter_t filters[4];
+
+	exact_filters(IDs, 4, filters);
+	TEST_CHECK(4 == CAN_filter_reduce(filters, 4, CAN_RX_MB_COUNT));
+	TEST_CHECK((0x010 == filters[0].ID) && (0x123 == filters[1].ID) && (0x300 == filters[2].ID) && (0x7FF == filters[3].ID));
+	TEST_CHECK((CAN_RX_FILTER_EXACT == filters[0].mask) && (CAN_RX_FILTER_EXACT == filters[3].mask));
+}
+
+/** The closest IDs are merged first, and the far ones keep their exact filter*/
+static void test_merge_closest(void)
+{
+	/** Two pairs of close IDs and two far IDs*/
+	const uint16_t IDs[6] = {0x100, 0x101, 0x400, 0x030, 0x031, 0x7F0};
+	/** Filters to be reduced*/
+	can_rx_filter_t filters[6];
+
+	exact_filters(IDs, 6, filters);
+	TEST_CHECK(4 == CAN_filter_reduce(filters, 6, 4));
+	TEST_CHECK(all_accepted(IDs, 6, filters, 4));
+
+	/** Each close pair takes one filter that only ignores the last bit*/
+	TEST_CHECK((0x030 == filters[0].ID) && ((CAN_RX_FILTER_EXACT & ~1U) == filters[0].mask));
+	TEST_CHECK((0x100 == filters[1].ID) && ((CAN_RX_FILTER_EXACT & ~1U) == filters[1].mask));
+	TEST_CHECK((0x400 == filters[2].ID) && (CAN_RX_FILTER_EXACT == filters[2].mask));
+	TEST_CHECK((0x7F0 == filters[3].ID) && (CAN_RX_FILTER_EXACT == filters[3].mask));
+}
+
+/** Random tables always fit the slots and accept every requested ID*/
+static void test_random_tables(void)
+{
+	/** Random IDs*/
+	uint16_t IDs[RANDOM_TABLE_SIZE];
+	/** Filters to be reduced*/
+	can_rx_filter_t filters[RANDOM_TABLE_SIZE];
+	/** Counters for the tables and the IDs*/
+	uint16_t table;
+	uint16_t counter;
+	/** Size of the table and slots of the reduction*/
+	uint16_t size;
+	uint16_t slots;
+	/** Filters after the reduction*/
+	uint16_t count;
+
+	srand(1);
+
+	for(table = INIT_VAL ; table < RANDOM_TABLES ; table ++)
+	{
+		size = 1U + (uint16_t)(rand() % RANDOM_TABLE_SIZE);
+		slots = (table & BIT_MASK) ? CAN_RX_FIFO_FILTERS : CAN_RX_MB_COUNT;
+
+		for(counter = INIT_VAL ; counter < size ; counter ++)
+		{
+			IDs[counter] = (uint16_t)(rand() & CAN_RX_FILTER_EXACT);
+		}
+
+		exact_filters(IDs, size, filters);
+		count = CAN_filter_reduce(filters, size, slots);
+
+		TEST_CHECK(((size < slots) ? size : slots) == count);
+		TEST_CHECK(all_accepted(IDs, size, filters, count));
+	}
+}
+
+/** Each Rx MB gets one exact filter, and an unchanged table doesn't freeze the module*/
+static void test_program_mbs(void)
+{
+	/** Filters to be programmed*/
+	can_rx_filter_t filters[4];
+	/** Registered IDs*/
+	uint16_t IDs[3] = {0x050, 0x010, 0x030};
+	/** Decoded Rx MB*/
+	host_can_mb_t frame = {INIT_VAL, 1, 0x030, {0xAA}};
+
+	host_test_reset_peripherals();
+	CAN_rx_filter_count[INIT_VAL] = INIT_VAL;
+	CAN0->MCR = CAN_MCR_FRZACK_MASK;
+
+	exact_filters(IDs, 3, filters);
+	TEST_CHECK(3 == CAN_set_rx_filters(CAN0, filters, 3));
+	TEST_CHECK((0x010UL << STD_ID_SHIFT) == CAN0->RAMn[(CAN_RX_MB_FIRST * MSG_BUF_SIZE) + ID_POS]);
+	TEST_CHECK((0x050UL << STD_ID_SHIFT) == CAN0->RAMn[((CAN_RX_MB_FIRST + 2) * MSG_BUF_SIZE) + ID_POS]);
+	TEST_CHECK(((uint32_t)CAN_RX_FILTER_EXACT << STD_ID_SHIFT) == CAN0->RXIMR[CAN_RX_MB_FIRST + 1]);
+	TEST_CHECK(ENABLE_RX_BUFF == CAN0->RAMn[((CAN_RX_MB_FIRST + 1) * MSG_BUF_SIZE) + CODE_AND_DLC_POS]);
+	TEST_CHECK(INACTIVE_BUFF == CAN0->RAMn[((CAN_RX_MB_FIRST + 3) * MSG_BUF_SIZE) + CODE_AND_DLC_POS]);
+
+	/** A message arrives in the second Rx MB*/
+	host_can_write_mb(CAN0, CAN_RX_MB_FIRST + 1, &frame);
+	/** The unused MB is written on every freeze*/
+	CAN0->RAMn[((CAN_RX_MB_FIRST + 3) * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ENABLE_RX_BUFF;
+
+	/** The same IDs, in another order, don't touch the module*/
+	IDs[0] = 0x030;
+	IDs[2] = 0x050;
+	exact_filters(IDs, 3, filters);
+	TEST_CHECK(3 == CAN_set_rx_filters(CAN0, filters, 3));
+	TEST_CHECK(ENABLE_RX_BUFF == CAN0->RAMn[((CAN_RX_MB_FIRST + 3) * MSG_BUF_SIZE) + CODE_AND_DLC_POS]);
+
+	/** A new ID only rewrites the MBs whose filter changed, the unread message is kept*/
+	IDs[1] = 0x020;
+	exact_filters(IDs, 3, filters);
+	TEST_CHECK(3 == CAN_set_rx_filters(CAN0, filters, 3));
+	TEST_CHECK(INACTIVE_BUFF == CAN0->RAMn[((CAN_RX_MB_FIRST + 3) * MSG_BUF_SIZE) + CODE_AND_DLC_POS]);
+	host_can_read_mb(CAN0, CAN_RX_MB_FIRST + 1, &frame);
+	TEST_CHECK((HOST_CAN_CODE_RX_FULL == frame.code) && (0x030 == frame.ID) && (0xAA == frame.data[0]));
+	TEST_CHECK((0x020UL << STD_ID_SHIFT) == CAN0->RAMn[(CAN_RX_MB_FIRST * MSG_BUF_SIZE) + ID_POS]);
+	TEST_CHECK(!(CAN0->MCR & (CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK)));
+}
+
+/** The Rx FIFO repeats the last filter in its unused elements*/
+static void test_program_fifo(void)
+{
+	/** Filters to be programmed*/
+	can_rx_filter_t filters[2];
+	/** Registered IDs*/
+	const uint16_t IDs[2] = {0x200, 0x100};
+
+	host_test_reset_peripherals();
+	CAN_rx_filter_count[INIT_VAL] = INIT_VAL;
+	CAN0->MCR = CAN_MCR_RFEN_MASK | CAN_MCR_FRZACK_MASK;
+
+	exact_filters(IDs, 2, filters);
+	TEST_CHECK(2 == CAN_set_rx_filters(CAN0, filters, 2));
+	TEST_CHECK((0x100UL << RX_FIFO_FILTER_SHIFT) == CAN0->RAMn[RX_FIFO_FILTER_POS]);
+	TEST_CHECK((0x200UL << RX_FIFO_FILTER_SHIFT) == CAN0->RAMn[RX_FIFO_FILTER_POS + 1]);
+	TEST_CHECK((0x200UL << RX_FIFO_FILTER_SHIFT) == CAN0->RAMn[RX_FIFO_FILTER_POS + CAN_RX_FIFO_FILTERS - 1]);
+	TEST_CHECK((((uint32_t)CAN_RX_FILTER_EXACT << RX_FIFO_FILTER_SHIFT) | RX_FIFO_FILTER_IDE) == CAN0->RXIMR[CAN_RX_FIFO_FILTERS - 1]);
+}
+
+/** Without freeze acknowledge the filters are not changed, and the request is withdrawn*/
+static void test_freeze_timeout(void)
+{
+	/** Filter to be programmed*/
+	can_rx_filter_t filter = {0x123, CAN_RX_FILTER_EXACT};
+
+	host_test_reset_peripherals();
+	CAN_rx_filter_count[INIT_VAL] = INIT_VAL;
+
+	TEST_CHECK(INIT_VAL == CAN_set_rx_filters(CAN0, &filter, 1));
+	TEST_CHECK(INIT_VAL == CAN0->RAMn[(CAN_RX_MB_FIRST * MSG_BUF_SIZE) + ID_POS]);
+	TEST_CHECK(!(CAN0->MCR & (CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK)));
+	TEST_CHECK(INIT_VAL == CAN_rx_filter_count[INIT_VAL]);
+}
+
+int main(void)
+{
+	test_sort_only();
+	test_merge_closest();
+	test_random_tables();
+	test_program_mbs();
+	test_program_fifo();
+	test_freeze_timeout();
+
+	return host_test_result();
+}
@@ -0,0 +1,288 @@
+/*!
+ 	 \file test_can_id_table.c
+
+ 	 \brief This is the host test of the table of the IDs with callback. The
+ 	 	 	 add, remove and change results are checked, and the dispatch of a
+ 	 	 	 received frame is timed with a growing number of IDs, against the
+ 	 	 	 walk of the whole vector that the Rx threads did before the index.
+ 	 	 	 It is built with ID_VECTOR_MAX_SIZE set to 255.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "can_id_table.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+/** Defines the step between the registered IDs (Prime, so they spread over the 11 bits)*/
+#define ID_STEP				(7U)
+/** Defines the first registered ID*/
+#define ID_FIRST			(0x11U)
+/** Defines the received frames of each timed run*/
+#define BENCH_FRAMES		(1UL << 16)
+/** Defines the timed runs of each size, the fastest one is kept (The host can stop the test)*/
+#define BENCH_RUNS			(5U)
+/** Defines the nanoseconds of a second*/
+#define NS_PER_S			(1000000000ULL)
+
+/** Table under test*/
+static can_id_table_t table;
+/** Calls of each callback*/
+static uint32_t calls_a;
+static uint32_t calls_b;
+
+/** Callbacks of the IDs*/
+static void callback_a(can_message_rx_config_t can_message_rx)
+{
+	(void)can_message_rx;
+	calls_a ++;
+}
+
+static void callback_b(can_message_rx_config_t can_message_rx)
+{
+	(void)can_message_rx;
+	calls_b ++;
+}
+
+/** Gets the ID of a position of the test*/
+static uint16_t test_ID(uint16_t position)
+{
+	return (uint16_t)((ID_FIRST + (position * ID_STEP)) % CAN_ID_TABLE_IDS);
+}
+
+/** Gets the time of the host, in ns*/
+static uint64_t now_ns(void)
+{
+	/** Time of the monotonic clock*/
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * NS_PER_S) + (uint64_t)now.tv_nsec;
+}
+
+/** Adds IDs until the vector is full, the duplicated IDs are refused*/
+static void test_add(void)
+{
+	/** Counter for the IDs*/
+	uint16_t position;
+	/** ID and callback to be added*/
+	ID_function_t ID_func = {INIT_VAL, callback_a};
+
+	CAN_ID_table_init(&table);
+
+	for(position = INIT_VAL ; ID_VECTOR_MAX_SIZE > position ; position ++)
+	{
+		ID_func.ID = test_ID(position);
+		TEST_CHECK(ID_func_vector_success == CAN_ID_table_add(&table, ID_func));
+	}
+	TEST_CHECK(ID_VECTOR_MAX_SIZE == table.ID_func_counter);
+
+	ID_func.ID = test_ID(INIT_VAL);
+	TEST_CHECK(ID_already_exist == CAN_ID_table_add(&table, ID_func));
+	ID_func.ID = test_ID(ID_VECTOR_MAX_SIZE);
+	TEST_CHECK(ID_func_vector_full == CAN_ID_table_add(&table, ID_func));
+
+	for(position = INIT_VAL ; ID_VECTOR_MAX_SIZE > position ; position ++)
+	{
+		TEST_CHECK(NULL != CAN_ID_table_find(&table, test_ID(position)));
+	}
+	TEST_CHECK(NULL == CAN_ID_table_find(&table, test_ID(ID_VECTOR_MAX_SIZE)));
+}
+
+/** A removed ID is replaced by the last one, which is still found*/
+static void test_remove(void)
+{
+	/** ID and callback to be added*/
+	ID_function_t ID_func = {0x100U, callback_a};
+	/** Entry of an ID*/
+	const ID_function_t* entry;
+
+	CAN_ID_table_init(&table);
+	TEST_CHECK(ID_func_vector_empty == CAN_ID_table_remove(&table, 0x100U));
+
+	CAN_ID_table_add(&table, ID_func);
+	ID_func.ID = 0x200U;
+	ID_func.ID_func = callback_b;
+	CAN_ID_table_add(&table, ID_func);
+
+	TEST_CHECK(ID_does_not_exist == CAN_ID_table_remove(&table, 0x300U));
+	TEST_CHECK(ID_func_vector_success == CAN_ID_table_remove(&table, 0x100U));
+	TEST_CHECK(1U == table.ID_func_counter);
+	TEST_CHECK(NULL == CAN_ID_table_find(&table, 0x100U));
+
+	entry = CAN_ID_table_find(&table, 0x200U);
+	TEST_CHECK((NULL != entry) && (0x200U == entry->ID) && (callback_b == entry->ID_func));
+	TEST_CHECK(entry == &table.ID_function[INIT_VAL]);
+
+	TEST_CHECK(ID_func_vector_success == CAN_ID_table_remove(&table, 0x200U));
+	TEST_CHECK(INIT_VAL == table.ID_func_counter);
+	TEST_CHECK(NULL == CAN_ID_table_find(&table, 0x200U));
+}
+
+/** An ID is changed to any free ID, or kept with a new callback*/
+static void test_change(void)
+{
+	/** ID and callback to be added*/
+	ID_function_t ID_func = {0x100U, callback_a};
+	/** Entry of an ID*/
+	const ID_function_t* entry;
+
+	CAN_ID_table_init(&table);
+	CAN_ID_table_add(&table, ID_func);
+	ID_func.ID = 0x200U;
+	CAN_ID_table_add(&table, ID_func);
+
+	ID_func.ID = 0x7FFU;
+	ID_func.ID_func = callback_b;
+	TEST_CHECK(ID_does_not_exist == CAN_ID_table_change(&table, 0x300U, ID_func));
+	TEST_CHECK(ID_func_vector_success == CAN_ID_table_change(&table, 0x100U, ID_func));
+	TEST_CHECK(NULL == CAN_ID_table_find(&table, 0x100U));
+	entry = CAN_ID_table_find(&table, 0x7FFU);
+	TEST_CHECK((NULL != entry) && (callback_b == entry->ID_func) && (entry == &table.ID_function[INIT_VAL]));
+
+	/** The new ID of another callback is refused*/
+	ID_func.ID = 0x200U;
+	TEST_CHECK(ID_already_exist == CAN_ID_table_change(&table, 0x7FFU, ID_func));
+
+	/** The same ID takes a new callback*/
+	TEST_CHECK(ID_func_vector_success == CAN_ID_table_change(&table, 0x200U, ID_func));
+	entry = CAN_ID_table_find(&table, 0x200U);
+	TEST_CHECK((NULL != entry) && (callback_b == entry->ID_func));
+	TEST_CHECK(2U == table.ID_func_counter);
+}
+
+/** Calls the callback of each frame through the index*/
+static void dispatch_index(const uint16_t* IDs, can_message_rx_config_t* message)
+{
+	/** Counter for the frames*/
+	uint32_t frame;
+	/** Entry of the ID*/
+	const ID_function_t* entry;
+
+	for(frame = INIT_VAL ; BENCH_FRAMES > frame ; frame ++)
+	{
+		message->ID = IDs[frame % CAN_ID_TABLE_IDS];
+		entry = CAN_ID_table_find(&table, message->ID);
+		if(NULL != entry)
+		{
+			entry->ID_func(*message);
+		}
+	}
+}
+
+/** Calls the callback of each frame walking the whole vector (The Rx threads before the index)*/
+static void dispatch_walk(const uint16_t* IDs, can_message_rx_config_t* message)
+{
+	/** Counter for the frames*/
+	uint32_t frame;
+	/** Counter for the vector*/
+	uint16_t position;
+
+	for(frame = INIT_VAL ; BENCH_FRAMES > frame ; frame ++)
+	{
+		message->ID = IDs[frame % CAN_ID_TABLE_IDS];
+		for(position = INIT_VAL ; table.ID_func_counter > position ; position ++)
+		{
+			if(message->ID == table.ID_function[position].ID)
+			{
+				table.ID_function[position].ID_func(*message);
+			}
+		}
+	}
+}
+
+/** Times the fastest run of a dispatch, in ns per frame*/
+static double time_dispatch(void (*dispatch)(const uint16_t* IDs, can_message_rx_config_t* message), const uint16_t* IDs)
+{
+	/** Message given to the callbacks*/
+	can_message_rx_config_t message = {INIT_VAL};
+	/** Counter for the runs*/
+	uint8_t run;
+	/** Start and length of a run*/
+	uint64_t start;
+	uint64_t length;
+	/** Fastest run*/
+	uint64_t best = UINT64_MAX;
+
+	for(run = INIT_VAL ; BENCH_RUNS > run ; run ++)
+	{
+		start = now_ns();
+		dispatch(IDs, &message);
+		length = now_ns() - start;
+		if(best > length)
+		{
+			best = length;
+		}
+	}
+
+	return (double)best / BENCH_FRAMES;
+}
+
+/** Times the dispatch of every ID, with 1 to 255 IDs with callback (One frame in eight has a callback at 255)*/
+static void test_dispatch_cost(void)
+{
+	/** IDs with callback of each run*/
+	static const uint16_t sizes[] = {1U, 16U, 64U, 128U, ID_VECTOR_MAX_SIZE};
+	/** Received IDs, in a fixed order that mixes the 11 bits*/
+	static uint16_t IDs[CAN_ID_TABLE_IDS];
+	/** ID and callback to be added*/
+	ID_function_t ID_func = {INIT_VAL, callback_a};
+	/** Counters for the sizes and the IDs*/
+	uint8_t size;
+	uint16_t position;
+	/** Costs of the last size*/
+	double index_ns = 0.0;
+	double walk_ns = 0.0;
+	/** Calls of each dispatch*/
+	uint32_t index_calls;
+
+	for(position = INIT_VAL ; CAN_ID_TABLE_IDS > position ; position ++)
+	{
+		IDs[position] = (uint16_t)((position * 0x2F5U) % CAN_ID_TABLE_IDS);
+	}
+
+	printf("IDs   index (ns/frame)   walk (ns/frame)\n");
+	for(size = INIT_VAL ; (sizeof(sizes) / sizeof(sizes[0])) > size ; size ++)
+	{
+		CAN_ID_table_init(&table);
+		for(position = INIT_VAL ; sizes[size] > position ; position ++)
+		{
+			ID_func.ID = test_ID(position);
+			CAN_ID_table_add(&table, ID_func);
+		}
+
+		/** Both dispatches call the same callbacks*/
+		calls_a = INIT_VAL;
+		index_ns = time_dispatch(dispatch_index, IDs);
+		index_calls = calls_a;
+		calls_a = INIT_VAL;
+		walk_ns = time_dispatch(dispatch_walk, IDs);
+		TEST_CHECK(index_calls == calls_a);
+		TEST_CHECK((BENCH_RUNS * (BENCH_FRAMES / CAN_ID_TABLE_IDS) * sizes[size]) == index_calls);
+
+		printf("%3u   %16.1f   %15.1f\n", sizes[size], index_ns, walk_ns);
+	}
+
+	/** With every ID, the index is faster than the walk*/
+	TEST_CHECK(index_ns < walk_ns);
+}
+
+int main(void)
+{
+	test_add();
+	test_remove();
+	test_change();
+	test_dispatch_cost();
+
+	return host_test_result();
+}
@@ -0,0 +1,127 @@
+/*!
+ 	 \file test_can_rx_ring.c
+
+ 	 \brief This is the host test of the CAN Rx ring. The producer and the
+ 	 	 	 consumer are called from the same thread, so the order, the wrap of
+ 	 	 	 the positions and the statistics can be checked.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "can_rx_ring.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+
+/** Rx ring under test*/
+static can_rx_ring_t ring;
+
+/** Stores a message with the sequence number in its ID and first byte*/
+static uint8_t push(uint16_t sequence)
+{
+	/** Received message*/
+	can_message_rx_config_t message = {CAN0, sequence & 0x7FF, {(uint8_t)sequence}, 1};
+
+	return CAN_rx_ring_push(&ring, &message);
+}
+
+/** Takes a message and checks its sequence number*/
+static void pop_and_check(uint16_t sequence)
+{
+	/** Taken message*/
+	can_message_rx_config_t message;
+
+	TEST_CHECK(1 == CAN_rx_ring_pop(&ring, &message));
+	TEST_CHECK((sequence & 0x7FF) == message.ID);
+	TEST_CHECK((uint8_t)sequence == message.msg[0]);
+	TEST_CHECK(1 == message.DLC);
+}
+
+/** An empty ring returns nothing, and the messages come out in order*/
+static void test_order(void)
+{
+	/** Taken message*/
+	can_message_rx_config_t message;
+
+	CAN_rx_ring_init(&ring);
+	TEST_CHECK(INIT_VAL == CAN_rx_ring_pop(&ring, &message));
+
+	TEST_CHECK(1 == push(1));
+	TEST_CHECK(1 == push(2));
+	TEST_CHECK(1 == push(3));
+	pop_and_check(1);
+	pop_and_check(2);
+	pop_and_check(3);
+	TEST_CHECK(INIT_VAL == CAN_rx_ring_pop(&ring, &message));
+
+	TEST_CHECK(3 == ring.stats.received);
+	TEST_CHECK(3 == ring.stats.high_water);
+	TEST_CHECK(INIT_VAL == ring.stats.dropped);
+}
+
+/** A full ring drops the new messages and keeps the old ones*/
+static void test_full(void)
+{
+	/** Counter for the messages*/
+	uint16_t counter;
+
+	CAN_rx_ring_init(&ring);
+
+	for(counter = INIT_VAL ; CAN_RX_RING_SIZE > counter ; counter ++)
+	{
+		TEST_CHECK(1 == push(counter));
+	}
+
+	TEST_CHECK(INIT_VAL == push(0x100));
+	TEST_CHECK(INIT_VAL == push(0x101));
+	TEST_CHECK(2 == ring.stats.dropped);
+	TEST_CHECK(CAN_RX_RING_SIZE == ring.stats.high_water);
+
+	/** One free position takes one more message*/
+	pop_and_check(0);
+	TEST_CHECK(1 == push(0x102));
+
+	for(counter = 1 ; CAN_RX_RING_SIZE > counter ; counter ++)
+	{
+		pop_and_check(counter);
+	}
+	pop_and_check(0x102);
+}
+
+/** The positions are free running, so they wrap around the 16 bits*/
+static void test_wrap(void)
+{
+	/** Counter for the messages*/
+	uint32_t counter;
+
+	CAN_rx_ring_init(&ring);
+	ring.head = 0xFFF0;
+	ring.tail = 0xFFF0;
+
+	for(counter = INIT_VAL ; 40 > counter ; counter ++)
+	{
+		TEST_CHECK(1 == push((uint16_t)counter));
+		TEST_CHECK(1 == push((uint16_t)(counter + 0x200)));
+		pop_and_check((uint16_t)counter);
+		pop_and_check((uint16_t)(counter + 0x200));
+	}
+
+	TEST_CHECK(ring.head == ring.tail);
+	TEST_CHECK(0x0040 == ring.head);
+	TEST_CHECK(2 == ring.stats.high_water);
+}
+
+int main(void)
+{
+	test_order();
+	test_full();
+	test_wrap();
+
+	return host_test_result();
+}
@@ -0,0 +1,142 @@
+/*!
+ 	 \file test_can_tx_policy.c
+
+ 	 \brief This is the host test of the CAN Tx policy. Value sequences are
+ 	 	 	 checked against each mode, the minimum gap and the maximum age.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "can_tx_policy.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+
+/** Policy under test*/
+static can_tx_policy_t policy;
+
+/** Counts the values sent in [from, from + ticks), with a new value in each tick*/
+static uint32_t count_sent(uint32_t from, uint32_t ticks, uint16_t value, int16_t step)
+{
+	/** Counter for the ticks*/
+	uint32_t tick;
+	/** Values sent*/
+	uint32_t sent = INIT_VAL;
+
+	for(tick = INIT_VAL ; ticks > tick ; tick ++)
+	{
+		sent += CAN_tx_policy_check(&policy, (uint16_t)(value + (step * (int32_t)tick)), from + tick);
+	}
+
+	return sent;
+}
+
+/** Cyclic values are sent every max_age, whatever their changes*/
+static void test_cyclic(void)
+{
+	/** Cyclic every 10 ticks*/
+	can_tx_policy_config_t config = {tx_policy_cyclic, INIT_VAL, INIT_VAL, 10};
+
+	CAN_tx_policy_init(&policy, &config);
+	TEST_CHECK(10 == count_sent(INIT_VAL, 100, 100, 7));
+
+	/** A max_age of 0 sends every value*/
+	config.max_age = INIT_VAL;
+	CAN_tx_policy_init(&policy, &config);
+	TEST_CHECK(100 == count_sent(INIT_VAL, 100, 100, INIT_VAL));
+}
+
+/** Values out of the deadband are sent, a static value is never sent again*/
+static void test_on_change(void)
+{
+	/** On change, deadband of 5*/
+	const can_tx_policy_config_t config = {tx_policy_on_change, 5, INIT_VAL, 10};
+
+	CAN_tx_policy_init(&policy, &config);
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 100, INIT_VAL));
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 105, 1));
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 95, 2));
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 106, 3));
+
+	/** The deadband is measured from the last sent value, a slow drift is sent too*/
+	TEST_CHECK(2 == count_sent(4, 12, 107, 1));
+	TEST_CHECK(INIT_VAL == count_sent(100, 1000, 118, INIT_VAL));
+}
+
+/** Changes are sent right away, and a static value is refreshed every max_age*/
+static void test_mixed(void)
+{
+	/** Mixed, deadband of 5, refreshed every 50 ticks*/
+	const can_tx_policy_config_t config = {tx_policy_mixed, 5, INIT_VAL, 50};
+
+	CAN_tx_policy_init(&policy, &config);
+	TEST_CHECK(4 == count_sent(INIT_VAL, 200, 1000, INIT_VAL));
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 1010, 201));
+	TEST_CHECK(INIT_VAL == count_sent(202, 49, 1010, INIT_VAL));
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 1010, 251));
+}
+
+/** Nothing is sent before the minimum gap, a change is sent after it if it is still out of the deadband*/
+static void test_min_gap(void)
+{
+	/** On change, deadband of 5, 20 ticks between messages*/
+	const can_tx_policy_config_t config = {tx_policy_on_change, 5, 20, INIT_VAL};
+
+	CAN_tx_policy_init(&policy, &config);
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 100, INIT_VAL));
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 200, 19));
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 200, 20));
+
+	/** The change went back into the deadband while it waited*/
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 300, 30));
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 203, 40));
+
+	/** A fast ramp is sent once per gap*/
+	TEST_CHECK(10 == count_sent(41, 200, 210, 10));
+}
+
+/** The age survives the wrap of the tick count*/
+static void test_tick_wrap(void)
+{
+	/** Cyclic every 10 ticks*/
+	const can_tx_policy_config_t config = {tx_policy_cyclic, INIT_VAL, INIT_VAL, 10};
+
+	CAN_tx_policy_init(&policy, &config);
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 100, 0xFFFFFFFA));
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 100, 3));
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 100, 4));
+}
+
+/** A new configuration keeps the last sent value*/
+static void test_set_config(void)
+{
+	/** On change, deadband of 50*/
+	can_tx_policy_config_t config = {tx_policy_on_change, 50, INIT_VAL, INIT_VAL};
+
+	CAN_tx_policy_init(&policy, &config);
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 1000, INIT_VAL));
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 1020, 1));
+
+	config.deadband = 10;
+	CAN_tx_policy_set_config(&policy, &config);
+	TEST_CHECK(INIT_VAL == CAN_tx_policy_check(&policy, 1010, 2));
+	TEST_CHECK(1 == CAN_tx_policy_check(&policy, 1020, 3));
+}
+
+int main(void)
+{
+	test_cyclic();
+	test_on_change();
+	test_mixed();
+	test_min_gap();
+	test_tick_wrap();
+	test_set_config();
+
+	return host_test_result();
+}
@@ -0,0 +1,218 @@
+/*!
+ 	 \file test_can_tx_queue.c
+
+ 	 \brief This is the host test of the asynchronous CAN Tx queue. The
+ 	 	 	 messages are sent to an in-memory FlexCAN, and the end of each
+ 	 	 	 transmission is simulated before calling the interruption.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "can_tx_queue.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+/** Defines the IFLAG1 bit of a message buffer*/
+#define MB_FLAG(mb)			(1UL << (mb))
+
+/** Tx queue under test*/
+static can_tx_queue_t queue;
+
+/** Sends a message with the ID as its first data byte*/
+static CAN_tx_queue_status_t send(uint16_t ID, uint8_t tag)
+{
+	/** Data of the message*/
+	uint8_t data[2] = {(uint8_t)ID, tag};
+	/** Message to be sent*/
+	can_message_tx_config_t message = {CAN0, ID, data, sizeof(data)};
+
+	return CAN_tx_queue_send(&queue, message);
+}
+
+/** Checks the message loaded in a message buffer*/
+static void check_mb(uint8_t mb, uint16_t ID, uint8_t tag)
+{
+	/** Decoded message buffer*/
+	host_can_mb_t frame;
+
+	host_can_read_mb(CAN0, mb, &frame);
+	TEST_CHECK(HOST_CAN_CODE_TX_DATA == frame.code);
+	TEST_CHECK(ID == frame.ID);
+	TEST_CHECK(2 == frame.DLC);
+	TEST_CHECK((uint8_t)ID == frame.data[0]);
+	TEST_CHECK(tag == frame.data[1]);
+}
+
+/** The first messages are loaded right away in the Tx pool, lowest MB first*/
+static void test_idle_mbs(void)
+{
+	/** Counter for the Tx pool*/
+	uint8_t mb;
+
+	host_test_reset_peripherals();
+	CAN_tx_queue_init(&queue, CAN0);
+	TEST_CHECK(CAN_TX_MB_POOL_MASK == (CAN0->IMASK1 & CAN_TX_MB_POOL_MASK));
+
+	for(mb = INIT_VAL ; CAN_TX_MB_COUNT > mb ; mb ++)
+	{
+		TEST_CHECK(tx_queue_success == send(0x100 + mb, mb));
+		check_mb(CAN_TX_MB_FIRST + mb, 0x100 + mb, mb);
+	}
+
+	TEST_CHECK(INIT_VAL == queue.count);
+	TEST_CHECK(INIT_VAL == queue.free_mbs);
+	TEST_CHECK(INIT_VAL == host_test_critical_nesting());
+}
+
+/** Sends the messages on the bus, calling the interruption after each one, and checks their order*/
+static void check_wire_order(const uint16_t* IDs, const uint8_t* tags, uint8_t count)
+{
+	/** Message put on the bus*/
+	host_can_mb_t frame;
+	/** Counter for the messages*/
+	uint8_t counter = INIT_VAL;
+
+	while(HOST_CAN_NO_MB != host_can_send_next(CAN0, &frame))
+	{
+		TEST_CHECK(count > counter);
+		if(count > counter)
+		{
+			TEST_CHECK(IDs[counter] == frame.ID);
+			TEST_CHECK(tags[counter] == frame.data[1]);
+		}
+		counter ++;
+
+		CAN_tx_queue_isr(&queue);
+	}
+
+	TEST_CHECK(count == counter);
+	TEST_CHECK(INIT_VAL == queue.count);
+	TEST_CHECK(CAN_TX_MB_POOL_MASK == queue.free_mbs);
+}
+
+/** The messages leave lowest ID first, and in arrival order for equal IDs, even when a later message of an
+ 	 ID could take a lower MB than the earlier one*/
+static void test_wire_order(void)
+{
+	/** Order of the messages on the bus*/
+	static const uint16_t IDs[] = {0x100, 0x050, 0x110, 0x120, 0x130, 0x250, 0x250, 0x250};
+	static const uint8_t tags[] = {0, 1, 0, 0, 0, 1, 2, 3};
+	/** Statistics of the queue*/
+	can_tx_queue_stats_t stats;
+
+	host_test_reset_peripherals();
+	CAN_tx_queue_init(&queue, CAN0);
+
+	/** Fills the pool, the highest MB has the lowest ID so it is freed first*/
+	send(0x130, 0);
+	send(0x120, 0);
+	send(0x110, 0);
+	send(0x100, 0);
+
+	/** Waits in the queue*/
+	send(0x250, 1);
+	send(0x250, 2);
+	send(0x250, 3);
+	send(0x050, 1);
+	TEST_CHECK(4 == queue.count);
+
+	check_wire_order(IDs, tags, sizeof(IDs) / sizeof(IDs[0]));
+
+	CAN_tx_queue_get_stats(&queue, &stats);
+	TEST_CHECK(8 == stats.queued);
+	TEST_CHECK(8 == stats.sent);
+	TEST_CHECK(INIT_VAL == stats.dropped);
+	TEST_CHECK(4 == stats.high_water);
+	TEST_CHECK(INIT_VAL == host_test_critical_nesting());
+}
+
+/** A message whose ID is being sent waits, even with idle MBs, and the queue keeps the priority order*/
+static void test_same_ID_waits(void)
+{
+	/** Order of the messages on the bus*/
+	static const uint16_t IDs[] = {0x010, 0x010, 0x010, 0x020};
+	static const uint8_t tags[] = {1, 2, 3, 1};
+
+	host_test_reset_peripherals();
+	CAN_tx_queue_init(&queue, CAN0);
+
+	TEST_CHECK(tx_queue_success == send(0x010, 1));
+	TEST_CHECK(tx_queue_success == send(0x010, 2));
+	TEST_CHECK(1 == queue.count);
+
+	/** Waits behind the second 0x010, it is not loaded in an idle MB*/
+	TEST_CHECK(tx_queue_success == send(0x020, 1));
+	TEST_CHECK(2 == queue.count);
+	TEST_CHECK(tx_queue_success == send(0x010, 3));
+	TEST_CHECK(3 == queue.count);
+
+	check_wire_order(IDs, tags, sizeof(IDs) / sizeof(IDs[0]));
+	TEST_CHECK(INIT_VAL == host_test_critical_nesting());
+}
+
+/** A full queue drops the message and counts it*/
+static void test_queue_full(void)
+{
+	/** Counter for the messages*/
+	uint8_t counter;
+	/** Statistics of the queue*/
+	can_tx_queue_stats_t stats;
+
+	host_test_reset_peripherals();
+	CAN_tx_queue_init(&queue, CAN0);
+
+	for(counter = INIT_VAL ; (CAN_TX_MB_COUNT + CAN_TX_QUEUE_SIZE) > counter ; counter ++)
+	{
+		TEST_CHECK(tx_queue_success == send(0x400 - counter, counter));
+	}
+
+	TEST_CHECK(tx_queue_full == send(0x001, 0xFF));
+
+	CAN_tx_queue_get_stats(&queue, &stats);
+	TEST_CHECK((CAN_TX_MB_COUNT + CAN_TX_QUEUE_SIZE) == stats.queued);
+	TEST_CHECK(1 == stats.dropped);
+	TEST_CHECK(CAN_TX_QUEUE_SIZE == stats.high_water);
+
+	/** The dropped message did not take the place of a queued one*/
+	host_can_complete_tx(CAN0, MB_FLAG(CAN_TX_MB_FIRST));
+	CAN_tx_queue_isr(&queue);
+	check_mb(CAN_TX_MB_FIRST, 0x400 - (CAN_TX_MB_COUNT + CAN_TX_QUEUE_SIZE - 1), CAN_TX_MB_COUNT + CAN_TX_QUEUE_SIZE - 1);
+	TEST_CHECK(INIT_VAL == host_test_critical_nesting());
+}
+
+/** The DLC is limited to 8, and only DLC bytes are copied*/
+static void test_dlc_limit(void)
+{
+	/** Data longer than a message*/
+	uint8_t data[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	/** Message to be sent*/
+	can_message_tx_config_t message = {CAN0, 0x7FF, data, sizeof(data)};
+	/** Decoded message buffer*/
+	host_can_mb_t frame;
+
+	host_test_reset_peripherals();
+	CAN_tx_queue_init(&queue, CAN0);
+
+	TEST_CHECK(tx_queue_success == CAN_tx_queue_send(&queue, message));
+	host_can_read_mb(CAN0, CAN_TX_MB_FIRST, &frame);
+	TEST_CHECK(8 == frame.DLC);
+	TEST_CHECK(1 == frame.data[0]);
+	TEST_CHECK(8 == frame.data[7]);
+}
+
+int main(void)
+{
+	test_idle_mbs();
+	test_wire_order();
+	test_same_ID_waits();
+	test_queue_full();
+	test_dlc_limit();
+
+	return host_test_result();
+}
@@ -0,0 +1,222 @@
+/*!
+ 	 \file test_can_tx_schedule.c
+
+ 	 \brief This is the host test of the CAN periodic Tx schedule. The ticks
+ 	 	 	 are simulated, and every message that is due is taken in each tick.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "can_tx_schedule.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+/** Defines the first ID of the test messages*/
+#define FIRST_ID			(0x200)
+/** Defines the number of messages of the staggering tests*/
+#define TEST_MESSAGES		(4)
+
+/** Schedule under test*/
+static can_tx_schedule_t schedule;
+/** Data of the test messages*/
+static uint8_t data[1];
+/** Messages sent by each test message*/
+static uint32_t sent[TEST_MESSAGES];
+/** Most messages due in the same tick*/
+static uint32_t most_per_tick;
+
+/** Adds a message with FIRST_ID + number as its ID*/
+static uint8_t add(uint8_t number, uint32_t period, uint32_t now)
+{
+	/** Message to be sent*/
+	can_message_tx_config_t message = {CAN0, FIRST_ID + number, data, sizeof(data)};
+
+	return CAN_tx_schedule_add(&schedule, message, period, now);
+}
+
+/** Takes every message that is due in each tick of [from, from + ticks)*/
+static void run(uint32_t from, uint32_t ticks)
+{
+	/** Message taken*/
+	can_message_tx_config_t message;
+	/** Tick being simulated*/
+	uint32_t tick;
+	/** Messages of the tick*/
+	uint32_t per_tick;
+
+	for(tick = INIT_VAL ; ticks > tick ; tick ++)
+	{
+		per_tick = INIT_VAL;
+
+		while(CAN_tx_schedule_pop_due(&schedule, from + tick, &message))
+		{
+			TEST_CHECK((FIRST_ID <= message.ID) && ((FIRST_ID + TEST_MESSAGES) > message.ID));
+			sent[(message.ID - FIRST_ID) % TEST_MESSAGES] ++;
+			per_tick ++;
+		}
+
+		if(most_per_tick < per_tick)
+		{
+			most_per_tick = per_tick;
+		}
+	}
+}
+
+/** Starts a test with an empty schedule*/
+static void reset(void)
+{
+	/** Counter for the test messages*/
+	uint8_t number;
+
+	CAN_tx_schedule_init(&schedule);
+	most_per_tick = INIT_VAL;
+
+	for(number = INIT_VAL ; TEST_MESSAGES > number ; number ++)
+	{
+		sent[number] = INIT_VAL;
+	}
+}
+
+/** Messages with the same period get different offsets*/
+static void test_same_period(void)
+{
+	/** Counter for the test messages*/
+	uint8_t number;
+
+	reset();
+
+	for(number = INIT_VAL ; TEST_MESSAGES > number ; number ++)
+	{
+		TEST_CHECK(number == add(number, 10, INIT_VAL));
+	}
+
+	run(INIT_VAL, 1000);
+	TEST_CHECK(1 == most_per_tick);
+
+	for(number = INIT_VAL ; TEST_MESSAGES > number ; number ++)
+	{
+		TEST_CHECK(100 == sent[number]);
+	}
+}
+
+/** Messages with harmonic periods don't collide either*/
+static void test_mixed_periods(void)
+{
+	/** Periods of the test messages*/
+	const uint32_t periods[TEST_MESSAGES] = {5, 10, 20, 40};
+	/** Counter for the test messages*/
+	uint8_t number;
+
+	reset();
+
+	for(number = INIT_VAL ; TEST_MESSAGES > number ; number ++)
+	{
+		TEST_CHECK(number == add(number, periods[number], 3));
+	}
+
+	run(3, 4000);
+	TEST_CHECK(1 == most_per_tick);
+
+	for(number = INIT_VAL ; TEST_MESSAGES > number ; number ++)
+	{
+		TEST_CHECK((4000 / periods[number]) == sent[number]);
+	}
+}
+
+/** A late message is sent once, and its missed periods are skipped*/
+static void test_missed_periods(void)
+{
+	/** Message taken*/
+	can_message_tx_config_t message;
+
+	reset();
+	TEST_CHECK(CAN_TX_SCHEDULE_IDLE == CAN_tx_schedule_ticks_to_next(&schedule, INIT_VAL));
+
+	TEST_CHECK(INIT_VAL == add(INIT_VAL, 10, INIT_VAL));
+	TEST_CHECK(INIT_VAL == CAN_tx_schedule_ticks_to_next(&schedule, INIT_VAL));
+
+	TEST_CHECK(1 == CAN_tx_schedule_pop_due(&schedule, 35, &message));
+	TEST_CHECK(FIRST_ID == message.ID);
+	TEST_CHECK(INIT_VAL == CAN_tx_schedule_pop_due(&schedule, 35, &message));
+	TEST_CHECK(5 == CAN_tx_schedule_ticks_to_next(&schedule, 35));
+}
+
+/** The messages keep their period across the wrap of the tick count*/
+static void test_tick_wrap(void)
+{
+	reset();
+
+	TEST_CHECK(INIT_VAL == add(INIT_VAL, 10, 0xFFFFFF00));
+	TEST_CHECK(1 == add(1, 20, 0xFFFFFF00));
+	run(0xFFFFFF00, 1000);
+
+	TEST_CHECK(100 == sent[0]);
+	TEST_CHECK(50 == sent[1]);
+	TEST_CHECK(1 == most_per_tick);
+}
+
+/** Invalid periods and slots are rejected, and a full schedule doesn't take more messages*/
+static void test_invalid(void)
+{
+	/** Counter for the slots*/
+	uint8_t slot;
+	/** Message of the slots*/
+	can_message_tx_config_t message = {CAN0, FIRST_ID, data, sizeof(data)};
+
+	reset();
+	TEST_CHECK(CAN_TX_SCHEDULE_NO_SLOT == add(INIT_VAL, INIT_VAL, INIT_VAL));
+	TEST_CHECK(tx_schedule_invalid_slot == CAN_tx_schedule_remove(&schedule, INIT_VAL));
+	TEST_CHECK(tx_schedule_invalid_slot == CAN_tx_schedule_set_message(&schedule, CAN_TX_SCHEDULE_SIZE, message));
+
+	for(slot = INIT_VAL ; CAN_TX_SCHEDULE_SIZE > slot ; slot ++)
+	{
+		TEST_CHECK(slot == add(INIT_VAL, 100, INIT_VAL));
+	}
+	TEST_CHECK(CAN_TX_SCHEDULE_NO_SLOT == add(INIT_VAL, 100, INIT_VAL));
+
+	TEST_CHECK(tx_schedule_invalid_period == CAN_tx_schedule_set_period(&schedule, 3, INIT_VAL, INIT_VAL));
+	TEST_CHECK(tx_schedule_success == CAN_tx_schedule_remove(&schedule, 3));
+	TEST_CHECK(tx_schedule_invalid_slot == CAN_tx_schedule_remove(&schedule, 3));
+	TEST_CHECK(tx_schedule_invalid_slot == CAN_tx_schedule_set_period(&schedule, 3, 10, INIT_VAL));
+	TEST_CHECK(3 == add(INIT_VAL, 100, INIT_VAL));
+	TEST_CHECK(CAN_TX_SCHEDULE_SIZE == schedule.count);
+}
+
+/** A new period staggers the message again*/
+static void test_set_period(void)
+{
+	/** Counter for the test messages*/
+	uint8_t number;
+
+	reset();
+
+	for(number = INIT_VAL ; TEST_MESSAGES > number ; number ++)
+	{
+		TEST_CHECK(number == add(number, 8, INIT_VAL));
+	}
+
+	TEST_CHECK(tx_schedule_success == CAN_tx_schedule_set_period(&schedule, 2, 4, INIT_VAL));
+	run(INIT_VAL, 800);
+
+	TEST_CHECK(1 == most_per_tick);
+	TEST_CHECK(200 == sent[2]);
+	TEST_CHECK(100 == sent[3]);
+}
+
+int main(void)
+{
+	test_same_period();
+	test_mixed_periods();
+	test_missed_periods();
+	test_tick_wrap();
+	test_invalid();
+	test_set_period();
+
+	return host_test_result();
+}
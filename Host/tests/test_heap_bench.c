@@ -0,0 +1,298 @@
+/*!
+ 	 \file test_heap_bench.c
+
+ 	 \brief This is the host benchmark of the FreeRTOS heap. The same long
+ 	 	 	 random workload of kernel objects created and deleted (Tasks with
+ 	 	 	 their TCB and stack, queues, timers and event groups, with the
+ 	 	 	 sizes of the target) runs on the heap pools and on heap_2, the
+ 	 	 	 heap they replaced. It is built once with heap_pool.c
+ 	 	 	 (HEAP_BENCH_POOL) and once with heap_2.c, and prints the time of
+ 	 	 	 pvPortMalloc and vPortFree and the requests that failed.
+
+ 	 \note The objects alive never need more than the blocks of each class of
+ 	 	 	 the pools, nor more than the bytes of heap_2, so a failure is due
+ 	 	 	 to the fragmentation of the heap. The times include the reading
+ 	 	 	 of the host clock.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "FreeRTOS.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+/** Defines the name of the heap under test*/
+#ifdef HEAP_BENCH_POOL
+#define HEAP_NAME			"heap_pool"
+#else
+#define HEAP_NAME			"heap_2"
+#endif
+/** Defines the steps of the workload, each one creates or deletes an object*/
+#define BENCH_STEPS			(1000000UL)
+/** Defines the seed of the workload, the same for both heaps*/
+#define BENCH_SEED			(0x48454D49UL)
+/** Defines the blocks of the biggest object*/
+#define MAX_PARTS			(2)
+/** Defines the most objects alive of a kind*/
+#define MAX_ALIVE			(5)
+/** Defines the nanoseconds of a second*/
+#define NS_PER_S			(1000000000ULL)
+
+/*!
+ 	 \brief Kind of kernel object of the workload.
+ */
+typedef struct
+{
+	const char* name;			/*!< Name of the kind*/
+	uint16_t size[MAX_PARTS];	/*!< Bytes of each block of the object (0 for no block)*/
+	uint8_t max_alive;			/*!< Most objects of the kind alive at the same time*/
+}bench_kind_t;
+
+/*!
+ 	 \brief Times of a heap function.
+ */
+typedef struct
+{
+	uint64_t total;		/*!< Sum of the times, in ns*/
+	uint64_t max;		/*!< Longest time, in ns*/
+	uint32_t count;		/*!< Calls timed*/
+}bench_time_t;
+
+/** Kinds of objects, with the sizes of the target (A TCB of 88 bytes, the stacks of 128 and 200
+ 	 words). The alive ones fit in the classes of the pools: 5 blocks of 48 bytes, 11 of 96, 2 of 128,
+ 	 3 of 256, 3 of 512 and 6 of 800*/
+static const bench_kind_t kinds[] =
+{
+	{"task",		{88U, 800U},	5U},
+	{"small task",	{88U, 512U},	3U},
+	{"queue",		{80U, 0U},		3U},
+	{"ADC queue",	{120U, 0U},		2U},
+	{"timer queue",	{200U, 0U},		3U},
+	{"timer",		{44U, 0U},		3U},
+	{"event group",	{32U, 0U},		2U},
+};
+
+/** Number of kinds*/
+#define KINDS				(sizeof(kinds) / sizeof(kinds[0]))
+
+/** Blocks of the objects alive of each kind*/
+static void* alive[KINDS][MAX_ALIVE][MAX_PARTS];
+/** Objects alive of each kind*/
+static uint8_t alive_count[KINDS];
+/** State of the random numbers*/
+static uint32_t seed = BENCH_SEED;
+/** Times of the functions, and of pvPortMalloc in the last quarter of the workload*/
+static bench_time_t malloc_time;
+static bench_time_t malloc_late_time;
+static bench_time_t free_time;
+/** Objects that could not be created, and the calls to the malloc failed hook*/
+static uint32_t create_failed;
+static uint32_t malloc_failed;
+/** Fewest free bytes seen in a failure*/
+static size_t failed_free_bytes = (size_t)-1;
+
+/** Counts the failures of the heap (The hook of heap_pool.c stops the application)*/
+void vApplicationMallocFailedHook(void)
+{
+	malloc_failed ++;
+}
+
+/** Gets a random number (Linear congruential generator, the same sequence on every host)*/
+static uint32_t bench_random(void)
+{
+	seed = (seed * 1103515245UL) + 12345UL;
+
+	return seed >> 16;
+}
+
+/** Gets the time of the host, in ns*/
+static uint64_t now_ns(void)
+{
+	/** Time of the monotonic clock*/
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * NS_PER_S) + (uint64_t)now.tv_nsec;
+}
+
+/** Adds the time of a call*/
+static void time_add(bench_time_t* time, uint64_t value)
+{
+	time->total += value;
+	time->max = (time->max < value) ? value : time->max;
+	time->count ++;
+}
+
+/** Prints the times of a function*/
+static void time_print(const char* name, const bench_time_t* time)
+{
+	printf("  %-22s %8u calls, avg %6.1f ns, max %8.1f us\n", name, time->count,
+		(0U == time->count) ? 0.0 : (double)time->total / time->count, (double)time->max / 1000.0);
+}
+
+/** Takes a block, and times it*/
+static void* bench_malloc(size_t size, uint8_t late)
+{
+	/** Block taken*/
+	void* block;
+	/** Start of the call*/
+	uint64_t start = now_ns();
+	/** Length of the call*/
+	uint64_t length;
+
+	block = pvPortMalloc(size);
+	length = now_ns() - start;
+
+	time_add(&malloc_time, length);
+	if(late)
+	{
+		time_add(&malloc_late_time, length);
+	}
+
+	return block;
+}
+
+/** Returns a block, and times it*/
+static void bench_free(void* block)
+{
+	/** Start of the call*/
+	uint64_t start = now_ns();
+
+	vPortFree(block);
+	time_add(&free_time, now_ns() - start);
+}
+
+/** Deletes an object, the blocks are returned in the opposite order (The stack before the TCB)*/
+static void object_delete(void** parts)
+{
+	/** Counter for the blocks*/
+	uint8_t part = MAX_PARTS;
+
+	while(INIT_VAL < part)
+	{
+		part --;
+		if(NULL != parts[part])
+		{
+			bench_free(parts[part]);
+			parts[part] = NULL;
+		}
+	}
+}
+
+/** Creates an object of a kind, it returns 0 if a block is missing (The blocks taken are returned)*/
+static uint8_t object_create(const bench_kind_t* kind, void** parts, uint8_t late)
+{
+	/** Counter for the blocks*/
+	uint8_t part;
+	/** Free bytes before the object*/
+	size_t free_bytes = xPortGetFreeHeapSize();
+
+	for(part = INIT_VAL ; MAX_PARTS > part ; part ++)
+	{
+		parts[part] = NULL;
+		if(INIT_VAL != kind->size[part])
+		{
+			parts[part] = bench_malloc(kind->size[part], late);
+			if(NULL == parts[part])
+			{
+				failed_free_bytes = (failed_free_bytes > free_bytes) ? free_bytes : failed_free_bytes;
+				object_delete(parts);
+				return 0U;
+			}
+		}
+	}
+
+	return 1U;
+}
+
+/** Creates and deletes random objects, the same sequence for both heaps*/
+static void bench_workload(void)
+{
+	/** Counter for the steps*/
+	uint32_t step;
+	/** Kind and object of a step*/
+	uint32_t kind;
+	uint32_t object;
+	/** Free bytes before the workload*/
+	size_t free_bytes = xPortGetFreeHeapSize();
+	/** Indicates the last quarter of the workload*/
+	uint8_t late;
+
+	for(step = INIT_VAL ; BENCH_STEPS > step ; step ++)
+	{
+		kind = bench_random() % KINDS;
+		late = ((BENCH_STEPS - (BENCH_STEPS / 4U)) <= step) ? 1U : 0U;
+
+		/** Creates an object if the kind has room, half of the times when some are alive*/
+		if((kinds[kind].max_alive > alive_count[kind]) && ((INIT_VAL == alive_count[kind]) || (bench_random() & 1U)))
+		{
+			if(object_create(&kinds[kind], alive[kind][alive_count[kind]], late))
+			{
+				alive_count[kind] ++;
+			}
+			else
+			{
+				create_failed ++;
+			}
+		}
+
+		/** Deletes a random object, the last one takes its place*/
+		else if(INIT_VAL != alive_count[kind])
+		{
+			object = bench_random() % alive_count[kind];
+			object_delete(alive[kind][object]);
+			alive_count[kind] --;
+			alive[kind][object][0] = alive[kind][alive_count[kind]][0];
+			alive[kind][object][1] = alive[kind][alive_count[kind]][1];
+		}
+	}
+
+	printf("%s, %lu random creations and deletions of kernel objects:\n", HEAP_NAME, BENCH_STEPS);
+	time_print("pvPortMalloc", &malloc_time);
+	time_print("pvPortMalloc, last 1/4", &malloc_late_time);
+	time_print("vPortFree", &free_time);
+	printf("  %u objects not created, %u requests failed", create_failed, malloc_failed);
+	if(INIT_VAL != create_failed)
+	{
+		printf(" (with %u bytes free or more)", (uint32_t)failed_free_bytes);
+	}
+	printf("\n");
+
+	/** Every object is deleted, the heap gets all its bytes back*/
+	for(kind = INIT_VAL ; KINDS > kind ; kind ++)
+	{
+		while(INIT_VAL != alive_count[kind])
+		{
+			alive_count[kind] --;
+			object_delete(alive[kind][alive_count[kind]]);
+		}
+	}
+	TEST_CHECK(free_bytes == xPortGetFreeHeapSize());
+	TEST_CHECK(INIT_VAL == host_test_critical_nesting());
+
+#ifdef HEAP_BENCH_POOL
+	/** The objects alive fit in the classes, so the pools never fail*/
+	TEST_CHECK(INIT_VAL == create_failed);
+	TEST_CHECK(INIT_VAL == malloc_failed);
+#endif
+}
+
+int main(void)
+{
+	/** The first request initializes the heap*/
+	vPortFree(pvPortMalloc(kinds[0].size[0]));
+
+	bench_workload();
+
+	return host_test_result();
+}
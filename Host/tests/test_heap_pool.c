@@ -0,0 +1,201 @@
+/*!
+ 	 \file test_heap_pool.c
+
+ 	 \brief This is the host test of the FreeRTOS heap of fixed size blocks.
+ 	 	 	 The blocks of each size class are taken and returned, and the
+ 	 	 	 malloc failed hook is replaced to count the failed requests.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "host_test.h"
+#include "heap_pool.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL			(0)
+/** Defines the most blocks taken by a test*/
+#define MAX_BLOCKS			(64)
+
+/** Calls to the malloc failed hook*/
+static uint32_t malloc_failed;
+/** Statistics of each class*/
+static heap_pool_stats_t stats[HEAP_POOL_CLASSES];
+/** Bytes of all the pools*/
+static size_t heap_size;
+
+/** Replaces the hook of heap_pool.c, that stops the application*/
+void vApplicationMallocFailedHook(void)
+{
+	malloc_failed ++;
+}
+
+/** Reads the statistics of every class*/
+static void read_stats(void)
+{
+	/** Variable to go through the classes*/
+	uint8_t size_class;
+
+	for(size_class = INIT_VAL ; HEAP_POOL_CLASSES > size_class ; size_class ++)
+	{
+		heap_pool_get_stats(size_class, &stats[size_class]);
+	}
+}
+
+/** Takes every free block of a class, with the size of the blocks*/
+static uint16_t take_class(uint8_t size_class, void** blocks)
+{
+	/** Blocks taken*/
+	uint16_t count = INIT_VAL;
+
+	read_stats();
+	while((stats[size_class].blocks > stats[size_class].used) && (MAX_BLOCKS > count))
+	{
+		blocks[count] = pvPortMalloc(stats[size_class].block_size);
+		TEST_CHECK(NULL != blocks[count]);
+		count ++;
+		read_stats();
+	}
+
+	return count;
+}
+
+/** Returns the blocks taken*/
+static void give_back(void** blocks, uint16_t count)
+{
+	while(INIT_VAL < count)
+	{
+		count --;
+		vPortFree(blocks[count]);
+	}
+}
+
+/** The classes grow, fit in configTOTAL_HEAP_SIZE and are free before the first request*/
+static void test_classes(void)
+{
+	/** Variable to go through the classes*/
+	uint8_t size_class;
+
+	read_stats();
+	heap_size = INIT_VAL;
+
+	for(size_class = INIT_VAL ; HEAP_POOL_CLASSES > size_class ; size_class ++)
+	{
+		TEST_CHECK(INIT_VAL < stats[size_class].blocks);
+		TEST_CHECK(INIT_VAL == stats[size_class].used);
+		TEST_CHECK(INIT_VAL == (stats[size_class].block_size % portBYTE_ALIGNMENT));
+		TEST_CHECK((INIT_VAL == size_class) || (stats[size_class - 1].block_size < stats[size_class].block_size));
+		heap_size += (size_t)stats[size_class].block_size * stats[size_class].blocks;
+	}
+
+	TEST_CHECK(configTOTAL_HEAP_SIZE >= heap_size);
+	TEST_CHECK(heap_size == xPortGetFreeHeapSize());
+}
+
+/** A request takes a block of the smallest class that fits it*/
+static void test_smallest_fit(void)
+{
+	/** Variable to go through the classes*/
+	uint8_t size_class;
+	/** Block of each class*/
+	void* blocks[HEAP_POOL_CLASSES];
+	/** Bytes of the blocks taken*/
+	size_t taken = INIT_VAL;
+
+	for(size_class = INIT_VAL ; HEAP_POOL_CLASSES > size_class ; size_class ++)
+	{
+		/** One byte more than the previous class*/
+		blocks[size_class] = pvPortMalloc((INIT_VAL == size_class) ? 1U : (stats[size_class - 1].block_size + 1U));
+		TEST_CHECK(NULL != blocks[size_class]);
+		TEST_CHECK(INIT_VAL == ((uintptr_t)blocks[size_class] % portBYTE_ALIGNMENT));
+		taken += stats[size_class].block_size;
+	}
+
+	read_stats();
+	for(size_class = INIT_VAL ; HEAP_POOL_CLASSES > size_class ; size_class ++)
+	{
+		TEST_CHECK(1 == stats[size_class].used);
+	}
+	TEST_CHECK((heap_size - taken) == xPortGetFreeHeapSize());
+
+	/** A returned block is the next one taken*/
+	vPortFree(blocks[2]);
+	TEST_CHECK(blocks[2] == pvPortMalloc(stats[2].block_size));
+
+	give_back(blocks, HEAP_POOL_CLASSES);
+	read_stats();
+	TEST_CHECK(INIT_VAL == stats[2].used);
+	TEST_CHECK(1 == stats[2].high_water);
+	TEST_CHECK(heap_size == xPortGetFreeHeapSize());
+}
+
+/** An empty class is served by the next bigger class*/
+static void test_fallback(void)
+{
+	/** Blocks of class 0*/
+	void* blocks[MAX_BLOCKS];
+	/** Blocks taken from class 0*/
+	uint16_t count = take_class(INIT_VAL, blocks);
+	/** Block taken from class 1*/
+	void* bigger;
+
+	TEST_CHECK(stats[0].blocks == count);
+	bigger = pvPortMalloc(stats[0].block_size);
+	TEST_CHECK(NULL != bigger);
+
+	read_stats();
+	TEST_CHECK(1 == stats[1].used);
+	TEST_CHECK(INIT_VAL == stats[0].failed);
+	TEST_CHECK(INIT_VAL == malloc_failed);
+
+	vPortFree(bigger);
+	give_back(blocks, count);
+	read_stats();
+	TEST_CHECK((INIT_VAL == stats[0].used) && (INIT_VAL == stats[1].used));
+}
+
+/** A request that no block can serve calls the hook, and it is counted in the class that fits it*/
+static void test_failure(void)
+{
+	/** Blocks of the biggest class*/
+	void* blocks[MAX_BLOCKS];
+	/** Biggest class*/
+	uint8_t last = HEAP_POOL_CLASSES - 1;
+	/** Blocks taken from the biggest class*/
+	uint16_t count = take_class(last, blocks);
+	/** Block of the smallest class*/
+	void* smaller;
+
+	TEST_CHECK(NULL == pvPortMalloc(stats[last].block_size));
+	TEST_CHECK(1 == malloc_failed);
+	read_stats();
+	TEST_CHECK(1 == stats[last].failed);
+
+	/** Bigger than every block*/
+	TEST_CHECK(NULL == pvPortMalloc(stats[last].block_size + 1U));
+	TEST_CHECK(2 == malloc_failed);
+
+	/** The smaller classes still serve their requests*/
+	smaller = pvPortMalloc(stats[0].block_size);
+	TEST_CHECK(NULL != smaller);
+	TEST_CHECK(2 == malloc_failed);
+
+	vPortFree(smaller);
+	give_back(blocks, count);
+	TEST_CHECK(heap_size == xPortGetFreeHeapSize());
+	TEST_CHECK(INIT_VAL == host_test_critical_nesting());
+}
+
+int main(void)
+{
+	test_classes();
+	test_smallest_fit();
+	test_fallback();
+	test_failure();
+
+	return host_test_result();
+}
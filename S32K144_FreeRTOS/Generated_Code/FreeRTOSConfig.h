@@ -91,16 +91,16 @@
 #define configTICK_RATE_HZ                       ( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES                     ( 8 )
 #define configMINIMAL_STACK_SIZE                 ( ( unsigned short ) 200 )
-#define configTOTAL_HEAP_SIZE                    ( ( size_t ) 8192 )
+#define configTOTAL_HEAP_SIZE                    ( ( size_t ) 8704 )
 #define configMAX_TASK_NAME_LEN                  ( 12 )
-#define configUSE_TRACE_FACILITY                 0
+#define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
 #define configIDLE_SHOULD_YIELD                  1
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                0
-#define configCHECK_FOR_STACK_OVERFLOW           0
+#define configCHECK_FOR_STACK_OVERFLOW           2
 #define configUSE_RECURSIVE_MUTEXES              1
-#define configUSE_MALLOC_FAILED_HOOK             0
+#define configUSE_MALLOC_FAILED_HOOK             1
 #define configUSE_APPLICATION_TASK_TAG           0
 #define configUSE_COUNTING_SEMAPHORES            1
 
@@ -151,9 +151,15 @@ FreeRTOS/Source/tasks.c for limitations. */
 	unsigned long ulMainGetRunTimeCounterValue( void );
 #endif
 
-#define configGENERATE_RUN_TIME_STATS            0
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vMainConfigureTimerForRunTimeStats() /* DWT cycle counter */
+#define portGET_RUN_TIME_COUNTER_VALUE() DWT_CYCCNT /* DWT->CYCCNT, one read per context switch */
 
 
+/* User definitions */
+#include "trace_recorder.h" /* Kernel trace hooks */
+#include "runtime_stats.h" /* DWT cycle counter */
+
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
   #define configPRIO_BITS                         __NVIC_PRIO_BITS
@@ -187,7 +193,7 @@ See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #define configASSERT(x)                          if((x)==0) { taskDISABLE_INTERRUPTS(); for( ;; ); }
 
 /* Tickless Idle Mode */
-#define configUSE_TICKLESS_IDLE                  0 
+#define configUSE_TICKLESS_IDLE                  1 
 #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2 
 #define configUSE_TICKLESS_IDLE_DECISION_HOOK    0 
 
@@ -23,7 +23,7 @@ void ADC_init(void)  {
                                   /* ACFE,ACFGT,ACREN=0: Compare func disabled */
                                   /* DMAEN=0: DMA disabled */
                                   /* REFSEL=0: Voltage reference pins= VREFH, VREEFL */
-  ADC0->SC3 = 0x00000000;         /* CAL=0: Do not start calibration sequence */
+  ADC0->SC3 = 0x00000000;         /* CAL=0: Do not start calibration sequence (See ADC_calibration_init) */
                                   /* ADCO=0: One conversion performed */
                                   /* AVGE,AVGS=0: HW average function disabled */
 }
@@ -33,6 +33,11 @@ void convertAdcChan(uint16_t adcChan) {   /* For SW trigger mode, SC1[0] is used
   ADC0->SC1[0] = ADC_SC1_ADCH(adcChan);   /* Initiate Conversion*/
 }
 
+void convertAdcChan_interrupt(uint16_t adcChan) {   /* Same as convertAdcChan, with the COCO interrupt */
+  ADC0->SC1[0] = ADC_SC1_AIEN_MASK                  /* AIEN=1: Interrupt when the conversion completes */
+               | ADC_SC1_ADCH(adcChan);             /* Initiate Conversion*/
+}
+
 uint8_t adc_complete(void)  {
   return ((ADC0->SC1[0] & ADC_SC1_COCO_MASK)>>ADC_SC1_COCO_SHIFT); /* Wait for completion */
 }
@@ -40,6 +45,10 @@ uint8_t adc_complete(void)  {
 uint32_t read_adc_chx(void)  {
   uint16_t adc_result=0;
   adc_result=ADC0->R[0];      /* For SW trigger mode, R[0] is used */
-  return  (uint32_t) ((5000*adc_result)/0xFFF); /* Convert result to mv for 0-5V range */
+  return  (uint32_t) ((adc_result*ADC_MV_MUL + ADC_MV_ROUND)>>ADC_MV_SHIFT); /* Convert result to mv for 0-5V range (5000/0xFFF) */
+}
+
+uint16_t read_adc_raw(void)  {
+  return (uint16_t)ADC0->R[0];  /* For SW trigger mode, R[0] is used, without scaling */
 }
 
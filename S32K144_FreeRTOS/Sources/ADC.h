@@ -7,9 +7,15 @@
 #define ADC_H_
 #include "S32K144.h"
 
+#define ADC_MV_MUL    (80018UL)   /* 5000/0xFFF * 2^16, multiply-shift instead of a division */
+#define ADC_MV_SHIFT  (16)
+#define ADC_MV_ROUND  (1UL << (ADC_MV_SHIFT - 1))
+
 void convertAdcChan(uint16_t);
+void convertAdcChan_interrupt(uint16_t);
 void ADC_init(void);
 uint8_t adc_complete(void);
 uint32_t read_adc_chx(void);
+uint16_t read_adc_raw(void);
 
 #endif /* ADC_H_ */
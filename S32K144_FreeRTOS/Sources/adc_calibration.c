@@ -0,0 +1,204 @@
+/*!
+ 	 \file adc_calibration.c
+
+ 	 \brief This is the source file of the ADC calibration. The calibration
+ 	 	 	 sequence runs once, and its results are kept in a RAM section that
+ 	 	 	 is not initialized by the startup code, so a warm reset restores
+ 	 	 	 them instead of calibrating again.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "adc_calibration.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the value that marks the stored results as written*/
+#define CALIBRATION_MAGIC			(0xCA1B0ADCUL)
+/** Defines the averaging of the sequence (32 conversions, as the reference manual recommends)*/
+#define CALIBRATION_AVGS			(3)
+/** Defines the default user gain*/
+#define CALIBRATION_USER_GAIN		(4)
+/** Defines the checks of the CAL bit before giving up (The sequence takes some thousands of ADC clocks)*/
+#define CALIBRATION_TIMEOUT			(0x000FFFFFUL)
+/** Defines the resets that lose the contents of the RAM*/
+#define CALIBRATION_COLD_RESETS		(RCM_SRS_POR_MASK | RCM_SRS_LVD_MASK)
+/** Defines the rotation of the checksum*/
+#define CHECKSUM_ROTATION			(1)
+/** Defines the bits of a word*/
+#define WORD_BITS					(32)
+
+/** Results of each ADC (The startup code does not initialize this section, the results survive a warm reset)*/
+static adc_calibration_t adc_calibration[ADC_INSTANCE_COUNT] __attribute__((section(".customSection")));
+
+/** This function gets the index of an ADC (ADC_INSTANCE_COUNT if it is not an ADC)*/
+static uint8_t ADC_calibration_index(ADC_Type* base)
+{
+	/** ADCs of the device*/
+	ADC_Type* const adc_bases[ADC_INSTANCE_COUNT] = ADC_BASE_PTRS;
+	/** Variable to go through the ADCs*/
+	uint8_t index = INIT_VAL;
+
+	while((ADC_INSTANCE_COUNT > index) && (adc_bases[index] != base))
+	{
+		index ++;
+	}
+
+	return index;
+}
+
+/** This function gets the checksum of the results, without the checksum word*/
+static uint32_t ADC_calibration_checksum(const adc_calibration_t* calibration)
+{
+	/** Words of the results*/
+	const uint32_t* word = (const uint32_t*)calibration;
+	/** Variable to go through the words*/
+	uint8_t index;
+	/** Checksum (Rotate and xor, so a RAM filled with a single value is not valid)*/
+	uint32_t checksum = ~((uint32_t)CALIBRATION_MAGIC);
+
+	for(index = INIT_VAL; ((sizeof(adc_calibration_t) / sizeof(uint32_t)) - 1) > index; index ++)
+	{
+		checksum = ((checksum << CHECKSUM_ROTATION) | (checksum >> (WORD_BITS - CHECKSUM_ROTATION))) ^ word[index];
+	}
+
+	return checksum;
+}
+
+/** This function writes the stored results to an ADC*/
+static void ADC_calibration_restore(ADC_Type* base, const adc_calibration_t* calibration)
+{
+	base->G = calibration->gain;
+	base->OFS = calibration->offset;
+	base->CLPS = calibration->clp[0];
+	base->CLP3 = calibration->clp[1];
+	base->CLP2 = calibration->clp[2];
+	base->CLP1 = calibration->clp[3];
+	base->CLP0 = calibration->clp[4];
+	base->CLPX = calibration->clp[5];
+	base->CLP9 = calibration->clp[6];
+	base->CLPS_OFS = calibration->clp_ofs[0];
+	base->CLP3_OFS = calibration->clp_ofs[1];
+	base->CLP2_OFS = calibration->clp_ofs[2];
+	base->CLP1_OFS = calibration->clp_ofs[3];
+	base->CLP0_OFS = calibration->clp_ofs[4];
+	base->CLPX_OFS = calibration->clp_ofs[5];
+	base->CLP9_OFS = calibration->clp_ofs[6];
+}
+
+/** This function reads the results of the sequence from an ADC*/
+static void ADC_calibration_store(ADC_Type* base, adc_calibration_t* calibration)
+{
+	calibration->magic = CALIBRATION_MAGIC;
+	calibration->gain = base->G;
+	calibration->offset = base->OFS;
+	calibration->clp[0] = base->CLPS;
+	calibration->clp[1] = base->CLP3;
+	calibration->clp[2] = base->CLP2;
+	calibration->clp[3] = base->CLP1;
+	calibration->clp[4] = base->CLP0;
+	calibration->clp[5] = base->CLPX;
+	calibration->clp[6] = base->CLP9;
+	calibration->clp_ofs[0] = base->CLPS_OFS;
+	calibration->clp_ofs[1] = base->CLP3_OFS;
+	calibration->clp_ofs[2] = base->CLP2_OFS;
+	calibration->clp_ofs[3] = base->CLP1_OFS;
+	calibration->clp_ofs[4] = base->CLP0_OFS;
+	calibration->clp_ofs[5] = base->CLPX_OFS;
+	calibration->clp_ofs[6] = base->CLP9_OFS;
+	calibration->checksum = ADC_calibration_checksum(calibration);
+}
+
+/** This function runs the calibration sequence of an ADC, and stores its results*/
+adc_calibration_status_t ADC_calibration_run(ADC_Type* base)
+{
+	/** Index of the ADC*/
+	uint8_t index = ADC_calibration_index(base);
+	/** Trigger configuration, restored after the sequence*/
+	uint32_t sc2;
+	/** Averaging configuration, restored after the sequence*/
+	uint32_t sc3;
+	/** Checks left before giving up*/
+	uint32_t timeout = CALIBRATION_TIMEOUT;
+
+	if(ADC_INSTANCE_COUNT <= index)
+	{
+		return adc_calibration_invalid_adc;
+	}
+
+	sc2 = base->SC2;
+	sc3 = base->SC3;
+
+	/** The sequence needs the software trigger and the default user gain*/
+	base->SC2 = sc2 & ~ADC_SC2_ADTRG_MASK;
+	base->UG = ADC_UG_UG(CALIBRATION_USER_GAIN);
+
+	/** Starts the sequence, averaging 32 conversions*/
+	base->SC3 = ADC_SC3_CAL_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(CALIBRATION_AVGS);
+
+	/** The CAL bit clears when the sequence finishes*/
+	while((ADC_SC3_CAL_MASK == (base->SC3 & ADC_SC3_CAL_MASK)) && (INIT_VAL != timeout))
+	{
+		timeout --;
+	}
+
+	/** Restores the configuration*/
+	base->SC2 = sc2;
+	base->SC3 = sc3 & ~ADC_SC3_CAL_MASK;
+
+	if(INIT_VAL == timeout)
+	{
+		/** Invalidates the stored results, the next reset tries again*/
+		adc_calibration[index].magic = INIT_VAL;
+		return adc_calibration_timeout;
+	}
+
+	ADC_calibration_store(base, &adc_calibration[index]);
+
+	return adc_calibration_done;
+}
+
+/** This function calibrates an ADC, or restores its calibration*/
+adc_calibration_status_t ADC_calibration_init(ADC_Type* base)
+{
+	/** Index of the ADC*/
+	uint8_t index = ADC_calibration_index(base);
+
+	if(ADC_INSTANCE_COUNT <= index)
+	{
+		return adc_calibration_invalid_adc;
+	}
+
+	/** After a warm reset the results of the last calibration are still in RAM (The reset status is checked
+	 	 first, the RAM is not read after a power-on)*/
+	if((INIT_VAL == (RCM->SRS & CALIBRATION_COLD_RESETS)) &&
+		(CALIBRATION_MAGIC == adc_calibration[index].magic) &&
+		(ADC_calibration_checksum(&adc_calibration[index]) == adc_calibration[index].checksum))
+	{
+		ADC_calibration_restore(base, &adc_calibration[index]);
+		return adc_calibration_restored;
+	}
+
+	return ADC_calibration_run(base);
+}
+
+/** This function gets the stored calibration of an ADC*/
+adc_calibration_status_t ADC_calibration_get(ADC_Type* base, adc_calibration_t* calibration)
+{
+	/** Index of the ADC*/
+	uint8_t index = ADC_calibration_index(base);
+
+	if((ADC_INSTANCE_COUNT <= index) || (CALIBRATION_MAGIC != adc_calibration[index].magic))
+	{
+		return adc_calibration_invalid_adc;
+	}
+
+	*calibration = adc_calibration[index];
+
+	return adc_calibration_restored;
+}
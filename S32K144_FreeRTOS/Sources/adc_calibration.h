@@ -0,0 +1,87 @@
+/*!
+ 	 \file adc_calibration.h
+
+ 	 \brief This is the header file of the ADC calibration. The calibration
+ 	 	 	 sequence runs once, and its results are kept in a RAM section that
+ 	 	 	 is not initialized by the startup code, so a warm reset restores
+ 	 	 	 them instead of calibrating again.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef ADC_CALIBRATION_H_
+#define ADC_CALIBRATION_H_
+
+#include "S32K144.h"
+
+/** Defines the number of plus-side calibration values of an ADC*/
+#define ADC_CALIBRATION_CLP_COUNT		(7)
+
+/*!
+ 	 \brief Enumerator to define the result of the calibration.
+ */
+typedef enum
+{
+	adc_calibration_restored,	/*!< The results of a previous calibration were restored (Warm reset)*/
+	adc_calibration_done,		/*!< The calibration sequence ran, and its results were stored*/
+	adc_calibration_timeout,	/*!< The calibration sequence did not finish*/
+	adc_calibration_invalid_adc	/*!< The base is not ADC0 nor ADC1, or there are no results*/
+}adc_calibration_status_t;
+
+/*!
+ 	 \brief Results of the calibration of an ADC.
+ */
+typedef struct
+{
+	uint32_t magic;								/*!< Marks the results as written*/
+	uint32_t gain;								/*!< Gain (G)*/
+	uint32_t offset;							/*!< Offset (OFS)*/
+	uint32_t clp[ADC_CALIBRATION_CLP_COUNT];		/*!< Plus-side values (CLPS, CLP3, CLP2, CLP1, CLP0, CLPX and CLP9)*/
+	uint32_t clp_ofs[ADC_CALIBRATION_CLP_COUNT];	/*!< Offsets of the plus-side values, in the same order*/
+	uint32_t checksum;							/*!< Checksum of the results, with the magic*/
+}adc_calibration_t;
+
+/*!
+ 	 \brief This function calibrates an ADC, or restores its calibration.
+
+ 	 \note It must be called after the ADC is configured (Clock and mode).
+ 	 	 	 After a power-on or a low voltage reset the sequence always runs,
+ 	 	 	 since the RAM lost its contents. After any other reset the stored
+ 	 	 	 results are written back to the ADC if they are valid.
+
+ 	 \param[in] base ADC to be calibrated (ADC0 or ADC1).
+
+ 	 \return Whether the calibration was restored, done, or failed.
+ */
+adc_calibration_status_t ADC_calibration_init(ADC_Type* base);
+
+/*!
+ 	 \brief This function runs the calibration sequence of an ADC, even if
+ 	 	 	 there are valid stored results, and stores the new results.
+
+ 	 \note Useful when the temperature or the supply changed since the last
+ 	 	 	 calibration. The ADC can not convert while it is calibrating.
+
+ 	 \param[in] base ADC to be calibrated (ADC0 or ADC1).
+
+ 	 \return Whether the calibration was done, or failed.
+ */
+adc_calibration_status_t ADC_calibration_run(ADC_Type* base);
+
+/*!
+ 	 \brief This function gets the stored calibration of an ADC.
+
+ 	 \param[in] base ADC of the calibration (ADC0 or ADC1).
+ 	 \param[out] calibration Copy of the stored calibration.
+
+ 	 \return adc_calibration_restored if there are results,
+ 	 	 	 adc_calibration_invalid_adc otherwise.
+ */
+adc_calibration_status_t ADC_calibration_get(ADC_Type* base, adc_calibration_t* calibration);
+
+#endif /* ADC_CALIBRATION_H_ */
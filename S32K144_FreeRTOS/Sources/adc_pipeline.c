@@ -0,0 +1,119 @@
+/*!
+ 	 \file adc_pipeline.c
+
+ 	 \brief This is the source file of the ADC sample pipeline. Each channel
+ 	 	 	 has its own pipeline: a decimating IIR filter, a multiply-shift
+ 	 	 	 scaling and an optional hysteresis. The hardware averaging of the
+ 	 	 	 ADC is configured here too.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "adc_pipeline.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the fraction bits of the IIR filter state*/
+#define IIR_FRACTION_BITS			(8)
+/** Defines half of the LSB of the filter state, to round it*/
+#define IIR_ROUND					(1UL << (IIR_FRACTION_BITS - 1))
+/** Defines that an output was produced*/
+#define PIPELINE_OUTPUT				(1)
+/** Defines that no output was produced*/
+#define PIPELINE_NO_OUTPUT			(0)
+/** Defines the filter as primed*/
+#define PIPELINE_PRIMED				(1)
+/** Defines the fraction bits of the trim gain*/
+#define TRIM_FRACTION_BITS			(16)
+/** Defines half of the LSB of the trim gain, to round it*/
+#define TRIM_ROUND					(1ULL << (TRIM_FRACTION_BITS - 1))
+/** Defines the AVGS value for 4 conversions (adc_hw_average_4)*/
+#define AVGS_OFFSET					(1)
+
+/** This function sets the hardware averaging of an ADC*/
+void ADC_pipeline_set_hw_average(ADC_Type* base, adc_hw_average_t average)
+{
+	/** Keeps the rest of the configuration (CAL and ADCO)*/
+	uint32_t sc3 = base->SC3 & ~(ADC_SC3_AVGE_MASK | ADC_SC3_AVGS_MASK);
+
+	if(adc_hw_average_off != average)
+	{
+		sc3 |= ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(average - AVGS_OFFSET);
+	}
+
+	base->SC3 = sc3;
+}
+
+/** This function initializes the pipeline of a channel*/
+void ADC_pipeline_init(adc_pipeline_t* pipeline, const adc_pipeline_config_t* config)
+{
+	pipeline->config = *config;
+	pipeline->filtered = INIT_VAL;
+	pipeline->primed = INIT_VAL;
+	pipeline->decimation_count = INIT_VAL;
+	pipeline->output = INIT_VAL;
+}
+
+/** This function passes a raw result through the pipeline*/
+uint8_t ADC_pipeline_process(adc_pipeline_t* pipeline, uint16_t raw, uint16_t* output)
+{
+	/** Sample with the fraction bits of the filter*/
+	uint32_t sample = (uint32_t)raw << IIR_FRACTION_BITS;
+	/** Scaled value of the filter, before the shift*/
+	int32_t scaled_wide;
+	/** Scaled value of the filter*/
+	uint16_t scaled;
+	/** Distance from the last output*/
+	uint16_t change;
+
+	/** The first sample sets the filter, so it does not start from 0*/
+	if(PIPELINE_PRIMED != pipeline->primed)
+	{
+		pipeline->filtered = sample;
+		pipeline->primed = PIPELINE_PRIMED;
+	}
+
+	/** IIR filter, y += (x - y) / 2^shift (Signed, the sample can be lower than the state)*/
+	else
+	{
+		pipeline->filtered = (uint32_t)((int32_t)pipeline->filtered +
+			(((int32_t)sample - (int32_t)pipeline->filtered) >> pipeline->config.iir_shift));
+	}
+
+	/** Decimation, the filter runs with every sample*/
+	pipeline->decimation_count ++;
+	if(pipeline->decimation_count < pipeline->config.decimation)
+	{
+		return PIPELINE_NO_OUTPUT;
+	}
+	pipeline->decimation_count = INIT_VAL;
+
+	/** Multiply-add and shift scaling of the rounded filter value (Negative results are clamped to 0)*/
+	scaled_wide = (int32_t)(((pipeline->filtered + IIR_ROUND) >> IIR_FRACTION_BITS) * pipeline->config.scale_mul) +
+		pipeline->config.scale_offset;
+	scaled = (INIT_VAL > scaled_wide) ? INIT_VAL : (uint16_t)(scaled_wide >> pipeline->config.scale_shift);
+
+	/** Hysteresis, small changes keep the last output*/
+	change = (scaled > pipeline->output) ? (scaled - pipeline->output) : (pipeline->output - scaled);
+	if((INIT_VAL == pipeline->config.hysteresis) || (change >= pipeline->config.hysteresis))
+	{
+		pipeline->output = scaled;
+	}
+
+	*output = pipeline->output;
+
+	return PIPELINE_OUTPUT;
+}
+
+/** This function folds a gain and offset trim into the scaling of a configuration*/
+void ADC_pipeline_apply_trim(adc_pipeline_config_t* config, uint32_t gain_q16, int16_t offset)
+{
+	/** The offset is scaled with the multiplier before the gain changes it*/
+	config->scale_offset += (int32_t)offset * (int32_t)config->scale_mul;
+	config->scale_mul = (uint32_t)(((uint64_t)config->scale_mul * gain_q16 + TRIM_ROUND) >> TRIM_FRACTION_BITS);
+}
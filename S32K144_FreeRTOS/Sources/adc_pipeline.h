@@ -0,0 +1,111 @@
+/*!
+ 	 \file adc_pipeline.h
+
+ 	 \brief This is the header file of the ADC sample pipeline. Each channel
+ 	 	 	 has its own pipeline: a decimating IIR filter, a multiply-shift
+ 	 	 	 scaling and an optional hysteresis. The hardware averaging of the
+ 	 	 	 ADC is configured here too.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef ADC_PIPELINE_H_
+#define ADC_PIPELINE_H_
+
+#include "S32K144.h"
+
+/*!
+ 	 \brief Enumerator to define the hardware averaging of an ADC.
+ */
+typedef enum
+{
+	adc_hw_average_off,		/*!< Each result is one conversion*/
+	adc_hw_average_4,		/*!< Each result is the average of 4 conversions*/
+	adc_hw_average_8,		/*!< Each result is the average of 8 conversions*/
+	adc_hw_average_16,		/*!< Each result is the average of 16 conversions*/
+	adc_hw_average_32		/*!< Each result is the average of 32 conversions*/
+}adc_hw_average_t;
+
+/*!
+ 	 \brief Configuration of the pipeline of a channel.
+ */
+typedef struct
+{
+	uint8_t iir_shift;		/*!< IIR filter y += (x - y) / 2^iir_shift (0 disables the filter)*/
+	uint8_t decimation;		/*!< One output every decimation samples (0 or 1 for every sample)*/
+	uint32_t scale_mul;		/*!< Output = ((filtered * scale_mul) + scale_offset) >> scale_shift*/
+	int32_t scale_offset;	/*!< Offset of the scaling, with the rounding and any trim folded in*/
+	uint8_t scale_shift;	/*!< Shift of the scaling*/
+	uint16_t hysteresis;	/*!< The output only changes if it moves at least this much (0 disables it)*/
+}adc_pipeline_config_t;
+
+/*!
+ 	 \brief Pipeline of a channel.
+ */
+typedef struct
+{
+	adc_pipeline_config_t config;	/*!< Configuration of the pipeline*/
+	uint32_t filtered;				/*!< State of the IIR filter, with 8 fraction bits*/
+	uint8_t primed;					/*!< Defines whether the filter has received its first sample*/
+	uint8_t decimation_count;		/*!< Samples since the last output*/
+	uint16_t output;				/*!< Last output*/
+}adc_pipeline_t;
+
+/*!
+ 	 \brief This function sets the hardware averaging of an ADC.
+
+ 	 \note The averaging applies to every channel of the ADC, and each result
+ 	 	 	 takes the time of all its conversions.
+
+ 	 \param[in] base ADC to be configured (ADC0 or ADC1).
+ 	 \param[in] average Conversions averaged for each result.
+
+ 	 \return void.
+ */
+void ADC_pipeline_set_hw_average(ADC_Type* base, adc_hw_average_t average);
+
+/*!
+ 	 \brief This function initializes the pipeline of a channel.
+
+ 	 \param[out] pipeline Pipeline to be initialized.
+ 	 \param[in] config Configuration of the pipeline.
+
+ 	 \return void.
+ */
+void ADC_pipeline_init(adc_pipeline_t* pipeline, const adc_pipeline_config_t* config);
+
+/*!
+ 	 \brief This function passes a raw result through the pipeline.
+
+ 	 \note It only uses additions, shifts and one multiplication, there are no
+ 	 	 	 divisions per sample.
+
+ 	 \param[in] pipeline Pipeline of the channel.
+ 	 \param[in] raw Raw result of the ADC.
+ 	 \param[out] output Scaled output, only written when the function returns 1.
+
+ 	 \return 1 when the decimation produces an output, 0 otherwise.
+ */
+uint8_t ADC_pipeline_process(adc_pipeline_t* pipeline, uint16_t raw, uint16_t* output);
+
+/*!
+ 	 \brief This function folds a gain and offset trim into the scaling of a
+ 	 	 	 configuration, so the trim costs nothing per sample.
+
+ 	 \note The scaling stays a single multiply-add:
+ 	 	 	 ((raw * gain) + offset) * mul = raw * (gain * mul) + (offset * mul).
+
+ 	 \param[in,out] config Configuration of the pipeline.
+ 	 \param[in] gain_q16 Gain of the trim, with 16 fraction bits (65536 is 1).
+ 	 \param[in] offset Offset of the trim, in raw counts.
+
+ 	 \return void.
+ */
+void ADC_pipeline_apply_trim(adc_pipeline_config_t* config, uint32_t gain_q16, int16_t offset);
+
+#endif /* ADC_PIPELINE_H_ */
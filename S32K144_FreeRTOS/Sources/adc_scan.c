@@ -0,0 +1,207 @@
+/*!
+ 	 \file adc_scan.c
+
+ 	 \brief This is the source file of the ADC scan. The PDB1 triggers, by
+ 	 	 	 hardware, a scan of a list of channels of the ADC1 at a fixed
+ 	 	 	 period. Each conversion starts when the previous one completes
+ 	 	 	 (PDB back-to-back mode), so the sampling does not depend on the
+ 	 	 	 tasks, and the CPU is only used once per scan.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "adc_scan.h"
+#include "clock_manager.h"
+#include "adc_calibration.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines a bit to be shifted*/
+#define BIT_TO_SHIFT				(1)
+/** Defines the pre-triggers of each PDB channel*/
+#define PDB_PRETRIGGERS				(8)
+/** Defines the mask of all the pre-triggers of a PDB channel*/
+#define PDB_PRETRIGGER_MASK			(0xFF)
+/** Defines the software trigger as the input of the PDB*/
+#define PDB_SOFTWARE_TRIGGER		(0x0F)
+/** Defines the maximum value of the PDB counter*/
+#define PDB_MAX_COUNT				(0xFFFF)
+/** Defines the prescaler values of the PDB (Divide by 2^PRESCALER)*/
+#define PDB_PRESCALERS				(8)
+/** Defines the multiplication factors of the PDB*/
+#define PDB_MULTS					(4)
+/** Defines the microseconds in a second*/
+#define US_PER_S					(1000000UL)
+/** Defines the SOSCDIV2 as the clock of the ADC (Same as ADC_init)*/
+#define ADC_CLOCK_SOSCDIV2			(1)
+/** Defines the channel that disables the conversions*/
+#define ADC_CHANNEL_DISABLED		(0x1F)
+/** Defines the configuration of the ADC clock and resolution (Same as ADC_init)*/
+#define ADC_CFG1_CONFIG				(0x00000004)
+/** Defines the sample time of the ADC (Same as ADC_init)*/
+#define ADC_CFG2_CONFIG				(0x0000000C)
+
+/** Division of each PDB MULT value*/
+static const uint8_t pdb_mult[PDB_MULTS] = {1, 10, 20, 40};
+
+/** Number of channels of the running scan*/
+static uint8_t scan_count = INIT_VAL;
+
+/** This function gets the PDB prescaler, MULT and modulus for a period*/
+static adc_scan_status_t ADC_scan_pdb_timing(uint32_t period_us, uint32_t* sc, uint32_t* mod)
+{
+	/** Bus clock, the clock of the PDB*/
+	uint32_t bus_clock = INIT_VAL;
+	/** PDB clocks in a period (64 bits, the product does not fit in 32)*/
+	uint64_t counts;
+	/** Variables to go through the MULT and the prescaler values*/
+	uint8_t mult;
+	uint8_t prescaler;
+
+	CLOCK_SYS_GetFreq(BUS_CLOCK, &bus_clock);
+	counts = ((uint64_t)bus_clock * period_us) / US_PER_S;
+
+	if(INIT_VAL == counts)
+	{
+		return adc_scan_invalid_period;
+	}
+
+	/** Looks for the smallest division that fits the counter, for the best resolution*/
+	for(mult = INIT_VAL; PDB_MULTS > mult; mult ++)
+	{
+		for(prescaler = INIT_VAL; PDB_PRESCALERS > prescaler; prescaler ++)
+		{
+			if(PDB_MAX_COUNT >= (counts / ((uint32_t)pdb_mult[mult] << prescaler)))
+			{
+				*sc = PDB_SC_PRESCALER(prescaler) | PDB_SC_MULT(mult);
+				*mod = (uint32_t)(counts / ((uint32_t)pdb_mult[mult] << prescaler));
+				return adc_scan_success;
+			}
+		}
+	}
+
+	return adc_scan_invalid_period;
+}
+
+/** This function configures the ADC1 and the PDB1 for the scan, and starts it*/
+adc_scan_status_t ADC_scan_start(const adc_scan_config_t* config)
+{
+	/** Prescaler and MULT of the PDB*/
+	uint32_t pdb_sc = INIT_VAL;
+	/** Modulus of the PDB*/
+	uint32_t pdb_mod = INIT_VAL;
+	/** Pre-triggers used by each PDB channel*/
+	uint32_t pretriggers;
+	/** Variable to go through the channels*/
+	uint8_t channel;
+	/** Result of the configuration*/
+	adc_scan_status_t status;
+
+	if((INIT_VAL == config->count) || (ADC_SCAN_MAX_CHANNELS < config->count))
+	{
+		return adc_scan_invalid_channels;
+	}
+
+	status = ADC_scan_pdb_timing(config->period_us, &pdb_sc, &pdb_mod);
+	if(adc_scan_success != status)
+	{
+		return status;
+	}
+
+	ADC_scan_stop();
+
+	/** Enables the clocks of the ADC1 (SOSCDIV2) and the PDB1*/
+	PCC->PCCn[PCC_ADC1_INDEX] &= ~PCC_PCCn_CGC_MASK;
+	PCC->PCCn[PCC_ADC1_INDEX] |= PCC_PCCn_PCS(ADC_CLOCK_SOSCDIV2);
+	PCC->PCCn[PCC_ADC1_INDEX] |= PCC_PCCn_CGC_MASK;
+	PCC->PCCn[PCC_PDB1_INDEX] |= PCC_PCCn_CGC_MASK;
+
+	/** The ADC1 is triggered by the PDB1 pre-triggers*/
+	SIM->ADCOPT &= ~(SIM_ADCOPT_ADC1TRGSEL_MASK | SIM_ADCOPT_ADC1SWPRETRG_MASK | SIM_ADCOPT_ADC1PRETRGSEL_MASK);
+
+	/** Configures the ADC1 as the ADC0, with hardware trigger*/
+	ADC1->CFG1 = ADC_CFG1_CONFIG;
+	ADC1->CFG2 = ADC_CFG2_CONFIG;
+	ADC1->SC2 = ADC_SC2_ADTRG_MASK;
+	ADC1->SC3 = INIT_VAL;
+
+	/** Calibrates the ADC1 the first time, or restores its calibration after a warm reset*/
+	if(adc_calibration_timeout == ADC_calibration_init(ADC1))
+	{
+		return adc_scan_calibration_failed;
+	}
+
+	/** Loads the channel list, only the last channel interrupts*/
+	for(channel = INIT_VAL; config->count > channel; channel ++)
+	{
+		ADC1->SC1[channel] = ADC_SC1_ADCH(config->channels[channel]) |
+			(((config->count - 1) == channel) ? ADC_SC1_AIEN_MASK : INIT_VAL);
+	}
+	scan_count = config->count;
+
+	/** The PDB1 restarts itself every period (Continuous mode), started by software once*/
+	PDB1->SC = pdb_sc | PDB_SC_TRGSEL(PDB_SOFTWARE_TRIGGER) | PDB_SC_CONT_MASK | PDB_SC_PDBEN_MASK;
+	PDB1->MOD = PDB_MOD_MOD(pdb_mod);
+
+	/** The channel 0 pre-triggers convert SC1[0..7], and the channel 1 pre-triggers SC1[8..15].
+	 	 The pre-trigger 0 starts with the counter, the rest wait for the previous conversion
+	 	 (Back-to-back, chained from the channel 0 pre-trigger 7 to the channel 1 pre-trigger 0)*/
+	pretriggers = (PDB_PRETRIGGERS < scan_count) ? PDB_PRETRIGGER_MASK : ((BIT_TO_SHIFT << scan_count) - 1);
+	PDB1->CH[0].DLY[0] = INIT_VAL;
+	PDB1->CH[0].C1 = PDB_C1_EN(pretriggers) | PDB_C1_TOS(BIT_TO_SHIFT) | PDB_C1_BB(pretriggers & ~BIT_TO_SHIFT);
+
+	pretriggers = (PDB_PRETRIGGERS < scan_count) ? ((BIT_TO_SHIFT << (scan_count - PDB_PRETRIGGERS)) - 1) : INIT_VAL;
+	PDB1->CH[1].C1 = PDB_C1_EN(pretriggers) | PDB_C1_BB(pretriggers);
+
+	/** Loads the registers and starts the first period*/
+	PDB1->SC |= PDB_SC_LDOK_MASK;
+	PDB1->SC |= PDB_SC_SWTRIG_MASK;
+
+	return adc_scan_success;
+}
+
+/** This function stops the scan*/
+void ADC_scan_stop(void)
+{
+	/** Variable to go through the channels*/
+	uint8_t channel;
+
+	/** Only if the clocks are enabled, the registers can be written*/
+	if(PCC->PCCn[PCC_PDB1_INDEX] & PCC_PCCn_CGC_MASK)
+	{
+		PDB1->SC &= ~PDB_SC_PDBEN_MASK;
+	}
+
+	if(PCC->PCCn[PCC_ADC1_INDEX] & PCC_PCCn_CGC_MASK)
+	{
+		for(channel = INIT_VAL; scan_count > channel; channel ++)
+		{
+			ADC1->SC1[channel] = ADC_SC1_ADCH(ADC_CHANNEL_DISABLED);
+		}
+	}
+
+	scan_count = INIT_VAL;
+}
+
+/** This function reads the results of a completed scan*/
+uint8_t ADC_scan_read(uint16_t* results)
+{
+	/** Variable to go through the channels*/
+	uint8_t channel;
+
+	for(channel = INIT_VAL; scan_count > channel; channel ++)
+	{
+		results[channel] = (uint16_t)ADC1->R[channel];
+	}
+
+	/** Clears the sequence errors (A scan longer than the period)*/
+	PDB1->CH[0].S &= ~PDB_S_ERR_MASK;
+	PDB1->CH[1].S &= ~PDB_S_ERR_MASK;
+
+	return scan_count;
+}
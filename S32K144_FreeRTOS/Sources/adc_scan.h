@@ -0,0 +1,93 @@
+/*!
+ 	 \file adc_scan.h
+
+ 	 \brief This is the header file of the ADC scan. The PDB1 triggers, by
+ 	 	 	 hardware, a scan of a list of channels of the ADC1 at a fixed
+ 	 	 	 period. Each conversion starts when the previous one completes
+ 	 	 	 (PDB back-to-back mode), so the sampling does not depend on the
+ 	 	 	 tasks, and the CPU is only used once per scan.
+
+ 	 \note The ADC0 is left for the single conversions of ADC.c.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef ADC_SCAN_H_
+#define ADC_SCAN_H_
+
+#include "S32K144.h"
+
+/** Defines the maximum number of channels of a scan (One for each SC1 register)*/
+#define ADC_SCAN_MAX_CHANNELS				(16)
+
+/*!
+ 	 \brief Enumerator to define the result of configuring the scan.
+ */
+typedef enum
+{
+	adc_scan_success,			/*!< Scan configured and started*/
+	adc_scan_invalid_channels,	/*!< No channels, or more than ADC_SCAN_MAX_CHANNELS*/
+	adc_scan_invalid_period,	/*!< Period of 0, or too long for the PDB counter*/
+	adc_scan_calibration_failed	/*!< The calibration sequence of the ADC1 did not finish*/
+}adc_scan_status_t;
+
+/*!
+ 	 \brief Configuration of the scan.
+ */
+typedef struct
+{
+	uint8_t channels[ADC_SCAN_MAX_CHANNELS];	/*!< ADC1 channels, in the order they are converted*/
+	uint8_t count;								/*!< Number of channels*/
+	uint32_t period_us;							/*!< Period, in microseconds, of the scan (Longer than the conversions)*/
+}adc_scan_config_t;
+
+/*!
+ 	 \brief Results of one scan.
+ */
+typedef struct
+{
+	uint32_t sequence;							/*!< Number of the scan, its sampling time is sequence * period_us*/
+	uint32_t tick;								/*!< Tick when the scan completed*/
+	uint16_t results[ADC_SCAN_MAX_CHANNELS];	/*!< Raw results, in the order of the channel list*/
+	uint8_t count;								/*!< Number of results*/
+}adc_scan_frame_t;
+
+/*!
+ 	 \brief This function configures the ADC1 and the PDB1 for the scan, and
+ 	 	 	 starts it.
+
+ 	 \note The conversion complete interruption of the ADC1 is enabled for the
+ 	 	 	 last channel, so it occurs once per scan. Its handler must call
+ 	 	 	 ADC_scan_read.
+
+ 	 \param[in] config Channels and period of the scan.
+
+ 	 \return Whether the scan was started, or the configuration was not valid.
+ */
+adc_scan_status_t ADC_scan_start(const adc_scan_config_t* config);
+
+/*!
+ 	 \brief This function stops the scan.
+
+ 	 \return void.
+ */
+void ADC_scan_stop(void);
+
+/*!
+ 	 \brief This function reads the results of a completed scan.
+
+ 	 \note Call it from the ADC1 interruption. Reading the last result clears
+ 	 	 	 the interruption flag.
+
+ 	 \param[out] results Results, in the order of the channel list.
+
+ 	 \return Number of results read.
+ */
+uint8_t ADC_scan_read(uint16_t* results);
+
+#endif /* ADC_SCAN_H_ */
@@ -14,11 +14,15 @@
  */
 
 #include "can_driver.h"
+#include "s32_core_cm4.h"
+#include <string.h>
 
 /** Defines the initial value for the variables*/
 #define INIT_VAL				(0)
-/** Defines the size of the RAM for the message buffers*/
-#define MAX_MSG_BUFFERS			(128)
+/** Defines the number of message buffers of CAN0*/
+#define CAN0_MSG_BUFFERS		(32)
+/** Defines the number of message buffers of CAN1 and CAN2*/
+#define CAN1_2_MSG_BUFFERS		(16)
 /** Defines the number of ID filters*/
 #define MAX_FILTER_BUFFERS		(16)
 
@@ -27,12 +31,22 @@
 
 /** Defines the RX mask to enable the buffer*/
 #define ENABLE_RX_BUFF			(0x04000000)
+/** Defines the code of a message buffer that doesn't receive nor transmit*/
+#define INACTIVE_BUFF			(0x00000000)
+/** Defines the mask for the code of a message buffer*/
+#define MB_CODE_MASK			(0x0F000000)
+/** Defines the shifts for the code of a message buffer*/
+#define MB_CODE_SHIFT			(24)
+/** Defines the code of a Rx MB with a message*/
+#define RX_CODE_FULL			(0x2)
+/** Defines the code of a Rx MB whose message was overwritten by a newer one*/
+#define RX_CODE_OVERRUN			(0x6)
 
 /** Defines the value to accept all IDs*/
 #define NOT_CHECK_ANY_ID		(0x00000000)
 
-/** Defines the bits to clear the interruption flag of the Rx MB*/
-#define CLEAR_MB_0				(0x00000001)
+/** Defines the bits to clear the interruption flag of the blocking Tx MB*/
+#define CLEAR_TX_MB				(0x00008000)
 /** Defines the mask for the standard ID*/
 #define STD_ID_MASK				(0x000007FF)
 /** Defines the shifts for the standard ID*/
@@ -41,25 +55,18 @@
 /** Defines the transmit code*/
 #define TX_BUFF_TRANSMITT		(0x0C400000)
 
-/** Defines the mask for the MB code*/
-#define CAN_CODE_MASK			(0x07000000)
-/** Defines the shift for the MB code*/
-#define CAN_CODE_SHIFT			(24)
-
 /** Defines the mask for the time stamp*/
 #define CAN_TIMESTAMP_MASK		(0x0000FFFF)
-/** Defines the bits to clear the interruption flag of the Tx MB*/
-#define CLEAR_MB_4				(0x00000010)
 
 /** Defines the mask for the LSB*/
 #define BIT_MASK				(1)
 /** Defines the bits to clear al MB interruption flags*/
 #define CLEAR_ALL_FLAGS			(0xFFFFFFFF)
 
-/** Defines the Rx MB offset in RAM array*/
-#define RX_BUFF_OFFSET			(0x04)
-/** Defines the Tx MB offset in RAM array*/
-#define TX_BUFF_OFFSET			(0x00)
+/** Defines the Tx MB offset in RAM array (Out of the Rx FIFO area and the Tx pool)*/
+#define TX_BUFF_OFFSET			(0x0F)
+/** Defines the Rx FIFO output offset in RAM array*/
+#define RX_FIFO_OFFSET			(0x00)
 /** Defines the code and DLC position in the MB array*/
 #define CODE_AND_DLC_POS		(0x00)
 /** Defines the ID position in the MB array*/
@@ -71,8 +78,6 @@
 
 /** Defines the divisor to convert from DLC to the msg size*/
 #define DLC_TO_MSG_SIZE_DIV		(0x04)
-/** Defines the shifts for the Rx MB interruption flag*/
-#define RX_MB_FLAG_SHIFT		(0x04)
 
 /** Disable CAN FS*/
 #define CAN_FD_DISABLE			(0x0003001F)
@@ -81,24 +86,11 @@
 /** Delay for the Tx*/
 #define CAN_DELAY				(10000)
 
-/** Mask to get the MSB of the Rx message*/
-#define CAN_RX_MSG_MSB_MASK		(0xFF000000)
-/** Mask to enable the interruption of the Rx message buffer*/
-#define CAN_SET_RX_BUFF_ISR		(0x10)
-
-/** Size of the variable to concatenate the message received*/
+/** Number of data words of a MB*/
 #define TEMP_VAR_SIZE			(2)
-/** Defines the bytes in a uint32_t variable*/
-#define BYTE_COUNT_4			(4)
-/** Shifts necessary to shift a byte*/
-#define BYTE_SHIFT				(8)
-/** Offset of the message position in the MB*/
-#define MSG_POS_OFFSET			(3)
-/** Shifts necessary to shift from a MSB to a LSB in a uint32_t*/
-#define MSB_TO_LSB_SHIFT		(24)
-/** Position of the low byte in the temp array*/
+/** Position of the first data word (Bytes 0 to 3) in the temp array*/
 #define LOW_BYTE_TEMP			(0)
-/** Position of the high byte in the temp array*/
+/** Position of the second data word (Bytes 4 to 7) in the temp array*/
 #define HIGH_BYTE_TEMP			(1)
 /** Offset of 1 for an array position*/
 #define ARRAY_OFFSET_1			(1)
@@ -106,18 +98,75 @@
 /** Maximum DLC that can be sent*/
 #define MAX_DLC					(8)
 
-/** Variable to store the code of the Rx MB*/
-static uint32_t RxCODE;
-/** Variable to store the ID of the Rx MB*/
-static uint32_t RxID;
-/** Variable to store the DLC of the Rx MB*/
-static uint32_t RxLENGTH;
+/** Defines the first word of the Rx FIFO filter table (MB6)*/
+#define RX_FIFO_FILTER_POS		(24)
+/** Defines the shifts for the standard ID in a Rx FIFO filter element (Format A)*/
+#define RX_FIFO_FILTER_SHIFT	(19)
+/** Defines the mask bit that compares the IDE bit of a Rx FIFO filter element*/
+#define RX_FIFO_FILTER_IDE		(0x40000000)
+
+/** Defines that a message was read*/
+#define MSG_READ				(1)
+/** Defines that no message was read*/
+#define MSG_NOT_READ			(0)
+
+/** Defines the MCR polls before a freeze mode change is abandoned (Some ms, a frame at 50 Kbps takes 2.7 ms)*/
+#define CAN_MCR_TIMEOUT			(100000UL)
+/** Defines that the MCR reached the expected value*/
+#define MCR_READY				(1)
+/** Defines that the MCR did not reach the expected value in time*/
+#define MCR_TIMEOUT				(0)
+
+/** Filters programmed in each CAN (Compared with the new ones to skip unchanged updates)*/
+static can_rx_filter_t CAN_rx_filters[CAN_INSTANCE_COUNT][CAN_RX_FIFO_FILTERS];
+/** Number of filters programmed in each CAN (0 before the first update)*/
+static uint16_t CAN_rx_filter_count[CAN_INSTANCE_COUNT];
+
+/** Gets the number of message buffers of the CAN (CAN1 and CAN2 have only 16)*/
+static uint8_t CAN_get_msg_buffers(CAN_Type* base)
+{
+	return (CAN0 == base) ? CAN0_MSG_BUFFERS : CAN1_2_MSG_BUFFERS;
+}
+
+/** Gets the position of the CAN in the instance arrays*/
+static uint8_t CAN_get_instance(CAN_Type* base)
+{
+	/** Array of the CAN instances*/
+	CAN_Type* const instances[CAN_INSTANCE_COUNT] = CAN_BASE_PTRS;
+	/** Counter for the instances*/
+	uint8_t instance = INIT_VAL;
+
+	while((instances[instance] != base) && ((CAN_INSTANCE_COUNT - ARRAY_OFFSET_1) > instance))
+	{
+		instance ++;
+	}
+
+	return instance;
+}
+
+/** Waits, for a bounded time, until the masked MCR bits have the expected value*/
+static uint8_t CAN_wait_mcr(CAN_Type* base, uint32_t mask, uint32_t expected)
+{
+	/** Polls of the MCR*/
+	uint32_t polls = INIT_VAL;
+
+	while(((base->MCR & mask) != expected) && (CAN_MCR_TIMEOUT > polls))
+	{
+		polls ++;
+	}
+
+	return ((base->MCR & mask) == expected) ? MCR_READY : MCR_TIMEOUT;
+}
 
 /** This function initializes the CAN*/
 void CAN_Init(can_init_config_t can_init)
 {
 	/** Counter to clean the RAM*/
 	uint8_t counter;
+	/** Number of message buffers of the CAN*/
+	uint8_t msg_buffers = CAN_get_msg_buffers(can_init.base);
+	/** Module configuration, the last MB depends on the CAN*/
+	uint32_t module_config = (CAN_FD_DISABLE & (~CAN_MCR_MAXMB_MASK)) | CAN_MCR_MAXMB(msg_buffers - ARRAY_OFFSET_1);
 
 	/** For CAN0*/
 	if(CAN0 == can_init.base)
@@ -153,7 +202,7 @@ void CAN_Init(can_init_config_t can_init)
 	can_init.base->CTRL1 = can_init.speed;
 
 	/** Initializes the MB RAM in 0*/
-	for(counter = INIT_VAL ; MAX_MSG_BUFFERS > counter ; counter ++)
+	for(counter = INIT_VAL ; (msg_buffers * MSG_BUF_SIZE) > counter ; counter ++)
 	{
 		can_init.base->RAMn[counter] = INIT_VAL;
 
@@ -167,32 +216,290 @@ void CAN_Init(can_init_config_t can_init)
 	/** Sets the global ID mask to not check any ID*/
 	can_init.base->RXMGMASK = NOT_CHECK_ANY_ID;
 
-	/** Enables the MB 4 for reception*/
-	can_init.base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ENABLE_RX_BUFF;
+	/** For the Rx FIFO*/
+	if(rx_fifo == can_init.rx_buffer)
+	{
+		/** Sets the FIFO global mask to not check any ID*/
+		can_init.base->RXFGMASK = NOT_CHECK_ANY_ID;
+		/** 8 filter elements (MB6 and MB7), the FIFO takes MB0 to MB7*/
+		can_init.base->CTRL2 &= (~CAN_CTRL2_RFFN_MASK);
+
+		/** CAN FD not used, Rx FIFO enabled*/
+		can_init.base->MCR = module_config | CAN_MCR_RFEN_MASK | CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK;
+		can_init.base->MCR = module_config | CAN_MCR_RFEN_MASK;
+	}
 
-	/** CAN FD not used*/
-	can_init.base->MCR = CAN_FD_DISABLE;
+	/** For the Rx message buffers*/
+	else
+	{
+		/** Enables the Rx MBs for reception, they accept every ID until the filters are programmed*/
+		for(counter = CAN_RX_MB_FIRST ; (CAN_RX_MB_FIRST + CAN_RX_MB_COUNT) > counter ; counter ++)
+		{
+			can_init.base->RAMn[(counter * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ENABLE_RX_BUFF;
+		}
+
+		/** CAN FD not used*/
+		can_init.base->MCR = module_config;
+	}
 
 	/** Waits for the module to exit freeze mode*/
 	while ((can_init.base->MCR && CAN_MCR_FRZACK_MASK) >> CAN_MCR_FRZACK_SHIFT);
 	/** Waits for the module to be ready*/
 	while ((can_init.base->MCR && CAN_MCR_NOTRDY_MASK) >> CAN_MCR_NOTRDY_SHIFT);
+
+	/** The RAM was cleared, so no filter is programmed*/
+	CAN_rx_filter_count[CAN_get_instance(can_init.base)] = INIT_VAL;
+}
+
+/** Reads the data words of a MB and stores them in msg (The MB stores the first byte in the MSB)*/
+static void CAN_read_mb_data(CAN_Type* base, uint8_t mb, uint8_t* msg)
+{
+	/** Data words of the MB*/
+	uint32_t data[TEMP_VAR_SIZE];
+	/** Data word as stored in the MB*/
+	uint32_t data_mb;
+
+	/** Each word is read once and reversed to memory order*/
+	data_mb = base->RAMn[(mb * MSG_BUF_SIZE) + MSG_POS];
+	REV_BYTES_32(data_mb, data[LOW_BYTE_TEMP]);
+	data_mb = base->RAMn[(mb * MSG_BUF_SIZE) + ARRAY_OFFSET_1 + MSG_POS];
+	REV_BYTES_32(data_mb, data[HIGH_BYTE_TEMP]);
+
+	/** msg is not word aligned inside the message structure*/
+	memcpy(msg, data, sizeof(data));
+}
+
+/** Writes DLC bytes of msg to the data words of a MB (The MB sends the MSB first)*/
+static void CAN_write_mb_data(CAN_Type* base, uint8_t mb, const uint8_t* msg, uint8_t DLC)
+{
+	/** Data words for the MB, the unused bytes are sent as 0*/
+	uint32_t data[TEMP_VAR_SIZE] = {INIT_VAL};
+	/** Data words reversed to the MB order*/
+	uint32_t data_rev;
+
+	memcpy(data, msg, DLC);
+
+	/** Each word is reversed and written once*/
+	REV_BYTES_32(data[LOW_BYTE_TEMP], data_rev);
+	base->RAMn[(mb * MSG_BUF_SIZE) + MSG_POS] = data_rev;
+	REV_BYTES_32(data[HIGH_BYTE_TEMP], data_rev);
+	base->RAMn[(mb * MSG_BUF_SIZE) + ARRAY_OFFSET_1 + MSG_POS] = data_rev;
+}
+
+/** Counts the bits of the ID that a filter compares*/
+static uint8_t CAN_filter_checked_bits(uint16_t mask)
+{
+	/** Bits set in the mask*/
+	uint8_t bits = INIT_VAL;
+
+	while(mask)
+	{
+		bits += (mask & BIT_MASK);
+		mask >>= BIT_MASK;
+	}
+
+	return bits;
+}
+
+/** Merges two filters into the smallest range mask that accepts both*/
+static can_rx_filter_t CAN_filter_merge(can_rx_filter_t a, can_rx_filter_t b)
+{
+	/** Merged filter*/
+	can_rx_filter_t merged;
+
+	/** Only the bits compared by both filters, and equal in both IDs, are kept*/
+	merged.mask = a.mask & b.mask & (~(a.ID ^ b.ID)) & CAN_RX_FILTER_EXACT;
+	merged.ID = a.ID & merged.mask;
+
+	return merged;
+}
+
+/** Sorts the filters and merges them until they fit in the available slots*/
+static uint16_t CAN_filter_reduce(can_rx_filter_t* filters, uint16_t count, uint16_t slots)
+{
+	/** Counters for the filters*/
+	uint16_t counter;
+	uint16_t position;
+	/** Filter being sorted*/
+	can_rx_filter_t filter;
+	/** Pair whose merge accepts the fewest extra IDs*/
+	uint16_t best_pair;
+	/** Bits compared by the best merge*/
+	uint8_t best_bits;
+	/** Bits compared by the current merge*/
+	uint8_t bits;
+
+	/** Sorts the filters by ID (Insertion sort, the table is small and almost sorted)*/
+	for(counter = ARRAY_OFFSET_1 ; counter < count ; counter ++)
+	{
+		filter = filters[counter];
+		position = counter;
+
+		while((INIT_VAL < position) && (filters[position - ARRAY_OFFSET_1].ID > filter.ID))
+		{
+			filters[position] = filters[position - ARRAY_OFFSET_1];
+			position --;
+		}
+
+		filters[position] = filter;
+	}
+
+	/** Merges the neighbor filters that accept the fewest extra IDs, until they fit*/
+	while(count > slots)
+	{
+		best_pair = INIT_VAL;
+		best_bits = INIT_VAL;
+
+		for(counter = INIT_VAL ; counter < (count - ARRAY_OFFSET_1) ; counter ++)
+		{
+			bits = CAN_filter_checked_bits(CAN_filter_merge(filters[counter], filters[counter + ARRAY_OFFSET_1]).mask);
+
+			if((INIT_VAL == counter) || (bits > best_bits))
+			{
+				best_bits = bits;
+				best_pair = counter;
+			}
+		}
+
+		/** Replaces the pair by the merged filter*/
+		filters[best_pair] = CAN_filter_merge(filters[best_pair], filters[best_pair + ARRAY_OFFSET_1]);
+		for(counter = best_pair + ARRAY_OFFSET_1 ; counter < (count - ARRAY_OFFSET_1) ; counter ++)
+		{
+			filters[counter] = filters[counter + ARRAY_OFFSET_1];
+		}
+		count --;
+	}
+
+	return count;
+}
+
+/** Checks whether a filter is the one programmed in a position*/
+static uint8_t CAN_filter_unchanged(const can_rx_filter_t* programmed, uint16_t programmed_count,
+		const can_rx_filter_t* filters, uint16_t position)
+{
+	return ((position < programmed_count) &&
+			(programmed[position].ID == filters[position].ID) &&
+			(programmed[position].mask == filters[position].mask));
+}
+
+/** This function programs the acceptance filters*/
+uint16_t CAN_set_rx_filters(CAN_Type* base, can_rx_filter_t* filters, uint16_t count)
+{
+	/** Counter for the filter elements*/
+	uint8_t counter;
+	/** Filter used by the current element*/
+	uint16_t filter_pos;
+	/** Filter that accepts every ID*/
+	can_rx_filter_t accept_all = {INIT_VAL, INIT_VAL};
+	/** Filters programmed in the CAN*/
+	can_rx_filter_t* programmed = CAN_rx_filters[CAN_get_instance(base)];
+	/** Number of filters programmed in the CAN*/
+	uint16_t* programmed_count = &CAN_rx_filter_count[CAN_get_instance(base)];
+	/** Number of filters of the new table that are already programmed*/
+	uint16_t unchanged = INIT_VAL;
+	/** Defines whether the Rx FIFO is used or not*/
+	uint8_t fifo = (base->MCR & CAN_MCR_RFEN_MASK) ? BIT_MASK : INIT_VAL;
+
+	/** Without IDs every message is accepted*/
+	if(INIT_VAL == count)
+	{
+		filters = &accept_all;
+		count = ARRAY_OFFSET_1;
+	}
+
+	/** Merges the filters before freezing the module, so the freeze is short*/
+	count = CAN_filter_reduce(filters, count, fifo ? CAN_RX_FIFO_FILTERS : CAN_RX_MB_COUNT);
+
+	for(counter = INIT_VAL ; counter < count ; counter ++)
+	{
+		unchanged += CAN_filter_unchanged(programmed, *programmed_count, filters, counter);
+	}
+
+	/** The module is only frozen if the table changed*/
+	if((count != *programmed_count) || (count != unchanged))
+	{
+		/** Enters freeze mode to write the filters (The wait is bounded, it runs with the scheduler suspended)*/
+		base->MCR |= CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK;
+
+		if(MCR_READY == CAN_wait_mcr(base, CAN_MCR_FRZACK_MASK, CAN_MCR_FRZACK_MASK))
+		{
+			/** For the Rx FIFO*/
+			if(fifo)
+			{
+				/** Unused elements repeat the last filter, so they don't accept other IDs*/
+				for(counter = INIT_VAL ; CAN_RX_FIFO_FILTERS > counter ; counter ++)
+				{
+					filter_pos = (counter < count) ? counter : (count - ARRAY_OFFSET_1);
+					base->RAMn[RX_FIFO_FILTER_POS + counter] = (uint32_t)filters[filter_pos].ID << RX_FIFO_FILTER_SHIFT;
+					base->RXIMR[counter] = ((uint32_t)filters[filter_pos].mask << RX_FIFO_FILTER_SHIFT) | RX_FIFO_FILTER_IDE;
+				}
+			}
+
+			/** For the Rx message buffers, one filter each*/
+			else
+			{
+				for(counter = INIT_VAL ; CAN_RX_MB_COUNT > counter ; counter ++)
+				{
+					/** The unused MBs don't receive*/
+					if(counter >= count)
+					{
+						base->RAMn[((CAN_RX_MB_FIRST + counter) * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = INACTIVE_BUFF;
+					}
+
+					/** Only the changed MBs are written, re-arming a MB discards its unread message*/
+					else if(!CAN_filter_unchanged(programmed, *programmed_count, filters, counter))
+					{
+						base->RAMn[((CAN_RX_MB_FIRST + counter) * MSG_BUF_SIZE) + ID_POS] = (uint32_t)filters[counter].ID << STD_ID_SHIFT;
+						base->RXIMR[CAN_RX_MB_FIRST + counter] = (uint32_t)filters[counter].mask << STD_ID_SHIFT;
+						base->RAMn[((CAN_RX_MB_FIRST + counter) * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ENABLE_RX_BUFF;
+					}
+				}
+			}
+
+			/** Keeps the programmed table*/
+			for(counter = INIT_VAL ; counter < count ; counter ++)
+			{
+				programmed[counter] = filters[counter];
+			}
+			*programmed_count = count;
+		}
+
+		/** The module didn't freeze, the filters are not changed*/
+		else
+		{
+			count = INIT_VAL;
+		}
+
+		/** Exits freeze mode (Also when the freeze was not acknowledged, to cancel the request)*/
+		base->MCR &= ~(CAN_MCR_FRZ_MASK | CAN_MCR_HALT_MASK);
+		CAN_wait_mcr(base, CAN_MCR_FRZACK_MASK, INIT_VAL);
+		CAN_wait_mcr(base, CAN_MCR_NOTRDY_MASK, INIT_VAL);
+	}
+
+	return count;
 }
 
-/** This function enables the interruption for the Rx message buffer*/
+/** This function enables the interruption for the Rx message buffers*/
 void CAN_enable_rx_interruption(CAN_Type* base)
 {
-	base->IMASK1 = CAN_SET_RX_BUFF_ISR;
+	base->IMASK1 |= CAN_RX_MB_POOL_MASK;
 }
 
-/** This function sends a message via CAN*/
-void CAN_send_message(can_message_tx_config_t can_message_tx)
+/** This function enables the interruptions of the Rx FIFO*/
+void CAN_enable_rx_fifo_interruption(CAN_Type* base)
 {
-	/** Counter to set the message to the MB*/
-	uint16_t counter = INIT_VAL;
-	uint16_t byte_counter = INIT_VAL;
-	uint32_t temp[TEMP_VAR_SIZE] = {INIT_VAL};
+	base->IMASK1 |= CAN_RX_FIFO_AVAILABLE | CAN_RX_FIFO_OVERFLOW;
+}
 
+/** This function enables the interruption for the Tx pool message buffers*/
+void CAN_enable_tx_interruption(CAN_Type* base)
+{
+	base->IMASK1 |= CAN_TX_MB_POOL_MASK;
+}
+
+/** This function loads a message into a Tx message buffer*/
+void CAN_send_message_mb(can_message_tx_config_t can_message_tx, uint8_t mb)
+{
 	/** Standard ID can only be of 11 bits*/
 	can_message_tx.ID &= STD_ID_MASK;
 
@@ -201,89 +508,169 @@ void CAN_send_message(can_message_tx_config_t can_message_tx)
 		can_message_tx.DLC = MAX_DLC;
 	}
 
-	/** Clears CAN 0 MB 0 interruption flag*/
-	can_message_tx.base->IFLAG1 = CLEAR_MB_0;
+	/** Clears the MB interruption flag*/
+	can_message_tx.base->IFLAG1 = ((uint32_t)BIT_MASK << mb);
 
 	/** Sets the message in the CAN tx buffer*/
-	for(counter = INIT_VAL ; counter < can_message_tx.DLC ; counter ++)
-	{
-		/** Concatenates each of the bytes in msg to temp*/
-		temp[(counter / BYTE_COUNT_4)] |= (uint32_t)((*can_message_tx.msg) << ((MSG_POS_OFFSET - byte_counter) * BYTE_SHIFT));
+	CAN_write_mb_data(can_message_tx.base, mb, can_message_tx.msg, can_message_tx.DLC);
 
-		/** Increments the pointer to msg*/
-		can_message_tx.msg ++;
-		/** Increments the number of bytes concatenated*/
-		byte_counter ++;
+	/** Sets the ID to the bits 28-18 (ID bits for standard format)*/
+	can_message_tx.base->RAMn[(mb * MSG_BUF_SIZE) + ID_POS] = (can_message_tx.ID << STD_ID_SHIFT);
+
+	/** Sets the DLC and the CAN command to transmit*/
+	can_message_tx.base->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = (can_message_tx.DLC << CAN_WMBn_CS_DLC_SHIFT) | TX_BUFF_TRANSMITT;
+}
+
+/** This function sends a message via CAN*/
+void CAN_send_message(can_message_tx_config_t can_message_tx)
+{
+	/** Loads the message into the blocking Tx MB*/
+	CAN_send_message_mb(can_message_tx, TX_BUFF_OFFSET);
 
-		/** When first 4 bytes of temp are full*/
-		if(BYTE_COUNT_4 == byte_counter)
+	while(!CAN_get_tx_status(can_message_tx.base));
+	can_message_tx.base->IFLAG1 = CLEAR_TX_MB;
+}
+
+/** This function receives a message from CAN*/
+uint8_t CAN_receive_message(can_message_rx_config_t *can_message_rx)
+{
+	/** Code and DLC of the Rx MB (Reading it locks the MB)*/
+	uint32_t code_and_dlc;
+	/** Code of the Rx MB*/
+	uint32_t code;
+	/** Rx MB being checked*/
+	uint8_t mb = CAN_RX_MB_FIRST;
+	/** ID of the Rx MB*/
+	uint32_t RxID;
+	/** DLC of the Rx MB*/
+	uint32_t RxLENGTH;
+	/** Sets the return value as no message read*/
+	uint8_t retval = MSG_NOT_READ;
+
+	/** With the Rx FIFO enabled the Rx MBs are part of the FIFO, reading or re-arming them would corrupt the FIFO*/
+	if(!((*can_message_rx).base->MCR & CAN_MCR_RFEN_MASK))
+	{
+		/** Looks for the first Rx MB with a message (A busy MB is being written, it is read later)*/
+		while((MSG_NOT_READ == retval) && ((CAN_RX_MB_FIRST + CAN_RX_MB_COUNT) > mb))
 		{
-			/** Resets the bytes concatenated count*/
-			byte_counter = INIT_VAL;
+			code_and_dlc = (*can_message_rx).base->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS];
+			code = (code_and_dlc & MB_CODE_MASK) >> MB_CODE_SHIFT;
+
+			if((RX_CODE_FULL == code) || (RX_CODE_OVERRUN == code))
+			{
+				retval = MSG_READ;
+			}
+			else
+			{
+				mb ++;
+			}
 		}
-	}
 
-	/** Sets the temp variable to the MB*/
-	can_message_tx.base->RAMn[(TX_BUFF_OFFSET * MSG_BUF_SIZE) + MSG_POS] = temp[LOW_BYTE_TEMP];
-	can_message_tx.base->RAMn[(TX_BUFF_OFFSET * MSG_BUF_SIZE) + ARRAY_OFFSET_1 + MSG_POS] = temp[HIGH_BYTE_TEMP];
+		if(MSG_READ == retval)
+		{
+			/** Gets ID*/
+			RxID = ((*can_message_rx).base->RAMn[(mb * MSG_BUF_SIZE) + ID_POS] & CAN_WMBn_ID_ID_MASK) >> STD_ID_SHIFT;
+			/** Gets the DLC*/
+			RxLENGTH = (code_and_dlc & CAN_WMBn_CS_DLC_MASK) >> CAN_WMBn_CS_DLC_SHIFT;
 
-	/** Sets the ID to the bits 28-18 (ID bits for standard format)*/
-	can_message_tx.base->RAMn[(TX_BUFF_OFFSET * MSG_BUF_SIZE) + ID_POS] = (can_message_tx.ID << STD_ID_SHIFT);
+			if(MAX_DLC < RxLENGTH)
+			{
+				RxLENGTH = MAX_DLC;
+			}
 
-	/** Sets the DLC and the CAN command to transmit*/
-	can_message_tx.base->RAMn[(TX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = (can_message_tx.DLC << CAN_WMBn_CS_DLC_SHIFT) | TX_BUFF_TRANSMITT;
+			/** Gets the data words, the MB is not modified*/
+			CAN_read_mb_data((*can_message_rx).base, mb, (*can_message_rx).msg);
 
-	while(!CAN_get_tx_status(CAN0));
-	can_message_tx.base->IFLAG1 = CLEAR_MB_0;
+			/** Clears the reception flag*/
+			(*can_message_rx).base->IFLAG1 = ((uint32_t)BIT_MASK << mb);
+
+			/** Returns the data*/
+			((*can_message_rx).ID) = (uint16_t)RxID;
+			/** Sets the DLC*/
+			((*can_message_rx).DLC) = (uint8_t)(RxLENGTH);
+
+			/** Sets the MB ready for another message*/
+			(*can_message_rx).base->RAMn[(mb * MSG_BUF_SIZE) + CODE_AND_DLC_POS] = ENABLE_RX_BUFF;
+		}
+
+		/** Reading the free running timer unlocks the last MB checked*/
+		(void)(*can_message_rx).base->TIMER;
+	}
+
+	return retval;
 }
 
-/** This function receives a message from CAN*/
-void CAN_receive_message(can_message_rx_config_t *can_message_rx)
+/** This function reads a message from the Rx FIFO*/
+uint8_t CAN_read_rx_fifo(can_message_rx_config_t *can_message_rx)
 {
-	/** Counter to get the message*/
-	uint8_t counter = INIT_VAL;
-
-	/** Gets the rx code*/
-	RxCODE = ((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] & CAN_CODE_MASK) >> CAN_CODE_SHIFT;
-	/** Gets ID*/
-	RxID = ((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + ID_POS] & CAN_WMBn_ID_ID_MASK) >> STD_ID_SHIFT;
-	/** Gets the DLC*/
-	RxLENGTH = ((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] & CAN_WMBn_CS_DLC_MASK);
-	RxLENGTH  >>= CAN_WMBn_CS_DLC_SHIFT;
-
-	/** Gets each of the bytes*/
-	for(counter = INIT_VAL ; counter < RxLENGTH ; counter ++)
+	/** Code and DLC of the FIFO output*/
+	uint32_t code_and_dlc;
+	/** Sets the return value as no message read*/
+	uint8_t retval = MSG_NOT_READ;
+
+	/** If the FIFO has at least one message*/
+	if(CAN_RX_FIFO_AVAILABLE & (*can_message_rx).base->IFLAG1)
 	{
-		/** Gets the highest byte of the MB and sets it to msg*/
-		((*can_message_rx).msg[counter]) = (uint8_t)((((*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) +
-													(counter / BYTE_COUNT_4) + MSG_POS]) & CAN_RX_MSG_MSB_MASK) >> MSB_TO_LSB_SHIFT);
+		/** Gets the DLC and the ID of the FIFO output*/
+		code_and_dlc = (*can_message_rx).base->RAMn[(RX_FIFO_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS];
+		((*can_message_rx).DLC) = (uint8_t)((code_and_dlc & CAN_WMBn_CS_DLC_MASK) >> CAN_WMBn_CS_DLC_SHIFT);
+		((*can_message_rx).ID) = (uint16_t)(((*can_message_rx).base->RAMn[(RX_FIFO_OFFSET * MSG_BUF_SIZE) + ID_POS] >> STD_ID_SHIFT) & STD_ID_MASK);
 
-		/** Shifts the remaining message to the left*/
-		(*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + (counter / BYTE_COUNT_4) + MSG_POS] <<= BYTE_SHIFT;
+		if(MAX_DLC < (*can_message_rx).DLC)
+		{
+			(*can_message_rx).DLC = MAX_DLC;
+		}
+
+		/** Gets the data words, the FIFO output is not modified*/
+		CAN_read_mb_data((*can_message_rx).base, RX_FIFO_OFFSET, (*can_message_rx).msg);
+
+		/** Releases the FIFO output, the next message is moved to it*/
+		(*can_message_rx).base->IFLAG1 = CAN_RX_FIFO_AVAILABLE;
+
+		retval = MSG_READ;
 	}
 
-	/** Clears the reception flag*/
-	(*can_message_rx).base->IFLAG1 = CLEAR_MB_4;
+	return retval;
+}
 
-	/** Returns the data*/
-	((*can_message_rx).ID) = (uint16_t)RxID;
-	/** Sets the DLC*/
-	((*can_message_rx).DLC) = (uint8_t)(RxLENGTH);
+/** This function checks and clears the Rx FIFO overflow*/
+uint8_t CAN_rx_fifo_overflowed(CAN_Type* base)
+{
+	/** Sets the return value as no overflow*/
+	uint8_t retval = INIT_VAL;
 
-	/** Sets the MB ready for another message*/
-	(*can_message_rx).base->RAMn[(RX_BUFF_OFFSET * MSG_BUF_SIZE) + CODE_AND_DLC_POS] |= ENABLE_RX_BUFF;
+	if(CAN_RX_FIFO_OVERFLOW & base->IFLAG1)
+	{
+		/** Clears the overflow and warning flags*/
+		base->IFLAG1 = CAN_RX_FIFO_OVERFLOW | CAN_IFLAG1_BUF6I_MASK;
+		retval = BIT_MASK;
+	}
+
+	return retval;
 }
 
-/** Gets the flag of the RX buffer*/
+/** Gets the flags of the RX buffers*/
 CAN_rx_status_t CAN_get_rx_status(CAN_Type* base)
 {
-	return ((CAN_rx_status_t)((base->IFLAG1 >> RX_MB_FLAG_SHIFT) & BIT_MASK));
+	return ((base->IFLAG1 & CAN_RX_MB_POOL_MASK) ? rx_interrupted : rx_not_interrupted);
 }
 
 /** Gets the flag of the RX buffer*/
 CAN_tx_status_t CAN_get_tx_status(CAN_Type* base)
 {
-	return((CAN_tx_status_t)(base->IFLAG1 & BIT_MASK));
+	return((CAN_tx_status_t)((base->IFLAG1 >> TX_BUFF_OFFSET) & BIT_MASK));
+}
+
+/** Gets the flags of the Tx pool message buffers*/
+uint32_t CAN_get_tx_pool_flags(CAN_Type* base)
+{
+	return (base->IFLAG1 & CAN_TX_MB_POOL_MASK);
+}
+
+/** This function clears the selected message buffer flags*/
+void CAN_clear_mb_flags(CAN_Type* base, uint32_t flags)
+{
+	base->IFLAG1 = flags;
 }
 
 /** This function clears the RX and TX buffer flags*/
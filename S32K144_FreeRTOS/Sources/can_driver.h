@@ -27,6 +27,20 @@
 /** Defines the speed of 50 Kbps*/
 #define CAN_CTRL1_SPEED_50KBPS			(0x09DB0006)
 
+/** Defines the first message buffer of the Tx pool*/
+#define CAN_TX_MB_FIRST					(8)
+/** Defines the number of message buffers in the Tx pool (1 to 7)*/
+#define CAN_TX_MB_COUNT					(4)
+/** Defines the IFLAG1/IMASK1 bits of the Tx pool*/
+#define CAN_TX_MB_POOL_MASK				(((1UL << CAN_TX_MB_COUNT) - 1UL) << CAN_TX_MB_FIRST)
+
+/** Defines the first message buffer of the Rx pool (Rx message buffer mode)*/
+#define CAN_RX_MB_FIRST					(4)
+/** Defines the number of message buffers of the Rx pool, each one with its own filter (1 to 4)*/
+#define CAN_RX_MB_COUNT					(4)
+/** Defines the IFLAG1/IMASK1 bits of the Rx pool*/
+#define CAN_RX_MB_POOL_MASK				(((1UL << CAN_RX_MB_COUNT) - 1UL) << CAN_RX_MB_FIRST)
+
 /*!
  	 \brief Enumerator to define whether the rx buffer has interrupted
  	 	 	 or not.
@@ -47,13 +61,43 @@ typedef enum
 	tx_interrupted		/*!< Tx message buffer interrupted*/
 }CAN_tx_status_t;
 
+/** Defines the IFLAG1/IMASK1 bit of the Rx FIFO frames available*/
+#define CAN_RX_FIFO_AVAILABLE			(CAN_IFLAG1_BUF5I_MASK)
+/** Defines the IFLAG1/IMASK1 bit of the Rx FIFO overflow*/
+#define CAN_RX_FIFO_OVERFLOW			(CAN_IFLAG1_BUF7I_MASK)
+
+/*!
+ 	 \brief Enumerator to define how the messages are received.
+ */
+typedef enum
+{
+	rx_mailbox,		/*!< Messages are received in the Rx message buffers (MB4 to MB7)*/
+	rx_fifo			/*!< Messages are received in the 6 messages deep Rx FIFO*/
+}CAN_rx_buffer_t;
+
+/** Defines the number of filter elements of the Rx FIFO (MB6 and MB7)*/
+#define CAN_RX_FIFO_FILTERS				(8)
+/** Defines the filter mask that checks every bit of a standard ID*/
+#define CAN_RX_FILTER_EXACT				(0x07FF)
+
+/*!
+ 	 \brief Acceptance filter for the received messages. A message is accepted
+ 	 	 	 when ((received ID ^ ID) & mask) is 0.
+ */
+typedef struct
+{
+	uint16_t ID;	/*!< ID to be compared*/
+	uint16_t mask;	/*!< Bits of the ID to be compared (CAN_RX_FILTER_EXACT for a single ID)*/
+}can_rx_filter_t;
+
 /*!
  	 \brief Arguments to initialize CAN (RTOS)
  */
 typedef struct
 {
-	CAN_Type* base; /*!< CAN to be initialized*/
-	uint32_t speed;	/*!< CAN speed to be set*/
+	CAN_Type* base; 			/*!< CAN to be initialized*/
+	uint32_t speed;				/*!< CAN speed to be set*/
+	CAN_rx_buffer_t rx_buffer;	/*!< Rx message buffer or Rx FIFO*/
 }can_init_config_t;
 
 /*!
@@ -88,7 +132,28 @@ typedef struct
 void CAN_Init(can_init_config_t can_init);
 
 /*!
- 	 \brief This function enables the interruption for the Rx MB.
+ 	 \brief This function programs the acceptance filters of the Rx FIFO (8 individual
+ 	 	 	 filters) or of the Rx message buffers (1 filter for each MB). When there are
+ 	 	 	 more filters than the hardware has, the filters with the closest IDs are
+ 	 	 	 merged into range masks, so every requested ID is still received.
+
+ 	 \note If the merged filters are the ones already programmed, the module is not
+ 	 	 	 touched. Otherwise it is frozen while the filters are written, so the
+ 	 	 	 messages on the bus during the update can be lost, and so is an unread
+ 	 	 	 message of a Rx message buffer whose filter changes.
+ 	 \note The filters array is used as work buffer and is modified.
+
+ 	 \param[in] base CAN whose filters will be programmed.
+ 	 \param[in] filters Filters to be programmed (Exact IDs or range masks).
+ 	 \param[in] count Number of filters in the array (0 accepts every ID).
+
+ 	 \return Number of filters programmed after merging, or 0 if the module did not
+ 	 	 	 enter freeze mode and the filters were not changed.
+ */
+uint16_t CAN_set_rx_filters(CAN_Type* base, can_rx_filter_t* filters, uint16_t count);
+
+/*!
+ 	 \brief This function enables the interruption for the Rx MBs.
 
  	 \param[in] base CAN whose interruption will be enabled.
 
@@ -96,10 +161,43 @@ void CAN_Init(can_init_config_t can_init);
  */
 void CAN_enable_rx_interruption(CAN_Type* base);
 
+/*!
+ 	 \brief This function enables the frames available and overflow interruptions
+ 	 	 	 of the Rx FIFO.
+
+ 	 \param[in] base CAN whose interruption will be enabled.
+
+ 	 \return void.
+ */
+void CAN_enable_rx_fifo_interruption(CAN_Type* base);
+
+/*!
+ 	 \brief This function enables the interruption for the Tx pool message buffers.
+
+ 	 \param[in] base CAN whose interruption will be enabled.
+
+ 	 \return void.
+ */
+void CAN_enable_tx_interruption(CAN_Type* base);
+
+/*!
+ 	 \brief This function loads a message into a Tx message buffer and requests
+ 	 	 	 its transmission. It does not wait for the message to be sent.
+
+ 	 \note If the DLC is higher than 8, it will be set to 8.
+
+	 \param[in] can_message_tx Message structure to be sent.
+	 \param[in] mb Message buffer used to send the message.
+
+ 	 \return void.
+ */
+void CAN_send_message_mb(can_message_tx_config_t can_message_tx, uint8_t mb);
+
 /*!
  	 \brief This function sends a message via CAN using the standard ID.
 
  	 \note If the DLC is higher than 8, it will be set to 8.
+ 	 \note This function uses the MB15 and waits until the message is sent.
 
 	 \param[in] can_message_tx Message structure to be sent.
 
@@ -110,26 +208,52 @@ void CAN_send_message(can_message_tx_config_t can_message_tx);
 /*!
  	 \brief This function reads a message received via CAN.
 
- 	 \note First make sure the CAN has received a message using the function CAN_get_rx_status().
- 	 \note This function erases the interruption flag of the Rx buffer.
+ 	 \note The lowest Rx MB that holds a message is read, so call it until it
+ 	 	 	 returns 0 to read every received message.
+ 	 \note This function erases the interruption flag of the Rx MB that is read.
+ 	 \note Only valid when the CAN was initialized with rx_mailbox. With rx_fifo the
+ 	 	 	 Rx MBs belong to the Rx FIFO, so the call is rejected; use CAN_read_rx_fifo.
 
-	 \param[out] can_message_rx Message structure with the data received.
+	 \param[in,out] can_message_rx Message structure with the data received.
+	 	 	 	 	 can_message_rx.base must be set before calling the function.
 
- 	 \return void.
+ 	 \return 1 if a message was read, 0 if no Rx MB had a message or the CAN uses the Rx FIFO.
  */
-void CAN_receive_message(can_message_rx_config_t *can_message_rx);
+uint8_t CAN_receive_message(can_message_rx_config_t *can_message_rx);
 
 /*!
- 	 \brief This function gets the status of the Rx message buffer.
+ 	 \brief This function reads the oldest message of the Rx FIFO, if any, and
+ 	 	 	 releases it so the FIFO can move to the next message.
+
+ 	 \note Only valid when the CAN was initialized with rx_fifo.
+
+	 \param[in,out] can_message_rx Message structure with the data received.
+	 	 	 	 	 can_message_rx.base must be set before calling the function.
+
+ 	 \return 1 if a message was read, 0 if the Rx FIFO was empty.
+ */
+uint8_t CAN_read_rx_fifo(can_message_rx_config_t *can_message_rx);
+
+/*!
+ 	 \brief This function checks and erases the Rx FIFO overflow flag.
+
+ 	 \param[in] base CAN module whose Rx FIFO will be checked.
+
+ 	 \return 1 if messages were lost because the Rx FIFO was full, 0 otherwise.
+ */
+uint8_t CAN_rx_fifo_overflowed(CAN_Type* base);
+
+/*!
+ 	 \brief This function gets the status of the Rx message buffers.
 
  	 \param[in] base CAN module from which the Rx status will be checked.
 
- 	 \return Whether the CAN module has received a message or not.
+ 	 \return Whether any Rx MB of the CAN module has received a message or not.
  */
 CAN_rx_status_t CAN_get_rx_status(CAN_Type* base);
 
 /*!
- 	 \brief This function gets the status of the Tx message buffer.
+ 	 \brief This function gets the status of the blocking Tx message buffer (MB15).
 
  	 \param[in] base CAN module from which the Tx status will be checked.
 
@@ -138,6 +262,26 @@ CAN_rx_status_t CAN_get_rx_status(CAN_Type* base);
 CAN_tx_status_t CAN_get_tx_status(CAN_Type* base);
 
 
+/*!
+ 	 \brief This function gets the flags of the Tx pool message buffers that
+ 	 	 	 have finished transmitting.
+
+ 	 \param[in] base CAN module from which the Tx pool flags will be checked.
+
+ 	 \return IFLAG1 bits of the Tx pool that are set.
+ */
+uint32_t CAN_get_tx_pool_flags(CAN_Type* base);
+
+/*!
+ 	 \brief This function erases the selected message buffer flags.
+
+ 	 \param[in] base CAN module whose flags will be erased.
+ 	 \param[in] flags IFLAG1 bits to be erased.
+
+ 	 \return void.
+ */
+void CAN_clear_mb_flags(CAN_Type* base, uint32_t flags);
+
 /*!
  	 \brief This function erases the Tx and Rx buffer flags.
 
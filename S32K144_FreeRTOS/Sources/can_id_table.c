@@ -0,0 +1,165 @@
+/*!
+ 	 \file can_id_table.c
+
+ 	 \brief This is the source file of the table of the IDs with callback of
+ 	 	 	 a CAN. The IDs and their callbacks are kept in a vector, and an
+ 	 	 	 index of the 2048 standard IDs gives the position of each one, so
+ 	 	 	 finding, adding, removing and changing an ID take constant time
+ 	 	 	 no matter how many IDs are in the table.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "can_id_table.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the value of the index for an ID without callback*/
+#define ID_NO_FUNCTION				(0)
+/** Defines the offset between the index and the position in the vector*/
+#define INDEX_OFFSET				(1)
+/** Defines the mask of the standard IDs*/
+#define ID_MASK						(CAN_ID_TABLE_IDS - 1)
+
+/** The positions of the vector are kept in the bytes of the index*/
+typedef char can_id_table_size_check_t[(255 >= ID_VECTOR_MAX_SIZE) ? 1 : -1];
+
+/** This function initializes the table, without IDs*/
+void CAN_ID_table_init(can_id_table_t* table)
+{
+	/** Counter for the IDs*/
+	uint16_t ID;
+
+	for(ID = INIT_VAL ; CAN_ID_TABLE_IDS > ID ; ID ++)
+	{
+		table->ID_index[ID] = ID_NO_FUNCTION;
+	}
+	for(ID = INIT_VAL ; ID_VECTOR_MAX_SIZE > ID ; ID ++)
+	{
+		table->ID_function[ID].ID = INIT_VAL;
+		table->ID_function[ID].ID_func = NULL;
+	}
+	table->ID_func_counter = INIT_VAL;
+}
+
+/** This function adds an ID and its callback at the end of the vector*/
+ID_func_vector_state_t CAN_ID_table_add(can_id_table_t* table, ID_function_t ID_func)
+{
+	/** Sets the return value as successful*/
+	ID_func_vector_state_t retval = ID_func_vector_success;
+
+	/** If the ID already exists*/
+	if(ID_NO_FUNCTION != table->ID_index[ID_func.ID & ID_MASK])
+	{
+		retval = ID_already_exist;
+	}
+
+	/** If the ID function vector is full*/
+	else if(ID_VECTOR_MAX_SIZE <= table->ID_func_counter)
+	{
+		retval = ID_func_vector_full;
+	}
+
+	else
+	{
+		/** Saves the ID and the function at the end of the vector*/
+		table->ID_function[table->ID_func_counter].ID = ID_func.ID & ID_MASK;
+		table->ID_function[table->ID_func_counter].ID_func = ID_func.ID_func;
+
+		/** Increments the size of the vector and indexes the ID*/
+		table->ID_func_counter ++;
+		table->ID_index[ID_func.ID & ID_MASK] = table->ID_func_counter;
+	}
+
+	return retval;
+}
+
+/** This function removes an ID, the last ID of the vector takes its position*/
+ID_func_vector_state_t CAN_ID_table_remove(can_id_table_t* table, uint16_t ID)
+{
+	/** Sets the return value as successful*/
+	ID_func_vector_state_t retval = ID_func_vector_success;
+	/** Position of the ID to erase*/
+	uint8_t ID_to_erase;
+
+	ID &= ID_MASK;
+
+	/** If the vector is empty*/
+	if(INIT_VAL >= table->ID_func_counter)
+	{
+		retval = ID_func_vector_empty;
+	}
+
+	/** If the ID doesn't exist*/
+	else if(ID_NO_FUNCTION == table->ID_index[ID])
+	{
+		retval = ID_does_not_exist;
+	}
+
+	else
+	{
+		/** Moves the last ID to the position of the erased one*/
+		ID_to_erase = table->ID_index[ID] - INDEX_OFFSET;
+		table->ID_func_counter --;
+		table->ID_function[ID_to_erase] = table->ID_function[table->ID_func_counter];
+		table->ID_index[table->ID_function[ID_to_erase].ID] = ID_to_erase + INDEX_OFFSET;
+
+		/** Erases the ID*/
+		table->ID_index[ID] = ID_NO_FUNCTION;
+		table->ID_function[table->ID_func_counter].ID = INIT_VAL;
+		table->ID_function[table->ID_func_counter].ID_func = NULL;
+	}
+
+	return retval;
+}
+
+/** This function changes an ID and its callback, in the same position of the vector*/
+ID_func_vector_state_t CAN_ID_table_change(can_id_table_t* table, uint16_t old_ID, ID_function_t ID_func_new)
+{
+	/** Sets the return value as successful*/
+	ID_func_vector_state_t retval = ID_func_vector_success;
+	/** Index of the ID to change*/
+	uint8_t ID_to_change;
+	/** New ID*/
+	uint16_t new_ID = ID_func_new.ID & ID_MASK;
+
+	old_ID &= ID_MASK;
+
+	/** If the target ID is not in the vector*/
+	if(ID_NO_FUNCTION == table->ID_index[old_ID])
+	{
+		retval = ID_does_not_exist;
+	}
+
+	/** If the new ID already belongs to another callback*/
+	else if((new_ID != old_ID) && (ID_NO_FUNCTION != table->ID_index[new_ID]))
+	{
+		retval = ID_already_exist;
+	}
+
+	else
+	{
+		/** Changes the ID and the function*/
+		ID_to_change = table->ID_index[old_ID];
+		table->ID_index[old_ID] = ID_NO_FUNCTION;
+		table->ID_index[new_ID] = ID_to_change;
+		table->ID_function[ID_to_change - INDEX_OFFSET].ID = new_ID;
+		table->ID_function[ID_to_change - INDEX_OFFSET].ID_func = ID_func_new.ID_func;
+	}
+
+	return retval;
+}
+
+/** This function gets the entry of an ID*/
+const ID_function_t* CAN_ID_table_find(const can_id_table_t* table, uint16_t ID)
+{
+	/** Position + 1 of the ID in the vector*/
+	uint8_t ID_position = table->ID_index[ID & ID_MASK];
+
+	return (ID_NO_FUNCTION == ID_position) ? NULL : &table->ID_function[ID_position - INDEX_OFFSET];
+}
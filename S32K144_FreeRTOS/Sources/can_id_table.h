@@ -0,0 +1,117 @@
+/*!
+ 	 \file can_id_table.h
+
+ 	 \brief This is the header file of the table of the IDs with callback of
+ 	 	 	 a CAN. The IDs and their callbacks are kept in a vector, and an
+ 	 	 	 index of the 2048 standard IDs gives the position of each one, so
+ 	 	 	 finding, adding, removing and changing an ID take constant time
+ 	 	 	 no matter how many IDs are in the table.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef CAN_ID_TABLE_H_
+#define CAN_ID_TABLE_H_
+
+#include <stddef.h>
+#include "can_driver.h"
+
+/** Defines the maximum number of IDs with callback (Up to 255, it can be given by the build)*/
+#ifndef ID_VECTOR_MAX_SIZE
+#define ID_VECTOR_MAX_SIZE				(64)
+#endif
+
+/** Defines the number of standard IDs*/
+#define CAN_ID_TABLE_IDS				(0x800)
+
+/*!
+ 	 \brief Enumerator to define the states of the ID function vector.
+ */
+typedef enum
+{
+	ID_func_vector_success,	/*!< ID vector configuration successful*/
+	ID_func_vector_full,	/*!< ID vector is full*/
+	ID_func_vector_empty,	/*!< ID vector is empty*/
+	ID_not_allowed,			/*!< ID not allowed to be set*/
+	ID_does_not_exist,		/*!< ID does not exists in the ID vector*/
+	ID_already_exist		/*!< ID already exists in the ID vector*/
+}ID_func_vector_state_t;
+
+/*!
+ 	 \brief Structure to define the ID vector.
+ */
+typedef struct
+{
+	uint16_t ID;												/*!< ID to be stored*/
+	void (*ID_func)(can_message_rx_config_t can_message_rx);	/*!< Pointer to the function to be executed*/
+}ID_function_t;
+
+/*!
+ 	 \brief Table of the IDs with callback of a CAN.
+ */
+typedef struct
+{
+	ID_function_t ID_function[ID_VECTOR_MAX_SIZE];	/*!< ID function vector (A removed ID is replaced by the last one)*/
+	uint8_t ID_func_counter;						/*!< ID function vector counter*/
+	uint8_t ID_index[CAN_ID_TABLE_IDS];				/*!< Position + 1 in the ID function vector of every ID (0 for no callback)*/
+}can_id_table_t;
+
+/*!
+ 	 \brief This function initializes the table, without IDs.
+
+ 	 \param[out] table Table to be initialized.
+
+ 	 \return void.
+ */
+void CAN_ID_table_init(can_id_table_t* table);
+
+/*!
+ 	 \brief This function adds an ID and its callback at the end of the vector.
+
+ 	 \param[in] table Table of the IDs.
+ 	 \param[in] ID_func ID (Up to 0x7FF) and callback to be added.
+
+ 	 \return ID_func_vector_success, ID_already_exist or ID_func_vector_full.
+ */
+ID_func_vector_state_t CAN_ID_table_add(can_id_table_t* table, ID_function_t ID_func);
+
+/*!
+ 	 \brief This function removes an ID, the last ID of the vector takes its position.
+
+ 	 \param[in] table Table of the IDs.
+ 	 \param[in] ID ID to be removed (Up to 0x7FF).
+
+ 	 \return ID_func_vector_success, ID_func_vector_empty or ID_does_not_exist.
+ */
+ID_func_vector_state_t CAN_ID_table_remove(can_id_table_t* table, uint16_t ID);
+
+/*!
+ 	 \brief This function changes an ID and its callback, in the same position of the vector.
+
+ 	 \param[in] table Table of the IDs.
+ 	 \param[in] old_ID ID to be changed (Up to 0x7FF).
+ 	 \param[in] ID_func_new New ID (Up to 0x7FF) and callback.
+
+ 	 \return ID_func_vector_success, ID_does_not_exist or ID_already_exist (The new ID
+ 	 	 	 belongs to another callback).
+ */
+ID_func_vector_state_t CAN_ID_table_change(can_id_table_t* table, uint16_t old_ID, ID_function_t ID_func_new);
+
+/*!
+ 	 \brief This function gets the entry of an ID.
+
+ 	 \note The entry moves when another ID is removed, copy its callback before that.
+
+ 	 \param[in] table Table of the IDs.
+ 	 \param[in] ID Received ID (Only its 11 bits are used).
+
+ 	 \return Entry of the ID in the vector, NULL if it has no callback.
+ */
+const ID_function_t* CAN_ID_table_find(const can_id_table_t* table, uint16_t ID);
+
+#endif /* CAN_ID_TABLE_H_ */
@@ -0,0 +1,102 @@
+/*!
+ 	 \file can_rx_ring.c
+
+ 	 \brief This is the source file of the CAN Rx ring. It is a lock-free
+ 	 	 	 single-producer/single-consumer ring: the CAN interruption drains
+ 	 	 	 the Rx FIFO into it, and the Rx task takes the messages in batches.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "can_rx_ring.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL				(0)
+/** Defines the mask to wrap the ring positions*/
+#define RING_MASK				(CAN_RX_RING_SIZE - 1)
+/** Defines that the message was stored or taken*/
+#define RING_OK					(1)
+/** Defines that the ring was full or empty*/
+#define RING_NOT_OK				(0)
+
+/** Keeps the compiler from moving the message copy after the index update*/
+#define RING_BARRIER()			__asm volatile ("" : : : "memory")
+
+/** This function initializes the Rx ring*/
+void CAN_rx_ring_init(can_rx_ring_t* ring)
+{
+	ring->head = INIT_VAL;
+	ring->tail = INIT_VAL;
+	ring->stats.received = INIT_VAL;
+	ring->stats.dropped = INIT_VAL;
+	ring->stats.fifo_overflows = INIT_VAL;
+	ring->stats.high_water = INIT_VAL;
+}
+
+/** This function stores a message in the ring*/
+uint8_t CAN_rx_ring_push(can_rx_ring_t* ring, const can_message_rx_config_t* can_message_rx)
+{
+	/** Local copy of the write position*/
+	uint16_t head = ring->head;
+	/** Messages waiting in the ring*/
+	uint16_t used = (uint16_t)(head - ring->tail);
+	/** Sets the return value as dropped*/
+	uint8_t retval = RING_NOT_OK;
+
+	/** If there is space in the ring*/
+	if(CAN_RX_RING_SIZE > used)
+	{
+		ring->frames[head & RING_MASK] = *can_message_rx;
+
+		/** The message must be complete before the consumer can see it*/
+		RING_BARRIER();
+		ring->head = (uint16_t)(head + 1);
+
+		ring->stats.received ++;
+		used ++;
+		if(ring->stats.high_water < used)
+		{
+			ring->stats.high_water = used;
+		}
+
+		retval = RING_OK;
+	}
+
+	/** The ring is full*/
+	else
+	{
+		ring->stats.dropped ++;
+	}
+
+	return retval;
+}
+
+/** This function takes the oldest message of the ring*/
+uint8_t CAN_rx_ring_pop(can_rx_ring_t* ring, can_message_rx_config_t* can_message_rx)
+{
+	/** Local copy of the read position*/
+	uint16_t tail = ring->tail;
+	/** Sets the return value as empty*/
+	uint8_t retval = RING_NOT_OK;
+
+	/** If there is at least one message*/
+	if(tail != ring->head)
+	{
+		/** The index must be read before the message*/
+		RING_BARRIER();
+		*can_message_rx = ring->frames[tail & RING_MASK];
+
+		/** The copy must be complete before the producer can reuse the position*/
+		RING_BARRIER();
+		ring->tail = (uint16_t)(tail + 1);
+
+		retval = RING_OK;
+	}
+
+	return retval;
+}
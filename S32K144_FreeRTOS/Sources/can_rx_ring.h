@@ -0,0 +1,79 @@
+/*!
+ 	 \file can_rx_ring.h
+
+ 	 \brief This is the header file of the CAN Rx ring. It is a lock-free
+ 	 	 	 single-producer/single-consumer ring: the CAN interruption drains
+ 	 	 	 the Rx FIFO into it, and the Rx task takes the messages in batches.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef CAN_RX_RING_H_
+#define CAN_RX_RING_H_
+
+#include "can_driver.h"
+
+/** Defines the number of messages of the ring (Must be a power of 2)*/
+#define CAN_RX_RING_SIZE				(32)
+
+/*!
+ 	 \brief Statistics of the Rx ring.
+ */
+typedef struct
+{
+	uint32_t received;			/*!< Messages stored in the ring*/
+	uint32_t dropped;			/*!< Messages lost because the ring was full*/
+	uint32_t fifo_overflows;	/*!< Times the hardware Rx FIFO overflowed*/
+	uint16_t high_water;		/*!< Maximum number of messages waiting in the ring*/
+}can_rx_ring_stats_t;
+
+/*!
+ 	 \brief Rx ring of one CAN module.
+ */
+typedef struct
+{
+	can_message_rx_config_t frames[CAN_RX_RING_SIZE];	/*!< Stored messages*/
+	volatile uint16_t head;								/*!< Next position to write (Only written by the producer)*/
+	volatile uint16_t tail;								/*!< Next position to read (Only written by the consumer)*/
+	can_rx_ring_stats_t stats;							/*!< Ring statistics (Only written by the producer)*/
+}can_rx_ring_t;
+
+/*!
+ 	 \brief This function initializes the Rx ring.
+
+ 	 \param[out] ring Rx ring to be initialized.
+
+ 	 \return void.
+ */
+void CAN_rx_ring_init(can_rx_ring_t* ring);
+
+/*!
+ 	 \brief This function stores a message in the ring.
+
+ 	 \note Only the producer (the CAN interruption) can call this function.
+
+ 	 \param[in] ring Rx ring.
+ 	 \param[in] can_message_rx Message to be stored.
+
+ 	 \return 1 if the message was stored, 0 if it was dropped because the ring was full.
+ */
+uint8_t CAN_rx_ring_push(can_rx_ring_t* ring, const can_message_rx_config_t* can_message_rx);
+
+/*!
+ 	 \brief This function takes the oldest message of the ring.
+
+ 	 \note Only the consumer (the Rx task) can call this function.
+
+ 	 \param[in] ring Rx ring.
+ 	 \param[out] can_message_rx Message taken from the ring.
+
+ 	 \return 1 if a message was taken, 0 if the ring was empty.
+ */
+uint8_t CAN_rx_ring_pop(can_rx_ring_t* ring, can_message_rx_config_t* can_message_rx);
+
+#endif /* CAN_RX_RING_H_ */
@@ -0,0 +1,86 @@
+/*!
+ 	 \file can_tx_policy.c
+
+ 	 \brief This is the source file of the CAN Tx policy of sensor-backed
+ 	 	 	 messages. It decides, for each new value, whether it is sent:
+ 	 	 	 cyclically, only when it changes more than a deadband, or both
+ 	 	 	 (Mixed). The messages keep a minimum gap between them and a
+ 	 	 	 maximum age, so a static signal is still refreshed.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "can_tx_policy.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL				(0)
+/** Defines that the value must be sent*/
+#define POLICY_SEND				(1)
+/** Defines that the value is not sent*/
+#define POLICY_SUPPRESS			(0)
+/** Defines that a message was sent*/
+#define POLICY_HAS_SENT			(1)
+
+/** This function initializes the policy of a message*/
+void CAN_tx_policy_init(can_tx_policy_t* policy, const can_tx_policy_config_t* config)
+{
+	policy->config = *config;
+	policy->last_value = INIT_VAL;
+	policy->last_tick = INIT_VAL;
+	policy->has_sent = INIT_VAL;
+}
+
+/** This function changes the configuration of a policy*/
+void CAN_tx_policy_set_config(can_tx_policy_t* policy, const can_tx_policy_config_t* config)
+{
+	policy->config = *config;
+}
+
+/** This function decides whether a new value is sent*/
+uint8_t CAN_tx_policy_check(can_tx_policy_t* policy, uint16_t value, uint32_t now)
+{
+	/** Ticks since the last message (The difference survives the wrap of the tick count)*/
+	uint32_t age = now - policy->last_tick;
+	/** Distance from the last sent value*/
+	uint16_t change = (value > policy->last_value) ? (value - policy->last_value) : (policy->last_value - value);
+	/** Whether the value is sent*/
+	uint8_t send = POLICY_SUPPRESS;
+
+	/** The first value is always sent*/
+	if(POLICY_HAS_SENT != policy->has_sent)
+	{
+		send = POLICY_SEND;
+	}
+
+	/** Nothing is sent before the minimum gap*/
+	else if(age < policy->config.min_gap)
+	{
+		send = POLICY_SUPPRESS;
+	}
+
+	/** A change out of the deadband (On change and mixed)*/
+	else if((tx_policy_cyclic != policy->config.mode) && (change > policy->config.deadband))
+	{
+		send = POLICY_SEND;
+	}
+
+	/** The refresh of the last value (Cyclic and mixed)*/
+	else if((tx_policy_on_change != policy->config.mode) && (age >= policy->config.max_age))
+	{
+		send = POLICY_SEND;
+	}
+
+	if(POLICY_SEND == send)
+	{
+		policy->last_value = value;
+		policy->last_tick = now;
+		policy->has_sent = POLICY_HAS_SENT;
+	}
+
+	return send;
+}
@@ -0,0 +1,92 @@
+/*!
+ 	 \file can_tx_policy.h
+
+ 	 \brief This is the header file of the CAN Tx policy of sensor-backed
+ 	 	 	 messages. It decides, for each new value, whether it is sent:
+ 	 	 	 cyclically, only when it changes more than a deadband, or both
+ 	 	 	 (Mixed). The messages keep a minimum gap between them and a
+ 	 	 	 maximum age, so a static signal is still refreshed.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef CAN_TX_POLICY_H_
+#define CAN_TX_POLICY_H_
+
+#include <stdint.h>
+
+/*!
+ 	 \brief Enumerator to define when a value is sent.
+ */
+typedef enum
+{
+	tx_policy_cyclic,		/*!< Sent when its age reaches max_age (0 sends every value)*/
+	tx_policy_on_change,	/*!< Sent only when it moves more than the deadband*/
+	tx_policy_mixed			/*!< Sent when it moves more than the deadband, or when its age reaches max_age*/
+}can_tx_policy_mode_t;
+
+/*!
+ 	 \brief Configuration of the policy of a message.
+ */
+typedef struct
+{
+	can_tx_policy_mode_t mode;	/*!< When a value is sent*/
+	uint16_t deadband;			/*!< Changes up to this value, from the last sent value, are not sent*/
+	uint32_t min_gap;			/*!< Minimum ticks between two messages (Changes wait for it)*/
+	uint32_t max_age;			/*!< Ticks after which the last sent value is sent again (Cyclic and mixed)*/
+}can_tx_policy_config_t;
+
+/*!
+ 	 \brief Policy of a message.
+ */
+typedef struct
+{
+	can_tx_policy_config_t config;	/*!< Configuration of the policy*/
+	uint16_t last_value;				/*!< Last sent value*/
+	uint32_t last_tick;				/*!< Tick of the last message*/
+	uint8_t has_sent;				/*!< Defines whether a message was sent or not (The first value is always sent)*/
+}can_tx_policy_t;
+
+/*!
+ 	 \brief This function initializes the policy of a message.
+
+ 	 \param[out] policy Policy to be initialized.
+ 	 \param[in] config Configuration of the policy.
+
+ 	 \return void.
+ */
+void CAN_tx_policy_init(can_tx_policy_t* policy, const can_tx_policy_config_t* config);
+
+/*!
+ 	 \brief This function changes the configuration of a policy, keeping the
+ 	 	 	 last sent value.
+
+ 	 \param[in] policy Policy of the message.
+ 	 \param[in] config New configuration of the policy.
+
+ 	 \return void.
+ */
+void CAN_tx_policy_set_config(can_tx_policy_t* policy, const can_tx_policy_config_t* config);
+
+/*!
+ 	 \brief This function decides whether a new value is sent, and if it is,
+ 	 	 	 takes it as the last sent value.
+
+ 	 \note The minimum gap applies to every mode, and it is measured from the
+ 	 	 	 last message. A change that waits for the gap is sent by the first
+ 	 	 	 value after it, if the value is still out of the deadband.
+
+ 	 \param[in] policy Policy of the message.
+ 	 \param[in] value New value.
+ 	 \param[in] now Current tick.
+
+ 	 \return 1 if the value must be sent, 0 otherwise.
+ */
+uint8_t CAN_tx_policy_check(can_tx_policy_t* policy, uint16_t value, uint32_t now);
+
+#endif /* CAN_TX_POLICY_H_ */
@@ -0,0 +1,298 @@
+/*!
+ 	 \file can_tx_queue.c
+
+ 	 \brief This is the source file of the asynchronous CAN Tx queue. The
+ 	 	 	 messages are loaded into a pool of Tx message buffers and, when
+ 	 	 	 all of them are busy, they wait in a software priority queue
+ 	 	 	 that is emptied from the message buffer interruption. The
+ 	 	 	 FlexCAN sends the MBs with equal IDs lowest MB first (CTRL1.LBUF
+ 	 	 	 is clear), so a message waits while its ID is in the pool, and
+ 	 	 	 the messages of an ID leave in their arrival order.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "can_tx_queue.h"
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL				(0)
+/** Defines a bit to be shifted in masks*/
+#define BIT_TO_SHIFT			(1UL)
+/** Defines the maximum DLC that can be sent*/
+#define MAX_DLC					(8)
+/** Defines the position of the first element of the heap*/
+#define HEAP_TOP				(0)
+/** Defines the offset of 1 in an array position*/
+#define ARRAY_OFFSET_1			(1)
+/** Defines the relation between a heap node and its children*/
+#define HEAP_CHILDREN			(2)
+
+/** Returns whether frame a must be sent before frame b (lower ID first, then arrival order)*/
+static uint8_t CAN_tx_frame_before(const can_tx_frame_t* a, const can_tx_frame_t* b)
+{
+	return ((a->ID < b->ID) || ((a->ID == b->ID) && (0 > (int32_t)(a->order - b->order))));
+}
+
+/** Swaps two frames of the heap*/
+static void CAN_tx_frame_swap(can_tx_frame_t* a, can_tx_frame_t* b)
+{
+	can_tx_frame_t temp = *a;
+
+	*a = *b;
+	*b = temp;
+}
+
+/** Loads a frame into the selected message buffer*/
+static void CAN_tx_queue_load(can_tx_queue_t* queue, can_tx_frame_t* frame, uint8_t mb)
+{
+	/** Message structure for the driver*/
+	can_message_tx_config_t can_message_tx;
+
+	can_message_tx.base = queue->base;
+	can_message_tx.ID = frame->ID;
+	can_message_tx.msg = frame->msg;
+	can_message_tx.DLC = frame->DLC;
+
+	/** Marks the MB as busy and requests the transmission*/
+	queue->free_mbs &= ~(BIT_TO_SHIFT << mb);
+	queue->mb_IDs[mb - CAN_TX_MB_FIRST] = frame->ID;
+	CAN_send_message_mb(can_message_tx, mb);
+}
+
+/** Gets the lowest idle message buffer of the pool*/
+static uint8_t CAN_tx_queue_get_free_mb(can_tx_queue_t* queue)
+{
+	/** Counter for the Tx pool*/
+	uint8_t mb = CAN_TX_MB_FIRST;
+
+	/** Looks for the first MB marked as free*/
+	while(!(queue->free_mbs & (BIT_TO_SHIFT << mb)))
+	{
+		mb ++;
+	}
+
+	return mb;
+}
+
+/** Returns whether a frame with the ID is in a busy message buffer of the pool*/
+static uint8_t CAN_tx_queue_ID_busy(can_tx_queue_t* queue, uint16_t ID)
+{
+	/** Indicates if the ID was found*/
+	uint8_t busy = INIT_VAL;
+	/** Counter for the Tx pool*/
+	uint8_t mb;
+
+	for(mb = CAN_TX_MB_FIRST ; ((CAN_TX_MB_FIRST + CAN_TX_MB_COUNT) > mb) && !busy ; mb ++)
+	{
+		busy = (!(queue->free_mbs & (BIT_TO_SHIFT << mb)) && (ID == queue->mb_IDs[mb - CAN_TX_MB_FIRST]));
+	}
+
+	return busy;
+}
+
+/** Inserts a frame in the heap*/
+static void CAN_tx_queue_push(can_tx_queue_t* queue, can_tx_frame_t* frame)
+{
+	/** Position of the new frame*/
+	uint8_t child = queue->count;
+	/** Position of the parent of the new frame*/
+	uint8_t parent;
+
+	queue->frames[child] = *frame;
+	queue->count ++;
+
+	/** Moves the frame up while it has a higher priority than its parent*/
+	while(HEAP_TOP < child)
+	{
+		parent = (child - ARRAY_OFFSET_1) / HEAP_CHILDREN;
+
+		if(!CAN_tx_frame_before(&queue->frames[child], &queue->frames[parent]))
+		{
+			break;
+		}
+
+		CAN_tx_frame_swap(&queue->frames[child], &queue->frames[parent]);
+		child = parent;
+	}
+
+	/** Updates the high water mark*/
+	if(queue->stats.high_water < queue->count)
+	{
+		queue->stats.high_water = queue->count;
+	}
+}
+
+/** Removes the frame with the highest priority from the heap*/
+static void CAN_tx_queue_pop(can_tx_queue_t* queue, can_tx_frame_t* frame)
+{
+	/** Position of the frame being moved down*/
+	uint8_t parent = HEAP_TOP;
+	/** Position of the child with the highest priority*/
+	uint8_t child;
+
+	*frame = queue->frames[HEAP_TOP];
+	queue->count --;
+	queue->frames[HEAP_TOP] = queue->frames[queue->count];
+
+	/** Moves the last frame down while a child has a higher priority*/
+	for(;;)
+	{
+		child = (parent * HEAP_CHILDREN) + ARRAY_OFFSET_1;
+
+		if(child >= queue->count)
+		{
+			break;
+		}
+
+		if(((child + ARRAY_OFFSET_1) < queue->count) &&
+			CAN_tx_frame_before(&queue->frames[child + ARRAY_OFFSET_1], &queue->frames[child]))
+		{
+			child ++;
+		}
+
+		if(!CAN_tx_frame_before(&queue->frames[child], &queue->frames[parent]))
+		{
+			break;
+		}
+
+		CAN_tx_frame_swap(&queue->frames[child], &queue->frames[parent]);
+		parent = child;
+	}
+}
+
+/** Loads the queued frames into the idle message buffers. The first frame waits while its ID is in the pool,
+ 	 the frames after it wait too, so they keep the priority order (It is one frame time at most)*/
+static void CAN_tx_queue_fill(can_tx_queue_t* queue)
+{
+	/** Next message to be sent*/
+	can_tx_frame_t frame;
+
+	while((INIT_VAL != queue->free_mbs) && (INIT_VAL != queue->count) &&
+		  !CAN_tx_queue_ID_busy(queue, queue->frames[HEAP_TOP].ID))
+	{
+		CAN_tx_queue_pop(queue, &frame);
+		CAN_tx_queue_load(queue, &frame, CAN_tx_queue_get_free_mb(queue));
+	}
+}
+
+/** This function initializes the Tx queue*/
+void CAN_tx_queue_init(can_tx_queue_t* queue, CAN_Type* base)
+{
+	queue->base = base;
+	queue->count = INIT_VAL;
+	queue->order = INIT_VAL;
+	queue->free_mbs = CAN_TX_MB_POOL_MASK;
+	queue->stats.queued = INIT_VAL;
+	queue->stats.sent = INIT_VAL;
+	queue->stats.dropped = INIT_VAL;
+	queue->stats.high_water = INIT_VAL;
+
+	/** Clears any old flag of the pool and enables its interruptions*/
+	CAN_clear_mb_flags(base, CAN_TX_MB_POOL_MASK);
+	CAN_enable_tx_interruption(base);
+}
+
+/** This function sends a message without waiting for its transmission*/
+CAN_tx_queue_status_t CAN_tx_queue_send(can_tx_queue_t* queue, can_message_tx_config_t can_message_tx)
+{
+	/** Sets the return value as successful*/
+	CAN_tx_queue_status_t retval = tx_queue_success;
+	/** Copy of the message*/
+	can_tx_frame_t frame;
+	/** Counter to copy the message*/
+	uint8_t counter;
+
+	if(MAX_DLC < can_message_tx.DLC)
+	{
+		can_message_tx.DLC = MAX_DLC;
+	}
+
+	/** Copies the message, so the caller can reuse its buffer*/
+	frame.ID = can_message_tx.ID;
+	frame.DLC = can_message_tx.DLC;
+	for(counter = INIT_VAL ; counter < can_message_tx.DLC ; counter ++)
+	{
+		frame.msg[counter] = can_message_tx.msg[counter];
+	}
+
+	/** The MB interruption also modifies the queue*/
+	taskENTER_CRITICAL();
+
+	frame.order = queue->order;
+	queue->order ++;
+
+	/** If a MB is idle, nothing waits and its ID is not being sent, the message goes directly to the MB*/
+	if((INIT_VAL != queue->free_mbs) && (INIT_VAL == queue->count) && !CAN_tx_queue_ID_busy(queue, frame.ID))
+	{
+		CAN_tx_queue_load(queue, &frame, CAN_tx_queue_get_free_mb(queue));
+		queue->stats.queued ++;
+	}
+
+	/** The message waits in the queue, it is loaded as soon as it is the first one and its ID is free*/
+	else if(CAN_TX_QUEUE_SIZE > queue->count)
+	{
+		CAN_tx_queue_push(queue, &frame);
+		CAN_tx_queue_fill(queue);
+		queue->stats.queued ++;
+	}
+
+	/** There is no space for the message*/
+	else
+	{
+		queue->stats.dropped ++;
+		retval = tx_queue_full;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return retval;
+}
+
+/** This function completes the transmitted messages from the MB interruption*/
+void CAN_tx_queue_isr(can_tx_queue_t* queue)
+{
+	/** Flags of the MBs that finished*/
+	uint32_t done_mbs;
+	/** Counter for the Tx pool*/
+	uint8_t mb;
+	/** Interruption mask to protect the queue*/
+	UBaseType_t isr_mask;
+
+	isr_mask = taskENTER_CRITICAL_FROM_ISR();
+
+	/** Gets and clears the flags of the finished MBs*/
+	done_mbs = CAN_get_tx_pool_flags(queue->base);
+	CAN_clear_mb_flags(queue->base, done_mbs);
+
+	for(mb = CAN_TX_MB_FIRST ; (CAN_TX_MB_FIRST + CAN_TX_MB_COUNT) > mb ; mb ++)
+	{
+		/** If the MB finished its transmission*/
+		if(done_mbs & (BIT_TO_SHIFT << mb))
+		{
+			queue->stats.sent ++;
+			queue->free_mbs |= (BIT_TO_SHIFT << mb);
+		}
+	}
+
+	/** Reloads the idle MBs with the next messages of the queue*/
+	CAN_tx_queue_fill(queue);
+
+	taskEXIT_CRITICAL_FROM_ISR(isr_mask);
+}
+
+/** This function gets the statistics of the Tx queue*/
+void CAN_tx_queue_get_stats(can_tx_queue_t* queue, can_tx_queue_stats_t* stats)
+{
+	taskENTER_CRITICAL();
+	*stats = queue->stats;
+	taskEXIT_CRITICAL();
+}
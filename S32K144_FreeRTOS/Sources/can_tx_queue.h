@@ -0,0 +1,124 @@
+/*!
+ 	 \file can_tx_queue.h
+
+ 	 \brief This is the header file of the asynchronous CAN Tx queue. The
+ 	 	 	 messages are loaded into a pool of Tx message buffers and, when
+ 	 	 	 all of them are busy, they wait in a software priority queue
+ 	 	 	 that is emptied from the message buffer interruption. A message
+ 	 	 	 is not loaded while another one with its ID is in the pool: with
+ 	 	 	 CTRL1.LBUF clear the FlexCAN sends equal IDs by MB number, so
+ 	 	 	 the messages of an ID leave in their arrival order.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef CAN_TX_QUEUE_H_
+#define CAN_TX_QUEUE_H_
+
+#include "can_driver.h"
+
+/** Defines the number of messages that can wait for a free Tx message buffer*/
+#define CAN_TX_QUEUE_SIZE				(16)
+
+/*!
+ 	 \brief Enumerator to define the result of queuing a message.
+ */
+typedef enum
+{
+	tx_queue_success,	/*!< Message loaded in a MB or queued*/
+	tx_queue_full		/*!< Queue is full, the message was dropped*/
+}CAN_tx_queue_status_t;
+
+/*!
+ 	 \brief Message stored in the software queue.
+ */
+typedef struct
+{
+	uint16_t ID;		/*!< ID of the message*/
+	uint8_t DLC;		/*!< DLC of the message*/
+	uint8_t msg[8];		/*!< Copy of the message data*/
+	uint32_t order;		/*!< Arrival order, to keep FIFO order between equal IDs*/
+}can_tx_frame_t;
+
+/*!
+ 	 \brief Statistics of the Tx queue.
+ */
+typedef struct
+{
+	uint32_t queued;		/*!< Messages accepted by CAN_tx_queue_send*/
+	uint32_t sent;			/*!< Messages that finished their transmission*/
+	uint32_t dropped;		/*!< Messages rejected because the queue was full*/
+	uint8_t high_water;		/*!< Maximum number of messages waiting in the queue*/
+}can_tx_queue_stats_t;
+
+/*!
+ 	 \brief Tx queue of one CAN module.
+ */
+typedef struct
+{
+	CAN_Type* base;								/*!< CAN that sends the messages*/
+	can_tx_frame_t frames[CAN_TX_QUEUE_SIZE];	/*!< Binary heap, lowest ID first*/
+	uint8_t count;								/*!< Messages in the heap*/
+	uint32_t free_mbs;							/*!< IFLAG1 bits of the idle Tx message buffers*/
+	uint16_t mb_IDs[CAN_TX_MB_COUNT];			/*!< IDs loaded in the busy Tx message buffers*/
+	uint32_t order;								/*!< Arrival counter*/
+	can_tx_queue_stats_t stats;					/*!< Queue statistics*/
+}can_tx_queue_t;
+
+/*!
+ 	 \brief This function initializes the Tx queue and enables the Tx pool
+ 	 	 	 interruptions.
+
+ 	 \note The CAN must be initialized with CAN_Init before calling this function.
+
+ 	 \param[out] queue Tx queue to be initialized.
+ 	 \param[in] base CAN that will send the messages of the queue.
+
+ 	 \return void.
+ */
+void CAN_tx_queue_init(can_tx_queue_t* queue, CAN_Type* base);
+
+/*!
+ 	 \brief This function sends a message without waiting for its transmission.
+ 	 	 	 If a Tx message buffer is idle, and no message waits before it,
+ 	 	 	 the message is loaded right away, otherwise it is stored in the
+ 	 	 	 priority queue.
+
+ 	 \note The message data is copied, so the buffer can be reused after the call.
+ 	 \note This function must be called from a task.
+
+ 	 \param[in] queue Tx queue of the CAN.
+ 	 \param[in] can_message_tx Message structure to be sent.
+
+ 	 \return Whether the message was accepted or dropped.
+ */
+CAN_tx_queue_status_t CAN_tx_queue_send(can_tx_queue_t* queue, can_message_tx_config_t can_message_tx);
+
+/*!
+ 	 \brief This function completes the transmitted messages and loads the next
+ 	 	 	 queued messages into the freed message buffers.
+
+ 	 \note This function must be called from the message buffer interruption.
+
+ 	 \param[in] queue Tx queue of the CAN.
+
+ 	 \return void.
+ */
+void CAN_tx_queue_isr(can_tx_queue_t* queue);
+
+/*!
+ 	 \brief This function gets the statistics of the Tx queue.
+
+ 	 \param[in] queue Tx queue of the CAN.
+ 	 \param[out] stats Copy of the statistics.
+
+ 	 \return void.
+ */
+void CAN_tx_queue_get_stats(can_tx_queue_t* queue, can_tx_queue_stats_t* stats);
+
+#endif /* CAN_TX_QUEUE_H_ */
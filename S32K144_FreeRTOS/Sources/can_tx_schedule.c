@@ -0,0 +1,277 @@
+/*!
+ 	 \file can_tx_schedule.c
+
+ 	 \brief This is the source file of the CAN periodic Tx schedule. It is a
+ 	 	 	 table of periodic messages, each one with its own period and
+ 	 	 	 offset, served by a single task. The offsets are staggered so
+ 	 	 	 that, whenever possible, no two messages are due in the same tick.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "can_tx_schedule.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL				(0)
+/** Defines the slot as in use*/
+#define SLOT_ACTIVE				(1)
+/** Defines the slot as free*/
+#define SLOT_FREE				(0)
+/** Defines that a message was taken*/
+#define SCHEDULE_DUE			(1)
+/** Defines that no message was due*/
+#define SCHEDULE_NOT_DUE		(0)
+/** Defines the worst number of collisions*/
+#define MAX_COLLISIONS			(0xFF)
+
+/** This function gets the greatest common divisor of two periods*/
+static uint32_t CAN_tx_schedule_gcd(uint32_t a, uint32_t b)
+{
+	/** Variable to keep the remainder*/
+	uint32_t remainder;
+
+	while(INIT_VAL != b)
+	{
+		remainder = a % b;
+		a = b;
+		b = remainder;
+	}
+
+	return a;
+}
+
+/** This function gets the first tick, from "from" on, when the offset is due*/
+static uint32_t CAN_tx_schedule_next_due(uint32_t period, uint32_t offset, uint32_t from)
+{
+	return from + ((offset + period - (from % period)) % period);
+}
+
+/** This function picks the offset that collides with the fewest messages of the schedule*/
+static uint32_t CAN_tx_schedule_stagger(can_tx_schedule_t* schedule, uint8_t slot, uint32_t period)
+{
+	/** gcd of the period with the period of each message*/
+	uint32_t gcd[CAN_TX_SCHEDULE_SIZE];
+	/** Offset of each message modulo its gcd*/
+	uint32_t phase[CAN_TX_SCHEDULE_SIZE];
+	/** The collisions repeat every lcm of the gcds (It divides the period)*/
+	uint32_t search_length = 1;
+	/** Variable to go through the schedule*/
+	uint8_t index;
+	/** Offset being checked*/
+	uint32_t offset;
+	/** Collisions of the offset being checked*/
+	uint8_t collisions;
+	/** Offset with the fewest collisions*/
+	uint32_t best_offset = INIT_VAL;
+	/** Collisions of the best offset*/
+	uint8_t best_collisions = MAX_COLLISIONS;
+
+	/** Gets the gcd and the phase of each message*/
+	for(index = INIT_VAL; CAN_TX_SCHEDULE_SIZE > index; index ++)
+	{
+		if((SLOT_ACTIVE == schedule->entries[index].active) && (slot != index))
+		{
+			gcd[index] = CAN_tx_schedule_gcd(period, schedule->entries[index].period);
+			phase[index] = schedule->entries[index].offset % gcd[index];
+			search_length = (search_length / CAN_tx_schedule_gcd(search_length, gcd[index])) * gcd[index];
+		}
+	}
+
+	/** Checks each offset until one without collisions is found*/
+	for(offset = INIT_VAL; (search_length > offset) && (INIT_VAL != best_collisions); offset ++)
+	{
+		collisions = INIT_VAL;
+
+		/** Two messages collide if their offsets are equal modulo the gcd of their periods*/
+		for(index = INIT_VAL; CAN_TX_SCHEDULE_SIZE > index; index ++)
+		{
+			if((SLOT_ACTIVE == schedule->entries[index].active) && (slot != index) &&
+				((offset % gcd[index]) == phase[index]))
+			{
+				collisions ++;
+			}
+		}
+
+		if(best_collisions > collisions)
+		{
+			best_collisions = collisions;
+			best_offset = offset;
+		}
+	}
+
+	return best_offset;
+}
+
+/** This function initializes the schedule without periodic messages*/
+void CAN_tx_schedule_init(can_tx_schedule_t* schedule)
+{
+	/** Variable to go through the schedule*/
+	uint8_t index;
+
+	for(index = INIT_VAL; CAN_TX_SCHEDULE_SIZE > index; index ++)
+	{
+		schedule->entries[index].active = SLOT_FREE;
+	}
+	schedule->count = INIT_VAL;
+}
+
+/** This function adds a periodic message to the schedule*/
+uint8_t CAN_tx_schedule_add(can_tx_schedule_t* schedule, can_message_tx_config_t can_message_tx, uint32_t period, uint32_t now)
+{
+	/** Variable to find a free slot*/
+	uint8_t slot = INIT_VAL;
+
+	/** A period of 0 ticks can not be scheduled*/
+	if(INIT_VAL == period)
+	{
+		return CAN_TX_SCHEDULE_NO_SLOT;
+	}
+
+	/** Looks for a free slot*/
+	while((CAN_TX_SCHEDULE_SIZE > slot) && (SLOT_ACTIVE == schedule->entries[slot].active))
+	{
+		slot ++;
+	}
+
+	/** The schedule is full*/
+	if(CAN_TX_SCHEDULE_SIZE == slot)
+	{
+		return CAN_TX_SCHEDULE_NO_SLOT;
+	}
+
+	/** Sets the message, staggered against the messages already scheduled*/
+	schedule->entries[slot].message = can_message_tx;
+	schedule->entries[slot].period = period;
+	schedule->entries[slot].offset = CAN_tx_schedule_stagger(schedule, slot, period);
+	schedule->entries[slot].next = CAN_tx_schedule_next_due(period, schedule->entries[slot].offset, now);
+	schedule->entries[slot].active = SLOT_ACTIVE;
+	schedule->count ++;
+
+	return slot;
+}
+
+/** This function removes a periodic message from the schedule*/
+CAN_tx_schedule_status_t CAN_tx_schedule_remove(can_tx_schedule_t* schedule, uint8_t slot)
+{
+	if((CAN_TX_SCHEDULE_SIZE <= slot) || (SLOT_FREE == schedule->entries[slot].active))
+	{
+		return tx_schedule_invalid_slot;
+	}
+
+	schedule->entries[slot].active = SLOT_FREE;
+	schedule->count --;
+
+	return tx_schedule_success;
+}
+
+/** This function changes the period of a periodic message*/
+CAN_tx_schedule_status_t CAN_tx_schedule_set_period(can_tx_schedule_t* schedule, uint8_t slot, uint32_t period, uint32_t now)
+{
+	if((CAN_TX_SCHEDULE_SIZE <= slot) || (SLOT_FREE == schedule->entries[slot].active))
+	{
+		return tx_schedule_invalid_slot;
+	}
+
+	if(INIT_VAL == period)
+	{
+		return tx_schedule_invalid_period;
+	}
+
+	/** Staggers the message again with its new period*/
+	schedule->entries[slot].period = period;
+	schedule->entries[slot].offset = CAN_tx_schedule_stagger(schedule, slot, period);
+	schedule->entries[slot].next = CAN_tx_schedule_next_due(period, schedule->entries[slot].offset, now);
+
+	return tx_schedule_success;
+}
+
+/** This function changes the message of a slot*/
+CAN_tx_schedule_status_t CAN_tx_schedule_set_message(can_tx_schedule_t* schedule, uint8_t slot, can_message_tx_config_t can_message_tx)
+{
+	if((CAN_TX_SCHEDULE_SIZE <= slot) || (SLOT_FREE == schedule->entries[slot].active))
+	{
+		return tx_schedule_invalid_slot;
+	}
+
+	schedule->entries[slot].message = can_message_tx;
+
+	return tx_schedule_success;
+}
+
+/** This function takes one message that is due*/
+uint8_t CAN_tx_schedule_pop_due(can_tx_schedule_t* schedule, uint32_t now, can_message_tx_config_t* can_message_tx)
+{
+	/** Variable to go through the schedule*/
+	uint8_t index;
+	/** Slot of the most overdue message*/
+	uint8_t slot = CAN_TX_SCHEDULE_NO_SLOT;
+	/** Ticks the most overdue message is late*/
+	int32_t latest = -1;
+	/** Entry of the due message*/
+	can_tx_schedule_entry_t* entry;
+
+	/** Finds the most overdue message (Ticks are compared as differences to survive the wrap)*/
+	for(index = INIT_VAL; CAN_TX_SCHEDULE_SIZE > index; index ++)
+	{
+		if((SLOT_ACTIVE == schedule->entries[index].active) &&
+			(latest < (int32_t)(now - schedule->entries[index].next)))
+		{
+			latest = (int32_t)(now - schedule->entries[index].next);
+			slot = index;
+		}
+	}
+
+	if(CAN_TX_SCHEDULE_NO_SLOT == slot)
+	{
+		return SCHEDULE_NOT_DUE;
+	}
+
+	entry = &schedule->entries[slot];
+	*can_message_tx = entry->message;
+
+	/** Schedules the next period, skipping the periods that were missed*/
+	entry->next += entry->period;
+	if(INIT_VAL <= (int32_t)(now - entry->next))
+	{
+		entry->next = CAN_tx_schedule_next_due(entry->period, entry->offset, now + 1);
+	}
+
+	return SCHEDULE_DUE;
+}
+
+/** This function gets the ticks until the next message is due*/
+uint32_t CAN_tx_schedule_ticks_to_next(can_tx_schedule_t* schedule, uint32_t now)
+{
+	/** Variable to go through the schedule*/
+	uint8_t index;
+	/** Ticks until the earliest message*/
+	uint32_t ticks = CAN_TX_SCHEDULE_IDLE;
+	/** Ticks until the message being checked*/
+	int32_t remaining;
+
+	for(index = INIT_VAL; CAN_TX_SCHEDULE_SIZE > index; index ++)
+	{
+		if(SLOT_ACTIVE == schedule->entries[index].active)
+		{
+			remaining = (int32_t)(schedule->entries[index].next - now);
+
+			/** A message is already due*/
+			if(INIT_VAL >= remaining)
+			{
+				return INIT_VAL;
+			}
+
+			if(ticks > (uint32_t)remaining)
+			{
+				ticks = (uint32_t)remaining;
+			}
+		}
+	}
+
+	return ticks;
+}
@@ -0,0 +1,148 @@
+/*!
+ 	 \file can_tx_schedule.h
+
+ 	 \brief This is the header file of the CAN periodic Tx schedule. It is a
+ 	 	 	 table of periodic messages, each one with its own period and
+ 	 	 	 offset, served by a single task. The offsets are staggered so
+ 	 	 	 that, whenever possible, no two messages are due in the same tick.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef CAN_TX_SCHEDULE_H_
+#define CAN_TX_SCHEDULE_H_
+
+#include "can_driver.h"
+
+/** Defines the number of periodic messages of the schedule*/
+#define CAN_TX_SCHEDULE_SIZE				(32)
+/** Defines the slot returned when the schedule is full*/
+#define CAN_TX_SCHEDULE_NO_SLOT				(0xFF)
+/** Defines the ticks returned when there are no periodic messages*/
+#define CAN_TX_SCHEDULE_IDLE				(0xFFFFFFFF)
+
+/*!
+ 	 \brief Enumerator to define the result of a schedule operation.
+ */
+typedef enum
+{
+	tx_schedule_success,		/*!< Operation successful*/
+	tx_schedule_full,			/*!< Schedule is full*/
+	tx_schedule_invalid_slot,	/*!< Slot out of range or not in use*/
+	tx_schedule_invalid_period	/*!< Period of 0 ticks*/
+}CAN_tx_schedule_status_t;
+
+/*!
+ 	 \brief Periodic message of the schedule.
+ */
+typedef struct
+{
+	can_message_tx_config_t message;	/*!< Message to be sent (The data is read when the message is due)*/
+	uint32_t period;					/*!< Period, in ticks*/
+	uint32_t offset;					/*!< Phase, in ticks (The message is due when tick % period == offset)*/
+	uint32_t next;						/*!< Tick when the message is due*/
+	uint8_t active;						/*!< Defines whether the slot is in use or not*/
+}can_tx_schedule_entry_t;
+
+/*!
+ 	 \brief Periodic Tx schedule.
+ */
+typedef struct
+{
+	can_tx_schedule_entry_t entries[CAN_TX_SCHEDULE_SIZE];	/*!< Periodic messages*/
+	uint8_t count;											/*!< Slots in use*/
+}can_tx_schedule_t;
+
+/*!
+ 	 \brief This function initializes the schedule without periodic messages.
+
+ 	 \param[out] schedule Schedule to be initialized.
+
+ 	 \return void.
+ */
+void CAN_tx_schedule_init(can_tx_schedule_t* schedule);
+
+/*!
+ 	 \brief This function adds a periodic message to the schedule.
+
+ 	 \note The offset is chosen to collide with the fewest messages already in
+ 	 	 	 the schedule. Two messages with periods p1 and p2 are due in the same
+ 	 	 	 tick only if their offsets are equal modulo gcd(p1, p2).
+
+ 	 \param[in] schedule Periodic Tx schedule.
+ 	 \param[in] can_message_tx Message to be sent. The data buffer is not copied,
+ 	 	 	 	 so it can be updated between transmissions.
+ 	 \param[in] period Period, in ticks.
+ 	 \param[in] now Current tick.
+
+ 	 \return Slot of the message, or CAN_TX_SCHEDULE_NO_SLOT if it was not added.
+ */
+uint8_t CAN_tx_schedule_add(can_tx_schedule_t* schedule, can_message_tx_config_t can_message_tx, uint32_t period, uint32_t now);
+
+/*!
+ 	 \brief This function removes a periodic message from the schedule.
+
+ 	 \param[in] schedule Periodic Tx schedule.
+ 	 \param[in] slot Slot returned by CAN_tx_schedule_add.
+
+ 	 \return This function indicates if the task was successful, or if an error occurred.
+ */
+CAN_tx_schedule_status_t CAN_tx_schedule_remove(can_tx_schedule_t* schedule, uint8_t slot);
+
+/*!
+ 	 \brief This function changes the period of a periodic message, and staggers
+ 	 	 	 its offset again.
+
+ 	 \param[in] schedule Periodic Tx schedule.
+ 	 \param[in] slot Slot returned by CAN_tx_schedule_add.
+ 	 \param[in] period New period, in ticks.
+ 	 \param[in] now Current tick.
+
+ 	 \return This function indicates if the task was successful, or if an error occurred.
+ */
+CAN_tx_schedule_status_t CAN_tx_schedule_set_period(can_tx_schedule_t* schedule, uint8_t slot, uint32_t period, uint32_t now);
+
+/*!
+ 	 \brief This function changes the message of a slot, keeping its period and
+ 	 	 	 offset.
+
+ 	 \param[in] schedule Periodic Tx schedule.
+ 	 \param[in] slot Slot returned by CAN_tx_schedule_add.
+ 	 \param[in] can_message_tx New message to be sent.
+
+ 	 \return This function indicates if the task was successful, or if an error occurred.
+ */
+CAN_tx_schedule_status_t CAN_tx_schedule_set_message(can_tx_schedule_t* schedule, uint8_t slot, can_message_tx_config_t can_message_tx);
+
+/*!
+ 	 \brief This function takes one message that is due, and schedules its next
+ 	 	 	 transmission.
+
+ 	 \note If the message missed whole periods, they are skipped instead of being
+ 	 	 	 sent in a burst.
+
+ 	 \param[in] schedule Periodic Tx schedule.
+ 	 \param[in] now Current tick.
+ 	 \param[out] can_message_tx Message to be sent.
+
+ 	 \return 1 if a message was due, 0 otherwise.
+ */
+uint8_t CAN_tx_schedule_pop_due(can_tx_schedule_t* schedule, uint32_t now, can_message_tx_config_t* can_message_tx);
+
+/*!
+ 	 \brief This function gets the ticks until the next message is due.
+
+ 	 \param[in] schedule Periodic Tx schedule.
+ 	 \param[in] now Current tick.
+
+ 	 \return Ticks until the next message is due (0 if one is already due), or
+ 	 	 	 CAN_TX_SCHEDULE_IDLE if there are no periodic messages.
+ */
+uint32_t CAN_tx_schedule_ticks_to_next(can_tx_schedule_t* schedule, uint32_t now);
+
+#endif /* CAN_TX_SCHEDULE_H_ */
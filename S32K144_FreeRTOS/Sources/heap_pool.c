@@ -0,0 +1,318 @@
+/*!
+ 	 \file heap_pool.c
+
+ 	 \brief This is the source file of the FreeRTOS heap. It replaces heap_2
+ 	 	 	 with pools of fixed size blocks, one for each size class (Timers,
+ 	 	 	 TCBs, queues and stacks), so pvPortMalloc and vPortFree take
+ 	 	 	 constant time and the heap does not fragment.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "heap_pool.h"
+#include "task.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+
+/** The blocks of each class are the objects created by the application (RX_INTERRUPT mode with
+ 	 one CAN) plus at least one spare block, so a new object doesn't stop the application*/
+/** Defines the blocks for timers and event groups (Up to 4 timers, in the timer mode)*/
+#define CLASS_0_SIZE				(48)
+#define CLASS_0_BLOCKS				(5)
+/** Defines the blocks for TCBs, mutexes and small queues (7 TCBs, the CAN mutex and the SW3 queue)*/
+#define CLASS_1_SIZE				(96)
+#define CLASS_1_BLOCKS				(11)
+/** Defines the blocks for queues of up to 32 bytes of storage (The ADC Tx queue)*/
+#define CLASS_2_SIZE				(128)
+#define CLASS_2_BLOCKS				(2)
+/** Defines the blocks for bigger queues (The timer command queue and the ADC scan queue)*/
+#define CLASS_3_SIZE				(256)
+#define CLASS_3_BLOCKS				(3)
+/** Defines the blocks for the stacks of the timer task and the run-time report task (When the class
+ 	 is empty, a request falls back to a block of 800 bytes of class 5)*/
+#define CLASS_4_SIZE				(512)
+#define CLASS_4_BLOCKS				(3)
+/** Defines the blocks for the task stacks (configMINIMAL_STACK_SIZE, 4 threads and the idle task)*/
+#define CLASS_5_SIZE				(800)
+#define CLASS_5_BLOCKS				(6)
+
+/** Defines the bytes of all the pools*/
+#define HEAP_POOL_SIZE				((CLASS_0_SIZE * CLASS_0_BLOCKS) + (CLASS_1_SIZE * CLASS_1_BLOCKS) + \
+									(CLASS_2_SIZE * CLASS_2_BLOCKS) + (CLASS_3_SIZE * CLASS_3_BLOCKS) + \
+									(CLASS_4_SIZE * CLASS_4_BLOCKS) + (CLASS_5_SIZE * CLASS_5_BLOCKS))
+
+/** Rounds a size up to a multiple of the size of a word*/
+#define HEAP_POOL_WORDS(size)		((((size) + sizeof(UBaseType_t) - 1) / sizeof(UBaseType_t)) * sizeof(UBaseType_t))
+
+/** Defines the optional fields of the TCB, with the options of FreeRTOSConfig.h*/
+#if(configUSE_TRACE_FACILITY == 1)
+#define TCB_TRACE_SIZE				(2 * sizeof(UBaseType_t))
+#else
+#define TCB_TRACE_SIZE				(0)
+#endif
+#if(configUSE_MUTEXES == 1)
+#define TCB_MUTEXES_SIZE			(2 * sizeof(UBaseType_t))
+#else
+#define TCB_MUTEXES_SIZE			(0)
+#endif
+#if(configUSE_APPLICATION_TASK_TAG == 1)
+#define TCB_TAG_SIZE				(sizeof(TaskHookFunction_t))
+#else
+#define TCB_TAG_SIZE				(0)
+#endif
+#if(configGENERATE_RUN_TIME_STATS == 1)
+#define TCB_RUN_TIME_SIZE			(sizeof(uint32_t))
+#else
+#define TCB_RUN_TIME_SIZE			(0)
+#endif
+#if(configUSE_TASK_NOTIFICATIONS == 1)
+#define TCB_NOTIFY_SIZE				(sizeof(uint32_t) + sizeof(eNotifyAction))
+#else
+#define TCB_NOTIFY_SIZE				(0)
+#endif
+
+/** Defines the bytes of a TCB. FreeRTOS 8.2.1 has no StaticTask_t to take it from, so it adds the
+ 	 fields of tskTCB (tasks.c): top of stack, 2 list items, priority, stack, name and the optional
+ 	 fields (Update it if the kernel is updated)*/
+#define HEAP_POOL_TCB_SIZE			((2 * sizeof(StackType_t*)) + (2 * sizeof(ListItem_t)) + sizeof(UBaseType_t) + \
+									HEAP_POOL_WORDS(configMAX_TASK_NAME_LEN) + TCB_TRACE_SIZE + TCB_MUTEXES_SIZE + \
+									TCB_TAG_SIZE + TCB_RUN_TIME_SIZE + TCB_NOTIFY_SIZE)
+
+/** The pools must fit in the RAM given to the heap, and keep the blocks aligned*/
+typedef char heap_pool_size_check_t[(configTOTAL_HEAP_SIZE >= HEAP_POOL_SIZE) ? 1 : -1];
+typedef char heap_pool_align_check_t[(INIT_VAL == ((CLASS_0_SIZE | CLASS_1_SIZE | CLASS_2_SIZE |
+									CLASS_3_SIZE | CLASS_4_SIZE | CLASS_5_SIZE) & portBYTE_ALIGNMENT_MASK)) ? 1 : -1];
+/** The TCBs must fit in the blocks of class 1 (The classes are sized for the 32-bit target, with
+ 	 64-bit pointers the pools are only used by the host test)*/
+typedef char heap_pool_tcb_check_t[((sizeof(void*) > sizeof(uint32_t)) || (CLASS_1_SIZE >= HEAP_POOL_TCB_SIZE)) ? 1 : -1];
+#if((configUSE_NEWLIB_REENTRANT == 1) || (configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0) || (portCRITICAL_NESTING_IN_TCB == 1))
+#error "HEAP_POOL_TCB_SIZE doesn't count the newlib, thread local storage and critical nesting fields of the TCB"
+#endif
+
+/*!
+ 	 \brief Free block, the link is stored inside the block itself.
+ */
+typedef struct heap_pool_block
+{
+	struct heap_pool_block* next;	/*!< Next free block of the class*/
+}heap_pool_block_t;
+
+/*!
+ 	 \brief Pool of a size class.
+ */
+typedef struct
+{
+	uint8_t* start;					/*!< First byte of the pool*/
+	uint8_t* end;					/*!< First byte after the pool*/
+	heap_pool_block_t* free_list;	/*!< Free blocks of the pool*/
+	heap_pool_stats_t stats;		/*!< Statistics of the pool*/
+}heap_pool_class_t;
+
+/** Size and blocks of each class, from the smallest to the biggest blocks*/
+static const uint16_t class_config[HEAP_POOL_CLASSES][2] =
+{
+	{CLASS_0_SIZE, CLASS_0_BLOCKS},
+	{CLASS_1_SIZE, CLASS_1_BLOCKS},
+	{CLASS_2_SIZE, CLASS_2_BLOCKS},
+	{CLASS_3_SIZE, CLASS_3_BLOCKS},
+	{CLASS_4_SIZE, CLASS_4_BLOCKS},
+	{CLASS_5_SIZE, CLASS_5_BLOCKS}
+};
+
+/** Position of the block size in class_config*/
+#define CONFIG_SIZE					(0)
+/** Position of the number of blocks in class_config*/
+#define CONFIG_BLOCKS				(1)
+
+/** RAM of the pools*/
+static uint8_t heap[HEAP_POOL_SIZE] __attribute__((aligned(portBYTE_ALIGNMENT)));
+/** Pools of the size classes*/
+static heap_pool_class_t pool[HEAP_POOL_CLASSES];
+/** Free bytes of the heap*/
+static size_t free_bytes = INIT_VAL;
+/** Defines whether the pools have been initialized or not*/
+static uint8_t heap_init_val = pdFALSE;
+
+/** This function splits the heap in the pools, and links the free blocks of each one*/
+static void heap_pool_init(void)
+{
+	/** Variable to go through the classes*/
+	uint8_t size_class;
+	/** Variable to go through the blocks*/
+	uint16_t block;
+	/** Next free byte of the heap*/
+	uint8_t* position = heap;
+
+	for(size_class = INIT_VAL; HEAP_POOL_CLASSES > size_class; size_class ++)
+	{
+		pool[size_class].start = position;
+		pool[size_class].free_list = NULL;
+		pool[size_class].stats.block_size = class_config[size_class][CONFIG_SIZE];
+		pool[size_class].stats.blocks = class_config[size_class][CONFIG_BLOCKS];
+		pool[size_class].stats.used = INIT_VAL;
+		pool[size_class].stats.high_water = INIT_VAL;
+		pool[size_class].stats.failed = INIT_VAL;
+
+		/** Links the blocks, the first block ends at the head of the free list*/
+		for(block = INIT_VAL; class_config[size_class][CONFIG_BLOCKS] > block; block ++)
+		{
+			((heap_pool_block_t*)position)->next = pool[size_class].free_list;
+			pool[size_class].free_list = (heap_pool_block_t*)position;
+			position += class_config[size_class][CONFIG_SIZE];
+		}
+
+		pool[size_class].end = position;
+	}
+
+	free_bytes = HEAP_POOL_SIZE;
+	heap_init_val = pdTRUE;
+}
+
+/** This function takes a block of the smallest class that fits the wanted size*/
+void *pvPortMalloc(size_t xWantedSize)
+{
+	/** Variable to go through the classes*/
+	uint8_t size_class = INIT_VAL;
+	/** Class that fits the wanted size*/
+	uint8_t fit_class = HEAP_POOL_CLASSES;
+	/** Block taken*/
+	heap_pool_block_t* block = NULL;
+
+	vTaskSuspendAll();
+	{
+		/** Initializes the pools in the first call*/
+		if(pdFALSE == heap_init_val)
+		{
+			heap_pool_init();
+		}
+
+		/** Finds the smallest class that fits (Fixed number of classes)*/
+		while((HEAP_POOL_CLASSES > size_class) && (pool[size_class].stats.block_size < xWantedSize))
+		{
+			size_class ++;
+		}
+		fit_class = size_class;
+
+		/** If the class is empty, the next bigger class is used*/
+		while((HEAP_POOL_CLASSES > size_class) && (NULL == pool[size_class].free_list))
+		{
+			size_class ++;
+		}
+
+		/** Takes the first free block of the class*/
+		if((INIT_VAL != xWantedSize) && (HEAP_POOL_CLASSES > size_class))
+		{
+			block = pool[size_class].free_list;
+			pool[size_class].free_list = block->next;
+
+			pool[size_class].stats.used ++;
+			if(pool[size_class].stats.high_water < pool[size_class].stats.used)
+			{
+				pool[size_class].stats.high_water = pool[size_class].stats.used;
+			}
+			free_bytes -= pool[size_class].stats.block_size;
+		}
+
+		/** No block fits the wanted size*/
+		else if((INIT_VAL != xWantedSize) && (HEAP_POOL_CLASSES > fit_class))
+		{
+			pool[fit_class].stats.failed ++;
+		}
+
+		traceMALLOC(block, xWantedSize);
+	}
+	(void)xTaskResumeAll();
+
+#if(configUSE_MALLOC_FAILED_HOOK == 1)
+	if(NULL == block)
+	{
+		extern void vApplicationMallocFailedHook(void);
+		vApplicationMallocFailedHook();
+	}
+#endif
+
+	return (void*)block;
+}
+
+/** This function returns a block to the pool it belongs to*/
+void vPortFree(void *pv)
+{
+	/** Variable to go through the classes*/
+	uint8_t size_class = INIT_VAL;
+	/** Block returned*/
+	uint8_t* block = (uint8_t*)pv;
+
+	if(NULL != pv)
+	{
+		/** The pool of the block is found by its address (Fixed number of classes)*/
+		while((HEAP_POOL_CLASSES > size_class) && (pool[size_class].end <= block))
+		{
+			size_class ++;
+		}
+
+		/** The block must be the start of a block of the heap*/
+		configASSERT((HEAP_POOL_CLASSES > size_class) && (pool[size_class].start <= block) &&
+			(INIT_VAL == ((uint32_t)(block - pool[size_class].start) % pool[size_class].stats.block_size)));
+
+		vTaskSuspendAll();
+		{
+			((heap_pool_block_t*)block)->next = pool[size_class].free_list;
+			pool[size_class].free_list = (heap_pool_block_t*)block;
+
+			pool[size_class].stats.used --;
+			free_bytes += pool[size_class].stats.block_size;
+
+			traceFREE(pv, pool[size_class].stats.block_size);
+		}
+		(void)xTaskResumeAll();
+	}
+}
+
+/** This function gets the free bytes of the heap*/
+size_t xPortGetFreeHeapSize(void)
+{
+	/** Before the first allocation the whole heap is free*/
+	return (pdFALSE == heap_init_val) ? HEAP_POOL_SIZE : free_bytes;
+}
+
+/** This function exists to keep the same interface as heap_2*/
+void vPortInitialiseBlocks(void)
+{
+}
+
+#if(configUSE_MALLOC_FAILED_HOOK == 1)
+/** Hook called when pvPortMalloc can't serve a request. The objects are created before the scheduler
+ 	 starts, so a failure means that a pool is too small (The failed counter of heap_pool_get_stats
+ 	 tells which one). It is weak, so the application can replace it*/
+__attribute__((weak)) void vApplicationMallocFailedHook(void)
+{
+	/** Stops the application, it can't run without its objects*/
+	taskDISABLE_INTERRUPTS();
+	for(;;);
+}
+#endif
+
+/** This function gets the statistics of a size class of the heap*/
+void heap_pool_get_stats(uint8_t size_class, heap_pool_stats_t* stats)
+{
+	vTaskSuspendAll();
+	{
+		/** Initializes the pools if nothing has been allocated yet*/
+		if(pdFALSE == heap_init_val)
+		{
+			heap_pool_init();
+		}
+
+		if(HEAP_POOL_CLASSES > size_class)
+		{
+			*stats = pool[size_class].stats;
+		}
+	}
+	(void)xTaskResumeAll();
+}
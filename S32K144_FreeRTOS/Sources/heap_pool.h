@@ -0,0 +1,50 @@
+/*!
+ 	 \file heap_pool.h
+
+ 	 \brief This is the header file of the FreeRTOS heap. It replaces heap_2
+ 	 	 	 with pools of fixed size blocks, one for each size class (Timers,
+ 	 	 	 TCBs, queues and stacks), so pvPortMalloc and vPortFree take
+ 	 	 	 constant time and the heap does not fragment.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef HEAP_POOL_H_
+#define HEAP_POOL_H_
+
+#include "FreeRTOS.h"
+
+/** Defines the number of size classes of the heap*/
+#define HEAP_POOL_CLASSES				(6)
+
+/*!
+ 	 \brief Statistics of a size class.
+ */
+typedef struct
+{
+	uint16_t block_size;	/*!< Bytes of each block*/
+	uint16_t blocks;		/*!< Blocks of the class*/
+	uint16_t used;			/*!< Blocks in use*/
+	uint16_t high_water;	/*!< Maximum number of blocks in use*/
+	uint32_t failed;		/*!< Requests of this class that could not be served*/
+}heap_pool_stats_t;
+
+/*!
+ 	 \brief This function gets the statistics of a size class of the heap.
+
+ 	 \note A request is served by the smallest class that fits it. If that class
+ 	 	 	 is empty, the next bigger class is used.
+
+ 	 \param[in] size_class Size class, from 0 (Smallest blocks) to HEAP_POOL_CLASSES - 1.
+ 	 \param[out] stats Copy of the statistics of the class.
+
+ 	 \return void.
+ */
+void heap_pool_get_stats(uint8_t size_class, heap_pool_stats_t* stats);
+
+#endif /* HEAP_POOL_H_ */
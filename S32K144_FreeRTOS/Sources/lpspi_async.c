@@ -0,0 +1,186 @@
+/*!
+ 	 \file lpspi_async.c
+
+ 	 \brief This is the source file of the asynchronous LPSPI1 transaction
+ 	 	 	 engine. The transfers wait in a queue and are moved through the
+ 	 	 	 LPSPI FIFOs from the receive interruption, so the CPU is free
+ 	 	 	 while the SPI clock runs. Each transfer can call a function when
+ 	 	 	 it completes.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "lpspi_async.h"
+#include "task.h"
+#include "timebase.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the words of the LPSPI1 FIFOs*/
+#define LPSPI_FIFO_WORDS			(4)
+/** Defines the Tx watermark (Not used, the Tx FIFO is filled from the Rx interruption)*/
+#define LPSPI_TX_WATERMARK			(3)
+
+/** Transfers waiting for the LPSPI1*/
+static lpspi_transfer_t* transfer_queue[LPSPI_ASYNC_QUEUE_SIZE];
+/** Next position to read in the queue*/
+static uint8_t queue_head = INIT_VAL;
+/** Transfers in the queue*/
+static uint8_t queue_count = INIT_VAL;
+/** Transfer in the LPSPI1 (NULL when it is idle)*/
+static lpspi_transfer_t* active_transfer = NULL;
+/** Statistics of the engine*/
+static lpspi_async_stats_t lpspi_stats = {INIT_VAL};
+
+/** This function fills the Tx FIFO, keeping at most a FIFO of words in flight so the Rx FIFO can not overflow*/
+static void LPSPI_async_fill(lpspi_transfer_t* transfer)
+{
+	/** Words sent and not read yet*/
+	uint8_t in_flight;
+
+	while((transfer->count > transfer->tx_index) && (LPSPI_FIFO_WORDS > (uint8_t)(transfer->tx_index - transfer->rx_index)))
+	{
+		LPSPI1->TDR = transfer->tx[transfer->tx_index];
+		transfer->tx_index ++;
+	}
+
+	/** The Rx flag is set when every word in flight was received, one interruption per FIFO of words*/
+	in_flight = (uint8_t)(transfer->tx_index - transfer->rx_index);
+	LPSPI1->FCR = LPSPI_FCR_TXWATER(LPSPI_TX_WATERMARK) | LPSPI_FCR_RXWATER(in_flight - 1);
+}
+
+/** This function starts the next queued transfer, if there is one*/
+static void LPSPI_async_start_next(void)
+{
+	if(INIT_VAL == queue_count)
+	{
+		active_transfer = NULL;
+		return;
+	}
+
+	active_transfer = transfer_queue[queue_head];
+	queue_head = (queue_head + 1) % LPSPI_ASYNC_QUEUE_SIZE;
+	queue_count --;
+
+	active_transfer->state = lpspi_transfer_active;
+	LPSPI_async_fill(active_transfer);
+}
+
+/** This function prepares the engine*/
+void LPSPI_async_init(void)
+{
+	queue_head = INIT_VAL;
+	queue_count = INIT_VAL;
+	active_transfer = NULL;
+
+	/** Discards any word of the polled transfers, and enables the receive interruption*/
+	LPSPI1->CR |= LPSPI_CR_RRF_MASK | LPSPI_CR_RTF_MASK;
+	LPSPI1->SR = LPSPI_SR_REF_MASK | LPSPI_SR_TEF_MASK;
+	LPSPI1->IER = LPSPI_IER_RDIE_MASK;
+}
+
+/** This function queues a transfer*/
+lpspi_async_status_t LPSPI_async_submit(lpspi_transfer_t* transfer)
+{
+	/** Result of the submission*/
+	lpspi_async_status_t status = lpspi_async_success;
+
+	if((INIT_VAL == transfer->count) ||
+		(lpspi_transfer_queued == transfer->state) || (lpspi_transfer_active == transfer->state))
+	{
+		return lpspi_async_invalid_transfer;
+	}
+
+	transfer->tx_index = INIT_VAL;
+	transfer->rx_index = INIT_VAL;
+
+	/** The interruption takes the transfers from the queue*/
+	taskENTER_CRITICAL();
+	if(LPSPI_ASYNC_QUEUE_SIZE == queue_count)
+	{
+		lpspi_stats.rejected ++;
+		status = lpspi_async_queue_full;
+	}
+	else
+	{
+		transfer->state = lpspi_transfer_queued;
+		transfer_queue[(queue_head + queue_count) % LPSPI_ASYNC_QUEUE_SIZE] = transfer;
+		queue_count ++;
+		lpspi_stats.submitted ++;
+
+		/** Starts it if the LPSPI1 is idle, the next transfers are started by the interruption*/
+		if(NULL == active_transfer)
+		{
+			LPSPI_async_start_next();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return status;
+}
+
+/** This function moves the words of the active transfer through the FIFOs*/
+void LPSPI_async_isr(BaseType_t* higher_priority_task_woken)
+{
+	/** Transfer in the LPSPI1*/
+	lpspi_transfer_t* transfer = active_transfer;
+	/** Words in the Rx FIFO*/
+	uint8_t rx_count = (uint8_t)((LPSPI1->FSR & LPSPI_FSR_RXCOUNT_MASK) >> LPSPI_FSR_RXCOUNT_SHIFT);
+	/** Received word*/
+	uint16_t word;
+	/** Start of the interruption, to measure it*/
+	uint32_t start = timebase_cycles_now();
+
+	lpspi_stats.interrupts ++;
+
+	/** Reads every received word (Reading the last one clears the Rx flag)*/
+	while(INIT_VAL != rx_count)
+	{
+		word = (uint16_t)LPSPI1->RDR;
+		rx_count --;
+
+		if((NULL != transfer) && (transfer->count > transfer->rx_index))
+		{
+			if(NULL != transfer->rx)
+			{
+				transfer->rx[transfer->rx_index] = word;
+			}
+			transfer->rx_index ++;
+		}
+	}
+
+	/** Sends the next words, or completes the transfer*/
+	if((NULL != transfer) && (transfer->count > transfer->rx_index))
+	{
+		LPSPI_async_fill(transfer);
+	}
+	else if(NULL != transfer)
+	{
+		transfer->state = lpspi_transfer_done;
+		lpspi_stats.completed ++;
+
+		/** Starts the next transfer before the completion function, so the SPI clock does not wait for it*/
+		LPSPI_async_start_next();
+
+		if(NULL != transfer->callback)
+		{
+			transfer->callback(transfer, higher_priority_task_woken);
+		}
+	}
+
+	lpspi_stats.isr_cycles += timebase_cycles_since(start);
+}
+
+/** This function gets the statistics of the engine*/
+void LPSPI_async_get_stats(lpspi_async_stats_t* stats)
+{
+	/** The statistics are updated from the interruption*/
+	taskENTER_CRITICAL();
+	*stats = lpspi_stats;
+	taskEXIT_CRITICAL();
+}
@@ -0,0 +1,127 @@
+/*!
+ 	 \file lpspi_async.h
+
+ 	 \brief This is the header file of the asynchronous LPSPI1 transaction
+ 	 	 	 engine. The transfers wait in a queue and are moved through the
+ 	 	 	 LPSPI FIFOs from the receive interruption, so the CPU is free
+ 	 	 	 while the SPI clock runs. Each transfer can call a function when
+ 	 	 	 it completes.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef LPSPI_ASYNC_H_
+#define LPSPI_ASYNC_H_
+
+#include "S32K144.h"
+#include "FreeRTOS.h"
+
+/** Defines the number of transfers that can wait for the LPSPI1*/
+#define LPSPI_ASYNC_QUEUE_SIZE			(8)
+
+/*!
+ 	 \brief Enumerator to define the state of a transfer.
+ */
+typedef enum
+{
+	lpspi_transfer_idle,		/*!< Not submitted, or already completed*/
+	lpspi_transfer_queued,		/*!< Waiting for the LPSPI1*/
+	lpspi_transfer_active,		/*!< Moving through the LPSPI1 FIFOs*/
+	lpspi_transfer_done		/*!< Completed, every word was received*/
+}lpspi_transfer_state_t;
+
+/*!
+ 	 \brief Enumerator to define the result of submitting a transfer.
+ */
+typedef enum
+{
+	lpspi_async_success,		/*!< Transfer queued*/
+	lpspi_async_queue_full,		/*!< Queue is full, the transfer was not queued*/
+	lpspi_async_invalid_transfer	/*!< Transfer without words, or already submitted*/
+}lpspi_async_status_t;
+
+/** Forward declaration for the completion function*/
+struct lpspi_transfer_s;
+
+/*!
+ 	 \brief Function called from the interruption when a transfer completes.
+ 	 	 	 higher_priority_task_woken is set by the FreeRTOS FromISR functions.
+ */
+typedef void (*lpspi_callback_t)(struct lpspi_transfer_s* transfer, BaseType_t* higher_priority_task_woken);
+
+/*!
+ 	 \brief Transfer of 16-bit words (One frame per word, with its own chip select).
+
+ 	 \note The transfer and its buffers must stay valid until it completes.
+ */
+typedef struct lpspi_transfer_s
+{
+	const uint16_t* tx;						/*!< Words to be sent*/
+	uint16_t* rx;							/*!< Words received (NULL to discard them)*/
+	uint8_t count;							/*!< Number of words*/
+	lpspi_callback_t callback;				/*!< Function called when it completes (NULL for none)*/
+	void* context;							/*!< Data for the completion function*/
+	volatile lpspi_transfer_state_t state;	/*!< State of the transfer*/
+	uint8_t tx_index;						/*!< Words written to the Tx FIFO*/
+	uint8_t rx_index;						/*!< Words read from the Rx FIFO*/
+}lpspi_transfer_t;
+
+/*!
+ 	 \brief Statistics of the engine.
+ */
+typedef struct
+{
+	uint32_t submitted;		/*!< Transfers accepted*/
+	uint32_t completed;		/*!< Transfers completed*/
+	uint32_t rejected;		/*!< Transfers rejected because the queue was full*/
+	uint32_t interrupts;		/*!< Receive interruptions (Each one reads up to a FIFO of words)*/
+	uint32_t isr_cycles;		/*!< Core cycles spent in the interruption*/
+}lpspi_async_stats_t;
+
+/*!
+ 	 \brief This function prepares the engine and enables the receive
+ 	 	 	 interruption of the LPSPI1.
+
+ 	 \note The LPSPI1 must be configured as master (LPSPI1_init_master) first.
+ 	 	 	 The interruption handler must call LPSPI_async_isr.
+
+ 	 \return void.
+ */
+void LPSPI_async_init(void);
+
+/*!
+ 	 \brief This function queues a transfer. If the LPSPI1 is idle it starts
+ 	 	 	 right away. It can not be called from an interruption.
+
+ 	 \param[in] transfer Transfer with its words, count and completion function.
+
+ 	 \return Whether the transfer was queued or not.
+ */
+lpspi_async_status_t LPSPI_async_submit(lpspi_transfer_t* transfer);
+
+/*!
+ 	 \brief This function moves the words of the active transfer through the
+ 	 	 	 FIFOs, completes it and starts the next one. It must be called from
+ 	 	 	 the LPSPI1 interruption.
+
+ 	 \param[out] higher_priority_task_woken Set if a completion function woke a task.
+
+ 	 \return void.
+ */
+void LPSPI_async_isr(BaseType_t* higher_priority_task_woken);
+
+/*!
+ 	 \brief This function gets the statistics of the engine.
+
+ 	 \param[out] stats Copy of the statistics.
+
+ 	 \return void.
+ */
+void LPSPI_async_get_stats(lpspi_async_stats_t* stats);
+
+#endif /* LPSPI_ASYNC_H_ */
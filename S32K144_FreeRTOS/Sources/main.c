@@ -72,6 +72,10 @@ volatile int exit_code = 0;
 #define PERIODIC_MSG_ID			(0x40)
 /** ID for the RX callback*/
 #define TEST_CALLBACK_ID		(0x123)
+/** ID for the SBC fault message*/
+#define SBC_FAULT_MSG_ID		(0x50)
+/** ID that requests a dump of the kernel trace*/
+#define TRACE_DUMP_REQUEST_ID	(0x7F)
 
 /** RX thread priority*/
 #define RX_THREAD_PRIO			(3)
@@ -79,6 +83,22 @@ volatile int exit_code = 0;
 #define ADC_THREAD_PRIO			(4)
 /** TX thread priority*/
 #define TX_THREAD_PRIO			(5)
+/** Run-time report thread priority (The lowest one above the idle task)*/
+#define RUNTIME_THREAD_PRIO		(1)
+
+/** Stacks of the threads, in words. Run the application under a representative load, log the run-time
+ 	 report frames and set the sizes given by Tools/stack_sizer.py (The overflow hook resets the core and
+ 	 reports the task if a stack is too small)*/
+/** TX thread stack*/
+#define TX_THREAD_STACK			(configMINIMAL_STACK_SIZE)
+/** TX periodic thread stack*/
+#define TX_PERIODIC_THREAD_STACK	(configMINIMAL_STACK_SIZE)
+/** RX thread stack*/
+#define RX_THREAD_STACK			(configMINIMAL_STACK_SIZE)
+/** ADC thread stack*/
+#define ADC_THREAD_STACK		(configMINIMAL_STACK_SIZE)
+/** Run-time report thread stack (Its buffers are static)*/
+#define RUNTIME_THREAD_STACK	(128)
 
 /** Period for the TX thread*/
 #define TX_THREAD_PERIOD		(1000)
@@ -93,8 +113,8 @@ void test_function(can_message_rx_config_t can_message_rx)
 	/** Message to be sent*/
 	uint8_t msg[4] = {0x01, 0x23, 0x45, 0x67};
 
-	/** Sets the values for the tx message*/
-	msg_test_function.base = CAN0;
+	/** Sets the values for the tx message (The answer is sent on the CAN of the request)*/
+	msg_test_function.base = can_message_rx.base;
 	msg_test_function.ID = 0x25;
 	msg_test_function.msg = msg;
 	msg_test_function.DLC = sizeof(msg);
@@ -103,6 +123,47 @@ void test_function(can_message_rx_config_t can_message_rx)
 	rtos_can_transmit(msg_test_function);
 }
 
+/** SBC fault callback function, it sends the flags of the status registers*/
+void sbc_fault_function(const sbc_status_t* status, const sbc_status_t* previous)
+{
+	/** Variable to send a message*/
+	can_message_tx_config_t msg_sbc_fault;
+	/** Flags of the regulator, CAN and I/O registers*/
+	uint8_t msg[sbc_status_count];
+	/** Variable to go through the registers*/
+	uint8_t index;
+
+	for(index = 0; sbc_status_count > index; index ++)
+	{
+		msg[index] = (uint8_t)status->flags[index];
+	}
+
+	/** Sets the values for the tx message*/
+	msg_sbc_fault.base = CAN0;
+	msg_sbc_fault.ID = SBC_FAULT_MSG_ID;
+	msg_sbc_fault.msg = msg;
+	msg_sbc_fault.DLC = sizeof(msg);
+
+	/** Queues the message (The data is copied)*/
+	rtos_can_transmit(msg_sbc_fault);
+}
+
+/** Trace dump callback function, the frames are sent by the run-time report thread*/
+void trace_dump_function(can_message_rx_config_t can_message_rx)
+{
+	rtos_trace_request_dump();
+}
+
+/** Creates a thread, the application stops if it can't be created (The heap pools are too small)*/
+void create_thread(const char* name, void (*thread)(void* args), void* args, int stack, int priority)
+{
+	/** Handle of the new thread (NULL if its TCB or stack could not be allocated)*/
+	sys_thread_t handle = sys_thread_new(name, thread, args, stack, priority);
+
+	configASSERT(NULL != handle);
+	(void)handle;
+}
+
 int main(void)
 {
 	/** SW3 message*/
@@ -111,6 +172,8 @@ int main(void)
 	static uint8_t per_msg[3] = {0x01, 0x23, 0x45};
 	/** Test ID to be set to the ID function vector*/
 	ID_function_t test_ID_func;
+	/** Trace dump ID to be set to the ID function vector*/
+	ID_function_t trace_ID_func;
 
 	/** Variable to initialize the CAN*/
 	can_init_config_t can_init;
@@ -118,9 +181,14 @@ int main(void)
 	can_message_tx_config_t tx_msg_init;
 	/** Periodic message structure*/
 	static can_message_tx_config_t periodic_msg;
+	/** CANs of the application, the first RTOS_CAN_INSTANCES are used*/
+	CAN_Type* const app_cans[CAN_INSTANCE_COUNT] = CAN_BASE_PTRS;
+	/** Names of the RX threads of each CAN*/
+	const char* const rx_names[CAN_INSTANCE_COUNT] = {"RX", "RX_CAN1", "RX_CAN2"};
+	/** Counter for the CANs*/
+	uint8_t instance;
 
-	/** Sets the base and the speed for CAN*/
-	can_init.base = CAN0;
+	/** Sets the speed for the CANs*/
 	can_init.speed = CAN_CTRL1_SPEED_500KBPS;
 
 	/** Sets the SW3 message*/
@@ -139,39 +207,81 @@ int main(void)
 	test_ID_func.ID = TEST_CALLBACK_ID;
 	test_ID_func.ID_func = test_function;
 
+	/** Sets the ID and the callback function of the trace dump*/
+	trace_ID_func.ID = TRACE_DUMP_REQUEST_ID;
+	trace_ID_func.ID_func = trace_dump_function;
+
 	/** Defines the tx messages (Periodic and SW3*/
 	rtos_define_tx_periodic_msg(periodic_msg);
 	rtos_can_set_sw_msg(tx_msg_init);
 
-	/** Adds the RX ID and function*/
-	rtos_add_ID_function(test_ID_func);
+	/** Adds the RX ID and function, the test request is answered on every CAN*/
+	for(instance = 0 ; RTOS_CAN_INSTANCES > instance ; instance ++)
+	{
+		rtos_add_ID_function(app_cans[instance], test_ID_func);
+	}
+	rtos_add_ID_function(CAN0, trace_ID_func);
+
+	/** Sends the SBC flags when they change*/
+	rtos_sbc_set_fault_callback(sbc_fault_function);
 
 	/** Sets the periods for tx and ADC*/
 	set_tx_thread_period(TX_THREAD_PERIOD);
 	set_adc_tx_thread_period(ADC_THREAD_PERIOD);
 
-	/** Initializes the rtos can*/
-	rtos_can_init(can_init);
+	/** Initializes the rtos can of each CAN (RTOS_CAN_INSTANCES, in rtos_driver.h, sets how many are used)*/
+	for(instance = 0 ; RTOS_CAN_INSTANCES > instance ; instance ++)
+	{
+		can_init.base = app_cans[instance];
+		rtos_can_init(can_init);
+	}
 
 	/** Creates the TX thread by interrupt*/
-	sys_thread_new("TX_interrupt_thread", rtos_can_tx_thread_EG, NULL, configMINIMAL_STACK_SIZE, TX_THREAD_PRIO);
+	create_thread("TX_interrupt_thread", rtos_can_tx_thread_EG, CAN0, TX_THREAD_STACK, TX_THREAD_PRIO);
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
 	/** Creates the TX periodic thread*/
-	sys_thread_new("TX_periodic_thread", rtos_can_tx_thread_periodic, NULL, configMINIMAL_STACK_SIZE, TX_THREAD_PRIO);
+	create_thread("TX_periodic_thread", rtos_can_tx_thread_periodic, NULL, TX_PERIODIC_THREAD_STACK, TX_THREAD_PRIO);
+#endif
 
 	/*******************************************************************************************************************/
-	/** NOTE: To test both the periodic RX and the RX by interrupt, please the value of RX_MODE, found in rtos_driver.h*/
+	/** NOTE: To test the periodic RX, the RX by interrupt and the RX FIFO, please the value of RX_MODE, found in rtos_driver.h*/
 	/*******************************************************************************************************************/
-#if(!RX_MODE)
-	/** Creates the RX thread by interrupt*/
-	sys_thread_new("RX", rtos_can_rx_thread_interruption, NULL, configMINIMAL_STACK_SIZE, RX_THREAD_PRIO);
+	/** Each CAN has its own RX thread or timer*/
+	for(instance = 0 ; RTOS_CAN_INSTANCES > instance ; instance ++)
+	{
+#if(RX_INTERRUPT == RX_MODE)
+		/** Creates the RX thread by interrupt*/
+		create_thread(rx_names[instance], rtos_can_rx_thread_interruption, app_cans[instance], RX_THREAD_STACK, RX_THREAD_PRIO);
 #endif
-#if(RX_MODE)
-	/** Creates the RX periodic thread*/
-	sys_thread_new("RX", rtos_can_rx_thread_periodic, NULL, configMINIMAL_STACK_SIZE, RX_THREAD_PRIO);
+#if(RX_FIFO == RX_MODE)
+		/** Creates the RX thread for the Rx FIFO*/
+		create_thread(rx_names[instance], rtos_can_rx_thread_fifo, app_cans[instance], RX_THREAD_STACK, RX_THREAD_PRIO);
 #endif
+#if(RX_PERIODIC == RX_MODE)
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
+		/** Creates the RX periodic thread*/
+		create_thread(rx_names[instance], rtos_can_rx_thread_periodic, app_cans[instance], RX_THREAD_STACK, RX_THREAD_PRIO);
+#else
+		/** Starts the RX periodic timer*/
+		rtos_can_rx_timer_start(app_cans[instance]);
+#endif
+#endif
+	}
 
+	/*******************************************************************************************************************/
+	/** NOTE: To run the ADC, the periodic TX and the periodic RX as software timers, please change the value of
+	 	 PERIODIC_JOB_MODE, found in rtos_driver.h*/
+	/*******************************************************************************************************************/
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
 	/** Creates the ADC thread*/
-	sys_thread_new("ADC", rtos_adc_read_thread, NULL, configMINIMAL_STACK_SIZE, ADC_THREAD_PRIO);
+	create_thread("ADC", rtos_adc_read_thread, NULL, ADC_THREAD_STACK, ADC_THREAD_PRIO);
+#else
+	/** Starts the ADC and the TX periodic timers*/
+	rtos_periodic_timers_start();
+#endif
+
+	/** Creates the thread that reports the CPU load and the stack of each task*/
+	create_thread("Runtime", rtos_runtime_report_thread, CAN0, RUNTIME_THREAD_STACK, RUNTIME_THREAD_PRIO);
 
 	/* Start the tasks and timer running. */
 	vTaskStartScheduler();
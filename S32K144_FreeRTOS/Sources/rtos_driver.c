@@ -16,15 +16,26 @@
 
 #include "rtos_driver.h"
 #include "ADC.h"
+#include "can_tx_queue.h"
 
 /** Defines the CAN hanlder as initialized*/
 #define IS_INIT								(1)
 /** Defines the CAN handler as not initialzied*/
 #define NOT_INIT							(0)
-/** Defines the bits for the ADC event group*/
-#define EVENT_GROUP_ADC						(0x01)
-/** Defines the bits for the SW3 event group*/
-#define EVENT_GROUP_SW						(0x02)
+/** Defines the notification bit of the ADC event for the Tx task*/
+#define TX_EVENT_ADC						(0x01)
+/** Defines the notification bit of the SW3 event for the Tx task*/
+#define TX_EVENT_SW							(0x02)
+/** Defines all the notification bits of the Tx task (The others are left for rtos_spi_transfer)*/
+#define TX_EVENT_ALL						(TX_EVENT_ADC | TX_EVENT_SW)
+/** Defines the notification bit of a completed SPI transfer (Above any Rx or ADC notification count)*/
+#define SPI_TRANSFER_NOTIFY_BIT				(0x80000000)
+/** Defines the number of ADC samples that can wait for the Tx task (1 ms samples for 16 ms)*/
+#define TX_EVENT_ADC_QUEUE_LENGTH			(16)
+/** Defines the number of SW3 presses that can wait for the Tx task (Must be 1 for latest-wins)*/
+#define TX_EVENT_SW_QUEUE_LENGTH			(1)
+/** Defines the value queued for a SW3 press (The message is set with rtos_can_set_sw_msg)*/
+#define TX_EVENT_SW_DATA					(0)
 
 /** Defines the pin for the red LED*/
 #define RED_LED_PIN            				(15U)
@@ -54,16 +65,31 @@
 /** Defines the initial value for the variables*/
 #define INIT_VAL							(0)
 
-/** Defines the priority for the rx MB interruption*/
-#define CAN_RX_INTERRUPT_PRIO				(0x03)
+/** Defines the position of the CAN0 handler*/
+#define CAN0_INDEX							(0)
+/** Defines the position of the CAN1 handler*/
+#define CAN1_INDEX							(1)
+/** Defines the position of the CAN2 handler*/
+#define CAN2_INDEX							(2)
+
+/** Defines the pins of CAN0 (PTE4 Rx and PTE5 Tx, ALT5)*/
+#define CAN0_RX_PIN							(4)
+#define CAN0_TX_PIN							(5)
+#define CAN0_PIN_MUX						(5)
+/** Defines the pins of CAN1 (PTA12 Rx and PTA13 Tx, ALT3)*/
+#define CAN1_RX_PIN							(12)
+#define CAN1_TX_PIN							(13)
+#define CAN1_PIN_MUX						(3)
+/** Defines the pins of CAN2 (PTC16 Rx and PTC17 Tx, ALT3)*/
+#define CAN2_RX_PIN							(16)
+#define CAN2_TX_PIN							(17)
+#define CAN2_PIN_MUX						(3)
+
+/** Defines the priority for the MB interruption*/
+#define CAN_MB_INTERRUPT_PRIO				(0x03)
 /** Defines a bit to be shifted in masks*/
 #define BIT_TO_SHIFT						(1)
 
-/** Defines the interrupt bits of MB4 in IFLAG1*/
-#define MB_4_INTERRUPT						(0x10)
-/** Defines the bits to clear all IFLAG1 bits*/
-#define CLEAR_ALL_FLAGS						(0xFFFFFFFE)
-
 /** Defines the ID of the ADC message*/
 #define ADC_TX_ID							(0x10)
 
@@ -84,18 +110,76 @@
 /** Defines the position of the ADC high byte in the ADC vector*/
 #define ADC_HIGH_BYTE_POS					(1)
 
-/** Defines the ID as not repeated in the ID function vector*/
-#define ID_NOT_REPEATED						(0)
-/** Defines the ID as repeated in the ID function vector*/
-#define ID_REPEATED							(1)
-
-/** Defines the ID as found in the ID function vector*/
-#define ID_FOUND							(0)
-/** Defines the ID as not found in the ID function vector*/
-#define ID_NOT_FOUND						(1)
-
-/** Defines the relation to get the ticks for 1 ms*/
-#define FIX_PERIOD							((10.0025F) / (6.0F))
+/** Defines the priority of the ADC interruption*/
+#define ADC_INTERRUPT_PRIO					(0x03)
+/** Defines the number of samples of the ADC buffer (Must be a power of 2)*/
+#define ADC_BUFFER_SIZE						(8)
+/** Defines the mask to wrap the positions of the ADC buffer*/
+#define ADC_BUFFER_MASK						(ADC_BUFFER_SIZE - 1)
+/** Defines the ticks to wait for a conversion (It takes microseconds, this only avoids a lock)*/
+#define ADC_CONVERSION_TIMEOUT				(2)
+
+/** Defines the priority of the LPSPI1 interruption*/
+#define LPSPI_INTERRUPT_PRIO				(0x03)
+/** Defines the period of the SBC watchdog refresh and status reads, in milliseconds (It must fall
+ 	 in the open window of the watchdog period programmed in the SBC)*/
+#define SBC_REFRESH_PERIOD					(100U)
+
+/** Defines the ID of the run-time report frames*/
+#define RUNTIME_REPORT_ID					(0x70)
+/** Defines the period of the run-time report, in milliseconds*/
+#define RUNTIME_REPORT_PERIOD				(1000U)
+/** Defines the position of the task number in the report frame*/
+#define RUNTIME_REPORT_NUMBER_POS			(0)
+/** Defines the position of the CPU load in the report frame*/
+#define RUNTIME_REPORT_LOAD_POS				(1)
+/** Defines the position of the low byte of the free stack in the report frame*/
+#define RUNTIME_REPORT_STACK_LOW_POS		(2)
+/** Defines the position of the high byte of the free stack in the report frame*/
+#define RUNTIME_REPORT_STACK_HIGH_POS		(3)
+/** Defines the position of the priority in the report frame*/
+#define RUNTIME_REPORT_PRIO_POS				(4)
+/** Defines the position of the name in the report frame*/
+#define RUNTIME_REPORT_NAME_POS				(5)
+/** Defines the characters of the name in the report frame*/
+#define RUNTIME_REPORT_NAME_SIZE			(3)
+/** Defines the ID of the frame with the name of the task whose stack overflowed before the reset*/
+#define STACK_OVERFLOW_REPORT_ID			(0x73)
+
+/** Defines the ID of the first frame of a trace dump (Number of records, core clock and tick rate)*/
+#define TRACE_DUMP_HEADER_ID				(0x71)
+/** Defines the ID of the trace records of a dump (One record per frame)*/
+#define TRACE_DUMP_RECORD_ID				(0x72)
+/** Defines the ticks to wait when the Tx queue is full during a dump*/
+#define TRACE_DUMP_RETRY_TICKS				(1)
+/** Defines a trace dump as requested*/
+#define TRACE_DUMP_REQUESTED				(1)
+/** Defines that no trace dump is requested*/
+#define TRACE_DUMP_IDLE						(0)
+/** Defines the position of the number of records in the dump header*/
+#define TRACE_DUMP_COUNT_POS				(0)
+/** Defines the position of the core clock in the dump header*/
+#define TRACE_DUMP_CLOCK_POS				(2)
+/** Defines the position of the tick rate in the dump header*/
+#define TRACE_DUMP_TICK_RATE_POS			(6)
+/** Defines the position of the timestamp in a record frame*/
+#define TRACE_DUMP_TIMESTAMP_POS			(0)
+/** Defines the position of the event in a record frame*/
+#define TRACE_DUMP_EVENT_POS				(4)
+/** Defines the position of the task in a record frame*/
+#define TRACE_DUMP_TASK_POS					(5)
+/** Defines the position of the object in a record frame*/
+#define TRACE_DUMP_OBJECT_POS				(6)
+/** Defines the bytes of a 32 bits value*/
+#define WORD_SIZE							(4)
+/** Defines the bytes of a 16 bits value*/
+#define HALF_WORD_SIZE						(2)
+
+/** Defines the priority of the ADC scan interruption*/
+#define ADC_SCAN_INTERRUPT_PRIO				(0x03)
+
+/** Defines the minimum period of a timer*/
+#define PERIODIC_JOB_MIN_TICKS				(1)
 
 /** Defines the initial period of the Rx task*/
 #define RX_TASK_INIT_PERIOD					(100U)
@@ -106,8 +190,6 @@
 
 /** Defines the maximum DLC message size*/
 #define CAN_MESSAGE_MAX_SIZE				(8)
-/** Defines the maximum size of the ID function vector*/
-#define ID_VECTOR_MAX_SIZE					(15)
 
 /** Defines the initial threshold of the red LED*/
 #define RED_LED_INIT_THRESHOLD				(3750)
@@ -118,36 +200,149 @@
 
 /** Defines the ADC channel to read the potentiometer*/
 #define ADC_POT_CHANNEL						(12)
+/** Defines the initial hardware averaging of the potentiometer*/
+#define ADC_POT_HW_AVERAGE					(adc_hw_average_4)
+/** Defines the initial IIR filter of the potentiometer (y += (x - y) / 4)*/
+#define ADC_POT_IIR_SHIFT					(2)
+/** Defines the initial decimation of the potentiometer (Every sample is sent)*/
+#define ADC_POT_DECIMATION					(1)
+/** Defines the initial hysteresis of the potentiometer, in mV*/
+#define ADC_POT_HYSTERESIS					(10)
+/** Defines the initial Tx policy of the potentiometer*/
+#define ADC_TX_POLICY_MODE					(tx_policy_mixed)
+/** Defines the initial deadband of the potentiometer messages, in mV*/
+#define ADC_TX_POLICY_DEADBAND				(20)
+/** Defines the initial minimum gap between potentiometer messages, in milliseconds*/
+#define ADC_TX_POLICY_MIN_GAP				(50U)
+/** Defines the initial maximum age of the potentiometer messages, in milliseconds*/
+#define ADC_TX_POLICY_MAX_AGE				(1000U)
+
+/** Defines the size of the Rx filter table (ADC ID and the ID function vector)*/
+#define RX_FILTER_TABLE_SIZE				(ID_VECTOR_MAX_SIZE + 1)
 
-/** Defines an oversize of the ID function vector*/
-#define ID_VECTOR_OVER_SIZE					(200)
 /** Defines a position offset of 1 in an array*/
 #define ARRAY_POS_OFFSET_1					(1)
 
 /*********************************************************************************************/
 
 /*!
- 	 \brief Structure for the RTOS handler.
+ 	 \brief Structure for the RTOS handler of one CAN.
  */
 typedef struct {
-	uint8_t init_val;					/*!< Defines whether the handler has been initialized or not*/
-	SemaphoreHandle_t sem_rx_binary;	/*!< Binary semaphore for the Rx task*/
-	SemaphoreHandle_t mutex;			/*!< Mutex to protect the CAN when sending and receiving*/
-	EventGroupHandle_t event_group;		/*!< Event group for the Tx task*/
+	CAN_Type* base;											/*!< CAN of the handler*/
+	uint8_t init_val;										/*!< Defines whether the handler has been initialized or not*/
+	TaskHandle_t rx_task;									/*!< Rx task, notified with the number of pending messages*/
+	SemaphoreHandle_t mutex;								/*!< Mutex to protect the CAN when sending and receiving*/
+	can_message_rx_config_t rx_message;						/*!< Message received by the Rx task*/
+	can_tx_queue_t tx_queue;								/*!< Tx queue of the CAN*/
+#if(RX_FIFO == RX_MODE)
+	can_rx_ring_t rx_ring;									/*!< Rx ring filled from the Rx FIFO interruption*/
+#endif
+#if(RX_INTERRUPT == RX_MODE)
+	can_rx_mb_stats_t rx_stats;								/*!< Statistics of the Rx MBs*/
+#endif
+	can_id_table_t ID_table;								/*!< IDs with callback (The zeroed table is empty, so IDs can be added before rtos_can_init)*/
+#if((RX_PERIODIC == RX_MODE) && (PERIODIC_JOB_TIMER == PERIODIC_JOB_MODE))
+	TimerHandle_t rx_timer;									/*!< Timer that receives the messages periodically*/
+#endif
 }RTOS_CAN_Handler_t;
 
+/*!
+ 	 \brief Structure for a source of the Tx task.
+ */
+typedef struct {
+	QueueHandle_t queue;									/*!< Requests waiting for the Tx task*/
+	uint8_t length;											/*!< Number of requests of the queue*/
+	tx_event_policy_t policy;								/*!< Coalescing policy of the source*/
+	uint32_t notify_bit;									/*!< Notification bit of the source in the Tx task*/
+	tx_event_stats_t stats;									/*!< Statistics of the source*/
+}RTOS_tx_event_source_t;
+
 /*********************************************************************************************/
 
 /*********************************************************************************************/
 
-/** RTOS handler for the CAN*/
-static RTOS_CAN_Handler_t can_handler = { INIT_VAL };
-/** Variable for the rx thread period*/
-static uint32_t rx_task_period = RX_TASK_INIT_PERIOD;
-/** Variable for the tx thread period*/
+#if((RTOS_CAN_INSTANCES < 1) || (RTOS_CAN_INSTANCES > CAN_INSTANCE_COUNT))
+#error "RTOS_CAN_INSTANCES must be between 1 and the number of CANs"
+#endif
+
+/** RTOS handlers, one for each CAN used (CAN0 first)*/
+static RTOS_CAN_Handler_t can_handler[RTOS_CAN_INSTANCES];
+/** Defines whether the board (Clocks, ADC, SBC, LEDs and SW3) has been initialized or not*/
+static uint8_t board_init_val = NOT_INIT;
+/** Tx task notified by the SW3 interruption and the ADC thread (NULL until the task starts)*/
+static TaskHandle_t tx_event_task = NULL;
+/** Sources of the Tx task*/
+static RTOS_tx_event_source_t tx_event_source[tx_event_source_count] =
+{
+	{NULL, TX_EVENT_ADC_QUEUE_LENGTH, tx_event_fifo, TX_EVENT_ADC, {INIT_VAL}},
+	{NULL, TX_EVENT_SW_QUEUE_LENGTH, tx_event_latest, TX_EVENT_SW, {INIT_VAL}}
+};
+/** Variable for the rx thread period, in ticks*/
+static TickType_t rx_task_period = TIMEBASE_MS_TO_TICKS(RX_TASK_INIT_PERIOD);
+/** Variable for the tx thread period, in milliseconds (Converted by the periodic Tx schedule)*/
 static uint32_t tx_task_period = TX_TASK_INIT_PERIOD;
-/** Variable for the ADC thread period*/
-static uint32_t adc_tx_task_period = ADC_TX_TASK_INIT_PERIOD;
+/** Variable for the ADC thread period, in ticks*/
+static TickType_t adc_tx_task_period = TIMEBASE_MS_TO_TICKS(ADC_TX_TASK_INIT_PERIOD);
+
+#if(ADC_INTERRUPT == ADC_MODE)
+/** Samples stored by the ADC interruption*/
+static uint16_t adc_buffer[ADC_BUFFER_SIZE];
+/** Next position to write in the ADC buffer (Only written by the interruption)*/
+static volatile uint8_t adc_buffer_head = INIT_VAL;
+/** Next position to read in the ADC buffer (Only written by the ADC job)*/
+static volatile uint8_t adc_buffer_tail = INIT_VAL;
+/** ADC task, notified when a conversion completes (NULL for the ADC timer)*/
+static TaskHandle_t adc_task = NULL;
+#endif
+
+/** Pipeline of the potentiometer samples (Filter, mV scaling and hysteresis)*/
+static adc_pipeline_t adc_pot_pipeline;
+/** Initial configuration of the potentiometer pipeline*/
+static const adc_pipeline_config_t adc_pot_pipeline_init =
+{
+	ADC_POT_IIR_SHIFT, ADC_POT_DECIMATION, ADC_MV_MUL, ADC_MV_ROUND, ADC_MV_SHIFT, ADC_POT_HYSTERESIS
+};
+
+/** Tx policy of the potentiometer samples (Sent on change, with a guaranteed refresh)*/
+static can_tx_policy_t adc_tx_policy;
+/** Initial configuration of the potentiometer Tx policy*/
+static const can_tx_policy_config_t adc_tx_policy_init =
+{
+	ADC_TX_POLICY_MODE, ADC_TX_POLICY_DEADBAND,
+	TIMEBASE_MS_TO_TICKS(ADC_TX_POLICY_MIN_GAP), TIMEBASE_MS_TO_TICKS(ADC_TX_POLICY_MAX_AGE)
+};
+
+/** SPI commands to initialize the MC33903 (The same sequence of LPSPI1_init_MC33903)*/
+static const uint16_t sbc_init_commands[] =
+{
+	0x2580,		/* Read SAFE register flags: bits 4:0 contain nonzero ID */
+	0xDF80,		/* Read Vreg High flags */
+	0x5A00,		/* Write Watchdog reg.: Enter NORMAL mode */
+	0x5E10,		/* Write Regulator reg.: Enable 5V CAN regulator */
+	0x60C0,		/* Write CAN reg.: CAN in Tx & Rx modes, fast slew */
+	0x66C4		/* Write LIN/1 reg.: Tx/Rx mode, 20 Kbps slew, term. on */
+};
+/** Answers of the MC33903 to the initialization*/
+static uint16_t sbc_init_answers[sizeof(sbc_init_commands) / sizeof(uint16_t)];
+/** SPI transfer of the MC33903 initialization*/
+static lpspi_transfer_t sbc_init_transfer =
+{
+	sbc_init_commands, sbc_init_answers, sizeof(sbc_init_commands) / sizeof(uint16_t), NULL, NULL, lpspi_transfer_idle
+};
+
+/** Timer of the SBC watchdog refresh and status reads*/
+static TimerHandle_t sbc_timer = NULL;
+
+/** Indicates if a dump of the kernel trace was requested (Served by the run-time report thread)*/
+static volatile uint8_t trace_dump_request = TRACE_DUMP_IDLE;
+
+/** Complete scans waiting for the consumer (NULL until the scan starts)*/
+static QueueHandle_t adc_scan_queue = NULL;
+/** Number of the next scan*/
+static uint32_t adc_scan_sequence = INIT_VAL;
+/** Statistics of the ADC scan*/
+static adc_scan_stats_t adc_scan_stats = {INIT_VAL};
 
 /** ID for the SW3 message*/
 static uint8_t ID_SW = INIT_VAL;
@@ -155,18 +350,8 @@ static uint8_t ID_SW = INIT_VAL;
 static uint8_t msg_SW[CAN_MESSAGE_MAX_SIZE] = {INIT_VAL};
 /** DLC of the SW3 message*/
 static uint8_t DLC_SW = INIT_VAL;
-/** Variable for the value read from the ADC*/
-static uint16_t adc_read = INIT_VAL;
-
-/** ID function vector*/
-static ID_function_t ID_function[ID_VECTOR_MAX_SIZE] = {{INIT_VAL, NULL}};
-/** ID function vector counter*/
-static uint8_t ID_func_counter = INIT_VAL;
-
-/** Variable for the received messages*/
-static can_message_rx_config_t rx_message;
-/** Variable to transmit messages*/
-static can_message_tx_config_t tx_message;
+/** CAN of the SW3 message*/
+static CAN_Type* base_SW = CAN0;
 
 /** Variable for the threshold of the red LED*/
 static uint16_t red_treshold = RED_LED_INIT_THRESHOLD;
@@ -174,47 +359,410 @@ static uint16_t red_treshold = RED_LED_INIT_THRESHOLD;
 static uint16_t yellow_treshold = YELLOW_LED_INIT_THRESHOLD;
 /** Variable for the threshold of the green LED*/
 static uint16_t green_treshold = GREEN_LED_INIT_THRESHOLD;
-/** Variable for the SW3 message*/
+/** Variable for the message set with rtos_define_tx_periodic_msg*/
 static can_message_tx_config_t message_to_send;
-
-/** Variable for the configured CAN base*/
-static CAN_Type* can_base;
+/** Slot of message_to_send in the periodic Tx schedule*/
+static uint8_t message_to_send_slot = CAN_TX_SCHEDULE_NO_SLOT;
+/** Periodic Tx schedule (Static storage starts with every slot free)*/
+static can_tx_schedule_t tx_schedule;
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
+/** Periodic Tx task, notified when the schedule changes (NULL until the task starts)*/
+static TaskHandle_t tx_schedule_task = NULL;
+#else
+/** Periodic Tx timer, restarted when the schedule changes (NULL until the timers start)*/
+static TimerHandle_t tx_schedule_timer = NULL;
+/** ADC reading timer (NULL until the timers start)*/
+static TimerHandle_t adc_read_timer = NULL;
+#endif
 
 /*********************************************************************************************/
 
-/** Interruption for the RX message buffer*/
-void CAN_RX_Interrupt(void)
+/** This function gets the RTOS handler of a CAN*/
+static RTOS_CAN_Handler_t* rtos_can_get_handler(CAN_Type* base)
+{
+	/** Index of CAN0*/
+	uint8_t index = CAN0_INDEX;
+
+	/** For CAN1*/
+	if(CAN1 == base)
+	{
+		index = CAN1_INDEX;
+	}
+
+	/** For CAN2*/
+	else if(CAN2 == base)
+	{
+		index = CAN2_INDEX;
+	}
+
+	/** Only the first RTOS_CAN_INSTANCES CANs have a handler*/
+	configASSERT(RTOS_CAN_INSTANCES > index);
+
+	return &can_handler[(RTOS_CAN_INSTANCES > index) ? index : CAN0_INDEX];
+}
+
+/** This function routes the Rx and Tx pins of a CAN, only the CANs started use their pins*/
+static void rtos_can_pins_init(CAN_Type* base)
+{
+	/** For CAN0*/
+	if(CAN0 == base)
+	{
+		PCC->PCCn[PCC_PORTE_INDEX] |= PCC_PCCn_CGC_MASK;
+		PORTE->PCR[CAN0_RX_PIN] |= PORT_PCR_MUX(CAN0_PIN_MUX);
+		PORTE->PCR[CAN0_TX_PIN] |= PORT_PCR_MUX(CAN0_PIN_MUX);
+	}
+
+	/** For CAN1*/
+	else if(CAN1 == base)
+	{
+		PCC->PCCn[PCC_PORTA_INDEX] |= PCC_PCCn_CGC_MASK;
+		PORTA->PCR[CAN1_RX_PIN] |= PORT_PCR_MUX(CAN1_PIN_MUX);
+		PORTA->PCR[CAN1_TX_PIN] |= PORT_PCR_MUX(CAN1_PIN_MUX);
+	}
+
+	/** For CAN2*/
+	else if(CAN2 == base)
+	{
+		PCC->PCCn[PCC_PORTC_INDEX] |= PCC_PCCn_CGC_MASK;
+		PORTC->PCR[CAN2_RX_PIN] |= PORT_PCR_MUX(CAN2_PIN_MUX);
+		PORTC->PCR[CAN2_TX_PIN] |= PORT_PCR_MUX(CAN2_PIN_MUX);
+	}
+}
+
+/** Interruption for the message buffers of one CAN*/
+static void rtos_can_mb_interrupt(RTOS_CAN_Handler_t* handler)
+{
+	/** Gets the enabled flags that caused the interruption*/
+	uint32_t flags = handler->base->IFLAG1 & handler->base->IMASK1;
+	/** Set if the Rx task has a higher priority than the interrupted task*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+#if(RX_FIFO != RX_MODE)
+	/** Counter for the Rx MBs*/
+	uint8_t rx_mb;
+#endif
+
+	/** If a Tx MB finished its transmission*/
+	if(flags & CAN_TX_MB_POOL_MASK)
+	{
+		/** Loads the next queued messages*/
+		CAN_tx_queue_isr(&handler->tx_queue);
+	}
+
+#if(RX_FIFO == RX_MODE)
+	/** Message drained from the Rx FIFO*/
+	can_message_rx_config_t fifo_message;
+
+	/** If the Rx FIFO has messages or overflowed*/
+	if(flags & (CAN_RX_FIFO_AVAILABLE | CAN_RX_FIFO_OVERFLOW))
+	{
+		fifo_message.base = handler->base;
+
+		/** Moves every pending message of the FIFO to the ring, adding one to the
+		 	 pending count of the Rx task for each stored message*/
+		while(CAN_read_rx_fifo(&fifo_message))
+		{
+			if(CAN_rx_ring_push(&handler->rx_ring, &fifo_message) && (NULL != handler->rx_task))
+			{
+				vTaskNotifyGiveFromISR(handler->rx_task, &higher_priority_task_woken);
+			}
+		}
+
+		/** Counts the messages lost by the hardware*/
+		if(CAN_rx_fifo_overflowed(handler->base))
+		{
+			handler->rx_ring.stats.fifo_overflows ++;
+		}
+	}
+#else
+	/** If the interruption was caused by the Rx MBs (With the Rx FIFO these flags are the ones of the FIFO,
+	 	 writing them would release its output)*/
+	if(flags & CAN_RX_MB_POOL_MASK)
+	{
+		/** Adds one to the pending count of the Rx task for each MB that received a message*/
+		for(rx_mb = CAN_RX_MB_FIRST ; (CAN_RX_MB_FIRST + CAN_RX_MB_COUNT) > rx_mb ; rx_mb ++)
+		{
+			if((flags & (BIT_TO_SHIFT << rx_mb)) && (NULL != handler->rx_task))
+			{
+				vTaskNotifyGiveFromISR(handler->rx_task, &higher_priority_task_woken);
+			}
+		}
+
+		/** Clears the interruption flags*/
+		CAN_clear_mb_flags(handler->base, flags & CAN_RX_MB_POOL_MASK);
+	}
+#endif
+
+	/** Switches directly to the Rx task if it has a higher priority*/
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/** Interruption for the message buffers of CAN0*/
+void CAN0_MB_Interrupt(void)
+{
+	/** Records the entry in the kernel trace*/
+	TRACE_ISR_ENTER(CAN0_ORed_0_15_MB_IRQn);
+	rtos_can_mb_interrupt(&can_handler[CAN0_INDEX]);
+	/** Records the exit in the kernel trace*/
+	TRACE_ISR_EXIT(CAN0_ORed_0_15_MB_IRQn);
+}
+
+#if(RTOS_CAN_INSTANCES > CAN1_INDEX)
+/** Interruption for the message buffers of CAN1*/
+void CAN1_MB_Interrupt(void)
+{
+	/** Records the entry in the kernel trace*/
+	TRACE_ISR_ENTER(CAN1_ORed_0_15_MB_IRQn);
+	rtos_can_mb_interrupt(&can_handler[CAN1_INDEX]);
+	/** Records the exit in the kernel trace*/
+	TRACE_ISR_EXIT(CAN1_ORed_0_15_MB_IRQn);
+}
+#endif
+
+#if(RTOS_CAN_INSTANCES > CAN2_INDEX)
+/** Interruption for the message buffers of CAN2*/
+void CAN2_MB_Interrupt(void)
+{
+	/** Records the entry in the kernel trace*/
+	TRACE_ISR_ENTER(CAN2_ORed_0_15_MB_IRQn);
+	rtos_can_mb_interrupt(&can_handler[CAN2_INDEX]);
+	/** Records the exit in the kernel trace*/
+	TRACE_ISR_EXIT(CAN2_ORed_0_15_MB_IRQn);
+}
+#endif
+
+/** This function queues a request of a Tx source and notifies the Tx task*/
+static void rtos_tx_event_post(tx_event_source_t source, uint16_t data)
+{
+	/** Source of the request*/
+	RTOS_tx_event_source_t* event_source = &tx_event_source[source];
+
+	/** For the latest-wins policy, replaces the pending request*/
+	if(tx_event_latest == event_source->policy)
+	{
+		if(INIT_VAL != uxQueueMessagesWaiting(event_source->queue))
+		{
+			event_source->stats.coalesced ++;
+		}
+		xQueueOverwrite(event_source->queue, &data);
+		event_source->stats.posted ++;
+	}
+
+	/** For the FIFO policy, the request is dropped if the queue is full*/
+	else if(pdPASS == xQueueSendToBack(event_source->queue, &data, INIT_VAL))
+	{
+		event_source->stats.posted ++;
+	}
+	else
+	{
+		event_source->stats.dropped ++;
+	}
+
+	/** Notifies the Tx task (The bit remains set until the task takes it)*/
+	if(NULL != tx_event_task)
+	{
+		xTaskNotify(tx_event_task, event_source->notify_bit, eSetBits);
+	}
+}
+
+/** This function queues a request of a Tx source and notifies the Tx task from an interruption*/
+static void rtos_tx_event_post_from_isr(tx_event_source_t source, uint16_t data, BaseType_t* higher_priority_task_woken)
 {
-	/** If the interruption was caused by the MB*/
-	if(can_base->IFLAG1 & MB_4_INTERRUPT)
+	/** Source of the request*/
+	RTOS_tx_event_source_t* event_source = &tx_event_source[source];
+
+	/** For the latest-wins policy, replaces the pending request*/
+	if(tx_event_latest == event_source->policy)
 	{
-		/** Releases the semaphore to received the data*/
-		xSemaphoreGiveFromISR(can_handler.sem_rx_binary, pdFALSE);
+		if(INIT_VAL != uxQueueMessagesWaitingFromISR(event_source->queue))
+		{
+			event_source->stats.coalesced ++;
+		}
+		xQueueOverwriteFromISR(event_source->queue, &data, higher_priority_task_woken);
+		event_source->stats.posted ++;
 	}
 
-	/** Clears the interruption flags*/
-	can_base->IFLAG1 = CLEAR_ALL_FLAGS;
+	/** For the FIFO policy, the request is dropped if the queue is full*/
+	else if(pdPASS == xQueueSendToBackFromISR(event_source->queue, &data, higher_priority_task_woken))
+	{
+		event_source->stats.posted ++;
+	}
+	else
+	{
+		event_source->stats.dropped ++;
+	}
+
+	/** Notifies the Tx task (The bit remains set until the task takes it)*/
+	if(NULL != tx_event_task)
+	{
+		xTaskNotifyFromISR(tx_event_task, event_source->notify_bit, eSetBits, higher_priority_task_woken);
+	}
+}
+
+/** Interruption for the LPSPI1, it moves the words of the SPI transfers*/
+void LPSPI1_ISR(void)
+{
+	/** Indicates if a completion function unblocked a higher priority task*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	/** Records the entry in the kernel trace*/
+	TRACE_ISR_ENTER(LPSPI1_IRQn);
+
+	LPSPI_async_isr(&higher_priority_task_woken);
+
+	/** Records the exit in the kernel trace*/
+	TRACE_ISR_EXIT(LPSPI1_IRQn);
+
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/** Completion function of the blocking SPI transfers, it wakes the waiting task with its own bit*/
+static void rtos_spi_transfer_done(lpspi_transfer_t* transfer, BaseType_t* higher_priority_task_woken)
+{
+	xTaskNotifyFromISR((TaskHandle_t)transfer->context, SPI_TRANSFER_NOTIFY_BIT, eSetBits, higher_priority_task_woken);
 }
 
 /** Interruption for the SW3*/
 void SW3_ISR(void)
 {
+	/** Indicates if the notification unblocked a higher priority task*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	/** Records the entry in the kernel trace*/
+	TRACE_ISR_ENTER(BTN_PORT_IRQn);
+
 	/** Clears the interrupt flags*/
 	PORT_HAL_ClearPortIntFlagCmd(BTN_PORT);
 
-	/** Sets the vent group bits*/
-	xEventGroupSetBitsFromISR(can_handler.event_group, EVENT_GROUP_SW, pdFALSE);
+	/** Queues the press and notifies the Tx task directly (Without deferring it to the timer task)*/
+	rtos_tx_event_post_from_isr(tx_event_sw, TX_EVENT_SW_DATA, &higher_priority_task_woken);
+
+	/** Records the exit in the kernel trace*/
+	TRACE_ISR_EXIT(BTN_PORT_IRQn);
+
+	/** Switches to the Tx task when the interruption returns*/
+	portYIELD_FROM_ISR(higher_priority_task_woken);
 }
 
-/** This function initializes the RTOS*/
-void rtos_can_init(can_init_config_t can_init)
+#if(ADC_INTERRUPT == ADC_MODE)
+/** Interruption for the ADC conversion complete*/
+void ADC0_ISR(void)
 {
-	/** Set the handler as initialized*/
-	can_handler.init_val = IS_INIT;
-	/** Creates the semaphores and the event group*/
-	can_handler.sem_rx_binary = xSemaphoreCreateBinary();
-	can_handler.mutex = xSemaphoreCreateMutex();
-	can_handler.event_group = xEventGroupCreate();
+	/** Indicates if the notification unblocked a higher priority task*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+	/** Reads the raw result, the ADC job scales it (Reading it clears the COCO flag)*/
+	uint16_t sample = read_adc_raw();
+
+	/** Records the entry in the kernel trace*/
+	TRACE_ISR_ENTER(ADC0_IRQn);
+
+	/** Stores the sample if the buffer has space*/
+	if(ADC_BUFFER_SIZE > (uint8_t)(adc_buffer_head - adc_buffer_tail))
+	{
+		adc_buffer[adc_buffer_head & ADC_BUFFER_MASK] = sample;
+		adc_buffer_head ++;
+	}
+
+	/** Wakes the ADC task*/
+	if(NULL != adc_task)
+	{
+		vTaskNotifyGiveFromISR(adc_task, &higher_priority_task_woken);
+	}
+
+	/** Records the exit in the kernel trace*/
+	TRACE_ISR_EXIT(ADC0_IRQn);
+
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+#endif
+
+/** Interruption for the ADC scan, it occurs once per scan*/
+void ADC1_ISR(void)
+{
+	/** Indicates if the queue unblocked a higher priority task*/
+	BaseType_t higher_priority_task_woken = pdFALSE;
+	/** Results of the scan*/
+	adc_scan_frame_t frame;
+
+	/** Records the entry in the kernel trace*/
+	TRACE_ISR_ENTER(ADC1_IRQn);
+
+	/** Reads the results (This clears the interruption flag), and stamps the scan*/
+	frame.count = ADC_scan_read(frame.results);
+	frame.sequence = adc_scan_sequence ++;
+	frame.tick = xTaskGetTickCountFromISR();
+
+	/** Delivers the scan to the consumer*/
+	if(pdPASS == xQueueSendToBackFromISR(adc_scan_queue, &frame, &higher_priority_task_woken))
+	{
+		adc_scan_stats.frames ++;
+	}
+	else
+	{
+		adc_scan_stats.dropped ++;
+	}
+
+	/** Records the exit in the kernel trace*/
+	TRACE_ISR_EXIT(ADC1_IRQn);
+
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/** This function programs the hardware filters with the ADC ID and the ID function vector*/
+static void rtos_can_update_rx_filters(RTOS_CAN_Handler_t* handler)
+{
+	/** Filter table, one exact filter per ID (Static, so it doesn't use the stack of the calling task,
+	 	 the tasks that change the ID function vectors are serialized by the scheduler suspension)*/
+	static can_rx_filter_t rx_filters[RX_FILTER_TABLE_SIZE];
+	/** Counter for the ID function vector*/
+	uint8_t ID_counter = INIT_VAL;
+
+	/** The ADC ID is always received*/
+	rx_filters[INIT_VAL].ID = ADC_RX_ID;
+	rx_filters[INIT_VAL].mask = CAN_RX_FILTER_EXACT;
+
+	/** Adds every ID of the ID function vector*/
+	for(ID_counter = INIT_VAL ; ID_counter < handler->ID_table.ID_func_counter ; ID_counter ++)
+	{
+		rx_filters[ID_counter + ARRAY_POS_OFFSET_1].ID = handler->ID_table.ID_function[ID_counter].ID;
+		rx_filters[ID_counter + ARRAY_POS_OFFSET_1].mask = CAN_RX_FILTER_EXACT;
+	}
+
+	/** Programs the filters (They are merged into range masks if they don't fit)*/
+	CAN_set_rx_filters(handler->base, rx_filters, handler->ID_table.ID_func_counter + ARRAY_POS_OFFSET_1);
+}
+
+/** This function updates the hardware filters after a change in the ID function vector*/
+static void rtos_can_refresh_rx_filters(RTOS_CAN_Handler_t* handler)
+{
+	/** Before the initialization the filters are programmed by rtos_can_init*/
+	if(IS_INIT == handler->init_val)
+	{
+		/** Protects the CAN while it is frozen*/
+		xSemaphoreTake(handler->mutex, portMAX_DELAY);
+		vTaskSuspendAll();
+		rtos_can_update_rx_filters(handler);
+		xTaskResumeAll();
+		xSemaphoreGive(handler->mutex);
+	}
+}
+
+/** Timer callback that refreshes the SBC watchdog and reads its status*/
+static void rtos_sbc_timer_callback(TimerHandle_t timer)
+{
+	SBC_service_run();
+}
+
+/** This function initializes the clocks, the ADC, the SBC, the LEDs and the SW3*/
+static void rtos_board_init(void)
+{
+	/** Variable to go through the Tx sources*/
+	uint8_t source;
+
+	/** Creates the queues of the Tx sources (Before the SW3 interruption is enabled)*/
+	for(source = INIT_VAL; tx_event_source_count > source; source ++)
+	{
+		tx_event_source[source].queue = xQueueCreate(tx_event_source[source].length, sizeof(uint16_t));
+	}
 
 	/*********************** NOTE ***************************/
 	/** This module is taken from the driver example FlexCAN*/
@@ -225,376 +773,1072 @@ void rtos_can_init(can_init_config_t can_init)
 	NormalRUNmode_80MHz();  /* Init clocks: 80 MHz sysclk & core, 40 MHz bus, 20 MHz flash */
 	/** To here *******************************************************************************/
 
+	/** Reads the core clock, the FreeRTOS tick is programmed with it*/
+	timebase_init();
+
+	/** Prepares the LPTMR0 that wakes the core when the idle task stops the tick*/
+	tickless_init();
+
+	/** Starts the kernel trace (The ring keeps the latest events until a dump is requested)*/
+	trace_recorder_start();
+
+	/** Initializes the ADC*/
+	ADC_init();
+
+	/** Calibrates the ADC on a power-on, or restores its calibration after a warm reset
+	 	 (The conversions run uncalibrated if the sequence does not finish)*/
+	ADC_calibration_init(ADC0);
+
+	/** Sets the hardware averaging and the pipeline of the potentiometer*/
+	ADC_pipeline_set_hw_average(ADC0, ADC_POT_HW_AVERAGE);
+	ADC_pipeline_init(&adc_pot_pipeline, &adc_pot_pipeline_init);
+	CAN_tx_policy_init(&adc_tx_policy, &adc_tx_policy_init);
+
+#if(ADC_INTERRUPT == ADC_MODE)
+	/** Installs the ADC interruption (It calls interrupt safe API functions)*/
+	INT_SYS_InstallHandler(ADC0_IRQn, ADC0_ISR, (isr_t *)NULL);
+	INT_SYS_EnableIRQ(ADC0_IRQn);
+	INT_SYS_SetPriority(ADC0_IRQn, ADC_INTERRUPT_PRIO);
+#endif
+
+	/*********************** NOTE ***************************/
+	/** This module is taken from the driver example FlexCAN,
+	 	 and the Blinking_LED example*/
+	/********************************************************/
+	/** From here *****************************************************************************/
+	PORT_init();             /* Configure ports */
+	LPSPI1_init_master();    /* Initialize LPSPI1 for communication with MC33903 */
+	/** To here *******************************************************************************/
+
+	/** Configures the SBC with the LPSPI1 interruption instead of polling each word (LPSPI1_init_MC33903)*/
+	LPSPI_async_init();
+	INT_SYS_InstallHandler(LPSPI1_IRQn, LPSPI1_ISR, (isr_t *)NULL);
+	INT_SYS_SetPriority(LPSPI1_IRQn, LPSPI_INTERRUPT_PRIO);
+	INT_SYS_EnableIRQ(LPSPI1_IRQn);
+	/** The queue was just emptied, so the transfer is always taken (No polled transfer can share the RDR with the interruption)*/
+	LPSPI_async_submit(&sbc_init_transfer);
+
+	/** Refreshes the SBC watchdog and reads its status periodically, without waiting for the SPI*/
+	SBC_service_init(SBC_REFRESH_PERIOD);
+	sbc_timer = xTimerCreate("SBC", TIMEBASE_MS_TO_TICKS(SBC_REFRESH_PERIOD), pdTRUE, NULL, rtos_sbc_timer_callback);
+	xTimerStart(sbc_timer, INIT_VAL);
+
+	/** From here *****************************************************************************/
+
+	/**************** LED CONFIGURATION ********************/
+	 /* Configure clock source */
+	PCC_HAL_SetClockMode(PCC, LED_PORT_PCC, false);
+	PCC_HAL_SetClockSourceSel(PCC, LED_PORT_PCC, CLK_SRC_FIRC);
+	PCC_HAL_SetClockMode(PCC, LED_PORT_PCC, true);
+
+	PCC_HAL_SetClockMode(PCC, BTN_PORT_PCC, false);
+	PCC_HAL_SetClockSourceSel(PCC, BTN_PORT_PCC, CLK_SRC_FIRC);
+	PCC_HAL_SetClockMode(PCC, BTN_PORT_PCC, true);
+
+	/* Configure ports */
+	PORT_HAL_SetMuxModeSel(LED_PORT, RED_LED_PIN,      PORT_MUX_AS_GPIO);
+	PORT_HAL_SetMuxModeSel(LED_PORT, GREEN_LED_PIN,      PORT_MUX_AS_GPIO);
+	PORT_HAL_SetMuxModeSel(BTN_PORT, BTN_PIN,   PORT_MUX_AS_GPIO);
+	PORT_HAL_SetPinIntSel(BTN_PORT, BTN_PIN, PORT_INT_RISING_EDGE);
+
+	/* Change RED_LED_PIN, GREEN_LED_PIN to outputs. */
+	GPIO_HAL_SetPinsDirection(LED_GPIO,  (BIT_TO_SHIFT << RED_LED_PIN) | (BIT_TO_SHIFT << GREEN_LED_PIN));
+
+	/* Change BTN1 to input */
+	GPIO_HAL_SetPinsDirection(BTN_GPIO, ~(BIT_TO_SHIFT << BTN_PIN));
+
+	/* Start with LEDs off. */
+	GPIO_HAL_SetPins(LED_GPIO, (BIT_TO_SHIFT << RED_LED_PIN) | (BIT_TO_SHIFT << GREEN_LED_PIN));
+
+	/* Install Button interrupt handler */
+    INT_SYS_InstallHandler(BTN_PORT_IRQn, SW3_ISR, (isr_t *)NULL);
+    /* Enable Button interrupt handler */
+    INT_SYS_EnableIRQ(BTN_PORT_IRQn);
+
+    /* The interrupt calls an interrupt safe API function - so its priority must
+    be equal to or lower than configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY. */
+    INT_SYS_SetPriority( BTN_PORT_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY );
+
+	/** To here *******************************************************************************/
+}
+
+/** This function initializes the RTOS*/
+void rtos_can_init(can_init_config_t can_init)
+{
+	/** Handler of the CAN*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler(can_init.base);
+
+	/** The board is initialized only with the first CAN*/
+	if(NOT_INIT == board_init_val)
+	{
+		board_init_val = IS_INIT;
+		rtos_board_init();
+	}
+
+	/** Set the handler as initialized*/
+	handler->init_val = IS_INIT;
 	/** Sets the configured base*/
-	can_base = can_init.base;
+	handler->base = can_init.base;
+	/** Creates the mutex*/
+	handler->mutex = xSemaphoreCreateMutex();
+
+	/** Selects the Rx message buffers or the Rx FIFO according to the Rx mode*/
+#if(RX_FIFO == RX_MODE)
+	can_init.rx_buffer = rx_fifo;
+#else
+	can_init.rx_buffer = rx_mailbox;
+#endif
 
+	/** Routes the pins of this CAN*/
+	rtos_can_pins_init(can_init.base);
 	/** Initializes the CAN*/
 	CAN_Init(can_init);
-	/** Initializes the ADC*/
-	ADC_init();
+	/** Receives only the ADC ID and the IDs of the ID function vector*/
+	rtos_can_update_rx_filters(handler);
 
-#if(!RX_MODE)
+	/** Initializes the Tx queue*/
+	CAN_tx_queue_init(&handler->tx_queue, handler->base);
+
+#if(RX_INTERRUPT == RX_MODE)
 	/** Enables the CAN RX message buffer interruption*/
-	CAN_enable_rx_interruption(can_base);
+	CAN_enable_rx_interruption(handler->base);
+#endif
+
+#if(RX_FIFO == RX_MODE)
+	/** Enables the CAN Rx FIFO interruptions*/
+	CAN_rx_ring_init(&handler->rx_ring);
+	CAN_enable_rx_fifo_interruption(handler->base);
+#endif
 
 	/** Sets the IRQ hadler, enables it and sets its priority*/
-	if(CAN0 == can_base)
+	if(CAN0 == handler->base)
 	{
-		INT_SYS_InstallHandler(CAN0_ORed_0_15_MB_IRQn, CAN_RX_Interrupt, (isr_t *)NULL);
+		INT_SYS_InstallHandler(CAN0_ORed_0_15_MB_IRQn, CAN0_MB_Interrupt, (isr_t *)NULL);
 		INT_SYS_EnableIRQ(CAN0_ORed_0_15_MB_IRQn);
-		INT_SYS_SetPriority(CAN0_ORed_0_15_MB_IRQn, CAN_RX_INTERRUPT_PRIO);
+		INT_SYS_SetPriority(CAN0_ORed_0_15_MB_IRQn, CAN_MB_INTERRUPT_PRIO);
 	}
-	else if(CAN1 == can_base)
+#if(RTOS_CAN_INSTANCES > CAN1_INDEX)
+	else if(CAN1 == handler->base)
 	{
-		INT_SYS_InstallHandler(CAN1_ORed_0_15_MB_IRQn, CAN_RX_Interrupt, (isr_t *)NULL);
+		INT_SYS_InstallHandler(CAN1_ORed_0_15_MB_IRQn, CAN1_MB_Interrupt, (isr_t *)NULL);
 		INT_SYS_EnableIRQ(CAN1_ORed_0_15_MB_IRQn);
-		INT_SYS_SetPriority(CAN1_ORed_0_15_MB_IRQn, CAN_RX_INTERRUPT_PRIO);
+		INT_SYS_SetPriority(CAN1_ORed_0_15_MB_IRQn, CAN_MB_INTERRUPT_PRIO);
+	}
+#endif
+#if(RTOS_CAN_INSTANCES > CAN2_INDEX)
+	else if(CAN2 == handler->base)
+	{
+		INT_SYS_InstallHandler(CAN2_ORed_0_15_MB_IRQn, CAN2_MB_Interrupt, (isr_t *)NULL);
+		INT_SYS_EnableIRQ(CAN2_ORed_0_15_MB_IRQn);
+		INT_SYS_SetPriority(CAN2_ORed_0_15_MB_IRQn, CAN_MB_INTERRUPT_PRIO);
+	}
+#endif
+}
+
+/** CAN tx thread that transmits either the message of the ADC, or the
+ 	 	 	 message set with rtos_can_set_sw_msg.*/
+void rtos_can_tx_thread_EG(void* args)
+{
+	/** Initializes the ADC message array*/
+	uint8_t adc_tx_msg[2] = {INIT_VAL};
+	/** Variable to get the notification bits*/
+	uint32_t tx_event;
+	/** Request taken from a Tx source*/
+	uint16_t tx_data;
+	/** Variable to transmit messages*/
+	can_message_tx_config_t tx_message;
+	/** Handler of the CAN that sends the ADC message*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler((CAN_Type*)args);
+
+	/** If the CAN handler has been initialized*/
+	if (IS_INIT == handler->init_val)
+	{
+		/** Registers the task to be notified by the SW3 and the ADC*/
+		tx_event_task = xTaskGetCurrentTaskHandle();
+
+		/** Infinite cycle*/
+		for(;;)
+		{
+			/** Waits for any notification bit, takes the bits and clears only its event bits*/
+			xTaskNotifyWait(INIT_VAL, TX_EVENT_ALL, &tx_event, portMAX_DELAY);
+
+			/** For the ADC event, sends every queued sample in order*/
+			while((TX_EVENT_ADC == (tx_event & TX_EVENT_ADC)) &&
+				(pdPASS == xQueueReceive(tx_event_source[tx_event_adc].queue, &tx_data, INIT_VAL)))
+			{
+				tx_event_source[tx_event_adc].stats.sent ++;
+
+				/** Sets the ADC read in the message array*/
+				adc_tx_msg[ADC_LOW_BYTE_POS] = (uint8_t)(tx_data & LOW_BYTE_MASK);
+				adc_tx_msg[ADC_HIGH_BYTE_POS] = (uint8_t)((tx_data & HIGH_BYTE_MASK) >> BYTE_SHIFT);
+
+				/** Sets the values for the tx message*/
+				tx_message.base = handler->base;
+				tx_message.ID = ADC_TX_ID;
+				tx_message.msg = adc_tx_msg;
+				tx_message.DLC = sizeof(adc_tx_msg);
+
+				/** Queues the message, it is sent from the MB interruption*/
+				rtos_can_transmit(tx_message);
+			}
+
+			/** For the switch event, sends the latest press*/
+			if((TX_EVENT_SW == (tx_event & TX_EVENT_SW)) &&
+				(pdPASS == xQueueReceive(tx_event_source[tx_event_sw].queue, &tx_data, INIT_VAL)))
+			{
+				tx_event_source[tx_event_sw].stats.sent ++;
+
+				/** Sets the predefined message to the tx message*/
+				tx_message.base = base_SW;
+				tx_message.ID = ID_SW;
+				tx_message.msg = msg_SW;
+				tx_message.DLC = DLC_SW;
+
+				/** Queues the message, it is sent from the MB interruption*/
+				rtos_can_transmit(tx_message);
+			}
+		}
+	}
+}
+
+/** This function wakes the periodic Tx job after the schedule changed*/
+static void rtos_tx_schedule_changed(void)
+{
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
+	if(NULL != tx_schedule_task)
+	{
+		xTaskNotifyGive(tx_schedule_task);
+	}
+#else
+	/** Runs the timer in the next tick (Changing the period also starts it)*/
+	if(NULL != tx_schedule_timer)
+	{
+		xTimerChangePeriod(tx_schedule_timer, PERIODIC_JOB_MIN_TICKS, INIT_VAL);
+	}
+#endif
+}
+
+/** This function sends the messages of the periodic Tx schedule that are due, and returns
+ 	 the ticks until the next message is due*/
+static uint32_t rtos_tx_schedule_job(void)
+{
+	/** Variable to transmit messages*/
+	can_message_tx_config_t tx_message;
+	/** Indicates if a message was due*/
+	uint8_t message_due;
+	/** Ticks until the next message is due*/
+	uint32_t ticks_to_next;
+
+	/** Sends every message that is due*/
+	do
+	{
+		/** The schedule is shared with the tasks that add, remove or change messages*/
+		vTaskSuspendAll();
+		message_due = CAN_tx_schedule_pop_due(&tx_schedule, xTaskGetTickCount(), &tx_message);
+		xTaskResumeAll();
+
+		/** Queues the message, it is sent from the MB interruption*/
+		if(message_due && (IS_INIT == rtos_can_get_handler(tx_message.base)->init_val))
+		{
+			rtos_can_transmit(tx_message);
+		}
+	}while(message_due);
+
+	/** Gets the ticks until the next message*/
+	vTaskSuspendAll();
+	ticks_to_next = CAN_tx_schedule_ticks_to_next(&tx_schedule, xTaskGetTickCount());
+	xTaskResumeAll();
+
+	return ticks_to_next;
+}
+
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
+/** This thread sends the messages of the periodic Tx schedule.*/
+void rtos_can_tx_thread_periodic(void *args)
+{
+	/** Ticks until the next message is due*/
+	uint32_t ticks_to_next;
+
+	/** Registers the task to be woken when the schedule changes*/
+	tx_schedule_task = xTaskGetCurrentTaskHandle();
+
+	/** Infinite cycle*/
+	for(;;)
+	{
+		/** Sends the messages that are due*/
+		ticks_to_next = rtos_tx_schedule_job();
+
+		/** Sleeps until the next message is due, or until the schedule changes*/
+		ulTaskNotifyTake(pdTRUE, (CAN_TX_SCHEDULE_IDLE == ticks_to_next) ? portMAX_DELAY : (TickType_t)ticks_to_next);
+	}
+}
+#else
+/** Timer callback that sends the messages of the periodic Tx schedule*/
+static void rtos_tx_schedule_timer_callback(TimerHandle_t timer)
+{
+	/** Sends the messages that are due*/
+	uint32_t ticks_to_next = rtos_tx_schedule_job();
+
+	/** Runs again when the next message is due (Without messages, the one-shot timer stays stopped)*/
+	if(CAN_TX_SCHEDULE_IDLE != ticks_to_next)
+	{
+		xTimerChangePeriod(timer, (PERIODIC_JOB_MIN_TICKS > ticks_to_next) ? PERIODIC_JOB_MIN_TICKS : (TickType_t)ticks_to_next, INIT_VAL);
+	}
+}
+#endif
+
+/** This function adds a message to the periodic Tx schedule*/
+uint8_t rtos_add_tx_periodic_msg(can_message_tx_config_t can_message_tx, uint32_t period)
+{
+	/** Slot of the message*/
+	uint8_t slot;
+
+	vTaskSuspendAll();
+	slot = CAN_tx_schedule_add(&tx_schedule, can_message_tx, timebase_ms_to_ticks(period), xTaskGetTickCount());
+	xTaskResumeAll();
+
+	rtos_tx_schedule_changed();
+
+	return slot;
+}
+
+/** This function removes a message from the periodic Tx schedule*/
+CAN_tx_schedule_status_t rtos_remove_tx_periodic_msg(uint8_t slot)
+{
+	/** Result of the operation*/
+	CAN_tx_schedule_status_t status;
+
+	vTaskSuspendAll();
+	status = CAN_tx_schedule_remove(&tx_schedule, slot);
+	xTaskResumeAll();
+
+	rtos_tx_schedule_changed();
+
+	return status;
+}
+
+/** This function changes the period of a message of the periodic Tx schedule*/
+CAN_tx_schedule_status_t rtos_set_tx_periodic_msg_period(uint8_t slot, uint32_t period)
+{
+	/** Result of the operation*/
+	CAN_tx_schedule_status_t status;
+
+	vTaskSuspendAll();
+	status = CAN_tx_schedule_set_period(&tx_schedule, slot, timebase_ms_to_ticks(period), xTaskGetTickCount());
+	xTaskResumeAll();
+
+	rtos_tx_schedule_changed();
+
+	return status;
+}
+
+/** This function calls the handler of a received message*/
+static void rtos_can_dispatch_message(RTOS_CAN_Handler_t* handler, can_message_rx_config_t* can_message_rx)
+{
+	/** Variable for the received ADC value*/
+	uint16_t received_ADC_val = INIT_VAL;
+	/** Callback of the received ID*/
+	void (*ID_func)(can_message_rx_config_t can_message_rx) = NULL;
+	/** Entry of the ID in the ID function vector*/
+	const ID_function_t* ID_entry;
+
+	/** Specific case for the ADC ID*/
+	if(ADC_RX_ID == can_message_rx->ID)
+	{
+		/** Sets the value received into one variable*/
+		received_ADC_val = (uint16_t)(can_message_rx->msg[ADC_LOW_BYTE_POS]);
+		received_ADC_val |= (uint16_t)(can_message_rx->msg[ADC_HIGH_BYTE_POS] << BYTE_SHIFT);
+
+		/** Turns on the LED according to the received ADC value*/
+		rtos_turn_on_leds(received_ADC_val);
+	}
+
+	/** For any other ID*/
+	else
+	{
+		/** Gets the callback from the index table (The vector can change from other tasks)*/
+		taskENTER_CRITICAL();
+		ID_entry = CAN_ID_table_find(&handler->ID_table, can_message_rx->ID);
+		if(NULL != ID_entry)
+		{
+			ID_func = ID_entry->ID_func;
+		}
+		taskEXIT_CRITICAL();
+
+		/** Calls the corresponding function*/
+		if(NULL != ID_func)
+		{
+			ID_func(*can_message_rx);
+		}
+	}
+}
+
+#if(RX_INTERRUPT == RX_MODE)
+/** This thread receives a message using interruption.*/
+void rtos_can_rx_thread_interruption(void *args)
+{
+	/** Handler of the CAN of the thread*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler((CAN_Type*)args);
+	/** Defines whether a message was read or not*/
+	uint8_t message_read;
+	/** Messages notified but not read yet (Negative when messages were read before their notification was taken)*/
+	int32_t pending;
+
+	/** If the CAN handler has been initialized*/
+	if(IS_INIT == handler->init_val)
+	{
+		/** Registers the task to be notified by the interruption*/
+		handler->rx_task = xTaskGetCurrentTaskHandle();
+
+		/** Infinite cycle*/
+		for(;;)
+		{
+			/** Waits for the interruption and takes the pending count, one for each
+			 	 message stored in the Rx MBs since the last wake up*/
+			handler->rx_stats.notified += ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+			/** Sets the base*/
+			handler->rx_message.base = handler->base;
+
+			/** Reads every Rx MB that holds a message*/
+			do
+			{
+				/** Receives a message protecting CAN*/
+				xSemaphoreTake(handler->mutex, portMAX_DELAY);
+				message_read = CAN_receive_message(&handler->rx_message);
+				handler->rx_stats.received += message_read;
+				xSemaphoreGive(handler->mutex);
+
+				/** Calls the handler of the message*/
+				if(message_read)
+				{
+					rtos_can_dispatch_message(handler, &handler->rx_message);
+				}
+			}while(message_read);
+
+			/** The Rx MBs are empty, so the notified messages that were not read were
+			 	 overwritten by a newer message in the same Rx MB*/
+			pending = (int32_t)(handler->rx_stats.notified - handler->rx_stats.received - handler->rx_stats.overwritten);
+			if(INIT_VAL < pending)
+			{
+				handler->rx_stats.overwritten += (uint32_t)pending;
+			}
+		}
+	}
+}
+
+/** This function gets the statistics of the Rx MBs*/
+void rtos_can_get_rx_mb_stats(CAN_Type* base, can_rx_mb_stats_t* stats)
+{
+	taskENTER_CRITICAL();
+	*stats = rtos_can_get_handler(base)->rx_stats;
+	taskEXIT_CRITICAL();
+}
+#endif
+
+#if(RX_FIFO == RX_MODE)
+/** This thread processes the messages of the Rx ring in batches.*/
+void rtos_can_rx_thread_fifo(void *args)
+{
+	/** Handler of the CAN of the thread*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler((CAN_Type*)args);
+
+	/** If the CAN handler has been initialized*/
+	if(IS_INIT == handler->init_val)
+	{
+		/** Registers the task to be notified by the interruption*/
+		handler->rx_task = xTaskGetCurrentTaskHandle();
+
+		/** Infinite cycle*/
+		for(;;)
+		{
+			/** Waits until the interruption stores messages in the ring, and clears
+			 	 the pending count (The whole batch is processed)*/
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+			/** Processes every message waiting in the ring*/
+			while(CAN_rx_ring_pop(&handler->rx_ring, &handler->rx_message))
+			{
+				/** Calls the handler of the message*/
+				rtos_can_dispatch_message(handler, &handler->rx_message);
+			}
+		}
+	}
+}
+
+/** This function gets the statistics of the Rx ring*/
+void rtos_can_get_rx_stats(CAN_Type* base, can_rx_ring_stats_t* stats)
+{
+	taskENTER_CRITICAL();
+	*stats = rtos_can_get_handler(base)->rx_ring.stats;
+	taskEXIT_CRITICAL();
+}
+#endif
+
+#if(RX_PERIODIC == RX_MODE)
+/** This function polls the Rx flag of a CAN once*/
+static void rtos_can_rx_poll_job(RTOS_CAN_Handler_t* handler, TickType_t mutex_wait)
+{
+	/** Defines whether a message was read or not*/
+	uint8_t message_read;
+
+	/** Queries the status of the Rx interruption*/
+	if(CAN_get_rx_status(handler->base))
+	{
+		/** Gets the configured bas*/
+		handler->rx_message.base = handler->base;
+
+		/** Receives the messages protecting the CAN first (This also clears the Rx flags). If
+		 	 the CAN is busy, the messages are read in the next period*/
+		do
+		{
+			/** A pass that does not get the CAN reads nothing, so the job returns*/
+			message_read = INIT_VAL;
+
+			if(pdTRUE == xSemaphoreTake(handler->mutex, mutex_wait))
+			{
+				message_read = CAN_receive_message(&handler->rx_message);
+				xSemaphoreGive(handler->mutex);
+
+				/** Calls the handler of the message*/
+				if(message_read)
+				{
+					rtos_can_dispatch_message(handler, &handler->rx_message);
+				}
+			}
+		}while(message_read);
+	}
+}
+
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
+void rtos_can_rx_thread_periodic(void *args)
+{
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime;
+
+	/** Handler of the CAN of the thread*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler((CAN_Type*)args);
+
+	/** If the CAN handler has been initialized*/
+	if(IS_INIT == handler->init_val)
+	{
+		/** Gets the current tick count*/
+		xLastWakeTime = xTaskGetTickCount();
+
+		/** Infinite cycle*/
+		for(;;)
+		{
+			/** Polls the Rx flag*/
+			rtos_can_rx_poll_job(handler, portMAX_DELAY);
+
+			/** Delay to make the function periodic*/
+			vTaskDelayUntil(&xLastWakeTime, rx_task_period);
+		}
+	}
+}
+#else
+/** Timer callback that polls the Rx flag of a CAN*/
+static void rtos_can_rx_timer_callback(TimerHandle_t timer)
+{
+	/** The timer callbacks can not block, the ID of the timer is the handler of its CAN*/
+	rtos_can_rx_poll_job((RTOS_CAN_Handler_t*)pvTimerGetTimerID(timer), INIT_VAL);
+}
+
+/** This function starts the timer that receives the messages of a CAN periodically*/
+void rtos_can_rx_timer_start(CAN_Type* base)
+{
+	/** Handler of the CAN of the timer*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler(base);
+
+	/** If the CAN handler has been initialized, and the timer was not created before*/
+	if((IS_INIT == handler->init_val) && (NULL == handler->rx_timer))
+	{
+		handler->rx_timer = xTimerCreate("RX", rx_task_period, pdTRUE, handler, rtos_can_rx_timer_callback);
+		xTimerStart(handler->rx_timer, INIT_VAL);
+	}
+}
+#endif
+#endif
+
+/** This function sets the message to be sent when a SW3 interruption occurrs*/
+void rtos_can_set_sw_msg(can_message_tx_config_t can_message_tx)
+{
+	/** Counter to copy the vector*/
+	uint8_t counter = INIT_VAL;
+
+	for(counter = INIT_VAL ; counter < can_message_tx.DLC ; counter ++)
+	{
+		/** Copies each value of the message to the tx message*/
+		msg_SW[counter] = (*can_message_tx.msg);
+		can_message_tx.msg ++;
+	}
+
+	/** Sets the CAN, the ID and the DLC to the tx message*/
+	base_SW = can_message_tx.base;
+	ID_SW = can_message_tx.ID;
+	DLC_SW = can_message_tx.DLC;
+}
+
+#if(RX_FIFO != RX_MODE)
+/** This function receives from CAN protecting it with mutex*/
+void rtos_can_receive(can_message_rx_config_t *can_message_tx)
+{
+	/** Handler of the CAN of the message*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler(can_message_tx->base);
+
+	/** Takes the mutex*/
+	xSemaphoreTake(handler->mutex, portMAX_DELAY);
+	/** Receives the message*/
+#if(RX_INTERRUPT == RX_MODE)
+	handler->rx_stats.received += CAN_receive_message(can_message_tx);
+#else
+	CAN_receive_message(can_message_tx);
+#endif
+	/** Releases the mutex*/
+	xSemaphoreGive(handler->mutex);
+}
+#endif
+
+/** This function transmits from CAN through the Tx queue*/
+CAN_tx_queue_status_t rtos_can_transmit(can_message_tx_config_t can_message_tx)
+{
+	/** Queues the message in the Tx queue of its CAN, it is sent from the MB interruption*/
+	return CAN_tx_queue_send(&rtos_can_get_handler(can_message_tx.base)->tx_queue, can_message_tx);
+}
+
+/** This function gets the statistics of the Tx queue*/
+void rtos_can_get_tx_stats(CAN_Type* base, can_tx_queue_stats_t* stats)
+{
+	CAN_tx_queue_get_stats(&rtos_can_get_handler(base)->tx_queue, stats);
+}
+
+/** This function starts the ADC scan*/
+adc_scan_status_t rtos_adc_scan_start(const adc_scan_config_t* config)
+{
+	/** Creates the queue of scans the first time*/
+	if(NULL == adc_scan_queue)
+	{
+		adc_scan_queue = xQueueCreate(ADC_SCAN_QUEUE_LENGTH, sizeof(adc_scan_frame_t));
+
+		/** Installs the ADC scan interruption (It calls interrupt safe API functions)*/
+		INT_SYS_InstallHandler(ADC1_IRQn, ADC1_ISR, (isr_t *)NULL);
+		INT_SYS_SetPriority(ADC1_IRQn, ADC_SCAN_INTERRUPT_PRIO);
+		INT_SYS_EnableIRQ(ADC1_IRQn);
 	}
-	else if(CAN2 == can_base)
+
+	/** The scans of the previous configuration are discarded*/
+	ADC_scan_stop();
+	xQueueReset(adc_scan_queue);
+	adc_scan_sequence = INIT_VAL;
+
+	return ADC_scan_start(config);
+}
+
+/** This function waits for a complete scan*/
+BaseType_t rtos_adc_scan_receive(adc_scan_frame_t* frame, TickType_t ticks_to_wait)
+{
+	/** Result of the reception*/
+	BaseType_t retval = pdFAIL;
+
+	if(NULL != adc_scan_queue)
 	{
-		INT_SYS_InstallHandler(CAN2_ORed_0_15_MB_IRQn, CAN_RX_Interrupt, (isr_t *)NULL);
-		INT_SYS_EnableIRQ(CAN2_ORed_0_15_MB_IRQn);
-		INT_SYS_SetPriority(CAN2_ORed_0_15_MB_IRQn, CAN_RX_INTERRUPT_PRIO);
+		retval = xQueueReceive(adc_scan_queue, frame, ticks_to_wait);
 	}
-#endif
 
-	/*********************** NOTE ***************************/
-	/** This module is taken from the driver example FlexCAN,
-	 	 and the Blinking_LED example*/
-	/********************************************************/
-	/** From here *****************************************************************************/
-	PORT_init();             /* Configure ports */
-	LPSPI1_init_master();    /* Initialize LPSPI1 for communication with MC33903 */
-	LPSPI1_init_MC33903();   /* Configure SBC via SPI for CAN transceiver operation */
+	return retval;
+}
 
-	/**************** LED CONFIGURATION ********************/
-	 /* Configure clock source */
-	PCC_HAL_SetClockMode(PCC, LED_PORT_PCC, false);
-	PCC_HAL_SetClockSourceSel(PCC, LED_PORT_PCC, CLK_SRC_FIRC);
-	PCC_HAL_SetClockMode(PCC, LED_PORT_PCC, true);
+/** This function gets the statistics of the ADC scan*/
+void rtos_adc_scan_get_stats(adc_scan_stats_t* stats)
+{
+	/** The statistics are updated from the interruption*/
+	taskENTER_CRITICAL();
+	*stats = adc_scan_stats;
+	taskEXIT_CRITICAL();
+}
 
-	PCC_HAL_SetClockMode(PCC, BTN_PORT_PCC, false);
-	PCC_HAL_SetClockSourceSel(PCC, BTN_PORT_PCC, CLK_SRC_FIRC);
-	PCC_HAL_SetClockMode(PCC, BTN_PORT_PCC, true);
+/** This function changes the pipeline of the potentiometer samples*/
+void rtos_adc_set_pipeline(const adc_pipeline_config_t* config)
+{
+	/** The ADC job can be using the pipeline*/
+	taskENTER_CRITICAL();
+	ADC_pipeline_init(&adc_pot_pipeline, config);
+	taskEXIT_CRITICAL();
+}
 
-	/* Configure ports */
-	PORT_HAL_SetMuxModeSel(LED_PORT, RED_LED_PIN,      PORT_MUX_AS_GPIO);
-	PORT_HAL_SetMuxModeSel(LED_PORT, GREEN_LED_PIN,      PORT_MUX_AS_GPIO);
-	PORT_HAL_SetMuxModeSel(BTN_PORT, BTN_PIN,   PORT_MUX_AS_GPIO);
-	PORT_HAL_SetPinIntSel(BTN_PORT, BTN_PIN, PORT_INT_RISING_EDGE);
+/** This function sends and receives SPI words with the LPSPI1, sleeping while they are moved*/
+lpspi_async_status_t rtos_spi_transfer(const uint16_t* tx, uint16_t* rx, uint8_t count)
+{
+	/** Transfer, it stays valid until it completes since this function waits for it*/
+	lpspi_transfer_t transfer = {tx, rx, count, rtos_spi_transfer_done, NULL, lpspi_transfer_idle};
+	/** Result of the submission*/
+	lpspi_async_status_t status;
+	/** Notification value of the calling task (Its other bits or counts are left untouched)*/
+	uint32_t notified_value = INIT_VAL;
 
-	/* Change RED_LED_PIN, GREEN_LED_PIN to outputs. */
-	GPIO_HAL_SetPinsDirection(LED_GPIO,  (BIT_TO_SHIFT << RED_LED_PIN) | (BIT_TO_SHIFT << GREEN_LED_PIN));
+	transfer.context = xTaskGetCurrentTaskHandle();
 
-	/* Change BTN1 to input */
-	GPIO_HAL_SetPinsDirection(BTN_GPIO, ~(BIT_TO_SHIFT << BTN_PIN));
+	status = LPSPI_async_submit(&transfer);
 
-	/* Start with LEDs off. */
-	GPIO_HAL_SetPins(LED_GPIO, (BIT_TO_SHIFT << RED_LED_PIN) | (BIT_TO_SHIFT << GREEN_LED_PIN));
+	if(lpspi_async_success == status)
+	{
+		/** Sleeps until the interruption completes the transfer, taking only the SPI bit*/
+		while(lpspi_transfer_done != transfer.state)
+		{
+			xTaskNotifyWait(INIT_VAL, SPI_TRANSFER_NOTIFY_BIT, &notified_value, portMAX_DELAY);
+		}
 
-	/* Install Button interrupt handler */
-    INT_SYS_InstallHandler(BTN_PORT_IRQn, SW3_ISR, (isr_t *)NULL);
-    /* Enable Button interrupt handler */
-    INT_SYS_EnableIRQ(BTN_PORT_IRQn);
+		/** Clears the SPI bit in case it was set after the last wait (It does not block)*/
+		xTaskNotifyWait(SPI_TRANSFER_NOTIFY_BIT, SPI_TRANSFER_NOTIFY_BIT, &notified_value, INIT_VAL);
 
-    /* The interrupt calls an interrupt safe API function - so its priority must
-    be equal to or lower than configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY. */
-    INT_SYS_SetPriority( BTN_PORT_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY );
+		/** The waits consumed the pending state of other notifications, so it is restored*/
+		if(INIT_VAL != (notified_value & ~SPI_TRANSFER_NOTIFY_BIT))
+		{
+			xTaskNotify((TaskHandle_t)transfer.context, INIT_VAL, eNoAction);
+		}
+	}
 
-	/** To here *******************************************************************************/
+	return status;
 }
 
-/** CAN tx thread that transmits either the message of the ADC, or the
- 	 	 	 message set with rtos_can_set_sw_msg.*/
-void rtos_can_tx_thread_EG(void* args)
+/** This function sets the function called when the status of the SBC changes*/
+void rtos_sbc_set_fault_callback(sbc_fault_callback_t callback)
 {
-	/** Initializes the ADC message array*/
-	uint8_t adc_tx_msg[2] = {INIT_VAL};
-	/** Variable to get the event group bits*/
-	EventBits_t tx_event;
+	SBC_service_set_callback(callback);
+}
 
-	/** If the CAN handler has been initialized*/
-	if (IS_INIT == can_handler.init_val)
-	{
-		/** Infinite cycle*/
-		for(;;)
-		{
-			/** Waits for any of the event group bits to be released*/
-			xEventGroupWaitBits(can_handler.event_group, EVENT_GROUP_ADC | EVENT_GROUP_SW, pdFALSE, pdFALSE, portMAX_DELAY);
-			/** Gets the event group bits*/
-			tx_event = xEventGroupGetBits(can_handler.event_group);
-			/** Clears the event group bits*/
-			xEventGroupClearBits(can_handler.event_group, tx_event);
-
-			/** For the ADC event group*/
-			if(EVENT_GROUP_ADC == (tx_event & EVENT_GROUP_ADC))
-			{
-				/** Sets the ADC read in the message array*/
-				adc_tx_msg[ADC_LOW_BYTE_POS] = (uint8_t)(adc_read & LOW_BYTE_MASK);
-				adc_tx_msg[ADC_HIGH_BYTE_POS] = (uint8_t)((adc_read & HIGH_BYTE_MASK) >> BYTE_SHIFT);
+/** This function gets the last status of the SBC*/
+void rtos_sbc_get_status(sbc_status_t* status)
+{
+	SBC_service_get_status(status);
+}
 
-				/** Sets the values for the tx message*/
-				tx_message.base = can_base;
-				tx_message.ID = ADC_TX_ID;
-				tx_message.msg = adc_tx_msg;
-				tx_message.DLC = sizeof(adc_tx_msg);
+/** This function gets the statistics and the duty cycle of the SBC service*/
+void rtos_sbc_get_stats(sbc_service_stats_t* stats)
+{
+	SBC_service_get_stats(stats);
+}
 
-				/** Sends the message protecting the CAN with a mutex*/
-				xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-				CAN_send_message(tx_message);
-				xSemaphoreGive(can_handler.mutex);
-			}
+/** This function gets the answers of the SBC to its initialization*/
+uint8_t rtos_sbc_get_init_answers(uint16_t* answers)
+{
+	/** Variable to go through the answers*/
+	uint8_t index;
 
-			/** For the switch event froup*/
-			if(EVENT_GROUP_SW == (tx_event & EVENT_GROUP_SW))
-			{
-				/** Sets the predefined message to the tx message*/
-				tx_message.base = can_base;
-				tx_message.ID = ID_SW;
-				tx_message.msg = msg_SW;
-				tx_message.DLC = DLC_SW;
+	if(lpspi_transfer_done != sbc_init_transfer.state)
+	{
+		return INIT_VAL;
+	}
 
-				/** Sends the message protecting the CAN with a mutex*/
-				xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-				CAN_send_message(tx_message);
-				xSemaphoreGive(can_handler.mutex);
-			}
-		}
+	for(index = INIT_VAL; sbc_init_transfer.count > index; index ++)
+	{
+		answers[index] = sbc_init_answers[index];
 	}
+
+	return sbc_init_transfer.count;
 }
 
-/** This thread sends a message periodically.*/
-void rtos_can_tx_thread_periodic(void *args)
+/** This function requests a dump of the kernel trace*/
+void rtos_trace_request_dump(void)
 {
-	/** Variable to count the ticks passed since the delay*/
-	TickType_t xLastWakeTime;
+	trace_dump_request = TRACE_DUMP_REQUESTED;
+}
 
-	/** If the CAN handler has been initialized*/
-	if(IS_INIT == can_handler.init_val)
-	{
-		/** Gets the current ticks*/
-		xLastWakeTime = xTaskGetTickCount();
+/** This function writes a value in a frame, low byte first*/
+static void rtos_put_little_endian(uint8_t* msg, uint32_t value, uint8_t size)
+{
+	/** Variable to go through the bytes*/
+	uint8_t index;
 
-		/** Infinite cycle*/
-		for(;;)
-		{
-			/** Sets the predefined tx message*/
-			tx_message.base = message_to_send.base;
-			tx_message.ID = message_to_send.ID;
-			tx_message.msg = message_to_send.msg;
-			tx_message.DLC = message_to_send.DLC;
-
-			/** Sends the message protecting the CAN with a mutex*/
-			xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-			CAN_send_message(tx_message);
-			xSemaphoreGive(can_handler.mutex);
-
-			/** Delay to make the function periodical*/
-			vTaskDelayUntil(&xLastWakeTime, (tx_task_period * FIX_PERIOD));
-		}
+	for(index = INIT_VAL; size > index; index ++)
+	{
+		msg[index] = (uint8_t)(value & LOW_BYTE_MASK);
+		value >>= BYTE_SHIFT;
 	}
 }
 
-#if(!RX_MODE)
-/** This thread receives a message using interruption.*/
-void rtos_can_rx_thread_interruption(void *args)
+/** This function queues a frame, waiting while the Tx queue is full*/
+static void rtos_can_transmit_wait(can_message_tx_config_t can_message_tx)
 {
-	/** Variable for the received ADC value*/
-	uint16_t received_ADC_val = INIT_VAL;
-	/** Counter for the ID function vector*/
-	uint8_t ID_counter = INIT_VAL;
+	while(tx_queue_full == rtos_can_transmit(can_message_tx))
+	{
+		vTaskDelay(TRACE_DUMP_RETRY_TICKS);
+	}
+}
 
-	/** If the CAN handler has been initialized*/
-	if(IS_INIT == can_handler.init_val)
+/** This function sends the records of the kernel trace, from the oldest one*/
+static void rtos_trace_dump(CAN_Type* base)
+{
+	/** Records in the ring*/
+	uint16_t count;
+	/** Variable to go through the records*/
+	uint16_t index;
+	/** Record being sent*/
+	trace_record_t record;
+	/** Data of the frame*/
+	uint8_t msg[CAN_MESSAGE_MAX_SIZE];
+	/** Frame of the dump*/
+	can_message_tx_config_t dump_msg;
+
+	/** The ring is frozen while it is sent (The dump would fill it with its own events)*/
+	trace_recorder_stop();
+	count = trace_recorder_get_count();
+
+	dump_msg.base = base;
+	dump_msg.msg = msg;
+	dump_msg.DLC = sizeof(msg);
+
+	/** Sends the header, the decoder needs the clock to convert the cycles*/
+	dump_msg.ID = TRACE_DUMP_HEADER_ID;
+	rtos_put_little_endian(&msg[TRACE_DUMP_COUNT_POS], count, HALF_WORD_SIZE);
+	rtos_put_little_endian(&msg[TRACE_DUMP_CLOCK_POS], timebase_get_core_clock(), WORD_SIZE);
+	rtos_put_little_endian(&msg[TRACE_DUMP_TICK_RATE_POS], configTICK_RATE_HZ, HALF_WORD_SIZE);
+	rtos_can_transmit_wait(dump_msg);
+
+	/** Sends one record per frame*/
+	dump_msg.ID = TRACE_DUMP_RECORD_ID;
+	for(index = INIT_VAL; count > index; index ++)
 	{
-		/** Infinite cycle*/
-		for(;;)
-		{
-			/** Takes the interruption semaphore*/
-			xSemaphoreTake(can_handler.sem_rx_binary, portMAX_DELAY);
+		trace_recorder_read(index, &record);
+		rtos_put_little_endian(&msg[TRACE_DUMP_TIMESTAMP_POS], record.timestamp, WORD_SIZE);
+		msg[TRACE_DUMP_EVENT_POS] = record.event;
+		msg[TRACE_DUMP_TASK_POS] = record.task;
+		rtos_put_little_endian(&msg[TRACE_DUMP_OBJECT_POS], record.object, HALF_WORD_SIZE);
+		rtos_can_transmit_wait(dump_msg);
+	}
 
-			/** Sets the base*/
-			rx_message.base = can_base;
+	/** Records again from an empty ring*/
+	trace_recorder_start();
+}
 
-			/** Receives a message protecting CAN*/
-			xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-			CAN_receive_message(&rx_message);
-			xSemaphoreGive(can_handler.mutex);
+/** This thread reports the CPU load and the stack high water mark of each task, the stack overflows, and sends the trace dumps*/
+void rtos_runtime_report_thread(void *args)
+{
+	/** Variable to count the ticks passed since the delay*/
+	TickType_t xLastWakeTime;
+	/** Load of each task (Static, so it is not in the small stack of the task)*/
+	static runtime_task_load_t loads[RUNTIME_STATS_MAX_TASKS];
+	/** Number of tasks collected*/
+	uint8_t tasks;
+	/** Variable to go through the tasks*/
+	uint8_t index;
+	/** Variable to go through the name*/
+	uint8_t character;
+	/** Data of the frame*/
+	uint8_t msg[CAN_MESSAGE_MAX_SIZE];
+	/** Frame of the report*/
+	can_message_tx_config_t report_msg;
+	/** Name of the task whose stack overflowed before the reset*/
+	char overflow_name[STACK_MONITOR_NAME_SIZE];
+
+	/** If the board has been initialized*/
+	if(IS_INIT == board_init_val)
+	{
+		report_msg.base = (CAN_Type*)args;
+		report_msg.msg = msg;
+		report_msg.DLC = sizeof(msg);
 
-			/** Checks the received IDs*/
-			switch(rx_message.ID)
+		/** Reports once the task that caused the reset (The frame has the first 8 characters of its name)*/
+		if(stack_monitor_overflow == stack_monitor_get_overflow(overflow_name))
+		{
+			report_msg.ID = STACK_OVERFLOW_REPORT_ID;
+			for(character = INIT_VAL; CAN_MESSAGE_MAX_SIZE > character; character ++)
 			{
-				/** Specific case for the ADC ID*/
-				case ADC_RX_ID:
-					/** Sets the value received into one variable*/
-					received_ADC_val = (uint16_t)(rx_message.msg[ADC_LOW_BYTE_POS]);
-					received_ADC_val |= (uint16_t)(rx_message.msg[ADC_HIGH_BYTE_POS] << BYTE_SHIFT);
-
-					/** Turns on the LED according to the received ADC value*/
-					rtos_turn_on_leds(received_ADC_val);
-				break;
-
-				/** For any other ID*/
-				default:
-					/** Checks the ID function vector (Only the initialized IDs)*/
-					for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
-					{
-						/** If the received ID exists in the ID function vector*/
-						if(rx_message.ID == ID_function[ID_counter].ID)
-						{
-							/** Calls the corresponding function*/
-							ID_function[ID_counter].ID_func(rx_message);
-						}
-					}
-				break;
+				msg[character] = (uint8_t)overflow_name[character];
 			}
+			rtos_can_transmit(report_msg);
 		}
-	}
-}
-#endif
 
-#if(RX_MODE)
-/** This thread receives a message, by checking the RX flag
- 	 periodically (Polling). The default period is 100ms.*/
-void rtos_can_rx_thread_periodic(void *args)
-{
-	/** Counter for the ID vector*/
-	uint8_t ID_counter = INIT_VAL;
-	/** Variable for the received ADC*/
-	uint16_t received_ADC_val = INIT_VAL;
-	/** Variable to count the ticks passed since the delay*/
-	TickType_t xLastWakeTime;
+		report_msg.ID = RUNTIME_REPORT_ID;
 
-	/** If the CAN handler has been initialized*/
-	if(IS_INIT == can_handler.init_val)
-	{
-		/** Gets the current tick count*/
+		/** The first collection only sets the start of the window*/
+		runtime_stats_collect(loads, RUNTIME_STATS_MAX_TASKS);
+
+		/** Gets the current ticks count*/
 		xLastWakeTime = xTaskGetTickCount();
 
 		/** Infinite cycle*/
 		for(;;)
 		{
-			/** Queries the status of the Rx interruption*/
-			if(CAN_get_rx_status(can_base))
-			{
-				/** Gets the configured bas*/
-				rx_message.base = can_base;
-
-				/** Receives the message protecting the CAN first*/
-				xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-				CAN_receive_message(&rx_message);
-				xSemaphoreGive(can_handler.mutex);
+			/** Delay to make the task periodically*/
+			vTaskDelayUntil(&xLastWakeTime, timebase_ms_to_ticks(RUNTIME_REPORT_PERIOD));
 
-				/** Clears the interruption flags*/
-				CAN_clear_tx_and_rx_flags(rx_message.base);
+			tasks = runtime_stats_collect(loads, RUNTIME_STATS_MAX_TASKS);
 
-				/** Checks the received ID*/
-				switch(rx_message.ID)
+			for(index = INIT_VAL; tasks > index; index ++)
+			{
+				msg[RUNTIME_REPORT_NUMBER_POS] = loads[index].number;
+				msg[RUNTIME_REPORT_LOAD_POS] = loads[index].load;
+				msg[RUNTIME_REPORT_STACK_LOW_POS] = (uint8_t)(loads[index].stack_free & LOW_BYTE_MASK);
+				msg[RUNTIME_REPORT_STACK_HIGH_POS] = (uint8_t)((loads[index].stack_free & HIGH_BYTE_MASK) >> BYTE_SHIFT);
+				msg[RUNTIME_REPORT_PRIO_POS] = loads[index].priority;
+
+				/** Copies the name, filling with 0 after its end*/
+				for(character = INIT_VAL; RUNTIME_REPORT_NAME_SIZE > character; character ++)
 				{
-					/** For the ADC ID*/
-					case ADC_RX_ID:
-						/** Concatenates the ADC received into a variable*/
-						received_ADC_val = (uint16_t)(rx_message.msg[ADC_LOW_BYTE_POS]);
-						received_ADC_val |= (uint16_t)(rx_message.msg[ADC_HIGH_BYTE_POS] << BYTE_SHIFT);
-
-						/** Turns the LED on according to the ADC received*/
-						rtos_turn_on_leds(received_ADC_val);
-					break;
-
-					/** For any other ID*/
-					default:
-						/** Checks the ID function vector*/
-						for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
-						{
-							/** If the ID received exists in the function vector*/
-							if(rx_message.ID == ID_function[ID_counter].ID)
-							{
-								/** Calls the corresponding function*/
-								ID_function[ID_counter].ID_func(rx_message);
-							}
-						}
-					break;
+					msg[RUNTIME_REPORT_NAME_POS + character] = ((character > INIT_VAL) && (INIT_VAL == msg[RUNTIME_REPORT_NAME_POS + character - 1])) ?
+						INIT_VAL : (uint8_t)loads[index].name[character];
 				}
+
+				/** Queues the frame (The data is copied)*/
+				rtos_can_transmit(report_msg);
 			}
 
-			/** Delay to make the function periodic*/
-			vTaskDelayUntil(&xLastWakeTime, (rx_task_period * FIX_PERIOD));
+			/** Sends the kernel trace after the report, which names the tasks of the records*/
+			if(TRACE_DUMP_REQUESTED == trace_dump_request)
+			{
+				trace_dump_request = TRACE_DUMP_IDLE;
+				rtos_trace_dump(report_msg.base);
+			}
 		}
 	}
 }
-#endif
 
-/** This function sets the message to be sent when a SW3 interruption occurrs*/
-void rtos_can_set_sw_msg(can_message_tx_config_t can_message_tx)
+/** This function changes when the potentiometer samples are sent*/
+void rtos_adc_set_tx_policy(can_tx_policy_mode_t mode, uint16_t deadband, uint32_t min_gap_ms, uint32_t max_age_ms)
 {
-	/** Counter to copy the vector*/
-	uint8_t counter = INIT_VAL;
+	/** New configuration of the Tx policy*/
+	can_tx_policy_config_t config;
+
+	config.mode = mode;
+	config.deadband = deadband;
+	config.min_gap = timebase_ms_to_ticks(min_gap_ms);
+	config.max_age = timebase_ms_to_ticks(max_age_ms);
+
+	/** The ADC job can be using the Tx policy (The last sent value is kept)*/
+	taskENTER_CRITICAL();
+	CAN_tx_policy_set_config(&adc_tx_policy, &config);
+	taskEXIT_CRITICAL();
+}
 
-	for(counter = INIT_VAL ; counter < can_message_tx.DLC ; counter ++)
-	{
-		/** Copies each value of the message to the tx message*/
-		msg_SW[counter] = (*can_message_tx.msg);
-		can_message_tx.msg ++;
-	}
+/** This function changes the hardware averaging of the potentiometer ADC*/
+void rtos_adc_set_hw_average(adc_hw_average_t average)
+{
+	ADC_pipeline_set_hw_average(ADC0, average);
+}
 
-	/** Sets the ID and the DLC to the tx message*/
-	ID_SW = can_message_tx.ID;
-	DLC_SW = can_message_tx.DLC;
+/** This function gets the statistics of a source of the Tx thread*/
+void rtos_get_tx_event_stats(tx_event_source_t source, tx_event_stats_t* stats)
+{
+	/** The SW3 statistics are updated from its interruption*/
+	taskENTER_CRITICAL();
+	*stats = tx_event_source[source].stats;
+	taskEXIT_CRITICAL();
 }
 
-/** This function receives from CAN protecting it with mutex*/
-void rtos_can_receive(can_message_rx_config_t *can_message_tx)
+/** This function passes a raw sample through the pipeline, and queues the outputs for the Tx task*/
+static void rtos_adc_process_sample(uint16_t raw)
 {
-	/** Takes the mutex*/
-	xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-	/** Receives the message*/
-	CAN_receive_message(can_message_tx);
-	/** Releases the mutex*/
-	xSemaphoreGive(can_handler.mutex);
+	/** Output of the pipeline, in mV*/
+	uint16_t output;
+	/** Indicates if the decimation produced an output*/
+	uint8_t has_output;
+
+	/** Indicates if the Tx policy sends the output*/
+	uint8_t send = INIT_VAL;
+
+	/** The pipeline and the Tx policy can be changed by another task*/
+	taskENTER_CRITICAL();
+	has_output = ADC_pipeline_process(&adc_pot_pipeline, raw, &output);
+	if(INIT_VAL != has_output)
+	{
+		send = CAN_tx_policy_check(&adc_tx_policy, output, xTaskGetTickCount());
+		if(INIT_VAL == send)
+		{
+			tx_event_source[tx_event_adc].stats.suppressed ++;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/** Only the outputs taken by the Tx policy wake the Tx task*/
+	if(INIT_VAL != send)
+	{
+		rtos_tx_event_post(tx_event_adc, output);
+	}
 }
 
-/** This function transmits from CAN protecting it with mutex*/
-void rtos_can_transmit(can_message_tx_config_t can_message_tx)
+/** This function reads the ADC once, and queues the sample for the Tx task*/
+static void rtos_adc_read_job(void)
 {
-	/** Takes the mutex*/
-	xSemaphoreTake(can_handler.mutex, portMAX_DELAY);
-	/** Sends the message*/
-	CAN_send_message(can_message_tx);
-	/** Releases the mutex*/
-	xSemaphoreGive(can_handler.mutex);
+#if(ADC_INTERRUPT == ADC_MODE)
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
+	/** Starts the conversion and sleeps until the interruption stores the sample*/
+	convertAdcChan_interrupt(ADC_POT_CHANNEL);
+	ulTaskNotifyTake(pdTRUE, ADC_CONVERSION_TIMEOUT);
+#endif
+
+	/** Queues the samples stored by the interruption and notifies the Tx task*/
+	while(adc_buffer_tail != adc_buffer_head)
+	{
+		rtos_adc_process_sample(adc_buffer[adc_buffer_tail & ADC_BUFFER_MASK]);
+		adc_buffer_tail ++;
+	}
+
+#if(PERIODIC_JOB_TIMER == PERIODIC_JOB_MODE)
+	/** The timer can not wait, the sample of this conversion is queued in the next period*/
+	convertAdcChan_interrupt(ADC_POT_CHANNEL);
+#endif
+#else
+	/** Converts the ADC value from the potentiometer channel*/
+	convertAdcChan(ADC_POT_CHANNEL);
+
+	/** Waits for the ADC to finish the conversion*/
+	while(0 == adc_complete());
+	/** Filters and scales the sample, then queues it for the Tx task*/
+	rtos_adc_process_sample(read_adc_raw());
+#endif
 }
 
-/** This function reads periodically the ADC*/
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
 void rtos_adc_read_thread(void *args)
 {
 	/** Variable to count the ticks passed since the delay*/
 	TickType_t xLastWakeTime;
 
-	/** If the handler has been initialized*/
-	if(IS_INIT == can_handler.init_val)
+	/** If the board has been initialized*/
+	if(IS_INIT == board_init_val)
 	{
+#if(ADC_INTERRUPT == ADC_MODE)
+		/** Registers the task to be woken by the ADC interruption*/
+		adc_task = xTaskGetCurrentTaskHandle();
+#endif
+
 		/** Gets the current ticks count*/
 		xLastWakeTime = xTaskGetTickCount();
 
 		/** Infinite cycle*/
 		for(;;)
 		{
-			/** Converts the ADC value from the potentiometer channel*/
-			convertAdcChan(ADC_POT_CHANNEL);
-
-			/** Waits for the ADC to finish the conversion*/
-			while(0 == adc_complete());
 			/** Reads the ADC*/
-			adc_read = read_adc_chx();
-
-			/** Releases the event group*/
-			xEventGroupSetBits(can_handler.event_group, EVENT_GROUP_ADC);
+			rtos_adc_read_job();
 
 			/** Delay to make the task periodically*/
-			vTaskDelayUntil(&xLastWakeTime, (adc_tx_task_period * FIX_PERIOD));
+			vTaskDelayUntil(&xLastWakeTime, adc_tx_task_period);
 		}
 	}
 }
+#else
+/** Timer callback that reads the ADC*/
+static void rtos_adc_read_timer_callback(TimerHandle_t timer)
+{
+	rtos_adc_read_job();
+}
+
+/** This function starts the timers of the ADC reading and the periodic Tx schedule*/
+void rtos_periodic_timers_start(void)
+{
+	/** If the board has been initialized, and the timers were not created before*/
+	if((IS_INIT == board_init_val) && (NULL == adc_read_timer))
+	{
+		adc_read_timer = xTimerCreate("ADC", adc_tx_task_period, pdTRUE, NULL, rtos_adc_read_timer_callback);
+		xTimerStart(adc_read_timer, INIT_VAL);
+
+		/** One-shot timer, it is restarted for the next message that is due*/
+		tx_schedule_timer = xTimerCreate("TX_periodic", PERIODIC_JOB_MIN_TICKS, pdFALSE, NULL, rtos_tx_schedule_timer_callback);
+		xTimerStart(tx_schedule_timer, INIT_VAL);
+	}
+}
+#endif
 
 /** This function turns on the LEDs according to the ADC value received from CAN*/
 void rtos_turn_on_leds(uint16_t adc_received)
@@ -631,19 +1875,51 @@ void rtos_turn_on_leds(uint16_t adc_received)
 /** This function sets the period for the RX thread*/
 void set_rx_thread_period(uint32_t new_value)
 {
-	rx_task_period = new_value;
+#if((RX_PERIODIC == RX_MODE) && (PERIODIC_JOB_TIMER == PERIODIC_JOB_MODE))
+	/** Variable to go through the handlers*/
+	uint8_t index;
+#endif
+
+	/** Converts the period to ticks once, not in every cycle of the thread*/
+	rx_task_period = timebase_ms_to_ticks(new_value);
+
+#if((RX_PERIODIC == RX_MODE) && (PERIODIC_JOB_TIMER == PERIODIC_JOB_MODE))
+	/** Changes the period of the running Rx timers*/
+	for(index = INIT_VAL; RTOS_CAN_INSTANCES > index; index ++)
+	{
+		if(NULL != can_handler[index].rx_timer)
+		{
+			xTimerChangePeriod(can_handler[index].rx_timer, rx_task_period, INIT_VAL);
+		}
+	}
+#endif
 }
 
 /** This function sets the period for the TX thread*/
 void set_tx_thread_period(uint32_t new_value)
 {
 	tx_task_period = new_value;
+
+	/** Changes the period of the message set with rtos_define_tx_periodic_msg*/
+	if(CAN_TX_SCHEDULE_NO_SLOT != message_to_send_slot)
+	{
+		rtos_set_tx_periodic_msg_period(message_to_send_slot, tx_task_period);
+	}
 }
 
 /** This function sets the period for the ADC thread*/
 void set_adc_tx_thread_period(uint32_t new_value)
 {
-	adc_tx_task_period = new_value;
+	/** Converts the period to ticks once, not in every cycle of the thread*/
+	adc_tx_task_period = timebase_ms_to_ticks(new_value);
+
+#if(PERIODIC_JOB_TIMER == PERIODIC_JOB_MODE)
+	/** Changes the period of the running ADC timer*/
+	if(NULL != adc_read_timer)
+	{
+		xTimerChangePeriod(adc_read_timer, adc_tx_task_period, INIT_VAL);
+	}
+#endif
 }
 
 /** This function turns on the red LED, turning off other LEDs*/
@@ -687,27 +1963,18 @@ void turn_off_LEDS()
 }
 
 /** This function adds an ID and a function to the ID function vector*/
-ID_func_vector_state_t rtos_add_ID_function(ID_function_t ID_func)
+ID_func_vector_state_t rtos_add_ID_function(CAN_Type* base, ID_function_t ID_func)
 {
+	/** Handler of the CAN*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler(base);
 	/** Sets the return value as successful*/
 	ID_func_vector_state_t retval = ID_func_vector_success;
-	/** Counter for the ID vector*/
-	uint8_t ID_counter = INIT_VAL;
-	/** Variable to check whether the ID already exists in the vector or not*/
-	uint8_t ID_repeated = ID_NOT_REPEATED;
-
-	/** If the ID function vector is full*/
-	if(15 <= ID_func_counter)
-	{
-		/** Sets the return value to full*/
-		retval = ID_func_vector_full;
-	}
 
 	/** If the ID is outside of the limits
 	 	 The limits used were the following
 	 	 	 ADC_RX_ID as the highest priority, for the lower limit
 	 	 	 11-bit value for the upper limit*/
-	else if(ADC_RX_ID >= ID_func.ID || MAX_ID < ID_func.ID)
+	if(ADC_RX_ID >= ID_func.ID || MAX_ID < ID_func.ID)
 	{
 		/** Sets the ID as not allowed*/
 		retval = ID_not_allowed;
@@ -716,33 +1983,18 @@ ID_func_vector_state_t rtos_add_ID_function(ID_function_t ID_func)
 	/** The vector can receive the ID*/
 	else
 	{
-		/** Checks the existing IDs*/
-		for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
-		{
-			/** If an ID already exists*/
-			if(ID_func.ID == ID_function[ID_counter].ID)
-			{
-				/** Sets the ID as repeated*/
-				ID_repeated = ID_REPEATED;
-			}
-		}
+		/** The Rx thread reads the vector, and another task can add the same ID between the checks and the write*/
+		taskENTER_CRITICAL();
 
-		/** If the ID is not repeated*/
-		if(ID_NOT_REPEATED == ID_repeated)
-		{
-			/** Saves the ID and the function in the vector*/
-			ID_function[ID_func_counter].ID = ID_func.ID;
-			ID_function[ID_func_counter].ID_func = ID_func.ID_func;
+		/** Saves the ID and the function at the end of the vector, if it is new and the vector is not full*/
+		retval = CAN_ID_table_add(&handler->ID_table, ID_func);
 
-			/** Incremetns the size of the vector*/
-			ID_func_counter ++;
-		}
+		taskEXIT_CRITICAL();
 
-		/** If the ID is repeated*/
-		else
+		/** Receives the new ID*/
+		if(ID_func_vector_success == retval)
 		{
-			/** Sets the return value as existing ID*/
-			retval = ID_already_exist;
+			rtos_can_refresh_rx_filters(handler);
 		}
 	}
 
@@ -750,72 +2002,37 @@ ID_func_vector_state_t rtos_add_ID_function(ID_function_t ID_func)
 }
 
 /** This function removes an ID from the ID function vector*/
-ID_func_vector_state_t rtos_remove_ID_function(ID_function_t ID_func)
+ID_func_vector_state_t rtos_remove_ID_function(CAN_Type* base, ID_function_t ID_func)
 {
+	/** Handler of the CAN*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler(base);
 	/** Sets the return value as successful*/
 	ID_func_vector_state_t retval = ID_func_vector_success;
-	/** Counter for the ID vector*/
-	uint8_t ID_counter = INIT_VAL;
-	/** Variable to set which ID to erase*/
-	uint8_t ID_to_erase = ID_VECTOR_OVER_SIZE;
-
-	/** If the vector is empty*/
-	if(INIT_VAL >= ID_func_counter)
-	{
-		/** Sets the return value as empty*/
-		retval = ID_func_vector_empty;
-	}
 
 	/** If the ID is outside of the limits
 	 	 The limits used were the following
 	 	 	 ADC_RX_ID as the highest priority, for the lower limit
 	 	 	 11-bit value for the upper limit*/
-	else if(ADC_RX_ID >= ID_func.ID || MAX_ID < ID_func.ID)
+	if(ADC_RX_ID >= ID_func.ID || MAX_ID < ID_func.ID)
 	{
 		retval = ID_not_allowed;
 	}
 
-	/** If the vector can receive the ID*/
+	/** Otherwise*/
 	else
 	{
-		/** Checks the IDs in the vector*/
-		for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
-		{
-			/** IF the ID exists*/
-			if(ID_func.ID == ID_function[ID_counter].ID)
-			{
-				/** Sets ID to erase index*/
-				ID_to_erase = ID_counter;
-			}
-		}
+		/** The Rx thread reads the vector, and another task can remove the same ID between the checks and the write*/
+		taskENTER_CRITICAL();
 
-		/** If the ID to erase didn't change*/
-		if(ID_VECTOR_OVER_SIZE == ID_to_erase)
-		{
-			/** Sets the ID as non-existing*/
-			retval = ID_does_not_exist;
-		}
-
-		/** Otherwise*/
-		else
-		{
-			/** Erases the ID*/
-			ID_function[ID_to_erase].ID = INIT_VAL;
-			ID_function[ID_to_erase].ID_func = NULL;
+		/** Erases the ID, the last ID of the vector takes its position*/
+		retval = CAN_ID_table_remove(&handler->ID_table, ID_func.ID);
 
-			/** Moves all the IDs from the erased one, one position in the vector forward*/
-			for(ID_counter = ID_to_erase ; ID_counter < (ID_func_counter - ARRAY_POS_OFFSET_1) ; ID_counter ++)
-			{
-				ID_function[ID_counter].ID = ID_function[ID_counter + ARRAY_POS_OFFSET_1].ID;
-				ID_function[ID_counter].ID_func = ID_function[ID_counter + ARRAY_POS_OFFSET_1].ID_func;
-			}
+		taskEXIT_CRITICAL();
 
-			/** Deletes the repeated ID and function*/
-			ID_function[ID_counter].ID = INIT_VAL;
-			ID_function[ID_counter].ID_func = NULL;
-
-			/** Decreases the vector size*/
-			ID_func_counter --;
+		/** Stops receiving the erased ID*/
+		if(ID_func_vector_success == retval)
+		{
+			rtos_can_refresh_rx_filters(handler);
 		}
 	}
 
@@ -823,48 +2040,45 @@ ID_func_vector_state_t rtos_remove_ID_function(ID_function_t ID_func)
 }
 
 /** This function changes and ID and a function in the ID vector function*/
-ID_func_vector_state_t rtos_change_ID_function(ID_function_t ID_func_old, ID_function_t ID_func_new)
+ID_func_vector_state_t rtos_change_ID_function(CAN_Type* base, ID_function_t ID_func_old, ID_function_t ID_func_new)
 {
+	/** Handler of the CAN*/
+	RTOS_CAN_Handler_t* handler = rtos_can_get_handler(base);
 	/** Sets the return value as success*/
 	ID_func_vector_state_t retval = ID_func_vector_success;
-	/** Counter for the ID function vector*/
-	uint8_t ID_counter = INIT_VAL;
-	/** Variable to set whether the ID was found or not*/
-	uint8_t ID_found = ID_NOT_FOUND;
 
 	/** If the new ID is outside of the limits
 	 	 The limits used were the following
 	 	 	 ADC_RX_ID as the highest priority, for the lower limit
 	 	 	 11-bit value for the upper limit*/
-	if(ID_func_new.ID || MAX_ID < ID_func_new.ID)
+	if(ADC_RX_ID >= ID_func_new.ID || MAX_ID < ID_func_new.ID)
 	{
 		/** Sets the return value as ID not allowed*/
 		retval = ID_not_allowed;
 	}
 
-	/** If the vector can receive the ID*/
+	/** If the target ID is outside of the limits, it can't be in the vector*/
+	else if(MAX_ID < ID_func_old.ID)
+	{
+		/** Sets the return value as non-existing ID*/
+		retval = ID_does_not_exist;
+	}
+
+	/** If the IDs are allowed*/
 	else
 	{
-		/** Checks every ID in the vector*/
-		for(ID_counter = INIT_VAL ; ID_counter < ID_func_counter ; ID_counter ++)
-		{
-			/** If the target ID is found in the vector*/
-			if(ID_func_old.ID == ID_function[ID_counter].ID)
-			{
-				/** Changes the ID and the function*/
-				ID_function[ID_counter].ID = ID_func_new.ID;
-				ID_function[ID_counter].ID_func = ID_func_new.ID_func;
+		/** The Rx thread reads the vector, and another task can change the same IDs between the checks and the write*/
+		taskENTER_CRITICAL();
 
-				/** Sets the ID as found*/
-				ID_found = ID_FOUND;
-			}
-		}
+		/** Changes the ID and the function, if the new ID doesn't belong to another callback*/
+		retval = CAN_ID_table_change(&handler->ID_table, ID_func_old.ID, ID_func_new);
+
+		taskEXIT_CRITICAL();
 
-		/** If the ID was not found*/
-		if(ID_NOT_FOUND == ID_found)
+		/** Receives the new ID instead of the old one*/
+		if(ID_func_vector_success == retval)
 		{
-			/** Sets the return value as non-existing ID*/
-			retval = ID_does_not_exist;
+			rtos_can_refresh_rx_filters(handler);
 		}
 	}
 
@@ -872,9 +2086,9 @@ ID_func_vector_state_t rtos_change_ID_function(ID_function_t ID_func_old, ID_fun
 }
 
 /** This function returns the ID function vector size*/
-uint8_t rtos_get_ID_function_vector_size(void)
+uint8_t rtos_get_ID_function_vector_size(CAN_Type* base)
 {
-	return ID_func_counter;
+	return rtos_can_get_handler(base)->ID_table.ID_func_counter;
 }
 
 /** This function sets the LED thresholds*/
@@ -910,4 +2124,16 @@ void rtos_define_tx_periodic_msg(can_message_tx_config_t can_message_tx)
 	message_to_send.ID = can_message_tx.ID;
 	message_to_send.msg = can_message_tx.msg;
 	message_to_send.DLC = can_message_tx.DLC;
+
+	/** Adds the message to the periodic Tx schedule, or replaces the one set before*/
+	if(CAN_TX_SCHEDULE_NO_SLOT == message_to_send_slot)
+	{
+		message_to_send_slot = rtos_add_tx_periodic_msg(message_to_send, tx_task_period);
+	}
+	else
+	{
+		vTaskSuspendAll();
+		CAN_tx_schedule_set_message(&tx_schedule, message_to_send_slot, message_to_send);
+		xTaskResumeAll();
+	}
 }
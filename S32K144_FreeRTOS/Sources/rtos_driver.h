@@ -34,47 +34,126 @@
 /* RTOS includes. */
 #include "projdefs.h"
 #include "can_driver.h"
+#include "can_tx_queue.h"
+#include "can_rx_ring.h"
+#include "can_tx_schedule.h"
+#include "can_tx_policy.h"
+#include "can_id_table.h"
 #include "semphr.h"
-#include "event_groups.h"
 
 /* Drivers include. */
 #include "transceiver.h"
 #include "clocks_and_modes.h"
-
-/** Defines the RX thread to work by semaphores (Aperiodically)*/
+#include "timebase.h"
+#include "tickless.h"
+#include "adc_scan.h"
+#include "adc_pipeline.h"
+#include "adc_calibration.h"
+#include "lpspi_async.h"
+#include "sbc_service.h"
+#include "runtime_stats.h"
+#include "stack_monitor.h"
+
+/** Defines the RX thread to work by task notifications (Aperiodically)*/
 #define RX_INTERRUPT						(0)
 /** Defines the RX thread to work periodically*/
 #define RX_PERIODIC							(1)
+/** Defines the RX thread to work with the Rx FIFO (Aperiodically, in batches)*/
+#define RX_FIFO								(2)
 
-/** Sets the mode of the RX thread*/
+/** Sets the mode of the RX thread (It can be given by the build, as the host simulator does)*/
+#ifndef RX_MODE
 #define RX_MODE								RX_INTERRUPT
+#endif
+
+/** Defines the periodic jobs (ADC reading, periodic Tx and periodic Rx) to run as tasks*/
+#define PERIODIC_JOB_TASK					(0)
+/** Defines the periodic jobs to run as software timers, in the timer task (No stack for each job)*/
+#define PERIODIC_JOB_TIMER					(1)
+
+/** Sets the mode of the periodic jobs*/
+#define PERIODIC_JOB_MODE					PERIODIC_JOB_TASK
+
+/** Defines the ADC to be read by polling its conversion complete flag*/
+#define ADC_POLLING							(0)
+/** Defines the ADC to be read with its conversion complete interruption (The CPU is free
+ 	 during the conversion)*/
+#define ADC_INTERRUPT						(1)
+
+/** Sets the mode of the ADC reading (It can be given by the build, as the host simulator does)*/
+#ifndef ADC_MODE
+#define ADC_MODE							ADC_POLLING
+#endif
+
+/** Defines the number of complete scans that can wait for the consumer*/
+#define ADC_SCAN_QUEUE_LENGTH				(3)
+
+/** Defines the number of CANs used with rtos_can_init, from CAN0 (Up to 3, each one
+ 	 keeps a handler with an index of the 2048 IDs and has its own RX thread, so the heap
+ 	 pools must take their TCBs and stacks. It can be given by the build)*/
+#ifndef RTOS_CAN_INSTANCES
+#define RTOS_CAN_INSTANCES					(1)
+#endif
 
 /*!
- 	 \brief Enumerator to define the states of the ID function vector.
+ 	 \brief Enumerator to define the sources of the Tx thread (rtos_can_tx_thread_EG).
  */
 typedef enum
 {
-	ID_func_vector_success,	/*!< ID vector configuration successful*/
-	ID_func_vector_full,	/*!< ID vector is full*/
-	ID_func_vector_empty,	/*!< ID vector is empty*/
-	ID_not_allowed,			/*!< ID not allowed to be set*/
-	ID_does_not_exist,		/*!< ID does not exists in the ID vector*/
-	ID_already_exist		/*!< ID already exists in the ID vector*/
-}ID_func_vector_state_t;
+	tx_event_adc,			/*!< ADC samples, read by rtos_adc_read_thread*/
+	tx_event_sw,			/*!< SW3 presses*/
+	tx_event_source_count	/*!< Number of Tx sources*/
+}tx_event_source_t;
+
+/*!
+ 	 \brief Enumerator to define the coalescing policy of a Tx source.
+ */
+typedef enum
+{
+	tx_event_fifo,			/*!< Every request is sent in order, requests are dropped when the queue is full*/
+	tx_event_latest			/*!< Only the latest request is kept, older pending requests are coalesced*/
+}tx_event_policy_t;
+
+/*!
+ 	 \brief Statistics of a Tx source.
+ */
+typedef struct
+{
+	uint32_t posted;		/*!< Requests accepted by the source queue*/
+	uint32_t sent;			/*!< Requests taken by the Tx thread*/
+	uint32_t dropped;		/*!< Requests lost because the source queue was full (FIFO policy)*/
+	uint32_t coalesced;		/*!< Pending requests replaced by a newer one (Latest-wins policy)*/
+	uint32_t suppressed;	/*!< Values not posted by the Tx policy (ADC source, see rtos_adc_set_tx_policy)*/
+}tx_event_stats_t;
+
+/*!
+ 	 \brief Statistics of the ADC scan.
+ */
+typedef struct
+{
+	uint32_t frames;		/*!< Scans completed*/
+	uint32_t dropped;		/*!< Scans lost because the consumer did not take the previous ones*/
+}adc_scan_stats_t;
 
 /*!
- 	 \brief Structure to define the ID vector.
+ 	 \brief Statistics of the Rx message buffers (RX_INTERRUPT mode).
  */
 typedef struct
 {
-	uint16_t ID;												/*!< ID to be stored*/
-	void (*ID_func)(can_message_rx_config_t can_message_rx);	/*!< Pointer to the function to be executed*/
-}ID_function_t;
+	uint32_t notified;		/*!< Messages notified by the MB interruption*/
+	uint32_t received;		/*!< Messages read from the Rx MBs (By the Rx thread or rtos_can_receive)*/
+	uint32_t overwritten;	/*!< Notified messages that were never read, a newer message overwrote them in their Rx MB*/
+}can_rx_mb_stats_t;
 
 /*!
  	 \brief This function initializes the handlers and drivers necessary to run
  	 	 	 CAN in FreeRTOS.
 
+ 	 \note Call it once for each CAN to be used (CAN0, CAN1 and CAN2 can work at the
+ 	 	 	 same time). Each CAN has its own mutex, interruption, Tx queue and ID
+ 	 	 	 function vector. The clocks, the ADC, the SBC, the LEDs and the SW3 are
+ 	 	 	 initialized with the first CAN.
+
  	 \param[in] can_init Configuration for the CAN driver.
 
  	 \return void.
@@ -86,30 +165,39 @@ void rtos_can_init(can_init_config_t can_init);
  	 	 	 message set with rtos_can_set_sw_msg.
 
  	 \note The ADC message is sent periodically, and the SW message is sent
- 	 	 	 when SW3 is pressed.
+ 	 	 	 when SW3 is pressed. Each source queues its requests, and notifies
+ 	 	 	 this task with a notification bit (See rtos_get_tx_event_stats).
 
  	 \note The ADC message period can be set with set_adc_tx_thread_period.
 
- 	 \param[in] args Thread arguments. Set to NULL.
+ 	 \param[in] args CAN that sends the ADC message (CAN0, CAN1 or CAN2).
 
  	 \return void.
  */
 void rtos_can_tx_thread_EG(void* args);
 
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
 /*!
- 	 \brief This thread sends a message periodically.
+ 	 \brief This thread sends the messages of the periodic Tx schedule. Each
+ 	 	 	 message has its own period, and their offsets are staggered so
+ 	 	 	 that, whenever possible, no two messages are due in the same tick.
 
- 	 \note The message sent by this thread is set with rtos_define_tx_periodic_msg.
- 	 	 	 Please set it before using this function. The default period is 1s.
+ 	 \note The messages are set with rtos_add_tx_periodic_msg, or with
+ 	 	 	 rtos_define_tx_periodic_msg (Default period of 1s). They can be
+ 	 	 	 added, removed or changed while the thread runs.
 
  	 \param[in] args Thread arguments. Set to NULL.
 
  	 \return void.
  */
 void rtos_can_tx_thread_periodic(void *args);
+#endif
 
 /*!
- 	 \brief This function sets the message to be sent periodically.
+ 	 \brief This function sets the message to be sent periodically with the
+ 	 	 	 period of set_tx_thread_period.
+
+ 	 \note Calling it again replaces the message, keeping its period.
 
  	 \param[in] can_message_tx Structure of the message to be sent.
 
@@ -118,38 +206,126 @@ void rtos_can_tx_thread_periodic(void *args);
 void rtos_define_tx_periodic_msg(can_message_tx_config_t can_message_tx);
 
 /*!
- 	 \brief This function sets the period of the Tx thread.
+ 	 \brief This function sets the period of the message set with
+ 	 	 	 rtos_define_tx_periodic_msg.
 
- 	 \param[in] new_value New period, in milliseconds, of the Tx thread.
+ 	 \param[in] new_value New period, in milliseconds, of the message.
 
  	 \return void.
  */
 void set_tx_thread_period(uint32_t new_value);
 
-#if(!RX_MODE)
+/*!
+ 	 \brief This function adds a message to the periodic Tx schedule.
+
+ 	 \note The data buffer of the message is not copied, it is read each time the
+ 	 	 	 message is sent. Up to CAN_TX_SCHEDULE_SIZE messages can be scheduled.
+
+ 	 \param[in] can_message_tx Structure of the message to be sent.
+ 	 \param[in] period Period, in milliseconds, of the message.
+
+ 	 \return Slot of the message in the schedule, or CAN_TX_SCHEDULE_NO_SLOT if
+ 	 	 	 the schedule is full or the period is 0.
+ */
+uint8_t rtos_add_tx_periodic_msg(can_message_tx_config_t can_message_tx, uint32_t period);
+
+/*!
+ 	 \brief This function removes a message from the periodic Tx schedule.
+
+ 	 \param[in] slot Slot returned by rtos_add_tx_periodic_msg.
+
+ 	 \return This function indicates if the task was successful, or if an error occurred.
+ */
+CAN_tx_schedule_status_t rtos_remove_tx_periodic_msg(uint8_t slot);
+
+/*!
+ 	 \brief This function changes the period of a message of the periodic Tx
+ 	 	 	 schedule. Its offset is staggered again.
+
+ 	 \param[in] slot Slot returned by rtos_add_tx_periodic_msg.
+ 	 \param[in] period New period, in milliseconds, of the message.
+
+ 	 \return This function indicates if the task was successful, or if an error occurred.
+ */
+CAN_tx_schedule_status_t rtos_set_tx_periodic_msg_period(uint8_t slot, uint32_t period);
+
+#if(RX_INTERRUPT == RX_MODE)
 /*!
  	 \brief This thread receives a message using interruption.
 
  	 \note Use rtos_add_ID_function or rtos_change_ID_function to set a callback
  	 	 	 for when a certain ID is received.
 
- 	 \param[in] args Thread arguments. Set to NULL.
+ 	 \param[in] args CAN whose messages are received (CAN0, CAN1 or CAN2).
 
  	 \return void.
  */
 void rtos_can_rx_thread_interruption(void *args);
+
+/*!
+ 	 \brief This function gets the statistics of the Rx MBs (messages notified, read,
+ 	 	 	 and overwritten before the Rx thread read them).
+
+ 	 \param[in] base CAN whose statistics are read.
+ 	 \param[out] stats Copy of the Rx MB statistics.
+
+ 	 \return void.
+ */
+void rtos_can_get_rx_mb_stats(CAN_Type* base, can_rx_mb_stats_t* stats);
 #endif
 
-#if RX_MODE
+#if(RX_FIFO == RX_MODE)
+/*!
+ 	 \brief This thread processes, in batches, the messages that the CAN
+ 	 	 	 interruption drains from the Rx FIFO into the Rx ring.
+
+ 	 \note Use rtos_add_ID_function or rtos_change_ID_function to set a callback
+ 	 	 	 for when a certain ID is received.
+
+ 	 \param[in] args CAN whose messages are received (CAN0, CAN1 or CAN2).
+
+ 	 \return void.
+ */
+void rtos_can_rx_thread_fifo(void *args);
+
+/*!
+ 	 \brief This function gets the statistics of the Rx ring (messages received,
+ 	 	 	 dropped, Rx FIFO overflows and the ring high water mark).
+
+ 	 \param[in] base CAN whose statistics are read.
+ 	 \param[out] stats Copy of the Rx ring statistics.
+
+ 	 \return void.
+ */
+void rtos_can_get_rx_stats(CAN_Type* base, can_rx_ring_stats_t* stats);
+#endif
+
+#if(RX_PERIODIC == RX_MODE)
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
 /*!
  	 \brief This thread receives a message, by checking the RX flag
  	 	 	 periodically (Polling). The default period is 100ms.
 
- 	 \param[in] args Thread arguments. Set to NULL.
+ 	 \param[in] args CAN whose messages are received (CAN0, CAN1 or CAN2).
 
  	 \return void.
  */
 void rtos_can_rx_thread_periodic(void *args);
+#else
+/*!
+ 	 \brief This function starts the software timer that receives the messages of
+ 	 	 	 a CAN, by checking the RX flag periodically (Polling). The default
+ 	 	 	 period is 100ms.
+
+ 	 \note The timer runs in the timer task, so if the CAN is busy the message is
+ 	 	 	 read in the next period instead of waiting for the mutex.
+
+ 	 \param[in] base CAN whose messages are received (CAN0, CAN1 or CAN2).
+
+ 	 \return void.
+ */
+void rtos_can_rx_timer_start(CAN_Type* base);
+#endif
 
 /*!
  	 \brief This function sets the period of the RX thread.
@@ -161,15 +337,196 @@ void rtos_can_rx_thread_periodic(void *args);
 void set_rx_thread_period(uint32_t new_value);
 #endif
 
+#if(PERIODIC_JOB_TASK == PERIODIC_JOB_MODE)
 /*!
- 	 \brief This thread reads the ADC periodically, and sets the EG for the value
- 	 	 	 to be sent.
+ 	 \brief This thread reads the ADC periodically, and notifies the Tx thread
+ 	 	 	 (rtos_can_tx_thread_EG) for the value to be sent.
 
  	 \param[in] args Thread arguments. Set to NULL.
 
  	 \return void.
  */
 void rtos_adc_read_thread(void *args);
+#else
+/*!
+ 	 \brief This function starts the software timers that read the ADC and send
+ 	 	 	 the messages of the periodic Tx schedule. They replace
+ 	 	 	 rtos_adc_read_thread and rtos_can_tx_thread_periodic.
+
+ 	 \note Call it after rtos_can_init. Each timer only needs its control block,
+ 	 	 	 instead of a task stack.
+
+ 	 \return void.
+ */
+void rtos_periodic_timers_start(void);
+#endif
+
+/*!
+ 	 \brief This function starts the ADC scan: the PDB1 triggers, by hardware, a
+ 	 	 	 conversion of every channel of the list with the ADC1, and the
+ 	 	 	 complete scans are delivered to rtos_adc_scan_receive.
+
+ 	 \note Calling it again replaces the channel list and the period.
+
+ 	 \param[in] config Channels and period of the scan.
+
+ 	 \return Whether the scan was started, or the configuration was not valid.
+ */
+adc_scan_status_t rtos_adc_scan_start(const adc_scan_config_t* config);
+
+/*!
+ 	 \brief This function waits for a complete scan.
+
+ 	 \note The scans are kept in a queue of ADC_SCAN_QUEUE_LENGTH frames, when
+ 	 	 	 it is full the new scans are dropped.
+
+ 	 \param[out] frame Results of the scan, with its sequence number and tick.
+ 	 \param[in] ticks_to_wait Ticks to wait for a scan (portMAX_DELAY to wait forever).
+
+ 	 \return pdPASS if a scan was received, pdFAIL if the time expired.
+ */
+BaseType_t rtos_adc_scan_receive(adc_scan_frame_t* frame, TickType_t ticks_to_wait);
+
+/*!
+ 	 \brief This function gets the statistics of the ADC scan.
+
+ 	 \param[out] stats Copy of the ADC scan statistics.
+
+ 	 \return void.
+ */
+void rtos_adc_scan_get_stats(adc_scan_stats_t* stats);
+
+/*!
+ 	 \brief This function changes the pipeline of the potentiometer samples sent
+ 	 	 	 by the ADC thread. The filter starts again from the next sample.
+
+ 	 \note By default the pipeline has a light IIR filter, scales the results to
+ 	 	 	 mV and ignores changes smaller than 10 mV.
+
+ 	 \param[in] config Configuration of the pipeline.
+
+ 	 \return void.
+ */
+void rtos_adc_set_pipeline(const adc_pipeline_config_t* config);
+
+/*!
+ 	 \brief This function changes the hardware averaging of the ADC of the
+ 	 	 	 potentiometer (ADC0).
+
+ 	 \param[in] average Conversions averaged for each result.
+
+ 	 \return void.
+ */
+void rtos_adc_set_hw_average(adc_hw_average_t average);
+
+/*!
+ 	 \brief This function sends and receives 16-bit words with the LPSPI1 (One
+ 	 	 	 frame per word), through the asynchronous transaction engine. The
+ 	 	 	 task sleeps while the words are moved by the LPSPI1 interruption.
+
+ 	 \note It waits for a dedicated bit (0x80000000) of the notification value
+ 	 	 	 of the calling task, so the other bits and the notification counts
+ 	 	 	 are kept pending for the task. It can only be called from a task.
+
+ 	 \param[in] tx Words to be sent.
+ 	 \param[out] rx Words received (NULL to discard them).
+ 	 \param[in] count Number of words.
+
+ 	 \return lpspi_async_success when the transfer completed, or the reason it
+ 	 	 	 was not queued.
+ */
+lpspi_async_status_t rtos_spi_transfer(const uint16_t* tx, uint16_t* rx, uint8_t count);
+
+/*!
+ 	 \brief This function sets the function called when the status of the SBC
+ 	 	 	 changes. It is called from the timer task, every 100 ms at most.
+
+ 	 \note The SBC watchdog is refreshed, and its status read, every 100 ms by
+ 	 	 	 a software timer, with one SPI burst moved by the LPSPI1 interruption.
+
+ 	 \param[in] callback Function called when the status changes (NULL for none).
+
+ 	 \return void.
+ */
+void rtos_sbc_set_fault_callback(sbc_fault_callback_t callback);
+
+/*!
+ 	 \brief This function gets the last status of the SBC.
+
+ 	 \param[out] status Copy of the status.
+
+ 	 \return void.
+ */
+void rtos_sbc_get_status(sbc_status_t* status);
+
+/*!
+ 	 \brief This function gets the statistics of the SBC service, with its CPU
+ 	 	 	 and SPI bus duty cycles.
+
+ 	 \param[out] stats Copy of the statistics.
+
+ 	 \return void.
+ */
+void rtos_sbc_get_stats(sbc_service_stats_t* stats);
+
+/*!
+ 	 \brief This function gets the answers of the MC33903 to the initialization
+ 	 	 	 sequence sent by rtos_can_init.
+
+ 	 \param[out] answers Answers of the SBC (At least 6 words).
+
+ 	 \return Number of answers, or 0 if the sequence has not completed.
+ */
+uint8_t rtos_sbc_get_init_answers(uint16_t* answers);
+
+/*!
+ 	 \brief This thread reports, once per period, the CPU load and the stack
+ 	 	 	 high water mark of each task. One frame is sent for each task:
+ 	 	 	 number, load (0.5 % units), free stack (Words, 2 bytes), priority
+ 	 	 	 and the first 3 characters of its name. Tools/stack_sizer.py turns
+ 	 	 	 the free stack of a profiling run into the stack of each task.
+ 	 	 	 If the last reset was caused by a stack overflow, the name of the
+ 	 	 	 task is sent once when the thread starts.
+
+ 	 \note Create it with the lowest priority, so the report does not disturb
+ 	 	 	 the other tasks. Its own run is included in the next report.
+
+ 	 \param[in] args CAN base used to send the frames.
+
+ 	 \return void.
+ */
+void rtos_runtime_report_thread(void *args);
+
+/*!
+ 	 \brief This function requests a dump of the kernel trace over CAN. The
+ 	 	 	 run-time report thread (rtos_runtime_report_thread) sends it after
+ 	 	 	 its next report: a header frame (Number of records, core clock
+ 	 	 	 and tick rate) and one frame per record, from the oldest one.
+ 	 	 	 Tools/trace_decode.py turns the frames into a timeline.
+
+ 	 \note The recording stops while the ring is sent, and starts again with
+ 	 	 	 an empty ring.
+
+ 	 \return void.
+ */
+void rtos_trace_request_dump(void);
+
+/*!
+ 	 \brief This function changes when the potentiometer samples are sent by the
+ 	 	 	 Tx thread (ADC_TX_ID).
+
+ 	 \note By default the samples are sent on change (20 mV deadband), at most
+ 	 	 	 every 50 ms, and refreshed every second when the potentiometer is
+ 	 	 	 static (Mixed). The cyclic mode with max_age_ms 0 sends every sample.
+
+ 	 \param[in] mode When a sample is sent.
+ 	 \param[in] deadband Changes up to this value, in mV, are not sent.
+ 	 \param[in] min_gap_ms Minimum time between two messages, in milliseconds.
+ 	 \param[in] max_age_ms Time after which the last value is sent again, in milliseconds.
+
+ 	 \return void.
+ */
+void rtos_adc_set_tx_policy(can_tx_policy_mode_t mode, uint16_t deadband, uint32_t min_gap_ms, uint32_t max_age_ms);
 
 /*!
  	 \brief This function sets the period of the ADC thread.
@@ -188,25 +545,59 @@ void set_adc_tx_thread_period(uint32_t new_value);
  */
 void rtos_can_set_sw_msg(can_message_tx_config_t can_message_tx);
 
+#if(RX_FIFO != RX_MODE)
 /*!
  	 \brief This function receives a message protecting the CAN with a mutex.
 
  	 \param[out] can_message_rx Message structure with the data received.
 
  	 \note can_message_tx.base is actually param[in], so it must be set before calling the function.
+ 	 \note Not available with RX_FIFO: the Rx FIFO is only read by the CAN interruption,
+ 	 	 	 which drains it into the Rx ring, and the messages reach the application
+ 	 	 	 through the functions set with rtos_add_ID_function.
 
  	 \return void.
  */
 void rtos_can_receive(can_message_rx_config_t *can_message_tx);
+#endif
 
 /*!
- 	 \brief This function transmits a message protecting the CAN wit a mutex.
+ 	 \brief This function queues a message for transmission and returns without
+ 	 	 	 waiting for the message to be sent.
+
+ 	 \note The message data is copied, so the buffer can be reused after the call.
 
  	 \param[in] can_message_tx Message structure with the data to be transmitted.
 
- 	 \return void
+ 	 \return Whether the message was accepted or dropped because the Tx queue was full.
+ */
+CAN_tx_queue_status_t rtos_can_transmit(can_message_tx_config_t can_message_tx);
+
+/*!
+ 	 \brief This function gets the statistics of the Tx queue (messages queued,
+ 	 	 	 sent, dropped and the queue high water mark).
+
+ 	 \param[in] base CAN whose statistics are read.
+ 	 \param[out] stats Copy of the Tx queue statistics.
+
+ 	 \return void.
  */
-void rtos_can_transmit(can_message_tx_config_t can_message_tx);
+void rtos_can_get_tx_stats(CAN_Type* base, can_tx_queue_stats_t* stats);
+
+/*!
+ 	 \brief This function gets the statistics of a source of the Tx thread
+ 	 	 	 (rtos_can_tx_thread_EG).
+
+ 	 \note The ADC source is FIFO (Every posted sample is sent), and the SW3 source is
+ 	 	 	 latest-wins (Presses not sent yet are coalesced into one message).
+ 	 	 	 The ADC samples go through the Tx policy before they are posted.
+
+ 	 \param[in] source Tx source whose statistics are read.
+ 	 \param[out] stats Copy of the Tx source statistics.
+
+ 	 \return void.
+ */
+void rtos_get_tx_event_stats(tx_event_source_t source, tx_event_stats_t* stats);
 
 /*!
  	 \brief This function turns on the LEDs according to the thresholds set for
@@ -222,17 +613,20 @@ void rtos_turn_on_leds(uint16_t adc_received);
  	 \brief This function adds an ID and a callback to be executed when the ID set
  	 	 	 received.
 
- 	 \note The maximum IDs that can be stored are 15.
+ 	 \note The maximum IDs that can be stored are ID_VECTOR_MAX_SIZE. The callback
+ 	 	 	 of a received ID is found in constant time, regardless of the stored IDs.
 
+ 	 \param[in] base CAN that receives the ID.
  	 \param[in] ID_func ID and callback function to be stored.
 
  	 \return This function indicates if the task was successful, or if an error occurred.
  */
-ID_func_vector_state_t rtos_add_ID_function(ID_function_t ID_func);
+ID_func_vector_state_t rtos_add_ID_function(CAN_Type* base, ID_function_t ID_func);
 
 /*!
  	 \brief THis function removes and ID and its respective callback from the ID vector.
 
+ 	 \param[in] base CAN that receives the ID.
  	 \param[in] ID_func ID and callback to be removed.
 
  	 \warning This function only checks for IDs, if an ID is found in the vector, it will
@@ -241,24 +635,27 @@ ID_func_vector_state_t rtos_add_ID_function(ID_function_t ID_func);
 
  	 \return This function indicates if the task was successful, or if an error occurred.
  */
-ID_func_vector_state_t rtos_remove_ID_function(ID_function_t ID_func);
+ID_func_vector_state_t rtos_remove_ID_function(CAN_Type* base, ID_function_t ID_func);
 
 /*!
  	 \brief This function changes an ID and its callback function to new ones.
 
+ 	 \param[in] base CAN that receives the ID.
  	 \param[in] ID_func_old ID and callback to be replaced.
  	 \param[in] ID_func_new ID and callback to be set.
 
  	 \return This function indicates if the task was successful, or if an error occurred.
  */
-ID_func_vector_state_t rtos_change_ID_function(ID_function_t ID_func_old, ID_function_t ID_func_new);
+ID_func_vector_state_t rtos_change_ID_function(CAN_Type* base, ID_function_t ID_func_old, ID_function_t ID_func_new);
 
 /*!
  	 \brief This function returns the number of IDs stored in the ID vector.
 
+ 	 \param[in] base CAN of the ID vector.
+
  	 \return The number of IDs and callbacks stored in the ID function vector.
  */
-uint8_t rtos_get_ID_function_vector_size(void);
+uint8_t rtos_get_ID_function_vector_size(CAN_Type* base);
 
 /*!
  	 \brief This function turns on the red LED.
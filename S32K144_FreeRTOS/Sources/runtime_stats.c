@@ -0,0 +1,94 @@
+/*!
+ 	 \file runtime_stats.c
+
+ 	 \brief This is the source file of the run-time statistics. The FreeRTOS
+ 	 	 	 run-time counter is the DWT cycle counter of the Cortex-M4, so each
+ 	 	 	 context switch only reads one register. The CPU load of each task
+ 	 	 	 and its stack high water mark are collected for a report window.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "runtime_stats.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timebase.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL						(0)
+/** Defines the number of tasks whose counters are kept (Indexed by task number)*/
+#define TRACKED_TASKS					(32)
+
+/** Tasks of the last collection*/
+static TaskStatus_t task_status[RUNTIME_STATS_MAX_TASKS];
+/** Run-time counter of each task in the last collection*/
+static uint32_t last_counter[TRACKED_TASKS];
+/** Tick of the last collection*/
+static TickType_t last_tick = INIT_VAL;
+
+/** This function starts the DWT cycle counter*/
+void vMainConfigureTimerForRunTimeStats(void)
+{
+	CORE_DEBUG_DEMCR |= CORE_DEBUG_DEMCR_TRCENA;
+
+	/** The trace recorder can start the counter before the scheduler*/
+	if(INIT_VAL == (DWT_CTRL & DWT_CTRL_CYCCNTENA))
+	{
+		DWT_CYCCNT = INIT_VAL;
+		DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+	}
+}
+
+/** This function reads the DWT cycle counter*/
+unsigned long ulMainGetRunTimeCounterValue(void)
+{
+	return DWT_CYCCNT;
+}
+
+/** This function gets the CPU load of each task since the last call*/
+uint8_t runtime_stats_collect(runtime_task_load_t* loads, uint8_t max_tasks)
+{
+	/** Tasks read*/
+	UBaseType_t tasks;
+	/** Variable to go through the tasks*/
+	UBaseType_t index;
+	/** Current tick*/
+	TickType_t now = xTaskGetTickCount();
+	/** Core cycles of the window (Including the time the core slept)*/
+	uint64_t window_cycles;
+	/** Cycles of the task in the window*/
+	uint32_t task_cycles;
+	/** Load of the task*/
+	uint64_t load;
+
+	if(max_tasks > RUNTIME_STATS_MAX_TASKS)
+	{
+		max_tasks = RUNTIME_STATS_MAX_TASKS;
+	}
+
+	tasks = uxTaskGetSystemState(task_status, RUNTIME_STATS_MAX_TASKS, NULL);
+	window_cycles = ((uint64_t)(now - last_tick) * timebase_get_core_clock()) / configTICK_RATE_HZ;
+	last_tick = now;
+
+	for(index = INIT_VAL; (tasks > index) && (max_tasks > index); index ++)
+	{
+		/** The difference survives the wrap of the counter*/
+		task_cycles = task_status[index].ulRunTimeCounter - last_counter[task_status[index].xTaskNumber % TRACKED_TASKS];
+		last_counter[task_status[index].xTaskNumber % TRACKED_TASKS] = task_status[index].ulRunTimeCounter;
+
+		load = (INIT_VAL == window_cycles) ? INIT_VAL : (((uint64_t)task_cycles * RUNTIME_STATS_FULL_LOAD) / window_cycles);
+
+		loads[index].number = (uint8_t)task_status[index].xTaskNumber;
+		loads[index].priority = (uint8_t)task_status[index].uxCurrentPriority;
+		loads[index].load = (load > RUNTIME_STATS_FULL_LOAD) ? RUNTIME_STATS_FULL_LOAD : (uint8_t)load;
+		loads[index].stack_free = task_status[index].usStackHighWaterMark;
+		loads[index].name = task_status[index].pcTaskName;
+	}
+
+	return (uint8_t)index;
+}
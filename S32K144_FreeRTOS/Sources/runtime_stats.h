@@ -0,0 +1,78 @@
+/*!
+ 	 \file runtime_stats.h
+
+ 	 \brief This is the header file of the run-time statistics. The FreeRTOS
+ 	 	 	 run-time counter is the DWT cycle counter of the Cortex-M4, so each
+ 	 	 	 context switch only reads one register. The CPU load of each task
+ 	 	 	 and its stack high water mark are collected for a report window.
+
+ 	 \note This header is included by FreeRTOSConfig.h, so it can not
+ 	 	 	 include any FreeRTOS header.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef RUNTIME_STATS_H_
+#define RUNTIME_STATS_H_
+
+#include <stdint.h>
+
+/** Defines the Debug Exception and Monitor Control Register of the core*/
+#define CORE_DEBUG_DEMCR				(*(volatile uint32_t*)0xE000EDFCUL)
+/** Defines the trace enable bit of the DEMCR (It powers the DWT)*/
+#define CORE_DEBUG_DEMCR_TRCENA			(1UL << 24)
+/** Defines the control register of the DWT*/
+#define DWT_CTRL						(*(volatile uint32_t*)0xE0001000UL)
+/** Defines the cycle counter enable bit of the DWT*/
+#define DWT_CTRL_CYCCNTENA				(1UL)
+/** Defines the cycle counter of the DWT (Run-time counter and trace timestamp)*/
+#define DWT_CYCCNT						(*(volatile uint32_t*)0xE0001004UL)
+
+/** Defines the maximum number of tasks in a report*/
+#define RUNTIME_STATS_MAX_TASKS			(10)
+/** Defines the CPU load of a fully loaded task (0.5 % units, so it fits in one byte)*/
+#define RUNTIME_STATS_FULL_LOAD			(200)
+
+/*!
+ 	 \brief CPU load of a task in a report window.
+ */
+typedef struct
+{
+	uint8_t number;				/*!< Number of the task (Given by FreeRTOS when it is created)*/
+	uint8_t priority;			/*!< Current priority*/
+	uint8_t load;				/*!< CPU load in the window, in 0.5 % units (RUNTIME_STATS_FULL_LOAD is 100 %)*/
+	uint16_t stack_free;			/*!< Minimum free stack since the task started, in words*/
+	const char* name;			/*!< Name of the task*/
+}runtime_task_load_t;
+
+/*!
+ 	 \brief This function starts the DWT cycle counter (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS).
+
+ 	 \note The counter is cleared only if it was stopped, so the trace
+ 	 	 	 started before the scheduler keeps growing timestamps.
+
+ 	 \return void.
+ */
+void vMainConfigureTimerForRunTimeStats(void);
+
+/*!
+ 	 \brief This function gets the CPU load of each task since the last call.
+
+ 	 \note The cycle counter stops while the core sleeps (Tickless idle), so
+ 	 	 	 the loads are computed against the ticks of the window. The time the
+ 	 	 	 core slept is the idle time not counted for any task. The window
+ 	 	 	 must be shorter than the wrap of the counter (53 s at 80 MHz).
+
+ 	 \param[out] loads Load of each task.
+ 	 \param[in] max_tasks Size of loads.
+
+ 	 \return Number of tasks written in loads.
+ */
+uint8_t runtime_stats_collect(runtime_task_load_t* loads, uint8_t max_tasks);
+
+#endif /* RUNTIME_STATS_H_ */
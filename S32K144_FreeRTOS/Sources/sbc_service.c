@@ -0,0 +1,190 @@
+/*!
+ 	 \file sbc_service.c
+
+ 	 \brief This is the source file of the MC33903 SBC service. Every period
+ 	 	 	 it sends one SPI burst, through the asynchronous LPSPI1 engine,
+ 	 	 	 with the watchdog refresh and the reads of the status registers.
+ 	 	 	 The fault flags are published, and a function is called only
+ 	 	 	 when they change.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "sbc_service.h"
+#include "task.h"
+#include "timebase.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the status as valid*/
+#define STATUS_VALID				(1)
+/** Defines the status as changed*/
+#define STATUS_CHANGED				(1)
+/** Defines the watchdog refresh command (Write Watchdog reg., the same value of the initialization)*/
+#define SBC_WD_REFRESH				(0x5A00)
+/** Defines the command to read the regulator flags*/
+#define SBC_READ_VREG				(0xDF80)
+/** Defines the command to read the CAN flags*/
+#define SBC_READ_CAN				(0xE180)
+/** Defines the command to read the I/O flags*/
+#define SBC_READ_IO					(0xE380)
+/** Defines the position of the first status answer in the burst (After the refresh)*/
+#define SBC_STATUS_OFFSET			(1)
+/** Defines the words of a burst*/
+#define SBC_BURST_WORDS				(SBC_STATUS_OFFSET + sbc_status_count)
+/** Defines the time of one SPI word, in ns (16 SCK of 1 us, 1 us PCS to SCK, 0.5 us SCK to PCS, 1 us between words)*/
+#define SBC_SPI_WORD_NS				(18500UL)
+/** Defines the ns in a ms*/
+#define NS_PER_MS					(1000000UL)
+/** Defines the parts per million*/
+#define PPM							(1000000ULL)
+
+/** Commands of the burst, the watchdog refresh is first*/
+static const uint16_t sbc_burst_commands[SBC_BURST_WORDS] =
+{
+	SBC_WD_REFRESH, SBC_READ_VREG, SBC_READ_CAN, SBC_READ_IO
+};
+/** Answers of the burst*/
+static uint16_t sbc_burst_answers[SBC_BURST_WORDS];
+/** SPI transfer of the burst*/
+static lpspi_transfer_t sbc_burst =
+{
+	sbc_burst_commands, sbc_burst_answers, SBC_BURST_WORDS, NULL, NULL, lpspi_transfer_idle
+};
+
+/** Last status of the SBC*/
+static sbc_status_t sbc_status = {{INIT_VAL}, INIT_VAL};
+/** Function called when the status changes*/
+static sbc_fault_callback_t sbc_fault_callback = NULL;
+/** Period of the service, in milliseconds*/
+static uint32_t sbc_period_ms = INIT_VAL;
+/** Statistics of the service*/
+static sbc_service_stats_t sbc_stats = {INIT_VAL};
+
+/** This function takes the answers of the completed burst, and calls the function if the status changed*/
+static void SBC_service_check(void)
+{
+	/** Status before the burst*/
+	sbc_status_t previous = sbc_status;
+	/** Variable to go through the status registers*/
+	uint8_t index;
+	/** Whether the status changed*/
+	uint8_t changed = (STATUS_VALID != previous.valid) ? STATUS_CHANGED : INIT_VAL;
+
+	for(index = INIT_VAL; sbc_status_count > index; index ++)
+	{
+		if(previous.flags[index] != sbc_burst_answers[SBC_STATUS_OFFSET + index])
+		{
+			changed = STATUS_CHANGED;
+		}
+	}
+
+	/** Only a change is published and escalated*/
+	if(STATUS_CHANGED != changed)
+	{
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	for(index = INIT_VAL; sbc_status_count > index; index ++)
+	{
+		sbc_status.flags[index] = sbc_burst_answers[SBC_STATUS_OFFSET + index];
+	}
+	sbc_status.valid = STATUS_VALID;
+	sbc_stats.escalations ++;
+	taskEXIT_CRITICAL();
+
+	if(NULL != sbc_fault_callback)
+	{
+		sbc_fault_callback(&sbc_status, &previous);
+	}
+}
+
+/** This function initializes the service*/
+void SBC_service_init(uint32_t period_ms)
+{
+	sbc_period_ms = period_ms;
+
+	/** Bus time of the burst over the period*/
+	sbc_stats.spi_duty_ppm = (INIT_VAL == period_ms) ? INIT_VAL :
+		(uint32_t)(((uint64_t)SBC_BURST_WORDS * SBC_SPI_WORD_NS * PPM) / ((uint64_t)period_ms * NS_PER_MS));
+}
+
+/** This function changes the function called when the status changes*/
+void SBC_service_set_callback(sbc_fault_callback_t callback)
+{
+	sbc_fault_callback = callback;
+}
+
+/** This function checks the answers of the last burst, and sends the next one*/
+void SBC_service_run(void)
+{
+	/** Start of the job, to measure it*/
+	uint32_t start = timebase_cycles_now();
+	/** Cycles of the job*/
+	uint32_t cycles;
+
+	/** The last burst is still in the LPSPI1, the watchdog is not refreshed this period*/
+	if((lpspi_transfer_queued == sbc_burst.state) || (lpspi_transfer_active == sbc_burst.state))
+	{
+		sbc_stats.overruns ++;
+	}
+	else
+	{
+		if(lpspi_transfer_done == sbc_burst.state)
+		{
+			SBC_service_check();
+		}
+
+		/** Refreshes the watchdog and reads the status in the same burst*/
+		if(lpspi_async_success == LPSPI_async_submit(&sbc_burst))
+		{
+			sbc_stats.refreshes ++;
+		}
+		else
+		{
+			sbc_stats.overruns ++;
+		}
+	}
+
+	cycles = timebase_cycles_since(start);
+	sbc_stats.job_cycles += cycles;
+	if(sbc_stats.job_cycles_max < cycles)
+	{
+		sbc_stats.job_cycles_max = cycles;
+	}
+}
+
+/** This function gets the last status of the SBC*/
+void SBC_service_get_status(sbc_status_t* status)
+{
+	taskENTER_CRITICAL();
+	*status = sbc_status;
+	taskEXIT_CRITICAL();
+}
+
+/** This function gets the statistics and the duty cycle of the service*/
+void SBC_service_get_stats(sbc_service_stats_t* stats)
+{
+	/** Statistics of the LPSPI1 engine (Cycles of its interruption)*/
+	lpspi_async_stats_t spi_stats;
+	/** Core cycles of the periods run so far*/
+	uint64_t elapsed_cycles;
+
+	LPSPI_async_get_stats(&spi_stats);
+
+	taskENTER_CRITICAL();
+	*stats = sbc_stats;
+	taskEXIT_CRITICAL();
+
+	/** Cycles of the service over the cycles of its periods*/
+	elapsed_cycles = ((uint64_t)(stats->refreshes + stats->overruns) * sbc_period_ms * timebase_get_core_clock()) /
+		TIMEBASE_MS_PER_S;
+	stats->cpu_duty_ppm = (INIT_VAL == elapsed_cycles) ? INIT_VAL :
+		(uint32_t)((((uint64_t)stats->job_cycles + spi_stats.isr_cycles) * PPM) / elapsed_cycles);
+}
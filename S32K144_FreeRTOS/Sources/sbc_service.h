@@ -0,0 +1,117 @@
+/*!
+ 	 \file sbc_service.h
+
+ 	 \brief This is the header file of the MC33903 SBC service. Every period
+ 	 	 	 it sends one SPI burst, through the asynchronous LPSPI1 engine,
+ 	 	 	 with the watchdog refresh and the reads of the status registers.
+ 	 	 	 The fault flags are published, and a function is called only
+ 	 	 	 when they change.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef SBC_SERVICE_H_
+#define SBC_SERVICE_H_
+
+#include "lpspi_async.h"
+
+/*!
+ 	 \brief Enumerator to define the status registers read in each burst.
+ */
+typedef enum
+{
+	sbc_status_vreg,		/*!< Regulator flags (0xDF80)*/
+	sbc_status_can,		/*!< CAN flags (0xE180)*/
+	sbc_status_io,			/*!< I/O flags (0xE380)*/
+	sbc_status_count		/*!< Number of status registers*/
+}sbc_status_register_t;
+
+/*!
+ 	 \brief Status of the SBC.
+ */
+typedef struct
+{
+	uint16_t flags[sbc_status_count];	/*!< Answer of each status register*/
+	uint8_t valid;						/*!< Defines whether a burst has completed or not*/
+}sbc_status_t;
+
+/*!
+ 	 \brief Function called when the status of the SBC changes (From the
+ 	 	 	 context that runs SBC_service_run).
+ */
+typedef void (*sbc_fault_callback_t)(const sbc_status_t* status, const sbc_status_t* previous);
+
+/*!
+ 	 \brief Statistics and duty cycle of the service.
+ */
+typedef struct
+{
+	uint32_t refreshes;		/*!< Bursts sent (Watchdog refreshes)*/
+	uint32_t overruns;		/*!< Periods without refresh, because the last burst had not completed*/
+	uint32_t escalations;		/*!< Changes of the status*/
+	uint32_t job_cycles;		/*!< Core cycles spent by SBC_service_run*/
+	uint32_t job_cycles_max;	/*!< Longest SBC_service_run, in core cycles*/
+	uint32_t cpu_duty_ppm;		/*!< CPU used by the service and the LPSPI1 interruption, in parts per million*/
+	uint32_t spi_duty_ppm;		/*!< Time the SPI bus is busy with the bursts, in parts per million*/
+}sbc_service_stats_t;
+
+/*!
+ 	 \brief This function initializes the service.
+
+ 	 \note SBC_service_run must be called every period_ms, by a timer or a task.
+ 	 	 	 The function called when the status changes is kept.
+
+ 	 \param[in] period_ms Period of the watchdog refresh, in milliseconds. It must
+ 	 	 	 fall in the open window of the watchdog.
+
+ 	 \return void.
+ */
+void SBC_service_init(uint32_t period_ms);
+
+/*!
+ 	 \brief This function changes the function called when the status changes.
+
+ 	 \param[in] callback Function called when the status changes (NULL for none).
+
+ 	 \return void.
+ */
+void SBC_service_set_callback(sbc_fault_callback_t callback);
+
+/*!
+ 	 \brief This function checks the answers of the last burst, and sends the
+ 	 	 	 next one (Watchdog refresh and status reads).
+
+ 	 \note It does not wait for the SPI, the burst is moved by the LPSPI1
+ 	 	 	 interruption and its answers are checked in the next period.
+
+ 	 \return void.
+ */
+void SBC_service_run(void);
+
+/*!
+ 	 \brief This function gets the last status of the SBC.
+
+ 	 \param[out] status Copy of the status.
+
+ 	 \return void.
+ */
+void SBC_service_get_status(sbc_status_t* status);
+
+/*!
+ 	 \brief This function gets the statistics and the duty cycle of the service.
+
+ 	 \note The CPU duty cycle includes every LPSPI1 interruption, after the
+ 	 	 	 initialization only the service uses the LPSPI1.
+
+ 	 \param[out] stats Copy of the statistics.
+
+ 	 \return void.
+ */
+void SBC_service_get_stats(sbc_service_stats_t* stats);
+
+#endif /* SBC_SERVICE_H_ */
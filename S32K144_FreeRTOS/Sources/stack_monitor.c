@@ -0,0 +1,86 @@
+/*!
+ 	 \file stack_monitor.c
+
+ 	 \brief This is the source file of the stack monitor. FreeRTOS checks the
+ 	 	 	 stack of each task when it is switched out (configCHECK_FOR_STACK_OVERFLOW
+ 	 	 	 set to 2). When a stack overflows, the name of the task is kept in
+ 	 	 	 RAM that survives the reset, and the core is reset, so the overflow
+ 	 	 	 can be reported after the restart.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "stack_monitor.h"
+#include "S32K144.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL					(0)
+/** Defines the value that marks the record as written*/
+#define OVERFLOW_MAGIC				(0x5354414BUL)
+/** Defines the key to write the AIRCR register*/
+#define AIRCR_KEY					(0x05FA)
+
+/*!
+ 	 \brief Record of the last stack overflow.
+ */
+typedef struct
+{
+	uint32_t magic;							/*!< Marks the record as written*/
+	char name[STACK_MONITOR_NAME_SIZE];	/*!< Name of the task*/
+	uint32_t check;							/*!< Complement of the magic*/
+}stack_overflow_record_t;
+
+/** Record of the overflow (The startup code does not initialize this section, the record survives the reset)*/
+static stack_overflow_record_t stack_overflow_record __attribute__((section(".customSection")));
+
+/** Hook called by FreeRTOS when the stack of a task overflows*/
+void vApplicationStackOverflowHook(TaskHandle_t xTask, signed char* pcTaskName)
+{
+	/** Variable to go through the name*/
+	uint8_t index;
+
+	/** The stack can not be trusted anymore, the interruptions are not enabled again*/
+	taskDISABLE_INTERRUPTS();
+
+	/** Copies the name (It ends with 0 within the maximum length of the names)*/
+	for(index = INIT_VAL; STACK_MONITOR_NAME_SIZE > index; index ++)
+	{
+		stack_overflow_record.name[index] = (char)pcTaskName[index];
+	}
+	stack_overflow_record.name[STACK_MONITOR_NAME_SIZE - 1] = INIT_VAL;
+	stack_overflow_record.magic = OVERFLOW_MAGIC;
+	stack_overflow_record.check = ~((uint32_t)OVERFLOW_MAGIC);
+
+	/** Resets the core*/
+	S32_SCB->AIRCR = S32_SCB_AIRCR_VECTKEY(AIRCR_KEY) | S32_SCB_AIRCR_SYSRESETREQ_MASK;
+	for(;;);
+}
+
+/** This function gets the task whose stack overflowed before the last reset*/
+stack_monitor_status_t stack_monitor_get_overflow(char* name)
+{
+	/** Variable to go through the name*/
+	uint8_t index;
+
+	/** The record is only valid after the software reset of the hook*/
+	if((INIT_VAL == (RCM->SRS & RCM_SRS_SW_MASK)) || (OVERFLOW_MAGIC != stack_overflow_record.magic) ||
+		(~((uint32_t)OVERFLOW_MAGIC) != stack_overflow_record.check))
+	{
+		return stack_monitor_no_overflow;
+	}
+
+	for(index = INIT_VAL; STACK_MONITOR_NAME_SIZE > index; index ++)
+	{
+		name[index] = stack_overflow_record.name[index];
+	}
+
+	/** Clears the record, so it is reported once*/
+	stack_overflow_record.magic = INIT_VAL;
+
+	return stack_monitor_overflow;
+}
@@ -0,0 +1,58 @@
+/*!
+ 	 \file stack_monitor.h
+
+ 	 \brief This is the header file of the stack monitor. FreeRTOS checks the
+ 	 	 	 stack of each task when it is switched out (configCHECK_FOR_STACK_OVERFLOW
+ 	 	 	 set to 2). When a stack overflows, the name of the task is kept in
+ 	 	 	 RAM that survives the reset, and the core is reset, so the overflow
+ 	 	 	 can be reported after the restart.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef STACK_MONITOR_H_
+#define STACK_MONITOR_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** Defines the characters kept of the name of the task that overflowed*/
+#define STACK_MONITOR_NAME_SIZE			(configMAX_TASK_NAME_LEN)
+
+/*!
+ 	 \brief Enumerator to define the cause of the last reset.
+ */
+typedef enum
+{
+	stack_monitor_no_overflow,	/*!< The last reset was not caused by a stack overflow*/
+	stack_monitor_overflow		/*!< A stack overflowed before the last reset*/
+}stack_monitor_status_t;
+
+/*!
+ 	 \brief Hook called by FreeRTOS when the stack of a task overflows. It keeps
+ 	 	 	 the name of the task and resets the core.
+
+ 	 \param[in] xTask Task that overflowed.
+ 	 \param[in] pcTaskName Name of the task.
+
+ 	 \return void.
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, signed char* pcTaskName);
+
+/*!
+ 	 \brief This function gets the task whose stack overflowed before the last
+ 	 	 	 reset. The record is cleared, so the overflow is reported once.
+
+ 	 \param[out] name Name of the task (STACK_MONITOR_NAME_SIZE characters, ended
+ 	 	 	 with 0).
+
+ 	 \return Whether the last reset was caused by a stack overflow.
+ */
+stack_monitor_status_t stack_monitor_get_overflow(char* name);
+
+#endif /* STACK_MONITOR_H_ */
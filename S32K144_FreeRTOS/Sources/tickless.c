@@ -0,0 +1,205 @@
+/*!
+ 	 \file tickless.c
+
+ 	 \brief This is the source file of the tickless idle of FreeRTOS. When all
+ 	 	 	 the tasks are blocked, the SysTick is stopped and the LPTMR0 wakes
+ 	 	 	 the core when the next task is due, so the idle time costs no tick
+ 	 	 	 interruptions. Any other interruption (CAN, SW3, ADC) wakes the core
+ 	 	 	 too, and the ticks that passed are added to the tick count.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "tickless.h"
+#include "task.h"
+#include "timebase.h"
+#include "interrupt_manager.h"
+#include "S32K144.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL						(0)
+/** Defines the LPTMR0 clock as the one selected in the PCC*/
+#define LPTMR_PCC_CLOCK					(3)
+/** Defines the PCC clock of the LPTMR0 as the SOSCDIV2*/
+#define PCC_SOSCDIV2					(1)
+/** Defines the prescaler of the LPTMR0 (Divides by 2^(6 + 1) = 128)*/
+#define LPTMR_PRESCALE					(6)
+/** Defines the maximum counts of the LPTMR0*/
+#define LPTMR_MAX_COUNTS				(0xFFFFUL)
+/** Defines the priority of the LPTMR0 interruption (It does not call FreeRTOS functions)*/
+#define LPTMR_INTERRUPT_PRIO			(0x03)
+/** Defines that the LPTMR0 expired*/
+#define LPTMR_EXPIRED					(1)
+
+#if(1 == configUSE_TICKLESS_IDLE)
+/** Core cycles in one count of the LPTMR0*/
+static uint32_t cycles_per_count = INIT_VAL;
+/** Longest sleep, in ticks, that fits in the LPTMR0*/
+static TickType_t max_idle_ticks = INIT_VAL;
+/** Set by the LPTMR0 interruption*/
+static volatile uint8_t lptmr_expired = INIT_VAL;
+#endif
+/** Statistics of the tickless idle*/
+static tickless_stats_t tickless_stats = {INIT_VAL};
+
+#if(1 == configUSE_TICKLESS_IDLE)
+/** Interruption of the LPTMR0, it only wakes the core*/
+static void LPTMR0_ISR(void)
+{
+	/** Stops the timer and clears its flag*/
+	LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+	lptmr_expired = LPTMR_EXPIRED;
+}
+
+/** This function restarts the SysTick, its first period ends at the next tick*/
+static void tickless_restart_systick(uint32_t next_tick_cycles, uint32_t tick_cycles)
+{
+	S32_SysTick->RVR = next_tick_cycles - 1UL;
+	S32_SysTick->CVR = INIT_VAL;
+	S32_SysTick->CSR |= S32_SysTick_CSR_ENABLE_MASK;
+	S32_SysTick->RVR = tick_cycles - 1UL;
+}
+
+/** Sleeps with the SysTick stopped (Replaces the weak SysTick function of the port)*/
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+	/** Core cycles in one tick*/
+	uint32_t tick_cycles = S32_SysTick->RVR + 1UL;
+	/** Core cycles left in the current tick*/
+	uint32_t remaining;
+	/** Core cycles until the next task is due*/
+	uint32_t sleep_cycles;
+	/** Counts of the LPTMR0 for the sleep*/
+	uint32_t counts;
+	/** Core cycles that passed while sleeping*/
+	uint32_t elapsed_cycles;
+	/** Ticks that passed while sleeping*/
+	uint32_t complete_ticks = INIT_VAL;
+	/** Core cycles until the next tick, after waking*/
+	uint32_t next_tick_cycles;
+
+	if(xExpectedIdleTime > max_idle_ticks)
+	{
+		xExpectedIdleTime = max_idle_ticks;
+	}
+
+	/** Stops the SysTick, keeping the cycles left of the current tick*/
+	S32_SysTick->CSR &= ~S32_SysTick_CSR_ENABLE_MASK;
+	remaining = (INIT_VAL == S32_SysTick->CVR) ? tick_cycles : S32_SysTick->CVR;
+
+	/** Masks the interruptions without the BASEPRI, so any of them still wakes the core*/
+	__asm volatile("cpsid i");
+
+	sleep_cycles = remaining + ((xExpectedIdleTime - 1UL) * tick_cycles);
+	counts = sleep_cycles / cycles_per_count;
+
+	/** A task became ready, or the sleep is shorter than one count*/
+	if((eAbortSleep == eTaskConfirmSleepModeStatus()) || (INIT_VAL == counts))
+	{
+		tickless_restart_systick(remaining, tick_cycles);
+		tickless_stats.aborted ++;
+		__asm volatile("cpsie i");
+		return;
+	}
+
+	/** The LPTMR0 interrupts after CMR + 1 counts*/
+	lptmr_expired = INIT_VAL;
+	LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+	LPTMR0->CMR = LPTMR_CMR_COMPARE(counts - 1UL);
+	LPTMR0->CSR = LPTMR_CSR_TIE_MASK | LPTMR_CSR_TEN_MASK;
+
+	__asm volatile("dsb");
+	__asm volatile("wfi");
+	__asm volatile("isb");
+
+	/** Lets the interruption that woke the core run right away (CAN Rx latency), before the tick accounting*/
+	__asm volatile("cpsie i");
+	__asm volatile("isb");
+	__asm volatile("cpsid i");
+
+	/** The LPTMR0 can expire after the window, with its interruption masked: the counter already
+	 	 restarted from zero, so the flag is checked before it*/
+	if(LPTMR0->CSR & LPTMR_CSR_TCF_MASK)
+	{
+		lptmr_expired = LPTMR_EXPIRED;
+		INT_SYS_ClearPending(LPTMR0_IRQn);
+	}
+
+	/** Reads the counts that passed (Writing the counter latches it), then stops the LPTMR0*/
+	LPTMR0->CNR = INIT_VAL;
+	elapsed_cycles = (LPTMR_EXPIRED == lptmr_expired) ? counts : (LPTMR0->CNR & LPTMR_CNR_COUNTER_MASK);
+	elapsed_cycles *= cycles_per_count;
+	LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+
+	/** Gets the ticks that passed, and the cycles until the next one, so the tick keeps its phase*/
+	if(elapsed_cycles < remaining)
+	{
+		next_tick_cycles = remaining - elapsed_cycles;
+	}
+	else
+	{
+		complete_ticks = 1UL + ((elapsed_cycles - remaining) / tick_cycles);
+		next_tick_cycles = tick_cycles - ((elapsed_cycles - remaining) % tick_cycles);
+	}
+
+	/** The tick when the next task is due is counted by the SysTick interruption*/
+	if(complete_ticks > (xExpectedIdleTime - 1UL))
+	{
+		complete_ticks = xExpectedIdleTime - 1UL;
+		next_tick_cycles = cycles_per_count;
+	}
+
+	tickless_restart_systick(next_tick_cycles, tick_cycles);
+	vTaskStepTick(complete_ticks);
+
+	tickless_stats.sleeps ++;
+	tickless_stats.suppressed_ticks += complete_ticks;
+	if(LPTMR_EXPIRED != lptmr_expired)
+	{
+		tickless_stats.early_wakes ++;
+	}
+	if(tickless_stats.max_ticks < complete_ticks)
+	{
+		tickless_stats.max_ticks = complete_ticks;
+	}
+
+	__asm volatile("cpsie i");
+}
+#endif
+
+/** This function configures the LPTMR0 for the tickless idle*/
+void tickless_init(void)
+{
+#if(1 == configUSE_TICKLESS_IDLE)
+	/** Core cycles in one tick*/
+	uint32_t tick_cycles = timebase_get_core_clock() / configTICK_RATE_HZ;
+
+	/** Clocks the LPTMR0 with the SOSCDIV2*/
+	PCC->PCCn[PCC_LPTMR0_INDEX] &= ~PCC_PCCn_CGC_MASK;
+	PCC->PCCn[PCC_LPTMR0_INDEX] = PCC_PCCn_PCS(PCC_SOSCDIV2) | PCC_PCCn_CGC_MASK;
+
+	/** Time counter, reset when it reaches the compare value*/
+	LPTMR0->CSR = LPTMR_CSR_TCF_MASK;
+	LPTMR0->PSR = LPTMR_PSR_PCS(LPTMR_PCC_CLOCK) | LPTMR_PSR_PRESCALE(LPTMR_PRESCALE);
+
+	cycles_per_count = timebase_get_core_clock() / TICKLESS_LPTMR_HZ;
+	max_idle_ticks = (TickType_t)((LPTMR_MAX_COUNTS * cycles_per_count) / tick_cycles);
+
+	INT_SYS_InstallHandler(LPTMR0_IRQn, LPTMR0_ISR, (isr_t *)NULL);
+	INT_SYS_SetPriority(LPTMR0_IRQn, LPTMR_INTERRUPT_PRIO);
+	INT_SYS_EnableIRQ(LPTMR0_IRQn);
+#endif
+}
+
+/** This function gets the statistics of the tickless idle*/
+void tickless_get_stats(tickless_stats_t* stats)
+{
+	taskENTER_CRITICAL();
+	*stats = tickless_stats;
+	taskEXIT_CRITICAL();
+}
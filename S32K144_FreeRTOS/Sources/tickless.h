@@ -0,0 +1,57 @@
+/*!
+ 	 \file tickless.h
+
+ 	 \brief This is the header file of the tickless idle of FreeRTOS. When all
+ 	 	 	 the tasks are blocked, the SysTick is stopped and the LPTMR0 wakes
+ 	 	 	 the core when the next task is due, so the idle time costs no tick
+ 	 	 	 interruptions. Any other interruption (CAN, SW3, ADC) wakes the core
+ 	 	 	 too, and the ticks that passed are added to the tick count.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef TICKLESS_H_
+#define TICKLESS_H_
+
+#include "FreeRTOS.h"
+
+/** Defines the frequency of the LPTMR0 (SOSCDIV2 of 8 MHz divided by 128, one count every 16 us)*/
+#define TICKLESS_LPTMR_HZ			(62500UL)
+
+/*!
+ 	 \brief Statistics of the tickless idle.
+ */
+typedef struct
+{
+	uint32_t sleeps;			/*!< Times the core slept*/
+	uint32_t aborted;			/*!< Sleeps abandoned because a task became ready*/
+	uint32_t early_wakes;		/*!< Sleeps ended by an interruption before the LPTMR0*/
+	uint32_t suppressed_ticks;	/*!< Tick interruptions that did not occur*/
+	uint32_t max_ticks;			/*!< Longest sleep, in ticks*/
+}tickless_stats_t;
+
+/*!
+ 	 \brief This function configures the LPTMR0 for the tickless idle.
+
+ 	 \note Call it after the clocks are configured, and before the scheduler is
+ 	 	 	 started. It does nothing if configUSE_TICKLESS_IDLE is 0.
+
+ 	 \return void.
+ */
+void tickless_init(void);
+
+/*!
+ 	 \brief This function gets the statistics of the tickless idle.
+
+ 	 \param[out] stats Copy of the statistics.
+
+ 	 \return void.
+ */
+void tickless_get_stats(tickless_stats_t* stats);
+
+#endif /* TICKLESS_H_ */
@@ -0,0 +1,106 @@
+/*!
+ 	 \file timebase.c
+
+ 	 \brief This is the source file of the timebase. It reads the real core
+ 	 	 	 clock once the clocks are configured, programs the FreeRTOS tick
+ 	 	 	 from it, and converts milliseconds to ticks with integer math.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "timebase.h"
+#include "clock_manager.h"
+#include "scg_hal.h"
+#include "S32K144.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL				(0)
+/** Defines the minimum ticks of a period different to 0*/
+#define MIN_TICKS				(1)
+
+/** Frequency of the core clock (0 until timebase_init reads it)*/
+static uint32_t core_clock_hz = INIT_VAL;
+
+/** This function reads and keeps the frequency of the core clock*/
+void timebase_init(void)
+{
+	/** Frequency read from the clock manager*/
+	uint32_t frequency = INIT_VAL;
+
+	/** The SOSC is configured by registers, so the clock manager does not know the crystal*/
+	if(INIT_VAL == g_xtal0ClkFreq)
+	{
+		g_xtal0ClkFreq = TIMEBASE_XTAL0_HZ;
+	}
+
+	/** Reads the core clock from the SCG configuration*/
+	if((STATUS_SUCCESS == CLOCK_SYS_GetFreq(CORE_CLOCK, &frequency)) && (INIT_VAL != frequency))
+	{
+		core_clock_hz = frequency;
+	}
+
+	/** If the clock can not be read, the configured one is used*/
+	else
+	{
+		core_clock_hz = configCPU_CLOCK_HZ;
+	}
+}
+
+/** This function gets the frequency of the core clock*/
+uint32_t timebase_get_core_clock(void)
+{
+	/** Reads the clock if it was not read before*/
+	if(INIT_VAL == core_clock_hz)
+	{
+		timebase_init();
+	}
+
+	return core_clock_hz;
+}
+
+/** This function converts milliseconds to ticks*/
+TickType_t timebase_ms_to_ticks(uint32_t ms)
+{
+	/** Whole seconds and the remaining milliseconds are converted apart, so it does not overflow*/
+	uint32_t ticks = ((ms / TIMEBASE_MS_PER_S) * configTICK_RATE_HZ) +
+		((((ms % TIMEBASE_MS_PER_S) * configTICK_RATE_HZ) + (TIMEBASE_MS_PER_S / 2)) / TIMEBASE_MS_PER_S);
+
+	/** A period is never rounded to 0 ticks*/
+	if((INIT_VAL != ms) && (INIT_VAL == ticks))
+	{
+		ticks = MIN_TICKS;
+	}
+
+	return (TickType_t)ticks;
+}
+
+/** This function reads the SysTick counter*/
+uint32_t timebase_cycles_now(void)
+{
+	return S32_SysTick->CVR;
+}
+
+/** This function gets the core clock cycles since a reading of the SysTick counter*/
+uint32_t timebase_cycles_since(uint32_t start)
+{
+	/** Current value of the counter*/
+	uint32_t now = S32_SysTick->CVR;
+
+	/** The counter counts down, and restarts from the reload value*/
+	return (start >= now) ? (start - now) : (start + (S32_SysTick->RVR + 1UL) - now);
+}
+
+/** Configures the SysTick of FreeRTOS with the real core clock (Replaces the weak function of
+ 	 the port, which uses configCPU_CLOCK_HZ)*/
+void vPortSetupTimerInterrupt(void)
+{
+	/** Counts of the core clock in one tick*/
+	S32_SysTick->RVR = (timebase_get_core_clock() / configTICK_RATE_HZ) - 1UL;
+	S32_SysTick->CVR = INIT_VAL;
+	S32_SysTick->CSR = S32_SysTick_CSR_CLKSOURCE_MASK | S32_SysTick_CSR_TICKINT_MASK | S32_SysTick_CSR_ENABLE_MASK;
+}
@@ -0,0 +1,81 @@
+/*!
+ 	 \file timebase.h
+
+ 	 \brief This is the header file of the timebase. It reads the real core
+ 	 	 	 clock once the clocks are configured, programs the FreeRTOS tick
+ 	 	 	 from it, and converts milliseconds to ticks with integer math.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include "FreeRTOS.h"
+
+/** Defines the frequency of the crystal of the system oscillator (SOSC_init_8MHz)*/
+#define TIMEBASE_XTAL0_HZ				(8000000UL)
+/** Defines the milliseconds in a second*/
+#define TIMEBASE_MS_PER_S				(1000UL)
+
+/** Converts a constant number of milliseconds to ticks (Evaluated by the compiler)*/
+#define TIMEBASE_MS_TO_TICKS(ms)		((TickType_t)((((ms) * configTICK_RATE_HZ) + (TIMEBASE_MS_PER_S / 2)) / TIMEBASE_MS_PER_S))
+
+/*!
+ 	 \brief This function reads and keeps the frequency of the core clock.
+
+ 	 \note Call it after the clocks are configured (NormalRUNmode_80MHz), and
+ 	 	 	 before the scheduler is started.
+
+ 	 \return void.
+ */
+void timebase_init(void);
+
+/*!
+ 	 \brief This function gets the frequency of the core clock read by
+ 	 	 	 timebase_init.
+
+ 	 \return Frequency, in Hz, of the core clock.
+ */
+uint32_t timebase_get_core_clock(void);
+
+/*!
+ 	 \brief This function converts milliseconds to ticks, rounded to the nearest
+ 	 	 	 tick.
+
+ 	 \note Use it when a period is configured, not in every cycle of a thread.
+ 	 	 	 A period different to 0 is at least 1 tick.
+
+ 	 \param[in] ms Milliseconds to be converted.
+
+ 	 \return Ticks of the milliseconds.
+ */
+TickType_t timebase_ms_to_ticks(uint32_t ms);
+
+/*!
+ 	 \brief This function reads the SysTick counter, to measure a short span of
+ 	 	 	 code in core clock cycles with timebase_cycles_since.
+
+ 	 \return Current value of the SysTick counter.
+ */
+uint32_t timebase_cycles_now(void);
+
+/*!
+ 	 \brief This function gets the core clock cycles since a reading of
+ 	 	 	 timebase_cycles_now.
+
+ 	 \note The span must be shorter than one tick, since the SysTick counter
+ 	 	 	 restarts every tick.
+
+ 	 \param[in] start Reading of timebase_cycles_now.
+
+ 	 \return Core clock cycles since the reading.
+ */
+uint32_t timebase_cycles_since(uint32_t start);
+
+#endif /* TIMEBASE_H_ */
@@ -0,0 +1,101 @@
+/*!
+ 	 \file trace_recorder.c
+
+ 	 \brief This is the source file of the kernel trace recorder. The trace
+ 	 	 	 macros of FreeRTOS (Context switches, queue and semaphore blocks)
+ 	 	 	 and the interruptions of the driver write fixed size records, with
+ 	 	 	 the DWT cycle count, into a RAM ring. The ring keeps the latest
+ 	 	 	 events, and it is sent over CAN when a dump is requested.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#include "trace_recorder.h"
+#include "FreeRTOS.h"
+#include "runtime_stats.h"
+
+/** Defines the initial value for the variables*/
+#define INIT_VAL						(0)
+/** Defines the mask to index the ring*/
+#define TRACE_RECORDER_MASK				(TRACE_RECORDER_SIZE - 1)
+/** Defines the recorder as running*/
+#define RECORDING						(1)
+/** Defines the recorder as stopped*/
+#define NOT_RECORDING					(0)
+
+/** Ring of records*/
+static trace_record_t trace_ring[TRACE_RECORDER_SIZE];
+/** Records written since the start (The ring keeps the last TRACE_RECORDER_SIZE)*/
+static uint32_t trace_head = INIT_VAL;
+/** Number of the running task*/
+static uint8_t trace_task = INIT_VAL;
+/** Indicates if the records are written*/
+static volatile uint8_t trace_recording = NOT_RECORDING;
+
+/** This function clears the ring and starts recording*/
+void trace_recorder_start(void)
+{
+	/** Starts the cycle counter of the timestamps, it can be called before the scheduler*/
+	vMainConfigureTimerForRunTimeStats();
+
+	trace_head = INIT_VAL;
+	trace_recording = RECORDING;
+}
+
+/** This function stops recording*/
+void trace_recorder_stop(void)
+{
+	trace_recording = NOT_RECORDING;
+}
+
+/** This function writes a record of the running task*/
+void trace_recorder_write(trace_event_t event, uint16_t object)
+{
+	/** Interruption mask when the function was called*/
+	UBaseType_t mask;
+	/** Record to be written*/
+	trace_record_t* record;
+
+	if(RECORDING == trace_recording)
+	{
+		/** The interruptions are masked only while the slot is taken and written (Any context can record, the
+		 	 interruptions that record have the syscall priority of the kernel)*/
+		mask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+		record = &trace_ring[trace_head & TRACE_RECORDER_MASK];
+		trace_head ++;
+		record->timestamp = DWT_CYCCNT;
+		record->event = (uint8_t)event;
+		record->task = trace_task;
+		record->object = object;
+
+		portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+	}
+}
+
+/** This function sets the running task and writes its record*/
+void trace_recorder_task_switched_in(uint8_t task)
+{
+	trace_task = task;
+	trace_recorder_write(trace_event_task_switched_in, task);
+}
+
+/** This function gets the number of records in the ring*/
+uint16_t trace_recorder_get_count(void)
+{
+	return (TRACE_RECORDER_SIZE < trace_head) ? TRACE_RECORDER_SIZE : (uint16_t)trace_head;
+}
+
+/** This function reads a record of the ring*/
+void trace_recorder_read(uint16_t index, trace_record_t* record)
+{
+	/** Position of the oldest record*/
+	uint32_t oldest = trace_head - trace_recorder_get_count();
+
+	*record = trace_ring[(oldest + index) & TRACE_RECORDER_MASK];
+}
@@ -0,0 +1,148 @@
+/*!
+ 	 \file trace_recorder.h
+
+ 	 \brief This is the header file of the kernel trace recorder. The trace
+ 	 	 	 macros of FreeRTOS (Context switches, queue and semaphore blocks)
+ 	 	 	 and the interruptions of the driver write fixed size records, with
+ 	 	 	 the DWT cycle count, into a RAM ring. The ring keeps the latest
+ 	 	 	 events, and it is sent over CAN when a dump is requested.
+
+ 	 \note This header is included by FreeRTOSConfig.h, so it can not
+ 	 	 	 include any FreeRTOS header.
+
+ 	 \author HEMI team
+ 	 	 	 Arpio Fernandez, Leon 				ie702086@iteso.mx
+ 	 	 	 Barragan Alvarez, Daniel 			ie702554@iteso.mx
+ 	 	 	 Delsordo Bustillo, Jose Ricardo	ie702570@iteso.mx
+
+ 	 \date 	16/10/2026
+ */
+
+#ifndef TRACE_RECORDER_H_
+#define TRACE_RECORDER_H_
+
+#include <stdint.h>
+
+/** Defines if the trace macros write records (Set it to 0 to compile them out)*/
+#define TRACE_RECORDER_ENABLED			(1)
+/** Defines the records of the ring (It must be a power of 2, each record uses 8 bytes)*/
+#define TRACE_RECORDER_SIZE				(256)
+
+/*!
+ 	 \brief Events of the trace. The values are part of the dump format, new
+ 	 	 	 events are added at the end.
+ */
+typedef enum
+{
+	trace_event_task_switched_in,		/*!< The task of the record starts running*/
+	trace_event_task_ready,				/*!< The task in object is moved to the ready list*/
+	trace_event_queue_send,				/*!< Item sent to a queue (Or semaphore given)*/
+	trace_event_queue_send_failed,		/*!< The queue was full*/
+	trace_event_queue_receive,			/*!< Item received from a queue (Or semaphore taken)*/
+	trace_event_queue_receive_failed,	/*!< The queue was empty*/
+	trace_event_queue_block_send,		/*!< The task blocks until the queue has space*/
+	trace_event_queue_block_receive,		/*!< The task blocks until the queue has an item*/
+	trace_event_queue_send_from_isr,		/*!< Item sent to a queue by an interruption*/
+	trace_event_queue_receive_from_isr,	/*!< Item received from a queue by an interruption*/
+	trace_event_task_delay,				/*!< The task blocks in vTaskDelay*/
+	trace_event_task_delay_until,		/*!< The task blocks in vTaskDelayUntil*/
+	trace_event_tick_step,				/*!< Ticks added after a tickless sleep (The cycle counter stops while the core sleeps)*/
+	trace_event_isr_enter,				/*!< Interruption in object starts*/
+	trace_event_isr_exit					/*!< Interruption in object ends*/
+}trace_event_t;
+
+/*!
+ 	 \brief Record of the trace. It is sent as is in the data of one CAN frame.
+ */
+typedef struct
+{
+	uint32_t timestamp;		/*!< DWT cycle count of the event*/
+	uint8_t event;			/*!< Event (trace_event_t)*/
+	uint8_t task;				/*!< Number of the running task*/
+	uint16_t object;			/*!< Low half of the queue address, task number, interruption number or ticks*/
+}trace_record_t;
+
+/*!
+ 	 \brief This function clears the ring and starts recording.
+
+ 	 \note It starts the DWT cycle counter if it is stopped, so it can be
+ 	 	 	 called before the scheduler starts.
+
+ 	 \return void.
+ */
+void trace_recorder_start(void);
+
+/*!
+ 	 \brief This function stops recording, so the ring can be read.
+
+ 	 \return void.
+ */
+void trace_recorder_stop(void);
+
+/*!
+ 	 \brief This function writes a record of the running task.
+
+ 	 \param[in] event Event of the record.
+ 	 \param[in] object Object of the event.
+
+ 	 \return void.
+ */
+void trace_recorder_write(trace_event_t event, uint16_t object);
+
+/*!
+ 	 \brief This function sets the running task and writes its record.
+
+ 	 \param[in] task Number of the task switched in.
+
+ 	 \return void.
+ */
+void trace_recorder_task_switched_in(uint8_t task);
+
+/*!
+ 	 \brief This function gets the number of records in the ring.
+
+ 	 \return Records in the ring (At most TRACE_RECORDER_SIZE).
+ */
+uint16_t trace_recorder_get_count(void);
+
+/*!
+ 	 \brief This function reads a record of the ring. Stop the recording before
+ 	 	 	 reading it.
+
+ 	 \param[in] index Record to be read, 0 is the oldest one.
+ 	 \param[out] record Copy of the record.
+
+ 	 \return void.
+ */
+void trace_recorder_read(uint16_t index, trace_record_t* record);
+
+#if(TRACE_RECORDER_ENABLED)
+/** Records the interruption entry*/
+#define TRACE_ISR_ENTER(irq)						trace_recorder_write(trace_event_isr_enter, (uint16_t)(irq))
+/** Records the interruption exit*/
+#define TRACE_ISR_EXIT(irq)						trace_recorder_write(trace_event_isr_exit, (uint16_t)(irq))
+/** Gets the object of a queue (Its address, the SRAM is smaller than 64 KB)*/
+#define TRACE_QUEUE_OBJECT(queue)				((uint16_t)(uintptr_t)(queue))
+
+/** FreeRTOS trace macros (They are expanded in tasks.c and queue.c)*/
+#define traceTASK_SWITCHED_IN()					trace_recorder_task_switched_in((uint8_t)pxCurrentTCB->uxTCBNumber)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB)	trace_recorder_write(trace_event_task_ready, (uint16_t)(pxTCB)->uxTCBNumber)
+#define traceQUEUE_SEND(pxQueue)					trace_recorder_write(trace_event_queue_send, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceQUEUE_SEND_FAILED(pxQueue)			trace_recorder_write(trace_event_queue_send_failed, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue)				trace_recorder_write(trace_event_queue_receive, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)		trace_recorder_write(trace_event_queue_receive_failed, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)	trace_recorder_write(trace_event_queue_block_send, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)	trace_recorder_write(trace_event_queue_block_receive, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)		trace_recorder_write(trace_event_queue_send_from_isr, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)	trace_recorder_write(trace_event_queue_receive_from_isr, TRACE_QUEUE_OBJECT(pxQueue))
+#define traceTASK_DELAY()							trace_recorder_write(trace_event_task_delay, 0)
+#define traceTASK_DELAY_UNTIL()					trace_recorder_write(trace_event_task_delay_until, 0)
+#define traceINCREASE_TICK_COUNT(x)				trace_recorder_write(trace_event_tick_step, (uint16_t)(x))
+#else
+/** Records the interruption entry*/
+#define TRACE_ISR_ENTER(irq)
+/** Records the interruption exit*/
+#define TRACE_ISR_EXIT(irq)
+#endif
+
+#endif /* TRACE_RECORDER_H_ */
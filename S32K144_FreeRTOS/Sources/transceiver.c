@@ -13,12 +13,9 @@ void WDOG_disable (void)
 
 void PORT_init (void)
 {
-	PCC->PCCn[PCC_PORTE_INDEX] |= PCC_PCCn_CGC_MASK; /* Enable clock for PORTE */
 	PCC->PCCn[PCC_PORTD_INDEX ]|=PCC_PCCn_CGC_MASK;   /* Enable clock for PORTD */
 
-	PORTE->PCR[4] |= PORT_PCR_MUX(5); /* Port E4: MUX = ALT5, CAN0_RX */
-	PORTE->PCR[5] |= PORT_PCR_MUX(5); /* Port E5: MUX = ALT5, CAN0_TX */
-
+	/* The CAN pins are routed by rtos_can_init, only for the CANs that are started */
 
 	PORTD->PCR[0]  =  0x00000100;  /* Port D0: MUX = GPIO */
 	PORTD->PCR[15] =  0x00000100;  /* Port D15: MUX = GPIO */
@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""Recommends the stack of each task of the S32K144_FreeRTOS project.
+
+Run the application under a representative load for long enough to reach the
+worst paths (CAN bursts, SW3, ADC, SBC faults), log the CAN bus, and pass the
+log to this tool. The run-time report thread sends, every second, one frame
+per task on ID 0x70:
+    number, load, free stack in words (u16, little endian), priority, name[3]
+The free stack is the high water mark since the task started, so the last
+report of each task is the minimum of the run. A frame on 0x73 means that a
+stack overflowed (configCHECK_FOR_STACK_OVERFLOW) and the core was reset.
+
+The stack of each task is read from the sys_thread_new calls of main.c, and
+the stacks of the idle and timer tasks from FreeRTOSConfig.h. The result is
+the used stack plus a margin, rounded to keep the stacks 8 byte aligned.
+
+Usage:
+    stack_sizer.py profile.log [--margin 25] [--min-margin 32]
+"""
+
+import argparse
+import os
+import re
+import sys
+
+RUNTIME_REPORT_ID = 0x70
+STACK_OVERFLOW_REPORT_ID = 0x73
+
+PROJECT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "S32K144_FreeRTOS")
+MAIN_C = os.path.join(PROJECT, "Sources", "main.c")
+CONFIG_H = os.path.join(PROJECT, "Generated_Code", "FreeRTOSConfig.h")
+HEAP_POOL_C = os.path.join(PROJECT, "Sources", "heap_pool.c")
+
+# Bytes of a stack word (StackType_t)
+WORD_BYTES = 4
+# Words of the stack alignment (portBYTE_ALIGNMENT of 8 bytes)
+ALIGN_WORDS = 2
+
+FRAME_SHORT = re.compile(r"\b([0-9A-Fa-f]{3,8})#([0-9A-Fa-f]*)")
+FRAME_LONG = re.compile(r"\b([0-9A-Fa-f]{3,8})\s+\[(\d)\]\s+((?:[0-9A-Fa-f]{2}\s*)*)")
+DEFINE = re.compile(r"^\s*#define\s+(\w+)\s+(.+?)\s*(?:/\*.*)?$")
+THREAD = re.compile(r'sys_thread_new\(\s*"([^"]*)"\s*,\s*\w+\s*,\s*\w+\s*,\s*(\w+)\s*,')
+
+
+def parse_frames(lines):
+    """Yields (ID, data) for each CAN frame of the log."""
+    for line in lines:
+        match = FRAME_SHORT.search(line)
+        if match:
+            yield int(match.group(1), 16), bytes.fromhex(match.group(2))
+            continue
+        match = FRAME_LONG.search(line)
+        if match:
+            data = bytes.fromhex("".join(match.group(3).split()))
+            yield int(match.group(1), 16), data[: int(match.group(2))]
+
+
+def read_defines(path):
+    """Gets the object-like macros of a file."""
+    defines = {}
+    with open(path) as source:
+        for line in source:
+            match = DEFINE.match(line)
+            if match and "(" not in match.group(1):
+                defines[match.group(1)] = match.group(2)
+    return defines
+
+
+def evaluate(expression, defines, depth=0):
+    """Evaluates a macro made of numbers, casts and other macros."""
+    if depth > 16:
+        raise ValueError("recursive macro: %s" % expression)
+    expression = re.sub(r"\(\s*(?:unsigned\s+short|size_t|TickType_t|uint\d+_t)\s*\)", "", expression)
+    expression = re.sub(r"\b(\d+)[uUlL]+\b", r"\1", expression)
+
+    def replace(match):
+        name = match.group(0)
+        if name in defines:
+            return "(%d)" % evaluate(defines[name], defines, depth + 1)
+        raise ValueError("unknown macro %s" % name)
+
+    expression = re.sub(r"\b[A-Za-z_]\w*\b", replace, expression)
+    return int(eval(expression, {"__builtins__": {}}))
+
+
+def read_tasks(main_c, config_h):
+    """Gets (name, stack macro, stack in words) of each task, in creation order."""
+    defines = read_defines(config_h)
+    defines.update(read_defines(main_c))
+    tasks = []
+    with open(main_c) as source:
+        for match in THREAD.finditer(source.read()):
+            task = (match.group(1), match.group(2), evaluate(match.group(2), defines))
+            # The calls in alternative #if branches (RX_MODE) create the same task
+            if task not in tasks:
+                tasks.append(task)
+    # Created by vTaskStartScheduler, after the application tasks
+    tasks.append(("IDLE", "configMINIMAL_STACK_SIZE", evaluate("configMINIMAL_STACK_SIZE", defines)))
+    tasks.append(("Tmr Svc", "configTIMER_TASK_STACK_DEPTH", evaluate("configTIMER_TASK_STACK_DEPTH", defines)))
+    return tasks
+
+
+def read_pool_classes(path):
+    """Gets the block size of each class of the heap, from the smallest one."""
+    defines = read_defines(path)
+    sizes = []
+    index = 0
+    while "CLASS_%d_SIZE" % index in defines:
+        sizes.append(evaluate(defines["CLASS_%d_SIZE" % index], defines))
+        index += 1
+    return sizes
+
+
+def pool_block(classes, words):
+    """Gets the block of the heap that serves a stack."""
+    for size in classes:
+        if size >= words * WORD_BYTES:
+            return size
+    return None
+
+
+def recommend(used, margin, min_margin):
+    """Gets the used stack plus the margin, aligned."""
+    words = used + max((used * margin + 99) // 100, min_margin)
+    return -(-words // ALIGN_WORDS) * ALIGN_WORDS
+
+
+def match_reports(tasks, reports):
+    """Matches the reported tasks with the created ones.
+
+    The report only has 3 characters of the name, so tasks with the same prefix
+    are matched in creation order (The task numbers grow with each creation).
+    """
+    matched = {}
+    for number in sorted(reports):
+        prefix = reports[number][0]
+        for index, (name, _, _) in enumerate(tasks):
+            if index not in matched and name[: len(prefix)] == prefix and (prefix or not name):
+                matched[index] = reports[number]
+                break
+    return matched
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="CAN log of the profiling run ('-' for stdin)")
+    parser.add_argument("--margin", type=int, default=25, help="margin over the used stack, in percent (25)")
+    parser.add_argument(
+        "--min-margin",
+        type=int,
+        default=32,
+        help="minimum margin, in words (32, an exception frame with the FPU context uses 26)",
+    )
+    parser.add_argument("--main", default=MAIN_C, help="main.c with the sys_thread_new calls")
+    parser.add_argument("--config", default=CONFIG_H, help="FreeRTOSConfig.h")
+    parser.add_argument("--heap", default=HEAP_POOL_C, help="heap_pool.c with the size classes")
+    args = parser.parse_args()
+
+    tasks = read_tasks(args.main, args.config)
+    classes = read_pool_classes(args.heap) if os.path.exists(args.heap) else []
+
+    reports = {}
+    overflows = []
+    log = sys.stdin if args.log == "-" else open(args.log)
+    with log:
+        for frame_id, data in parse_frames(log):
+            if frame_id == RUNTIME_REPORT_ID and len(data) == 8:
+                name = data[5:8].split(b"\0")[0].decode("ascii", "replace")
+                free = int.from_bytes(data[2:4], "little")
+                previous = reports.get(data[0], (name, free))[1]
+                reports[data[0]] = (name, min(free, previous))
+            elif frame_id == STACK_OVERFLOW_REPORT_ID:
+                overflows.append(data.split(b"\0")[0].decode("ascii", "replace"))
+
+    if not reports:
+        sys.exit("No run-time report (ID 0x%X) found" % RUNTIME_REPORT_ID)
+    for name in overflows:
+        print("warning: the stack of %s overflowed during the run, give it more stack and profile again" % name)
+
+    matched = match_reports(tasks, reports)
+    print("%-20s  %8s  %8s  %8s  %12s  %10s" % ("task", "stack", "free", "used", "recommended", "heap_block"))
+    total_now = 0
+    total_after = 0
+    lines = []
+    for index, (name, macro, stack) in enumerate(tasks):
+        if index not in matched:
+            print("%-20s  %8d  %8s  %8s  %12s" % (name, stack, "-", "-", "not reported"))
+            continue
+        free = matched[index][1]
+        used = stack - free
+        words = recommend(used, args.margin, args.min_margin)
+        block_now = pool_block(classes, stack)
+        block_after = pool_block(classes, words)
+        print(
+            "%-20s  %8d  %8d  %8d  %12d  %4s -> %s"
+            % (name, stack, free, used, words, block_now or "-", block_after or "none")
+        )
+        total_now += stack * WORD_BYTES
+        total_after += words * WORD_BYTES
+        lines.append((macro, words, name))
+
+    print("\nstacks: %d bytes now, %d bytes recommended (%d bytes freed)" % (total_now, total_after, total_now - total_after))
+    print("The heap blocks are the size classes of heap_pool.c: resize CLASS_n_SIZE/BLOCKS to keep the bytes freed.\n")
+
+    # A macro shared by several tasks gets the biggest recommendation
+    sizes = {}
+    users = {}
+    for macro, words, name in lines:
+        sizes[macro] = max(sizes.get(macro, 0), words)
+        users.setdefault(macro, []).append(name)
+    for macro in sizes:
+        where = "FreeRTOSConfig.h" if macro.startswith("config") else "main.c"
+        print("#define %-28s (%d)  /* %s: %s */" % (macro, sizes[macro], where, ", ".join(users[macro])))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""Decodes a kernel trace dump of the S32K144_FreeRTOS project into a timeline.
+
+The dump is requested with a frame on ID 0x7F and sent by the run-time report
+thread (rtos_trace_request_dump):
+    0x70  run-time report, one frame per task (Gives the names of the tasks)
+    0x71  header: records (u16), core clock in Hz (u32), tick rate in Hz (u16)
+    0x72  one record per frame: DWT cycles (u32), event, task, object (u16)
+All the values are little endian.
+
+The input is a CAN log with one frame per line, as written by candump
+("(time) can0 072#0011223344556677" or "can0  072   [8]  00 11 ...").
+
+Usage:
+    trace_decode.py dump.log [--name 0x7A10=tx_queue ...]
+"""
+
+import argparse
+import re
+import sys
+
+RUNTIME_REPORT_ID = 0x70
+TRACE_DUMP_HEADER_ID = 0x71
+TRACE_DUMP_RECORD_ID = 0x72
+
+# Same order as trace_event_t (trace_recorder.h)
+EVENTS = [
+    "switched_in",
+    "ready",
+    "queue_send",
+    "queue_send_failed",
+    "queue_receive",
+    "queue_receive_failed",
+    "block_on_send",
+    "block_on_receive",
+    "queue_send_from_isr",
+    "queue_receive_from_isr",
+    "delay",
+    "delay_until",
+    "tick_step",
+    "isr_enter",
+    "isr_exit",
+]
+EVENT = {name: value for value, name in enumerate(EVENTS)}
+
+QUEUE_EVENTS = range(EVENT["queue_send"], EVENT["queue_receive_from_isr"] + 1)
+
+# Interruption numbers of the S32K144 used by the driver
+IRQ_NAMES = {
+    27: "LPSPI1",
+    39: "ADC0",
+    40: "ADC1",
+    61: "PORTC",
+    81: "CAN0_MB",
+    88: "CAN1_MB",
+    95: "CAN2_MB",
+}
+
+FRAME_SHORT = re.compile(r"\b([0-9A-Fa-f]{3,8})#([0-9A-Fa-f]*)")
+FRAME_LONG = re.compile(r"\b([0-9A-Fa-f]{3,8})\s+\[(\d)\]\s+((?:[0-9A-Fa-f]{2}\s*)*)")
+
+
+def parse_frames(lines):
+    """Yields (ID, data) for each CAN frame of the log."""
+    for line in lines:
+        match = FRAME_SHORT.search(line)
+        if match:
+            yield int(match.group(1), 16), bytes.fromhex(match.group(2))
+            continue
+        match = FRAME_LONG.search(line)
+        if match:
+            data = bytes.fromhex("".join(match.group(3).split()))
+            yield int(match.group(1), 16), data[: int(match.group(2))]
+
+
+def read_dump(frames):
+    """Gets the task names, the header and the records of the last dump."""
+    names = {}
+    header = None
+    records = []
+    for frame_id, data in frames:
+        if frame_id == RUNTIME_REPORT_ID and len(data) == 8:
+            name = data[5:8].split(b"\0")[0].decode("ascii", "replace")
+            names[data[0]] = name
+        elif frame_id == TRACE_DUMP_HEADER_ID and len(data) == 8:
+            header = (
+                int.from_bytes(data[0:2], "little"),
+                int.from_bytes(data[2:6], "little"),
+                int.from_bytes(data[6:8], "little"),
+            )
+            records = []
+        elif frame_id == TRACE_DUMP_RECORD_ID and len(data) == 8 and header:
+            records.append(
+                (
+                    int.from_bytes(data[0:4], "little"),
+                    data[4],
+                    data[5],
+                    int.from_bytes(data[6:8], "little"),
+                )
+            )
+    return names, header, records
+
+
+def unwrap(records, cycles_per_tick):
+    """Converts the 32 bits cycle counts to a time line in cycles.
+
+    The counter wraps every 2^32 cycles and stops while the core sleeps, so the
+    ticks of each tick_step are added as the time slept. Frames of equal ID can
+    be reordered by the Tx message buffers, so the records are sorted after the
+    counts are unwrapped (Each difference is read as signed).
+    """
+    timeline = []
+    previous = None
+    now = 0
+    slept = 0
+    for order, (stamp, event, task, obj) in enumerate(records):
+        if previous is not None:
+            delta = (stamp - previous) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            now += delta
+        previous = stamp
+        if event == EVENT["tick_step"]:
+            slept += obj * cycles_per_tick
+        timeline.append((now + slept, order, event, task, obj))
+    timeline.sort()
+    return timeline
+
+
+def describe(event, obj, names, objects):
+    """Gets the event name and its object."""
+    name = EVENTS[event] if event < len(EVENTS) else "event_%d" % event
+    if event in (EVENT["switched_in"], EVENT["ready"]):
+        return name, task_name(obj, names)
+    if event in QUEUE_EVENTS:
+        return name, objects.get(obj, "0x%04X" % obj)
+    if event in (EVENT["isr_enter"], EVENT["isr_exit"]):
+        return name, IRQ_NAMES.get(obj, "IRQ%d" % obj)
+    if event == EVENT["tick_step"]:
+        return name, "%d ticks slept" % obj
+    return name, ""
+
+
+def task_name(number, names):
+    return "%d:%s" % (number, names.get(number, "?"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="CAN log with the dump ('-' for stdin)")
+    parser.add_argument(
+        "--name",
+        action="append",
+        default=[],
+        metavar="OBJECT=LABEL",
+        help="label of a queue, by the low half of its address (E.g. 0x7A10=tx_queue)",
+    )
+    args = parser.parse_args()
+
+    objects = {}
+    for item in args.name:
+        obj, _, label = item.partition("=")
+        objects[int(obj, 0) & 0xFFFF] = label
+
+    log = sys.stdin if args.log == "-" else open(args.log)
+    with log:
+        names, header, records = read_dump(parse_frames(log))
+
+    if not header:
+        sys.exit("No trace dump (ID 0x%X) found" % TRACE_DUMP_HEADER_ID)
+    count, clock, tick_rate = header
+    if len(records) != count:
+        print("warning: %d of %d records received" % (len(records), count), file=sys.stderr)
+
+    cycles_per_tick = clock // tick_rate
+    us_per_cycle = 1e6 / clock
+    timeline = unwrap(records, cycles_per_tick)
+    if not timeline:
+        return
+
+    start = timeline[0][0]
+    ready_since = {}
+    isr_since = {}
+    worst_ready = {}
+    worst_isr = {}
+    run_since = None
+    running = None
+    run_time = {}
+
+    print("%12s  %-8s  %-22s  %s" % ("time_us", "task", "event", "object"))
+    for cycles, _, event, task, obj in timeline:
+        name, detail = describe(event, obj, names, objects)
+        print("%12.1f  %-8s  %-22s  %s" % ((cycles - start) * us_per_cycle, task_name(task, names), name, detail))
+
+        if event == EVENT["ready"]:
+            ready_since.setdefault(obj, cycles)
+        elif event == EVENT["switched_in"]:
+            if running is not None:
+                run_time[running] = run_time.get(running, 0) + cycles - run_since
+            running, run_since = obj, cycles
+            if obj in ready_since:
+                latency = cycles - ready_since.pop(obj)
+                worst_ready[obj] = max(worst_ready.get(obj, 0), latency)
+        elif event == EVENT["isr_enter"]:
+            isr_since[obj] = cycles
+        elif event == EVENT["isr_exit"] and obj in isr_since:
+            duration = cycles - isr_since.pop(obj)
+            worst_isr[obj] = max(worst_isr.get(obj, 0), duration)
+
+    if running is not None:
+        run_time[running] = run_time.get(running, 0) + timeline[-1][0] - run_since
+    total = max(timeline[-1][0] - start, 1)
+
+    print("\n%-10s  %10s  %8s  %18s" % ("task", "run_us", "cpu_%", "worst_ready_us"))
+    for number in sorted(set(run_time) | set(worst_ready)):
+        print(
+            "%-10s  %10.1f  %8.1f  %18.1f"
+            % (
+                task_name(number, names),
+                run_time.get(number, 0) * us_per_cycle,
+                100.0 * run_time.get(number, 0) / total,
+                worst_ready.get(number, 0) * us_per_cycle,
+            )
+        )
+    if worst_isr:
+        print("\n%-10s  %14s" % ("interrupt", "worst_us"))
+        for irq in sorted(worst_isr):
+            print("%-10s  %14.1f" % (IRQ_NAMES.get(irq, "IRQ%d" % irq), worst_isr[irq] * us_per_cycle))
+
+
+if __name__ == "__main__":
+    main()